@@ -0,0 +1,129 @@
+#include "datastructure/GeneralTimetable.hpp"
+#include "datastructure/RailwayNetwork.hpp"
+#include "datastructure/Route.hpp"
+#include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <gsl/span>
+#include <map>
+#include <plog/Appenders/ColorConsoleAppender.h>
+#include <plog/Formatters/TxtFormatter.h>
+#include <plog/Initializers/ConsoleInitializer.h>
+#include <plog/Log.h>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,bugprone-exception-escape)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  /**
+   * Measures the import time of all general performance optimization
+   * instances within a directory, e.g., test/example-networks-gen-po. The
+   * network, timetable and routes are timed separately, followed by the
+   * import of the complete instance, sequentially and using the concurrent
+   * import_instance_async.
+   * Arguments: instance directory, repetitions (optional, default 10)
+   */
+
+  // Only log to console using std::cerr and std::cout respectively unless
+  // initialized differently
+  if (plog::get() == nullptr) {
+    static plog::ColorConsoleAppender<plog::TxtFormatter> console_appender;
+    plog::init(plog::info, &console_appender);
+  }
+
+  if (argc < 2 || argc > 3) {
+    PLOGE << "Expected 1 or 2 arguments, got " << argc - 1;
+    PLOGE << "Usage: " << argv[0] << " instance_directory [repetitions]";
+    std::exit(-1);
+  }
+
+  auto         args        = gsl::span<char*>(argv, argc);
+  const size_t repetitions = argc >= 3 ? std::stoul(args[2]) : 10;
+
+  const std::filesystem::path instance_dir = args[1];
+
+  std::vector<std::filesystem::path> instance_paths;
+  for (const auto& entry : std::filesystem::directory_iterator(instance_dir)) {
+    if (entry.is_directory() &&
+        std::filesystem::exists(entry.path() / "problem_data.json")) {
+      instance_paths.push_back(entry.path());
+    }
+  }
+  std::sort(instance_paths.begin(), instance_paths.end());
+  PLOGI << "Found " << instance_paths.size() << " instances in "
+        << instance_dir.string();
+
+  double network_time   = 0;
+  double timetable_time = 0;
+  double routes_time    = 0;
+  double instance_time  = 0;
+  double async_time     = 0;
+  size_t num_edges      = 0;
+
+  std::map<std::string, double> async_part_times;
+  for (size_t rep = 0; rep < repetitions; rep++) {
+    for (const auto& path : instance_paths) {
+      auto start = Clock::now();
+      const cda_rail::Network network(path / "network");
+      network_time += elapsed_ms(start);
+
+      start = Clock::now();
+      const cda_rail::GeneralTimetable<
+          cda_rail::GeneralSchedule<cda_rail::GeneralScheduledStop>>
+          timetable(path / "timetable", network);
+      timetable_time += elapsed_ms(start);
+
+      start = Clock::now();
+      const cda_rail::RouteMap routes(path / "routes", network);
+      routes_time += elapsed_ms(start);
+
+      start = Clock::now();
+      const cda_rail::instances::GeneralPerformanceOptimizationInstance
+          instance(path);
+      instance_time += elapsed_ms(start);
+
+      std::map<std::string, double> part_times;
+      start = Clock::now();
+      const auto instance_async = cda_rail::instances::
+          GeneralPerformanceOptimizationInstance::import_instance_async(
+              path, &part_times);
+      async_time += elapsed_ms(start);
+      for (const auto& [part, time] : part_times) {
+        async_part_times[part] += time;
+      }
+
+      num_edges += instance.const_n().number_of_edges();
+    }
+  }
+
+  const auto num_imports =
+      static_cast<double>(repetitions * instance_paths.size());
+  PLOGI << "Average import times over " << instance_paths.size()
+        << " instances with " << num_edges / std::max<size_t>(1, repetitions)
+        << " edges in total:";
+  PLOGI << "Network: " << network_time / num_imports << " ms";
+  PLOGI << "Timetable: " << timetable_time / num_imports << " ms";
+  PLOGI << "Routes: " << routes_time / num_imports << " ms";
+  PLOGI << "Complete instance: " << instance_time / num_imports << " ms";
+  PLOGI << "Complete instance (async): " << async_time / num_imports << " ms";
+  for (const auto& [part, time] : async_part_times) {
+    PLOGI << "  " << part << ": " << time / num_imports << " ms";
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,bugprone-exception-escape)
@@ -0,0 +1,153 @@
+#include "Definitions.hpp"
+#include "datastructure/TrainTrajectory.hpp"
+#include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <gsl/span>
+#include <plog/Appenders/ColorConsoleAppender.h>
+#include <plog/Formatters/TxtFormatter.h>
+#include <plog/Initializers/ConsoleInitializer.h>
+#include <plog/Log.h>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,bugprone-exception-escape)
+
+namespace {
+
+using Solution = cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>;
+
+constexpr double EDGE_LENGTH  = 100;
+constexpr double TRAIN_SPEED  = 10;
+constexpr int    TRAIN_LENGTH = 50;
+constexpr int    HEADWAY      = 60;
+
+Solution create_solution(size_t num_trains, size_t num_edges) {
+  /**
+   * Creates a solution on a single line of num_edges edges, which is
+   * traversed by all trains one after another at constant speed.
+   */
+
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
+  for (size_t i = 0; i <= num_edges; i++) {
+    instance.n().add_vertex("v" + std::to_string(i),
+                            cda_rail::VertexType::TTD);
+  }
+  for (size_t i = 0; i < num_edges; i++) {
+    instance.n().add_edge(i, i + 1, EDGE_LENGTH, 2 * TRAIN_SPEED, false);
+    if (i > 0) {
+      instance.n().add_successor(i - 1, i);
+    }
+  }
+
+  const auto travel_time =
+      static_cast<int>(static_cast<double>(num_edges) * EDGE_LENGTH /
+                       TRAIN_SPEED) +
+      HEADWAY;
+  for (size_t tr = 0; tr < num_trains; tr++) {
+    const auto t_0 = static_cast<int>(tr) * HEADWAY;
+    instance.add_train("tr" + std::to_string(tr), TRAIN_LENGTH,
+                       2 * TRAIN_SPEED, 1, 1, {t_0, t_0}, TRAIN_SPEED, "v0",
+                       {t_0, t_0 + 2 * travel_time}, TRAIN_SPEED,
+                       "v" + std::to_string(num_edges));
+  }
+
+  Solution solution(instance);
+  solution.set_obj(0);
+  solution.set_status(cda_rail::SolutionStatus::Feasible);
+  solution.set_solution_found();
+  for (size_t tr = 0; tr < num_trains; tr++) {
+    const auto tr_name = "tr" + std::to_string(tr);
+    const auto t_0     = static_cast<double>(tr * HEADWAY);
+    solution.add_empty_route(tr_name);
+    cda_rail::TrainTrajectoryBuilder trajectory;
+    trajectory.reserve(num_edges + 2);
+    for (size_t i = 0; i < num_edges; i++) {
+      solution.push_back_edge_to_route(tr_name, i);
+      trajectory.add(t_0 + static_cast<double>(i) * EDGE_LENGTH / TRAIN_SPEED,
+                     static_cast<double>(i) * EDGE_LENGTH, TRAIN_SPEED);
+    }
+    const auto r_len = static_cast<double>(num_edges) * EDGE_LENGTH;
+    trajectory.add(t_0 + r_len / TRAIN_SPEED, r_len, TRAIN_SPEED);
+    trajectory.add(t_0 + (r_len + TRAIN_LENGTH) / TRAIN_SPEED,
+                   r_len + TRAIN_LENGTH, TRAIN_SPEED);
+    solution.set_train_trajectory(tr_name, trajectory.build());
+    solution.set_train_routed(tr_name);
+  }
+  return solution;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  /**
+   * Measures ordering and bound queries on a solution object, i.e.,
+   * get_train_order for every edge and get_edge_and_time_bounds for every
+   * train at every second of its trip.
+   * Arguments (all optional): number of trains (default 50), number of edges
+   * (default 100), repetitions (default 10)
+   */
+
+  // Only log to console using std::cerr and std::cout respectively unless
+  // initialized differently
+  if (plog::get() == nullptr) {
+    static plog::ColorConsoleAppender<plog::TxtFormatter> console_appender;
+    plog::init(plog::info, &console_appender);
+  }
+
+  if (argc > 4) {
+    PLOGE << "Expected at most 3 arguments, got " << argc - 1;
+    std::exit(-1);
+  }
+
+  auto         args        = gsl::span<char*>(argv, argc);
+  const size_t num_trains  = argc >= 2 ? std::stoul(args[1]) : 50;
+  const size_t num_edges   = argc >= 3 ? std::stoul(args[2]) : 100;
+  const size_t repetitions = argc >= 4 ? std::stoul(args[3]) : 10;
+
+  const auto solution = create_solution(num_trains, num_edges);
+  PLOGI << "Created solution with " << num_trains << " trains on "
+        << num_edges << " edges";
+
+  // Accumulate results so that the queries are not optimized away
+  size_t checksum = 0;
+
+  const auto order_start = std::chrono::steady_clock::now();
+  for (size_t rep = 0; rep < repetitions; rep++) {
+    for (size_t e = 0; e < num_edges; e++) {
+      checksum += solution.get_train_order(e).front();
+    }
+  }
+  const auto order_time = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - order_start)
+                              .count();
+
+  size_t     num_bound_queries = 0;
+  const auto bounds_start      = std::chrono::steady_clock::now();
+  for (size_t rep = 0; rep < repetitions; rep++) {
+    for (size_t tr = 0; tr < num_trains; tr++) {
+      const auto  tr_name = "tr" + std::to_string(tr);
+      const auto& times   = solution.get_train_trajectory(tr_name).get_times();
+      for (auto t = times.front(); t <= times.back(); t += 1) {
+        const auto [edge, t0, t1] =
+            solution.get_edge_and_time_bounds(tr_name, t);
+        checksum += edge;
+        num_bound_queries++;
+      }
+    }
+  }
+  const auto bounds_time = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - bounds_start)
+                               .count();
+
+  PLOGI << "get_train_order: " << order_time / static_cast<double>(repetitions)
+        << " ms for all " << num_edges << " edges";
+  PLOGI << "get_edge_and_time_bounds: "
+        << bounds_time * 1000 / static_cast<double>(num_bound_queries)
+        << " us per query (" << num_bound_queries << " queries)";
+  PLOGD << "Checksum: " << checksum;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,bugprone-exception-escape)
@@ -0,0 +1,304 @@
+#include "Definitions.hpp"
+#include "VSSModel.hpp"
+#include "nlohmann/json.hpp"
+#include "probleminstances/VSSGenerationTimetable.hpp"
+#include "solver/mip-based/GurobiEnvironmentPool.hpp"
+#include "solver/mip-based/VSSGenTimetableSolver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <gsl/span>
+#include <plog/Appenders/ColorConsoleAppender.h>
+#include <plog/Formatters/TxtFormatter.h>
+#include <plog/Initializers/ConsoleInitializer.h>
+#include <plog/Log.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+
+namespace {
+
+struct Configuration {
+  int    delta_t                = 15;
+  bool   fix_routes             = true;
+  bool   include_braking_curves = true;
+  bool   iterate_vss            = false;
+  int    optimality_strategy    = 0;
+  int    update_strategy        = 0;
+  double initial_vss            = 1;
+  double update_value           = 2;
+  bool   include_cuts           = true;
+  int    timeout                = -1;
+
+  [[nodiscard]] std::string to_string() const;
+  [[nodiscard]] static std::vector<Configuration>
+  import_configurations(const std::filesystem::path& p);
+};
+
+struct Result {
+  std::string status = "Error";
+  double      obj    = -1;
+  double      bound  = -1;
+  // Times in seconds
+  double      create_time = -1;
+  double      solve_time  = -1;
+  double      total_time  = -1;
+  std::string error;
+};
+
+std::string Configuration::to_string() const {
+  return std::to_string(delta_t) + "_" +
+         std::to_string(static_cast<int>(fix_routes)) + "_" +
+         std::to_string(static_cast<int>(include_braking_curves)) + "_" +
+         std::to_string(static_cast<int>(iterate_vss)) + "_" +
+         std::to_string(optimality_strategy) + "_" +
+         std::to_string(update_strategy) + "_" + std::to_string(initial_vss) +
+         "_" + std::to_string(update_value) + "_" +
+         std::to_string(static_cast<int>(include_cuts)) + "_" +
+         std::to_string(timeout);
+}
+
+std::vector<Configuration>
+Configuration::import_configurations(const std::filesystem::path& p) {
+  /**
+   * Reads one configuration per line, values separated by commas in the order
+   * delta_t, fix_routes, include_braking_curves, iterate_vss,
+   * optimality_strategy, update_strategy, initial_vss, update_value,
+   * include_cuts, timeout
+   * (same as the arguments of vss_generation_timetable_iterative_parameter_
+   * testing). Empty lines and lines starting with # are ignored.
+   */
+
+  std::ifstream file(p);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open configuration file " +
+                             p.string());
+  }
+
+  std::vector<Configuration> configurations;
+  std::string                line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream line_stream(line);
+    Configuration      config;
+    int                fix_routes_int             = 0;
+    int                include_braking_curves_int = 0;
+    int                iterate_vss_int            = 0;
+    int                include_cuts_int           = 0;
+    if (!(line_stream >> config.delta_t >> fix_routes_int >>
+          include_braking_curves_int >> iterate_vss_int >>
+          config.optimality_strategy >> config.update_strategy >>
+          config.initial_vss >> config.update_value >> include_cuts_int >>
+          config.timeout)) {
+      throw std::runtime_error("Invalid configuration: " + line);
+    }
+    config.fix_routes             = fix_routes_int != 0;
+    config.include_braking_curves = include_braking_curves_int != 0;
+    config.iterate_vss            = iterate_vss_int != 0;
+    config.include_cuts           = include_cuts_int != 0;
+    configurations.push_back(config);
+  }
+  return configurations;
+}
+
+std::string status_to_string(cda_rail::SolutionStatus status) {
+  switch (status) {
+  case cda_rail::SolutionStatus::Optimal:
+    return "Optimal";
+  case cda_rail::SolutionStatus::Feasible:
+    return "Feasible";
+  case cda_rail::SolutionStatus::Infeasible:
+    return "Infeasible";
+  case cda_rail::SolutionStatus::Timeout:
+    return "Timeout";
+  default:
+    return "Unknown";
+  }
+}
+
+Result solve_configuration(
+    const cda_rail::instances::VSSGenerationTimetable& instance,
+    const Configuration& config, int threads_per_solve) {
+  Result result;
+
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    cda_rail::solver::mip_based::VSSGenTimetableSolver solver(instance);
+    solver.set_threads(threads_per_solve);
+
+    const auto sol = solver.solve(
+        {config.delta_t, config.fix_routes, true,
+         config.include_braking_curves},
+        {cda_rail::vss::Model(cda_rail::vss::ModelType::Continuous)},
+        {config.iterate_vss,
+         static_cast<cda_rail::OptimalityStrategy>(config.optimality_strategy),
+         static_cast<cda_rail::solver::mip_based::UpdateStrategy>(
+             config.update_strategy),
+         config.initial_vss, config.update_value, config.include_cuts},
+        {}, config.timeout, false);
+
+    result.status      = status_to_string(sol.get_status());
+    result.obj         = sol.has_solution() ? sol.get_obj() : -1;
+    result.bound       = solver.get_obj_bound();
+    result.create_time = static_cast<double>(solver.get_create_time()) / 1000;
+    result.solve_time  = static_cast<double>(solver.get_solve_time()) / 1000;
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+  result.total_time =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  return result;
+}
+
+void export_results(const std::filesystem::path&      p,
+                    const std::string&                model_name,
+                    const std::vector<Configuration>& configurations,
+                    const std::vector<Result>&        results) {
+  std::filesystem::create_directories(p);
+
+  std::ofstream csv_file(p / (model_name + "_sweep.csv"));
+  csv_file << "model,delta_t,fix_routes,include_braking_curves,iterate_vss,"
+              "optimality_strategy,update_strategy,initial_vss,update_value,"
+              "include_cuts,timeout,status,obj,bound,create_time,solve_time,"
+              "total_time\n";
+
+  nlohmann::json json_results = nlohmann::json::array();
+  for (size_t i = 0; i < configurations.size(); ++i) {
+    const auto& config = configurations.at(i);
+    const auto& result = results.at(i);
+
+    csv_file << model_name << "," << config.delta_t << ","
+             << config.fix_routes << "," << config.include_braking_curves
+             << "," << config.iterate_vss << "," << config.optimality_strategy
+             << "," << config.update_strategy << "," << config.initial_vss
+             << "," << config.update_value << "," << config.include_cuts << ","
+             << config.timeout << "," << result.status << "," << result.obj
+             << "," << result.bound << "," << result.create_time << ","
+             << result.solve_time << "," << result.total_time << "\n";
+
+    nlohmann::json json_result;
+    json_result["model"]                  = model_name;
+    json_result["configuration"]          = config.to_string();
+    json_result["delta_t"]                = config.delta_t;
+    json_result["fix_routes"]             = config.fix_routes;
+    json_result["include_braking_curves"] = config.include_braking_curves;
+    json_result["iterate_vss"]            = config.iterate_vss;
+    json_result["optimality_strategy"]    = config.optimality_strategy;
+    json_result["update_strategy"]        = config.update_strategy;
+    json_result["initial_vss"]            = config.initial_vss;
+    json_result["update_value"]           = config.update_value;
+    json_result["include_cuts"]           = config.include_cuts;
+    json_result["timeout"]                = config.timeout;
+    json_result["status"]                 = result.status;
+    json_result["obj"]                    = result.obj;
+    json_result["bound"]                  = result.bound;
+    json_result["create_time"]            = result.create_time;
+    json_result["solve_time"]             = result.solve_time;
+    json_result["total_time"]             = result.total_time;
+    if (!result.error.empty()) {
+      json_result["error"] = result.error;
+    }
+    json_results.push_back(json_result);
+  }
+
+  std::ofstream json_file(p / (model_name + "_sweep.json"));
+  json_file << json_results.dump(2) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  // Only log to console using std::cerr and std::cout respectively unless
+  // initialized differently
+  if (plog::get() == nullptr) {
+    static plog::ColorConsoleAppender<plog::TxtFormatter> console_appender;
+    plog::init(plog::info, &console_appender);
+  }
+
+  if (argc < 4 || argc > 7) {
+    PLOGE << "Expected 3 to 6 arguments, got " << argc - 1;
+    PLOGE << "Usage: " << argv[0]
+          << " model_name instance_path configuration_file [num_workers] "
+             "[threads_per_solve] [output_path]";
+    std::exit(-1);
+  }
+
+  auto args = gsl::span<char*>(argv, argc);
+
+  const std::string model_name         = args[1];
+  const std::string instance_path      = args[2];
+  const std::string configuration_path = args[3];
+  size_t            num_workers        = (argc >= 5 ? std::stoul(args[4]) : 0);
+  const int         threads_per_solve  = (argc >= 6 ? std::stoi(args[5]) : 1);
+  const std::string output_path        = (argc >= 7 ? args[6] : ".");
+
+  // The instance is only parsed once and copied into every solver
+  const auto instance =
+      cda_rail::instances::VSSGenerationTimetable::import_instance(
+          instance_path);
+  PLOGI << "Instance " << model_name << " loaded at " << instance_path;
+
+  const auto configurations =
+      Configuration::import_configurations(configuration_path);
+  PLOGI << configurations.size() << " configurations loaded from "
+        << configuration_path;
+
+  if (num_workers == 0) {
+    num_workers = std::max<size_t>(
+        1, std::thread::hardware_concurrency() /
+               static_cast<size_t>(std::max(1, threads_per_solve)));
+  }
+  num_workers = std::min(num_workers, configurations.size());
+  PLOGI << "Solving using " << num_workers << " workers with "
+        << threads_per_solve << " thread(s) each";
+
+  // Keep one started environment per worker
+  cda_rail::solver::mip_based::GurobiEnvironmentPool::get_instance()
+      .set_max_size(num_workers);
+
+  std::vector<Result> results(configurations.size());
+  std::atomic<size_t> next_config{0};
+  const auto          worker = [&]() {
+    while (true) {
+      const size_t i = next_config++;
+      if (i >= configurations.size()) {
+        break;
+      }
+      const auto& config = configurations.at(i);
+      PLOGI << "Start configuration " << i << ": " << config.to_string();
+      results.at(i) =
+          solve_configuration(instance, config, threads_per_solve);
+      PLOGI << "Finished configuration " << i << ": " << results.at(i).status
+            << " with objective " << results.at(i).obj << " in "
+            << results.at(i).total_time << " s";
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  export_results(output_path, model_name, configurations, results);
+  PLOGI << "Results written to " << output_path;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay)
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace cda_rail {
+class ColumnFileWriter {
+  /**
+   * Writes a compact binary file consisting of scalars, strings and columns of
+   * doubles. All integers are stored little-endian independent of the
+   * platform. Every value of a column is XORed with its predecessor and only
+   * the non-zero bytes of the result are stored (delta encoding). Hence,
+   * repeated values take a single byte and values that differ only slightly,
+   * e.g., equidistant times, take two to three bytes instead of eight.
+   * The encoding is lossless, including NaN.
+   */
+private:
+  std::ofstream file;
+
+  void write_bytes(uint64_t val, size_t num_bytes);
+
+public:
+  explicit ColumnFileWriter(const std::filesystem::path& p);
+
+  void write_size(size_t val);
+  void write_int(int64_t val);
+  void write_bool(bool val);
+  void write_string(const std::string& val);
+  void write_column(const std::vector<double>& column);
+  void close();
+};
+
+class ColumnFileReader {
+  /**
+   * Reads a file written by ColumnFileWriter. Values have to be read in the
+   * same order as they were written. Lengths read from the file are checked
+   * against the remaining file size before allocating memory for them.
+   */
+private:
+  std::ifstream file;
+  uintmax_t     file_size = 0;
+
+  [[nodiscard]] uint64_t read_bytes(size_t num_bytes);
+  [[nodiscard]] uint64_t remaining_bytes();
+
+public:
+  explicit ColumnFileReader(const std::filesystem::path& p);
+
+  [[nodiscard]] size_t              read_size();
+  [[nodiscard]] int64_t             read_int();
+  [[nodiscard]] bool                read_bool();
+  [[nodiscard]] std::string         read_string();
+  [[nodiscard]] std::vector<double> read_column();
+};
+} // namespace cda_rail
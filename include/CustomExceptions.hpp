@@ -134,6 +134,9 @@ public:
       : error_message("Some station specified does not exist.") {}
   explicit StationNotExistentException(const std::string& station_name)
       : error_message("Station " + station_name + " does not exist.") {}
+  explicit StationNotExistentException(size_t station_id)
+      : error_message("Station with ID " + std::to_string(station_id) +
+                      " does not exist.") {}
   [[nodiscard]] const char* what() const noexcept override {
     return error_message.c_str();
   }
@@ -32,6 +32,7 @@ enum class ExportOption {
   ExportSolutionAndLP             = 4,
   ExportSolutionWithInstanceAndLP = 5
 };
+enum class SolutionFormat { JSON = 0, Binary = 1 };
 enum class OptimalityStrategy { Optimal = 0, TradeOff = 1, Feasible = 2 };
 enum class VelocityRefinementStrategy { None = 0, MinOneStep = 1 };
 
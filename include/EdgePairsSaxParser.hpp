@@ -0,0 +1,60 @@
+#pragma once
+
+#include "nlohmann/json.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace cda_rail {
+class EdgePairsSaxParser : public nlohmann::json_sax<nlohmann::json> {
+  /**
+   * Streaming parser for files of the form
+   * {key: [[v_0, v_1], [v_2, v_3], ...], ...}
+   * as used for routes, stations and successors. Instead of building a json
+   * object first, on_key is called for every key and on_pair for every pair
+   * of vertex names as soon as it is read. A file only containing null is
+   * treated as empty.
+   */
+public:
+  using KeyCallback = std::function<void(const std::string& key)>;
+  using PairCallback =
+      std::function<void(const std::string& key, const std::string& v_0,
+                         const std::string& v_1)>;
+
+private:
+  KeyCallback  on_key;
+  PairCallback on_pair;
+  std::string  current_key;
+  std::string  current_v_0;
+  std::string  current_v_1;
+  size_t       depth        = 0;
+  size_t       num_vertices = 0;
+
+  [[noreturn]] static void throw_unexpected(const std::string& what);
+
+public:
+  EdgePairsSaxParser(KeyCallback on_key, PairCallback on_pair)
+      : on_key(std::move(on_key)), on_pair(std::move(on_pair)) {};
+
+  static void parse(const std::filesystem::path& p, KeyCallback on_key,
+                    PairCallback on_pair);
+
+  bool null() override;
+  bool boolean(bool val) override;
+  bool number_integer(number_integer_t val) override;
+  bool number_unsigned(number_unsigned_t val) override;
+  bool number_float(number_float_t val, const string_t& s) override;
+  bool string(string_t& val) override;
+  bool binary(binary_t& val) override;
+  bool start_object(std::size_t elements) override;
+  bool key(string_t& val) override;
+  bool end_object() override;
+  bool start_array(std::size_t elements) override;
+  bool end_array() override;
+  bool parse_error(std::size_t position, const std::string& last_token,
+                   const nlohmann::detail::exception& ex) override;
+};
+} // namespace cda_rail
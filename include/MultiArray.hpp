@@ -1,7 +1,9 @@
 #pragma once
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace cda_rail {
@@ -10,15 +12,34 @@ private:
   std::vector<size_t> shape;
   std::vector<T>      data;
 
+  // If non-empty, only the indices dim_1_intervals[i] (inclusive) of the
+  // second dimension are stored for index i of the first dimension
+  std::vector<std::pair<size_t, size_t>> dim_1_intervals;
+  std::vector<size_t>                    dim_0_offsets;
+
+  template <typename... Args>
+  [[nodiscard]] std::optional<size_t> flat_index(Args... args) const;
+
 public:
   // Constructor with arbitrary number of size_t parameters
   template <typename... Args> explicit MultiArray(Args... args);
 
+  // Constructor only storing an interval of the second dimension for every
+  // index of the first dimension
+  template <typename... Args>
+  [[nodiscard]] static MultiArray
+  with_intervals(const std::vector<std::pair<size_t, size_t>>& dim_1_intervals,
+                 size_t dim_1_size, Args... args);
+
   // getter with arbitrary number of size_t parameters
   template <typename... Args> T& operator()(Args... args);
 
   template <typename... Args> T at(Args... args) const;
 
+  template <typename... Args> [[nodiscard]] bool is_stored(Args... args) const {
+    return flat_index(args...).has_value();
+  };
+
   // Function to obtain shape, size and dimensions
   [[nodiscard]] const std::vector<size_t>& get_shape() const { return shape; };
   [[nodiscard]] size_t                     size() const { return data.size(); };
@@ -27,17 +48,16 @@ public:
 
 template <typename T>
 template <typename... Args>
-T& MultiArray<T>::operator()(Args... args) {
+std::optional<size_t> MultiArray<T>::flat_index(Args... args) const {
   /**
-   * Getter for an arbitrary number of dimensions.
-   * The first parameter is the index of the first dimension.
-   * The remaining parameters are the indices of the remaining dimensions.
-   * The number of parameters must coincide with the number of dimensions
-   * specified in shape. The value of each parameter must be smaller than the
-   * size of the corresponding dimension.
+   * Position of an element in data. The number of parameters must coincide
+   * with the number of dimensions specified in shape. The value of each
+   * parameter must be smaller than the size of the corresponding dimension.
    *
-   * @param first Index of the first dimension
-   * @param args Indices of the remaining dimensions
+   * @param args Indices of the dimensions
+   *
+   * @return Position in data, empty if the element is not stored, i.e., outside
+   * of the stored interval of the second dimension.
    */
 
   // If the number of dimensions and number of arguments does not coincide throw
@@ -56,57 +76,77 @@ T& MultiArray<T>::operator()(Args... args) {
     }
   }
 
-  // Get the index of the element in the data respecting the row-major order
-  size_t index      = 0;
-  size_t multiplier = 1;
-  for (size_t i = 0; i < sizeof...(args); ++i) {
+  if (dim_1_intervals.empty()) {
+    // Get the index of the element in the data respecting the row-major order
+    size_t index      = 0;
+    size_t multiplier = 1;
+    for (size_t i = 0; i < sizeof...(args); ++i) {
+      index += arg_tuple[i] * multiplier;
+      multiplier *= shape[i];
+    }
+    return index;
+  }
+
+  // Every index of the first dimension has a block of its own, within the
+  // block the same order as above is used
+  const auto& [first, last] = dim_1_intervals[arg_tuple[0]];
+  if (arg_tuple[1] < first || arg_tuple[1] > last) {
+    return {};
+  }
+  size_t index      = arg_tuple[1] - first;
+  size_t multiplier = last - first + 1;
+  for (size_t i = 2; i < sizeof...(args); ++i) {
     index += arg_tuple[i] * multiplier;
     multiplier *= shape[i];
   }
-
-  return data[index];
+  return dim_0_offsets[arg_tuple[0]] + index;
 }
 
 template <typename T>
 template <typename... Args>
-T MultiArray<T>::at(Args... args) const {
+T& MultiArray<T>::operator()(Args... args) {
   /**
    * Getter for an arbitrary number of dimensions.
    * The first parameter is the index of the first dimension.
    * The remaining parameters are the indices of the remaining dimensions.
    * The number of parameters must coincide with the number of dimensions
    * specified in shape. The value of each parameter must be smaller than the
-   * size of the corresponding dimension.
+   * size of the corresponding dimension. The element has to be stored.
    *
    * @param first Index of the first dimension
    * @param args Indices of the remaining dimensions
    */
 
-  // If the number of dimensions and number of arguments does not coincide throw
-  // an error
-  if (shape.size() != sizeof...(args)) {
-    throw std::invalid_argument(
-        "Number of dimensions and number of arguments do not coincide.");
-  }
-  // If the value of any argument is too large throw an error
-  std::vector<size_t> arg_tuple = {static_cast<size_t>(args)...};
-  for (size_t i = 0; i < sizeof...(args); ++i) {
-    if (arg_tuple[i] >= shape[i]) {
-      std::stringstream ss;
-      ss << "Index " << arg_tuple[i] << " is too large for dimension " << i;
-      throw std::out_of_range(ss.str());
-    }
+  const auto index = flat_index(args...);
+  if (!index.has_value()) {
+    throw std::out_of_range("Element is outside of the stored interval.");
   }
 
-  // Get the index of the element in the data respecting the row-major order
-  size_t index      = 0;
-  size_t multiplier = 1;
-  for (size_t i = 0; i < sizeof...(args); ++i) {
-    index += arg_tuple[i] * multiplier;
-    multiplier *= shape[i];
+  return data[index.value()];
+}
+
+template <typename T>
+template <typename... Args>
+T MultiArray<T>::at(Args... args) const {
+  /**
+   * Getter for an arbitrary number of dimensions.
+   * The first parameter is the index of the first dimension.
+   * The remaining parameters are the indices of the remaining dimensions.
+   * The number of parameters must coincide with the number of dimensions
+   * specified in shape. The value of each parameter must be smaller than the
+   * size of the corresponding dimension. Elements that are not stored are
+   * default constructed.
+   *
+   * @param first Index of the first dimension
+   * @param args Indices of the remaining dimensions
+   */
+
+  const auto index = flat_index(args...);
+  if (!index.has_value()) {
+    return T();
   }
 
-  return data[index];
+  return data[index.value()];
 }
 
 template <typename T>
@@ -130,4 +170,56 @@ MultiArray<T>::MultiArray(Args... args)
   }
   data = std::vector<T>(cap);
 }
+
+template <typename T>
+template <typename... Args>
+MultiArray<T> MultiArray<T>::with_intervals(
+    const std::vector<std::pair<size_t, size_t>>& dim_1_intervals,
+    size_t dim_1_size, Args... args) {
+  /**
+   * Constructor for at least two dimensions, where for every index i of the
+   * first dimension only the indices dim_1_intervals[i].first, ...,
+   * dim_1_intervals[i].second of the second dimension are stored. Accessing
+   * other elements using operator() throws, at() returns a default value.
+   * This saves memory if, e.g., trains are only present during short
+   * intervals of the time horizon.
+   *
+   * @param dim_1_intervals Stored interval of the second dimension for every
+   * index of the first dimension. The first dimension has size
+   * dim_1_intervals.size(). An interval with first > second is empty.
+   * @param dim_1_size Size of the second dimension
+   * @param args Sizes of the remaining dimensions
+   */
+
+  MultiArray<T> array;
+  array.shape = {dim_1_intervals.size(), dim_1_size,
+                 static_cast<size_t>(args)...};
+
+  size_t block_size = 1;
+  for (size_t i = 2; i < array.shape.size(); ++i) {
+    block_size *= array.shape[i];
+  }
+
+  array.dim_1_intervals.reserve(dim_1_intervals.size());
+  array.dim_0_offsets.reserve(dim_1_intervals.size());
+  size_t cap = 0;
+  for (const auto& [first, last] : dim_1_intervals) {
+    array.dim_0_offsets.push_back(cap);
+    if (first > last) {
+      // Empty interval, which no index lies in
+      array.dim_1_intervals.emplace_back(1, 0);
+      continue;
+    }
+    if (last >= dim_1_size) {
+      std::stringstream ss;
+      ss << "Interval end " << last << " is too large for dimension 1";
+      throw std::out_of_range(ss.str());
+    }
+    array.dim_1_intervals.emplace_back(first, last);
+    cap += (last - first + 1) * block_size;
+  }
+  array.data = std::vector<T>(cap);
+
+  return array;
+}
 } // namespace cda_rail
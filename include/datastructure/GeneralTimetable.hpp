@@ -4,6 +4,7 @@
 #include "RailwayNetwork.hpp"
 #include "Station.hpp"
 #include "Train.hpp"
+#include "TrainIntervalIndex.hpp"
 #include "nlohmann/json.hpp"
 
 #include <algorithm>
@@ -351,6 +352,33 @@ class GeneralTimetable : BaseTimetable {
     }
   }
 
+  void set_schedules(const json& data, const Network& network) {
+    /**
+     * Sets the schedules of all trains from the content of schedules.json.
+     * The train and station lists have to be set beforehand.
+     */
+
+    for (size_t i = 0; i < this->train_list.size(); i++) {
+      const auto& tr = this->train_list.get_train(i);
+      if (!data.contains(tr.name)) {
+        throw exceptions::ScheduleNotExistentException(tr.name);
+      }
+
+      const auto& schedule_data = data.at(tr.name);
+
+      this->schedules.at(i).set_v_0(static_cast<double>(schedule_data["v_0"]));
+      this->schedules.at(i).set_entry(
+          network.get_vertex_index(schedule_data["entry"]));
+      this->schedules.at(i).set_v_n(static_cast<double>(schedule_data["v_n"]));
+      this->schedules.at(i).set_exit(
+          network.get_vertex_index(schedule_data["exit"]));
+
+      parse_schedule_data<decltype(T::time_type())>(schedule_data, i);
+    }
+
+    this->sort_stops();
+  }
+
 protected:
   StationList    station_list;
   TrainList      train_list;
@@ -397,30 +425,24 @@ public:
     std::ifstream f(p / "schedules.json");
     json          data = json::parse(f);
 
-    for (size_t i = 0; i < this->train_list.size(); i++) {
-      const auto& tr = this->train_list.get_train(i);
-      if (!data.contains(tr.name)) {
-        throw exceptions::ScheduleNotExistentException(tr.name);
-      }
-
-      const auto& schedule_data = data[tr.name];
-
-      this->schedules.at(i).set_v_0(static_cast<double>(schedule_data["v_0"]));
-      this->schedules.at(i).set_entry(
-          network.get_vertex_index(schedule_data["entry"]));
-      this->schedules.at(i).set_v_n(static_cast<double>(schedule_data["v_n"]));
-      this->schedules.at(i).set_exit(
-          network.get_vertex_index(schedule_data["exit"]));
-
-      parse_schedule_data<decltype(T::time_type())>(schedule_data, i);
-    }
-
-    this->sort_stops();
+    this->set_schedules(data, network);
   };
   GeneralTimetable(const std::string& path, const Network& network)
       : GeneralTimetable(std::filesystem::path(path), network) {};
   GeneralTimetable(const char* path, const Network& network)
       : GeneralTimetable(std::filesystem::path(path), network) {};
+  GeneralTimetable(StationList station_list, TrainList train_list,
+                   const json& schedule_data, const Network& network)
+      : station_list(std::move(station_list)) {
+    /**
+     * Constructs the timetable from already imported stations and trains as
+     * well as the parsed content of schedules.json. This allows importing
+     * the respective files independently, e.g., concurrently.
+     */
+
+    this->set_train_list(train_list);
+    this->set_schedules(schedule_data, network);
+  };
   GeneralTimetable(StationList station_list, TrainList train_list,
                    const std::vector<T>& schedules)
       : station_list(std::move(station_list)),
@@ -679,6 +701,15 @@ public:
   [[nodiscard]] const T& get_schedule(const std::string& train_name) const {
     return get_schedule(train_list.get_train_index(train_name));
   };
+  [[nodiscard]] T& editable_schedule(size_t index) {
+    if (!train_list.has_train(index)) {
+      throw exceptions::TrainNotExistentException(index);
+    }
+    return schedules.at(index);
+  };
+  [[nodiscard]] T& editable_schedule(const std::string& train_name) {
+    return editable_schedule(train_list.get_train_index(train_name));
+  };
 
   virtual bool is_forced_to_stop(const std::string& train_name,
                                  int                time) const {
@@ -731,6 +762,20 @@ public:
         train_list.get_train_index(static_cast<std::string>(train_name)));
   };
 
+  [[nodiscard]] TrainIntervalIndex get_train_interval_index() const {
+    /**
+     * Builds an index over the time intervals of all trains, see
+     * time_interval, to query the trains present at given times.
+     */
+
+    std::vector<std::pair<int, int>> intervals;
+    intervals.reserve(train_list.size());
+    for (size_t tr = 0; tr < train_list.size(); tr++) {
+      intervals.emplace_back(time_interval(tr));
+    }
+    return TrainIntervalIndex(std::move(intervals));
+  };
+
   void sort_stops() {
     /**
      * This methods sorts all stops of all trains according to the operator < of
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <numeric>
 #include <optional>
 #include <sstream>
@@ -72,6 +73,12 @@ private:
   std::vector<Edge>                       edges;
   std::vector<std::vector<size_t>>        successors;
   std::unordered_map<std::string, size_t> vertex_name_to_index;
+  // edge_index_by_vertices[source][target] is the index of the respective
+  // edge, so that edges can be found without scanning all of them
+  std::vector<std::unordered_map<size_t, size_t>> edge_index_by_vertices;
+  // Incremented whenever an edge length changes, so that cached lengths, e.g.,
+  // of routes, can be validated in constant time
+  size_t edge_length_version = 0;
 
   std::unordered_map<std::size_t, std::pair<size_t, double>>
       new_edge_to_old_edge_after_transform;
@@ -99,6 +106,7 @@ private:
   void write_successor_set_to_file(std::ofstream& file, size_t i) const;
 
   void update_new_old_edge(size_t new_edge, size_t old_edge, double position);
+  void change_edge_source(size_t edge_index, size_t new_source);
 
   std::pair<std::vector<size_t>, std::vector<size_t>>
   separate_edge_private_helper(
@@ -156,6 +164,9 @@ public:
     return vertices;
   };
   [[nodiscard]] const std::vector<Edge>& get_edges() const { return edges; };
+  [[nodiscard]] size_t get_edge_length_version() const {
+    return edge_length_version;
+  };
 
   [[nodiscard]] double
                        maximal_vertex_speed(size_t                     v,
@@ -553,6 +564,17 @@ public:
   shortest_path_using_edges(size_t source_edge_id, size_t target_vertex_id,
                             bool only_use_valid_successors   = true,
                             std::vector<size_t> edges_to_use = {}) const;
+
+  [[nodiscard]] std::vector<double> shortest_path_distances(
+      const std::vector<size_t>&                 sources,
+      const std::unordered_set<size_t>&          usable_edges,
+      const std::function<double(const Edge&)>& edge_weight,
+      bool                                       forward = true) const;
+  [[nodiscard]] std::vector<double> shortest_path_distances(
+      const std::vector<size_t>&                 sources,
+      const std::function<bool(size_t)>&         is_usable,
+      const std::function<double(const Edge&)>& edge_weight,
+      bool                                       forward = true) const;
 };
 
 // HELPER
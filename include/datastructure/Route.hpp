@@ -11,8 +11,28 @@
 
 namespace cda_rail {
 class Route {
+  /**
+   * Sequence of edges a train uses. Next to the edges, the route keeps the
+   * distance from its start to the end of every edge and the index of every
+   * edge within the route. Both are updated by every method changing the
+   * route, so that const methods never modify the object and can safely be
+   * called in parallel. After changing edge lengths of the network, e.g., via
+   * Network::change_edge_length, update_edge_lengths has to be called. Methods
+   * relying on the cached lengths throw otherwise, which is detected in
+   * constant time by comparing the edge length version of the network.
+   */
 private:
   std::vector<size_t> edges;
+  // Distance from the route start to the end of every edge
+  std::vector<double> cumulative_lengths;
+  // Index of the first occurrence of every edge within the route
+  std::unordered_map<size_t, size_t> edge_route_index;
+  // Network::get_edge_length_version when cumulative_lengths was computed
+  size_t edge_length_version = 0;
+
+  void update_cumulative_lengths(const Network& network);
+  void update_edge_route_index();
+  void check_edge_length_version(const Network& network) const;
 
 public:
   void push_back_edge(size_t edge_index, const Network& network);
@@ -36,6 +56,10 @@ public:
   void remove_first_edge();
   void remove_last_edge();
 
+  void update_edge_lengths(const Network& network) {
+    update_cumulative_lengths(network);
+  };
+
   [[nodiscard]] double length(const Network& network) const;
   [[nodiscard]] std::pair<double, double>
   edge_pos(size_t edge, const Network& network) const;
@@ -64,7 +88,7 @@ public:
   [[nodiscard]] const std::vector<size_t>& get_edges() const { return edges; };
 
   [[nodiscard]] bool contains_edge(size_t edge_index) const {
-    return std::find(edges.begin(), edges.end(), edge_index) != edges.end();
+    return edge_route_index.find(edge_index) != edge_route_index.end();
   };
   [[nodiscard]] bool contains_edge(std::optional<size_t> edge_index) const {
     return edge_index.has_value() && contains_edge(edge_index.value());
@@ -73,12 +97,21 @@ public:
   [[nodiscard]] bool check_consistency(const Network& network) const;
 
   void update_after_discretization(
-      const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges);
+      const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges,
+      const Network&                                             network);
 };
 
 class RouteMap {
+  /**
+   * Routes of trains identified by the train name. Every route additionally
+   * has a dense index, so that frequently accessed routes can be looked up
+   * without hashing the name every time.
+   */
 private:
-  std::unordered_map<std::string, Route> routes;
+  std::vector<std::pair<std::string, Route>> routes;
+  std::unordered_map<std::string, size_t>    route_name_to_index;
+
+  [[nodiscard]] Route& editable_route(const std::string& train_name);
 
 public:
   // Constructors
@@ -106,6 +139,8 @@ public:
 
   void push_back_edge(const std::string& train_name, size_t edge_index,
                       const Network& network);
+  void push_back_edge(size_t route_index, size_t edge_index,
+                      const Network& network);
   void push_back_edge(const std::string& train_name, size_t source,
                       size_t target, const Network& network);
   void push_back_edge(const std::string& train_name, const std::string& source,
@@ -123,12 +158,17 @@ public:
 
   void remove_route(const std::string& train_name);
 
+  void update_edge_lengths(const Network& network);
+
   [[nodiscard]] bool has_route(const std::string& train_name) const {
-    return routes.find(train_name) != routes.end();
+    return route_name_to_index.find(train_name) != route_name_to_index.end();
   };
   [[nodiscard]] size_t       size() const { return routes.size(); };
   [[nodiscard]] bool         empty() const { return routes.empty(); };
+  [[nodiscard]] const Route& get_route(size_t route_index) const;
   [[nodiscard]] const Route& get_route(const std::string& train_name) const;
+  [[nodiscard]] size_t
+  get_route_index(const std::string& train_name) const;
 
   [[nodiscard]] double length(const std::string& train_name,
                               const Network&     network) const;
@@ -180,6 +220,7 @@ public:
   };
 
   void update_after_discretization(
-      const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges);
+      const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges,
+      const Network&                                             network);
 };
 } // namespace cda_rail
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cda_rail {
@@ -20,10 +21,15 @@ struct Station {
 
 class StationList {
   /**
-   * StationList class
+   * StationList class. Every station additionally has a dense index in the
+   * order in which stations are added, so that stations can be accessed
+   * without hashing their name.
    */
 private:
-  std::unordered_map<std::string, Station> stations;
+  std::vector<std::pair<std::string, Station>> stations;
+  std::unordered_map<std::string, size_t>      station_name_to_index;
+
+  [[nodiscard]] Station& editable_station(const std::string& name);
 
 public:
   // Constructors
@@ -49,12 +55,19 @@ public:
   [[nodiscard]] auto begin() const { return stations.begin(); };
   [[nodiscard]] auto end() const { return stations.end(); };
 
-  void add_station(const std::string& name) { stations[name] = Station{name}; };
+  size_t add_station(const std::string& name);
 
   [[nodiscard]] bool has_station(const std::string& name) const {
-    return stations.find(name) != stations.end();
+    return station_name_to_index.find(name) != station_name_to_index.end();
+  };
+  [[nodiscard]] bool has_station(size_t index) const {
+    return index < stations.size();
+  };
+  [[nodiscard]] size_t         get_station_index(const std::string& name) const;
+  [[nodiscard]] const Station& get_station(size_t index) const;
+  [[nodiscard]] const Station& get_station(const std::string& name) const {
+    return get_station(get_station_index(name));
   };
-  [[nodiscard]] const Station& get_station(const std::string& name) const;
 
   [[nodiscard]] size_t size() const { return stations.size(); };
   [[nodiscard]] std::vector<std::string> get_station_names() const;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace cda_rail {
+class TrainIntervalIndex {
+  /**
+   * Index over the time intervals [t_0, t_n) in which trains are present in
+   * the network, e.g., as given by time_interval of a timetable. It is built
+   * once as a centered interval tree of logarithmic depth. Hence, all trains
+   * present at a time t or overlapping a time window are found in
+   * O(log n + k) (plus sorting the k results by index) instead of checking
+   * every train. Trains with empty intervals are never present.
+   */
+private:
+  struct Node {
+    int center = 0;
+    // Trains whose interval contains center, sorted by increasing start and
+    // by decreasing end respectively
+    std::vector<size_t>   by_start;
+    std::vector<size_t>   by_end;
+    std::optional<size_t> left;
+    std::optional<size_t> right;
+  };
+
+  std::vector<std::pair<int, int>> intervals;
+  std::vector<Node>                nodes;
+  // Non-empty intervals sorted by increasing start
+  std::vector<size_t> trains_by_start;
+
+  std::optional<size_t> build_node(std::vector<size_t> trains);
+  void collect_trains_at_t(int t, std::vector<size_t>& trains) const;
+  void check_train(size_t tr) const;
+
+public:
+  TrainIntervalIndex() = default;
+  explicit TrainIntervalIndex(std::vector<std::pair<int, int>> intervals);
+
+  [[nodiscard]] size_t number_of_trains() const { return intervals.size(); };
+  [[nodiscard]] bool   empty() const { return intervals.empty(); };
+
+  [[nodiscard]] const std::pair<int, int>& get_interval(size_t tr) const;
+  [[nodiscard]] bool                       is_present(size_t tr, int t) const;
+
+  [[nodiscard]] std::vector<size_t> trains_at_t(int t) const;
+  [[nodiscard]] std::vector<size_t>
+  trains_at_t(int t, const std::vector<size_t>& trains_to_consider) const;
+  [[nodiscard]] std::vector<size_t> trains_in_time_window(int t_0,
+                                                          int t_n) const;
+  [[nodiscard]] std::vector<std::vector<size_t>>
+  trains_at_time_steps(int dt, size_t num_t) const;
+};
+} // namespace cda_rail
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace cda_rail {
+class TrainTrajectory {
+  /**
+   * Trajectory of a single train stored column-wise, i.e., as parallel arrays
+   * of times, positions and speeds sorted by strictly increasing time. A time
+   * at which only the position or only the speed is known has NaN in the
+   * other column. Lookups use binary search on the time column. Since trains
+   * do not move backwards, positions are usually non-decreasing, in which case
+   * the time at a given position is found by binary search as well.
+   * Trajectories are meant to be created at once using a
+   * TrainTrajectoryBuilder. Single values can still be set, which is cheap if
+   * they are appended at the end.
+   */
+private:
+  std::vector<double> times;
+  std::vector<double> positions;
+  std::vector<double> speeds;
+  size_t              num_positions            = 0;
+  size_t              num_speeds               = 0;
+  bool                positions_non_decreasing = true;
+
+  size_t get_or_insert_index(double t);
+  void   update_monotonicity(size_t idx);
+  void   check_index(size_t idx) const;
+
+  friend class TrainTrajectoryBuilder;
+
+public:
+  TrainTrajectory() = default;
+
+  [[nodiscard]] size_t size() const { return times.size(); };
+  [[nodiscard]] bool   empty() const { return times.empty(); };
+  [[nodiscard]] size_t number_of_positions() const { return num_positions; };
+  [[nodiscard]] size_t number_of_speeds() const { return num_speeds; };
+  [[nodiscard]] bool   is_complete() const {
+    return num_positions == size() && num_speeds == size();
+  };
+  [[nodiscard]] bool has_non_decreasing_positions() const {
+    return num_positions == size() && positions_non_decreasing;
+  };
+
+  [[nodiscard]] const std::vector<double>& get_times() const { return times; };
+  [[nodiscard]] const std::vector<double>& get_positions() const {
+    return positions;
+  };
+  [[nodiscard]] const std::vector<double>& get_speeds() const {
+    return speeds;
+  };
+  [[nodiscard]] double get_time(size_t idx) const;
+  [[nodiscard]] bool   has_pos(size_t idx) const;
+  [[nodiscard]] bool   has_speed(size_t idx) const;
+  [[nodiscard]] double get_pos(size_t idx) const;
+  [[nodiscard]] double get_speed(size_t idx) const;
+
+  [[nodiscard]] std::optional<size_t> find_time(double t) const;
+  [[nodiscard]] std::optional<size_t> find_pos(double pos) const;
+  [[nodiscard]] std::optional<std::pair<size_t, size_t>>
+  get_bracket(double t) const;
+  [[nodiscard]] std::vector<double> get_times_with_speed() const;
+
+  void set_pos(double t, double pos);
+  void set_speed(double t, double speed);
+  void reserve(size_t n);
+};
+
+class TrainTrajectoryBuilder {
+  /**
+   * Collects points of a trajectory in arbitrary order and creates the sorted
+   * TrainTrajectory in one go. If the same time is added more than once, the
+   * point added last is used.
+   */
+private:
+  std::vector<double> times;
+  std::vector<double> positions;
+  std::vector<double> speeds;
+
+public:
+  TrainTrajectoryBuilder() = default;
+
+  void add(double t, double pos, double speed);
+  void reserve(size_t n);
+  [[nodiscard]] size_t          size() const { return times.size(); };
+  [[nodiscard]] TrainTrajectory build() const;
+};
+} // namespace cda_rail
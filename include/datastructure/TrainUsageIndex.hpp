@@ -0,0 +1,63 @@
+#pragma once
+#include "datastructure/RailwayNetwork.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace cda_rail {
+class TrainUsageIndex {
+  /**
+   * Relation between trains and the edges, vertices and sections they might
+   * use. It is built once from the edges potentially used by every train.
+   * Membership queries are answered by train x edge and train x section
+   * bitmaps in constant time, while the inverted lists (edge -> trains,
+   * section -> trains) return all trains in time linear in the result size.
+   * All lists are sorted in the order the corresponding queries of
+   * GeneralProblemInstanceWithScheduleAndRoutes return them.
+   */
+private:
+  std::vector<std::vector<bool>> train_edge_bitmap;
+  std::vector<std::vector<bool>> train_section_bitmap;
+
+  std::vector<std::vector<size_t>> edges_of_train;
+  std::vector<std::vector<size_t>> vertices_of_train;
+  std::vector<std::vector<size_t>> sections_of_train;
+  std::vector<std::vector<size_t>> trains_of_edge;
+  std::vector<std::vector<size_t>> trains_of_section;
+
+  void check_train(size_t tr) const;
+  void check_edge(size_t e) const;
+  void check_section(size_t section) const;
+
+public:
+  TrainUsageIndex() = default;
+  TrainUsageIndex(const Network&                          network,
+                  std::vector<std::vector<size_t>>        edges_used_by_trains,
+                  const std::vector<std::vector<size_t>>& sections);
+
+  [[nodiscard]] size_t number_of_trains() const {
+    return edges_of_train.size();
+  };
+  [[nodiscard]] size_t number_of_edges() const {
+    return trains_of_edge.size();
+  };
+  [[nodiscard]] size_t number_of_sections() const {
+    return trains_of_section.size();
+  };
+  [[nodiscard]] bool empty() const { return edges_of_train.empty(); };
+
+  [[nodiscard]] bool uses_edge(size_t tr, size_t e) const;
+  [[nodiscard]] bool uses_section(size_t tr, size_t section) const;
+
+  [[nodiscard]] const std::vector<size_t>& edges_used_by_train(size_t tr) const;
+  [[nodiscard]] const std::vector<size_t>&
+  vertices_used_by_train(size_t tr) const;
+  [[nodiscard]] const std::vector<size_t>&
+  sections_used_by_train(size_t tr) const;
+  [[nodiscard]] const std::vector<size_t>& trains_on_edge(size_t e) const;
+  [[nodiscard]] const std::vector<size_t>&
+  trains_in_section(size_t section) const;
+  [[nodiscard]] std::vector<size_t>
+  trains_on_edges(const std::vector<size_t>& edges) const;
+};
+} // namespace cda_rail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ColumnFile.hpp"
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
 #include "GeneralProblemInstance.hpp"
@@ -7,12 +8,16 @@
 #include "datastructure/GeneralTimetable.hpp"
 #include "datastructure/RailwayNetwork.hpp"
 #include "datastructure/Route.hpp"
+#include "datastructure/TrainTrajectory.hpp"
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -23,6 +28,26 @@ using json = nlohmann::json;
 
 namespace cda_rail::instances {
 
+enum class TimetableConflictType : std::uint8_t {
+  RunningTime     = 0,
+  StationCapacity = 1,
+  OppositeTracks  = 2,
+  EntryHeadway    = 3,
+  ExitHeadway     = 4
+};
+
+struct TimetableConflict {
+  /**
+   * Trains that cannot all meet their schedules in any solution.
+   * @param type Type of the conflict
+   * @param trains Indices of the trains involved, sorted
+   * @param explanation Human-readable reason of the conflict
+   */
+  TimetableConflictType type;
+  std::vector<size_t>   trains;
+  std::string           explanation;
+};
+
 class GeneralPerformanceOptimizationInstance
     : public GeneralProblemInstanceWithScheduleAndRoutes<
           GeneralTimetable<GeneralSchedule<GeneralScheduledStop>>> {
@@ -42,6 +67,46 @@ class GeneralPerformanceOptimizationInstance
   double lambda = 1; // Minutes of delay (of a weight one train) that are
                      // "equal" to scheduling another weight one train
 
+  void import_problem_data(const json& j) {
+    for (const auto& [train_name, weight] : j["train_weights"].items()) {
+      set_train_weight(train_name, static_cast<double>(weight));
+    }
+    for (const auto& [train_name, optional] : j["train_optional"].items()) {
+      set_train_optionality_value(train_name, static_cast<bool>(optional));
+    }
+    lambda = static_cast<double>(j["lambda"]);
+  };
+
+  struct ForcedStop {
+    size_t              train;
+    std::string         station;
+    std::pair<int, int> interval;
+    // Edges used by every possible stop path, i.e., occupied in any case
+    std::vector<size_t> edges;
+  };
+
+  void check_running_times(size_t tr, bool fixed_routes,
+                           std::vector<TimetableConflict>& conflicts,
+                           std::vector<ForcedStop>&        forced_stops) const;
+  void
+  check_station_capacities(const std::vector<ForcedStop>&  forced_stops,
+                           std::vector<TimetableConflict>& conflicts) const;
+  void check_opposite_tracks(const std::vector<ForcedStop>&  forced_stops,
+                             std::vector<TimetableConflict>& conflicts) const;
+  void check_headways(std::vector<TimetableConflict>& conflicts) const;
+
+  GeneralPerformanceOptimizationInstance(
+      std::shared_ptr<Network>                                network,
+      GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable,
+      RouteMap                                                routes,
+      const json&                                             problem_data)
+      : GeneralProblemInstanceWithScheduleAndRoutes<
+            GeneralTimetable<GeneralSchedule<GeneralScheduledStop>>>(
+            std::move(network), std::move(timetable), std::move(routes)) {
+    initialize_vectors();
+    import_problem_data(problem_data);
+  };
+
 public:
   GeneralPerformanceOptimizationInstance() = default;
   explicit GeneralPerformanceOptimizationInstance(const Network& network)
@@ -65,16 +130,16 @@ public:
     initialize_vectors();
 
     std::ifstream file(path / "problem_data.json");
-    json          j = json::parse(file);
-    for (const auto& [train_name, weight] : j["train_weights"].items()) {
-      set_train_weight(train_name, static_cast<double>(weight));
-    }
-    for (const auto& [train_name, optional] : j["train_optional"].items()) {
-      set_train_optionality_value(train_name, static_cast<bool>(optional));
-    }
-    lambda = static_cast<double>(j["lambda"]);
+    import_problem_data(json::parse(file));
   };
 
+  // Imports the same instance as the constructor from a path but reads
+  // independent files concurrently. If import_times is given, the wall time
+  // in milliseconds of every part of the import is stored within.
+  [[nodiscard]] static GeneralPerformanceOptimizationInstance
+  import_instance_async(const std::filesystem::path& path,
+                        std::map<std::string, double>* import_times = nullptr);
+
   static GeneralPerformanceOptimizationInstance
   cast_from_vss_generation(const VSSGenerationTimetable& vss_gen);
   [[nodiscard]] VSSGenerationTimetable
@@ -242,6 +307,15 @@ public:
   [[nodiscard]] double get_approximate_leaving_time(size_t train) const;
   [[nodiscard]] double get_maximal_leaving_time(size_t train, double v) const;
   [[nodiscard]] double get_minimal_leaving_time(size_t train, double v) const;
+
+  [[nodiscard]] bool are_trains_interchangeable(size_t tr1, size_t tr2) const;
+  [[nodiscard]] std::vector<std::vector<size_t>>
+  get_interchangeable_train_classes() const;
+  [[nodiscard]] std::vector<TimetableConflict>
+  check_timetable_conflicts(bool fixed_routes) const;
+  [[nodiscard]] std::optional<std::vector<size_t>>
+  optional_trains_resolving_conflicts(
+      const std::vector<TimetableConflict>& conflicts) const;
   [[nodiscard]] double
   get_approximate_leaving_time(const std::string& tr_name) const {
     return get_approximate_leaving_time(
@@ -265,18 +339,58 @@ class SolGeneralPerformanceOptimizationInstance
   static_assert(
       std::is_base_of<GeneralPerformanceOptimizationInstance, T>::value,
       "T must be derived from GeneralPerformanceOptimizationInstance");
-  std::vector<std::map<double, double>> train_pos;
-  std::vector<std::map<double, double>> train_speed;
-  std::vector<bool>                     train_routed;
+  std::vector<TrainTrajectory> train_trajectories;
+  std::vector<bool>            train_routed;
 
   void initialize_vectors() {
-    train_pos.reserve(this->instance.get_timetable().get_train_list().size());
-    train_speed.reserve(this->instance.get_timetable().get_train_list().size());
+    train_trajectories = std::vector<TrainTrajectory>(
+        this->instance.get_timetable().get_train_list().size());
     train_routed = std::vector<bool>(
         this->instance.get_timetable().get_train_list().size(), false);
-    for (size_t tr = 0; tr < this->instance.get_train_list().size(); ++tr) {
-      train_pos.emplace_back();
-      train_speed.emplace_back();
+  };
+
+  void export_trajectories_binary(const std::filesystem::path& p) const {
+    /**
+     * Writes the trajectories and routed flags of all trains to p / solution /
+     * trajectories.bin. For every train, its name, whether it is routed, and
+     * the time, position and speed columns are written.
+     */
+
+    ColumnFileWriter writer(p / "solution" / "trajectories.bin");
+    writer.write_size(this->instance.get_train_list().size());
+    for (size_t tr_id = 0; tr_id < this->instance.get_train_list().size();
+         ++tr_id) {
+      const auto& train      = this->instance.get_train_list().get_train(tr_id);
+      const auto& trajectory = train_trajectories.at(tr_id);
+      writer.write_string(train.name);
+      writer.write_bool(train_routed.at(tr_id));
+      writer.write_column(trajectory.get_times());
+      writer.write_column(trajectory.get_positions());
+      writer.write_column(trajectory.get_speeds());
+    }
+    writer.close();
+  };
+
+  void import_trajectories_binary(const std::filesystem::path& p) {
+    ColumnFileReader reader(p / "solution" / "trajectories.bin");
+    const auto       num_trains = reader.read_size();
+    for (size_t i = 0; i < num_trains; ++i) {
+      const auto tr_name   = reader.read_string();
+      const auto routed    = reader.read_bool();
+      const auto times     = reader.read_column();
+      const auto positions = reader.read_column();
+      const auto speeds    = reader.read_column();
+      if (positions.size() != times.size() || speeds.size() != times.size()) {
+        throw exceptions::ImportException("Columns of trajectory of train " +
+                                          tr_name + " have different lengths");
+      }
+      TrainTrajectoryBuilder builder;
+      builder.reserve(times.size());
+      for (size_t j = 0; j < times.size(); ++j) {
+        builder.add(times[j], positions[j], speeds[j]);
+      }
+      set_train_trajectory(tr_name, builder.build());
+      set_train_routed_value(tr_name, routed);
     }
   };
 
@@ -311,8 +425,8 @@ public:
     }
 
     if (import_routes) {
-      this->instance.editable_routes() =
-          RouteMap(p / "instance" / "routes", this->instance.const_n());
+      this->instance.set_routes(
+          RouteMap(p / "instance" / "routes", this->instance.const_n()));
     }
 
     std::ifstream data_file(p / "solution" / "data.json");
@@ -323,6 +437,11 @@ public:
 
     this->initialize_vectors();
 
+    if (this->get_solution_format() == SolutionFormat::Binary) {
+      import_trajectories_binary(p);
+      return;
+    }
+
     // Read train_pos
     std::ifstream train_pos_file(p / "solution" / "train_pos.json");
     json          train_pos_json = json::parse(train_pos_file);
@@ -354,70 +473,60 @@ public:
     }
   };
 
+  [[nodiscard]] double get_train_pos(size_t tr, double t) const {
+    const auto& trajectory = get_train_trajectory(tr);
+    const auto  idx        = trajectory.find_time(t);
+    if (idx.has_value() && trajectory.has_pos(idx.value())) {
+      return trajectory.get_pos(idx.value());
+    }
+    throw exceptions::ConsistencyException(
+        "No position for train " +
+        this->instance.get_train_list().get_train(tr).name + " at time " +
+        std::to_string(t));
+  };
   [[nodiscard]] double get_train_pos(const std::string& tr_name,
                                      double             t) const {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
-    }
-    const auto tr_id = this->instance.get_train_list().get_train_index(tr_name);
-    if (train_pos.at(tr_id).count(t) > 0) {
-      return train_pos.at(tr_id).at(t);
-    }
-    throw exceptions::ConsistencyException("No position for train " + tr_name +
-                                           " at time " + std::to_string(t));
+    return get_train_pos(
+        this->instance.get_train_list().get_train_index(tr_name), t);
   };
   [[nodiscard]] std::tuple<size_t, double, double>
-  get_edge_and_time_bounds(const std::string& tr_name, double t) const {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
-    }
-    const auto tr_id = this->instance.get_train_list().get_train_index(tr_name);
-    const auto& tr_pos = train_pos.at(tr_id);
-
-    double t0 = -1;
-    double t1 = -1;
-    for (const auto& [time, pos] : tr_pos) {
-      if (std::abs(time - t) < GRB_EPS) {
-        t0 = time;
-        t1 = time;
-        break;
-      }
-      if (time < t) {
-        t0 = time;
-      } else if (t0 >= 0) {
-        t1 = time;
-        break;
-      } else {
-        throw exceptions::ConsistencyException(
-            "Train " + tr_name + " not present at time " + std::to_string(t));
-      }
-    }
-    if (t1 < 0) {
+  get_edge_and_time_bounds(size_t tr, double t) const {
+    const auto& trajectory = get_train_trajectory(tr);
+    const auto  bracket    = trajectory.get_bracket(t);
+    if (!bracket.has_value()) {
       throw exceptions::ConsistencyException(
-          "Train " + tr_name + " not present at time " + std::to_string(t));
+          "Train " + this->instance.get_train_list().get_train(tr).name +
+          " not present at time " + std::to_string(t));
     }
+    const auto t0 = trajectory.get_time(bracket->first);
+    const auto t1 = trajectory.get_time(bracket->second);
 
     assert(t >= t0 - GRB_EPS);
     assert(t <= t1 + GRB_EPS);
-    const auto pos0 = get_train_pos(tr_name, t0);
+    const auto pos0 = get_train_pos(tr, t0);
 
-    const Route& route = this->get_instance().const_routes().get_route(tr_name);
-    const Network& n   = this->get_instance().const_n();
+    const Route&   route = this->get_instance().get_route(tr);
+    const Network& n     = this->get_instance().const_n();
     const auto     r_len = route.length(n);
     return {route.get_edge_at_pos(std::min(pos0 + GRB_EPS, r_len), n), t0, t1};
   };
+  [[nodiscard]] std::tuple<size_t, double, double>
+  get_edge_and_time_bounds(const std::string& tr_name, double t) const {
+    return get_edge_and_time_bounds(
+        this->instance.get_train_list().get_train_index(tr_name), t);
+  };
   [[nodiscard]] std::tuple<double, double, double, double>
-  get_exact_pos_and_vel_bounds(const std::string& tr_name, double t) const {
-    const auto [edge, t1, t2] = get_edge_and_time_bounds(tr_name, t);
+  get_exact_pos_and_vel_bounds(size_t tr, double t) const {
+    const auto [edge, t1, t2] = get_edge_and_time_bounds(tr, t);
     assert(t >= t1 - GRB_EPS);
     assert(t <= t2 + GRB_EPS);
 
-    const auto v1   = get_train_speed(tr_name, t1);
-    const auto v2   = get_train_speed(tr_name, t2);
-    const auto pos1 = get_train_pos(tr_name, t1);
-    const auto pos2 = get_train_pos(tr_name, t2);
+    const auto v1   = get_train_speed(tr, t1);
+    const auto v2   = get_train_speed(tr, t2);
+    const auto pos1 = get_train_pos(tr, t1);
+    const auto pos2 = get_train_pos(tr, t2);
 
-    const Route& tr_route         = this->instance.get_route(tr_name);
+    const Route& tr_route         = this->instance.get_route(tr);
     const auto&  r_len            = tr_route.length(this->instance.const_n());
     const bool   tr_leaving_route = pos2 >= r_len + GRB_EPS;
 
@@ -427,8 +536,7 @@ public:
     }
 
     const auto& edge_obj = this->instance.const_n().get_edge(edge);
-    const auto& tr_obj   = this->instance.get_train_list().get_train(tr_name);
-
+    const auto& tr_obj   = this->instance.get_train_list().get_train(tr);
     const auto max_speed = tr_leaving_route
                                ? tr_obj.max_speed
                                : std::min(edge_obj.max_speed, tr_obj.max_speed);
@@ -470,25 +578,29 @@ public:
     }
     return {lb, ub, v_lb, v_ub};
   };
+  [[nodiscard]] std::tuple<double, double, double, double>
+  get_exact_pos_and_vel_bounds(const std::string& tr_name, double t) const {
+    return get_exact_pos_and_vel_bounds(
+        this->instance.get_train_list().get_train_index(tr_name), t);
+  };
   [[nodiscard]] std::optional<std::pair<double, double>>
-  get_approximate_train_pos_and_vel(const std::string& tr_name,
-                                    double             t) const {
-    const auto [edge, t1, t2] = get_edge_and_time_bounds(tr_name, t);
+  get_approximate_train_pos_and_vel(size_t tr, double t) const {
+    const auto [edge, t1, t2] = get_edge_and_time_bounds(tr, t);
     assert(t >= t1 - GRB_EPS);
     assert(t <= t2 + GRB_EPS);
 
-    const auto pos_1 = get_train_pos(tr_name, t1);
-    const auto v1    = get_train_speed(tr_name, t1);
+    const auto pos_1 = get_train_pos(tr, t1);
+    const auto v1    = get_train_speed(tr, t1);
 
     if (t1 == t2) {
       return std::make_pair(pos_1, v1);
     }
 
-    const auto pos_2 = get_train_pos(tr_name, t2);
-    const auto v2    = get_train_speed(tr_name, t2);
+    const auto pos_2 = get_train_pos(tr, t2);
+    const auto v2    = get_train_speed(tr, t2);
 
     const auto& edge_obj  = this->instance.const_n().get_edge(edge);
-    const auto& tr_obj    = this->instance.get_train_list().get_train(tr_name);
+    const auto& tr_obj    = this->instance.get_train_list().get_train(tr);
     const auto  max_speed = std::min(tr_obj.max_speed, edge_obj.max_speed);
     const auto  dist_travelled = pos_2 - pos_1;
 
@@ -505,7 +617,7 @@ public:
     }
 
     const auto tr_pos =
-        get_train_pos(tr_name, t1) +
+        get_train_pos(tr, t1) +
         pos_on_edge_at_time(v1, v2, v_line, tr_obj.acceleration,
                             tr_obj.deceleration, dist_travelled, t - t1);
     const auto tr_vel =
@@ -514,57 +626,76 @@ public:
 
     return std::make_pair(tr_pos, tr_vel);
   };
+  [[nodiscard]] std::optional<std::pair<double, double>>
+  get_approximate_train_pos_and_vel(const std::string& tr_name,
+                                    double             t) const {
+    return get_approximate_train_pos_and_vel(
+        this->instance.get_train_list().get_train_index(tr_name), t);
+  };
+  [[nodiscard]] double get_train_speed(size_t tr, double t) const {
+    const auto& trajectory = get_train_trajectory(tr);
+    const auto  idx        = trajectory.find_time(t);
+    if (idx.has_value() && trajectory.has_speed(idx.value())) {
+      return trajectory.get_speed(idx.value());
+    }
+    throw exceptions::ConsistencyException(
+        "No speed for train " +
+        this->instance.get_train_list().get_train(tr).name + " at time " +
+        std::to_string(t));
+  };
   [[nodiscard]] double get_train_speed(const std::string& tr_name,
                                        double             t) const {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
-    }
-    const auto tr_id = this->instance.get_train_list().get_train_index(tr_name);
-    if (train_speed.at(tr_id).count(t) > 0) {
-      return train_speed.at(tr_id).at(t);
+    return get_train_speed(
+        this->instance.get_train_list().get_train_index(tr_name), t);
+  };
+  [[nodiscard]] bool get_train_routed(size_t tr) const {
+    if (!this->instance.get_train_list().has_train(tr)) {
+      throw exceptions::TrainNotExistentException(tr);
     }
-    throw exceptions::ConsistencyException("No speed for train " + tr_name +
-                                           " at time " + std::to_string(t));
+    return train_routed.at(tr);
   };
   [[nodiscard]] bool get_train_routed(const std::string& tr_name) const {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
-    }
-    return train_routed.at(
+    return get_train_routed(
         this->instance.get_train_list().get_train_index(tr_name));
   };
+  [[nodiscard]] std::vector<double> get_train_times(size_t tr) const {
+    // Already sorted, no copy of positions or speeds needed
+    return get_train_trajectory(tr).get_times_with_speed();
+  };
   [[nodiscard]] std::vector<double>
   get_train_times(const std::string& tr_name) const {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
-    }
-    const auto tr_id = this->instance.get_train_list().get_train_index(tr_name);
-    const auto& tr_speed_map = train_speed.at(tr_id);
-    // Return keys of the map
-    std::vector<double> times;
-    for (const auto& [t, _] : tr_speed_map) {
-      times.push_back(t);
+    return get_train_times(
+        this->instance.get_train_list().get_train_index(tr_name));
+  };
+  [[nodiscard]] const TrainTrajectory& get_train_trajectory(size_t tr) const {
+    if (!this->instance.get_train_list().has_train(tr)) {
+      throw exceptions::TrainNotExistentException(tr);
     }
-    // Sort
-    std::sort(times.begin(), times.end());
-    return times;
+    return train_trajectories.at(tr);
+  };
+  [[nodiscard]] const TrainTrajectory&
+  get_train_trajectory(const std::string& tr_name) const {
+    return get_train_trajectory(
+        this->instance.get_train_list().get_train_index(tr_name));
   };
   [[nodiscard]] std::vector<size_t> get_train_order(size_t edge_index) const {
     std::vector<size_t> tr_on_edge =
         this->get_instance().trains_on_edge(edge_index, true);
-    std::map<size_t, double> tr_times;
+    // Time at which every train enters the edge, same order as tr_on_edge
+    std::vector<std::pair<double, size_t>> tr_times;
+    tr_times.reserve(tr_on_edge.size());
     for (const auto& tr : tr_on_edge) {
-      const Train& tr_object =
-          this->get_instance().get_train_list().get_train(tr);
       const double e_pos =
-          this->get_instance().route_edge_pos(tr_object.name, edge_index).first;
-      const auto time_at_e_pos = get_time_at_pos(tr_object.name, e_pos);
-      tr_times.insert({tr, time_at_e_pos});
-    }
-    std::sort(tr_on_edge.begin(), tr_on_edge.end(),
-              [&tr_times](size_t tr1, size_t tr2) {
-                return tr_times.at(tr1) < tr_times.at(tr2);
-              });
+          this->get_instance().route_edge_pos(tr, edge_index).first;
+      tr_times.emplace_back(get_time_at_pos(tr, e_pos), tr);
+    }
+    std::stable_sort(tr_times.begin(), tr_times.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                       return lhs.first < rhs.first;
+                     });
+    for (size_t i = 0; i < tr_times.size(); ++i) {
+      tr_on_edge[i] = tr_times[i].second;
+    }
     return tr_on_edge;
   };
   [[nodiscard]] std::vector<std::pair<size_t, bool>>
@@ -585,11 +716,8 @@ public:
       const auto& rel_e       = direction ? edge_index : rev_e.value();
       const auto& rel_tr_on_e = direction ? tr_on_edge : tr_on_rev_edge;
       for (const auto& tr : rel_tr_on_e) {
-        const Train& tr_object =
-            this->get_instance().get_train_list().get_train(tr);
-        const double e_pos =
-            this->get_instance().route_edge_pos(tr_object.name, rel_e).first;
-        const auto time_at_e_pos = get_time_at_pos(tr_object.name, e_pos);
+        const double e_pos = this->get_instance().route_edge_pos(tr, rel_e).first;
+        const auto time_at_e_pos = get_time_at_pos(tr, e_pos);
         tr_times.insert({tr, time_at_e_pos});
         ret_vec.emplace_back(tr, direction);
       }
@@ -603,19 +731,27 @@ public:
 
     return ret_vec;
   }
-  [[nodiscard]] double get_time_at_pos(const std::string& tr_name,
-                                       double             pos) const {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
-    }
-    const auto tr_times = get_train_times(tr_name);
-    for (const auto& t : tr_times) {
-      if (std::abs(get_train_pos(tr_name, t) - pos) < GRB_EPS) {
-        return t;
-      }
+  [[nodiscard]] double get_time_at_pos(size_t tr, double pos) const {
+    /**
+     * Returns the first time at which the train is at the given position. The
+     * lookup is logarithmic in the number of trajectory points since
+     * positions along a route are non-decreasing.
+     */
+
+    const auto& trajectory = get_train_trajectory(tr);
+    const auto  idx        = trajectory.find_pos(pos);
+    if (idx.has_value()) {
+      return trajectory.get_time(idx.value());
     }
     throw exceptions::ConsistencyException(
-        "No time for train " + tr_name + " at position " + std::to_string(pos));
+        "No time for train " +
+        this->instance.get_train_list().get_train(tr).name + " at position " +
+        std::to_string(pos));
+  };
+  [[nodiscard]] double get_time_at_pos(const std::string& tr_name,
+                                       double             pos) const {
+    return get_time_at_pos(
+        this->instance.get_train_list().get_train_index(tr_name), pos);
   };
 
   void add_train_pos(const std::string& tr_name, double t, double pos) {
@@ -629,12 +765,9 @@ public:
       throw exceptions::ConsistencyException("Time must be non-negative");
     }
 
-    const auto tr_id = this->instance.get_train_list().get_train_index(tr_name);
-    if (train_pos.at(tr_id).count(t) > 0) {
-      train_pos.at(tr_id).at(t) = pos;
-    } else {
-      train_pos.at(tr_id).insert({t, pos});
-    }
+    train_trajectories
+        .at(this->instance.get_train_list().get_train_index(tr_name))
+        .set_pos(t, pos);
   };
   void add_train_speed(const std::string& tr_name, double t, double speed) {
     if (!this->instance.get_train_list().has_train(tr_name)) {
@@ -647,12 +780,30 @@ public:
       throw exceptions::ConsistencyException("Time must be non-negative");
     }
 
-    const auto tr_id = this->instance.get_train_list().get_train_index(tr_name);
-    if (train_speed.at(tr_id).count(t) > 0) {
-      train_speed.at(tr_id).at(t) = speed;
-    } else {
-      train_speed.at(tr_id).insert({t, speed});
+    train_trajectories
+        .at(this->instance.get_train_list().get_train_index(tr_name))
+        .set_speed(t, speed);
+  };
+  void set_train_trajectory(size_t tr, TrainTrajectory trajectory) {
+    /**
+     * Replaces all positions and speeds of a train, e.g., by a trajectory
+     * created using a TrainTrajectoryBuilder.
+     */
+
+    if (!this->instance.get_train_list().has_train(tr)) {
+      throw exceptions::TrainNotExistentException(tr);
+    }
+    const auto& times = trajectory.get_times();
+    if (!times.empty() && times.front() + EPS < 0) {
+      throw exceptions::ConsistencyException("Time must be non-negative");
     }
+    train_trajectories.at(tr) = std::move(trajectory);
+  };
+  void set_train_trajectory(const std::string& tr_name,
+                            TrainTrajectory    trajectory) {
+    set_train_trajectory(
+        this->instance.get_train_list().get_train_index(tr_name),
+        std::move(trajectory));
   };
   void set_train_routed(const std::string& tr_name) {
     set_train_routed_value(tr_name, true);
@@ -660,12 +811,15 @@ public:
   void set_train_not_routed(const std::string& tr_name) {
     set_train_routed_value(tr_name, false);
   };
-  void set_train_routed_value(const std::string& tr_name, bool val) {
-    if (!this->instance.get_train_list().has_train(tr_name)) {
-      throw exceptions::TrainNotExistentException(tr_name);
+  void set_train_routed_value(size_t tr, bool val) {
+    if (!this->instance.get_train_list().has_train(tr)) {
+      throw exceptions::TrainNotExistentException(tr);
     }
-    train_routed.at(this->instance.get_train_list().get_train_index(tr_name)) =
-        val;
+    train_routed.at(tr) = val;
+  };
+  void set_train_routed_value(const std::string& tr_name, bool val) {
+    set_train_routed_value(
+        this->instance.get_train_list().get_train_index(tr_name), val);
   };
 
   void export_solution(const std::filesystem::path& p,
@@ -682,6 +836,10 @@ public:
      * - train_pos and train_speed are exported to p / solution / train_pos.json
      * and p / solution / train_speed.json The method throws a
      * ConsistencyException if the solution is not consistent.
+     * - If the solution format is binary, train_pos, train_speed and
+     * train_routed are instead exported to p / solution / trajectories.bin
+     * - Files of the other solution format are removed, the format itself is
+     * stored in data.json
      *
      * @param p the path to the folder where the solution should be exported
      * @param export_instance whether the instance should be exported next to
@@ -700,14 +858,36 @@ public:
     SolGeneralProblemInstanceWithScheduleAndRoutes<
         T>::export_general_solution_data_with_routes(p, export_instance, true);
 
+    if (this->get_solution_format() == SolutionFormat::Binary) {
+      export_trajectories_binary(p);
+      this->remove_solution_files(
+          p, {"train_pos.json", "train_speed.json", "train_routed.json"});
+      return;
+    }
+    this->remove_solution_files(p, {"trajectories.bin"});
+
     json train_pos_json;
     json train_speed_json;
     json train_routed_json;
     for (size_t tr_id = 0; tr_id < this->instance.get_train_list().size();
          ++tr_id) {
-      const auto& train = this->instance.get_train_list().get_train(tr_id);
-      train_pos_json[train.name]    = train_pos.at(tr_id);
-      train_speed_json[train.name]  = train_speed.at(tr_id);
+      const auto& train      = this->instance.get_train_list().get_train(tr_id);
+      const auto& trajectory = train_trajectories.at(tr_id);
+      // Same format as a serialized std::map<double, double>
+      json tr_pos_json   = json::array();
+      json tr_speed_json = json::array();
+      for (size_t i = 0; i < trajectory.size(); ++i) {
+        if (trajectory.has_pos(i)) {
+          tr_pos_json.push_back(
+              {trajectory.get_time(i), trajectory.get_pos(i)});
+        }
+        if (trajectory.has_speed(i)) {
+          tr_speed_json.push_back(
+              {trajectory.get_time(i), trajectory.get_speed(i)});
+        }
+      }
+      train_pos_json[train.name]    = tr_pos_json;
+      train_speed_json[train.name]  = tr_speed_json;
       train_routed_json[train.name] = train_routed.at(tr_id);
     }
 
@@ -746,33 +926,29 @@ public:
           !this->instance.get_train_optional().at(tr_id)) {
         return false;
       }
-      if (train_routed.at(tr_id) && train_pos.at(tr_id).size() < 2) {
+      const auto& trajectory = train_trajectories.at(tr_id);
+      if (train_routed.at(tr_id) && trajectory.number_of_positions() < 2) {
         // At least two points of information are needed to recover the timing
         return false;
       }
 
-      if (train_pos.size() != train_speed.size()) {
-        return false;
-      }
-
-      for (const auto& [t, pos] : train_pos.at(tr_id)) {
-        if (train_speed.at(tr_id).count(t) != 1) {
+      for (size_t i = 0; i < trajectory.size(); ++i) {
+        if (trajectory.has_pos(i) && !trajectory.has_speed(i)) {
           return false;
         }
       }
     }
 
-    for (const auto& train_pos_vec : train_pos) {
-      for (const auto& [t, pos] : train_pos_vec) {
-        if (pos + EPS < 0) {
+    for (size_t tr_id = 0; tr_id < train_trajectories.size(); ++tr_id) {
+      const auto& train      = this->instance.get_train_list().get_train(tr_id);
+      const auto& trajectory = train_trajectories.at(tr_id);
+      for (size_t i = 0; i < trajectory.size(); ++i) {
+        if (trajectory.has_pos(i) && trajectory.get_pos(i) + EPS < 0) {
           return false;
         }
-      }
-    }
-    for (size_t tr_id = 0; tr_id < train_speed.size(); ++tr_id) {
-      const auto& train = this->instance.get_train_list().get_train(tr_id);
-      for (const auto& [t, v] : train_speed.at(tr_id)) {
-        if (v + EPS < 0 || v > train.max_speed + EPS) {
+        if (trajectory.has_speed(i) &&
+            (trajectory.get_speed(i) + EPS < 0 ||
+             trajectory.get_speed(i) > train.max_speed + EPS)) {
           return false;
         }
       }
@@ -1,16 +1,21 @@
 #pragma once
 
+#include "CustomExceptions.hpp"
 #include "Definitions.hpp"
 #include "datastructure/GeneralTimetable.hpp"
 #include "datastructure/RailwayNetwork.hpp"
 #include "datastructure/Route.hpp"
+#include "datastructure/TrainUsageIndex.hpp"
 #include "nlohmann/json.hpp"
 
 #include <algorithm>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -22,26 +27,42 @@ struct HasTimeType<T, std::void_t<decltype(std::declval<T>().time_type())>>
     : std::true_type {};
 
 class GeneralProblemInstance {
-  Network network;
+  /**
+   * The network is shared between copies of an instance, e.g., between an
+   * instance, its solutions and solvers working on it. It is only copied once
+   * a copy is modified via n() (copy-on-write). Hence, references obtained by
+   * n() must not be kept across copying the instance.
+   */
+  std::shared_ptr<Network> network = std::make_shared<Network>();
 
 protected:
   GeneralProblemInstance() = default;
   explicit GeneralProblemInstance(Network network)
-      : network(std::move(network)) {};
+      : network(std::make_shared<Network>(std::move(network))) {};
   explicit GeneralProblemInstance(const std::filesystem::path& path)
-      : network(Network(path / "network")) {};
+      : network(std::make_shared<Network>(path / "network")) {};
+  explicit GeneralProblemInstance(std::shared_ptr<Network> network)
+      : network(std::move(network)) {};
 
   void export_network(const std::filesystem::path& path) const {
     if (!is_directory_and_create(path)) {
       throw std::invalid_argument("Path is not a directory");
     }
-    network.export_network(path / "network");
+    network->export_network(path / "network");
   }
 
 public:
   // Network functions, i.e., network is accessible via n() as a reference
-  [[nodiscard]] Network&       n() { return network; };
-  [[nodiscard]] const Network& const_n() const { return network; };
+  [[nodiscard]] Network& n() {
+    if (network.use_count() > 1) {
+      network = std::make_shared<Network>(*network);
+    }
+    return *network;
+  };
+  [[nodiscard]] const Network& const_n() const { return *network; };
+  [[nodiscard]] std::shared_ptr<const Network> get_network_ptr() const {
+    return network;
+  };
 
   virtual void export_instance(const std::filesystem::path& path) const = 0;
 
@@ -69,6 +90,34 @@ class GeneralProblemInstanceWithScheduleAndRoutes
 
   T        timetable;
   RouteMap routes;
+  // Index of the route of every train within routes (if any), aligned with
+  // the train indices. Hence, the route of a train can be accessed by its
+  // index without hashing its name. Updated whenever trains or routes are
+  // added or removed.
+  std::vector<std::optional<size_t>> train_route_index;
+
+  void update_train_route_index() {
+    const auto& train_list = timetable.get_train_list();
+    train_route_index.clear();
+    train_route_index.reserve(train_list.size());
+    for (const auto& tr : train_list) {
+      train_route_index.emplace_back(
+          routes.has_route(tr.name)
+              ? std::optional<size_t>(routes.get_route_index(tr.name))
+              : std::nullopt);
+    }
+  };
+  void update_train_route_index(const std::string& train_name) {
+    const auto tr = get_train_list().get_train_index(train_name);
+    if (tr >= train_route_index.size()) {
+      update_train_route_index();
+      return;
+    }
+    train_route_index[tr] =
+        routes.has_route(train_name)
+            ? std::optional<size_t>(routes.get_route_index(train_name))
+            : std::nullopt;
+  };
 
 protected:
   GeneralProblemInstanceWithScheduleAndRoutes() = default;
@@ -79,26 +128,51 @@ protected:
       RouteMap routes) // according to linter, large objects by const reference,
                        // others using std::move
       : GeneralProblemInstance(network), timetable(timetable),
-        routes(std::move(routes)) {};
+        routes(std::move(routes)) {
+    update_train_route_index();
+  };
   explicit GeneralProblemInstanceWithScheduleAndRoutes(
       const std::filesystem::path& path)
       : GeneralProblemInstance(path),
         timetable(T(path / "timetable", this->const_n())),
-        routes(RouteMap(path / "routes", this->const_n())) {};
+        routes(RouteMap(path / "routes", this->const_n())) {
+    update_train_route_index();
+  };
+  explicit GeneralProblemInstanceWithScheduleAndRoutes(
+      std::shared_ptr<Network> network, T timetable, RouteMap routes)
+      : GeneralProblemInstance(std::move(network)),
+        timetable(std::move(timetable)), routes(std::move(routes)) {
+    update_train_route_index();
+  };
 
+  // Must not add or remove trains or routes, use set_routes instead
   [[nodiscard]] T&              editable_timetable() { return timetable; };
   [[nodiscard]] RouteMap&       editable_routes() { return routes; };
   [[nodiscard]] const T&        const_timetable() const { return timetable; };
   [[nodiscard]] const RouteMap& const_routes() const { return routes; };
 
+  void set_routes(RouteMap new_routes) {
+    routes = std::move(new_routes);
+    update_train_route_index();
+  };
+
 public:
   [[nodiscard]] const auto& get_timetable() const { return timetable; };
   [[nodiscard]] const auto& get_routes() const { return routes; };
 
+  // Has to be called after changing edge lengths of the network via n()
+  void update_route_lengths() { routes.update_edge_lengths(this->const_n()); };
+
   Train& editable_tr(size_t index) { return timetable.editable_tr(index); };
   Train& editable_tr(const std::string& name) {
     return timetable.editable_tr(name);
   };
+  auto& editable_schedule(size_t index) {
+    return timetable.editable_schedule(index);
+  };
+  auto& editable_schedule(const std::string& train_name) {
+    return timetable.editable_schedule(train_name);
+  };
 
   [[nodiscard]] bool is_forced_to_stop(const std::string& train_name,
                                        int                time) const {
@@ -112,9 +186,11 @@ public:
                    decltype(T::time_type()) t_0, double v_0,
                    const EntryN& entry, decltype(T::time_type()) t_n,
                    double v_n, const ExitN& exit) {
-    return timetable.add_train(name, length, max_speed, acceleration,
-                               deceleration, t_0, v_0, entry, t_n, v_n, exit,
-                               this->const_n());
+    const auto tr = timetable.add_train(name, length, max_speed, acceleration,
+                                        deceleration, t_0, v_0, entry, t_n,
+                                        v_n, exit, this->const_n());
+    update_train_route_index(get_train_list().get_train(tr).name);
+    return tr;
   }
 
   void add_station(const std::string& name) { timetable.add_station(name); };
@@ -152,7 +228,8 @@ public:
 
   [[nodiscard]] std::vector<std::pair<size_t, std::vector<std::vector<size_t>>>>
   possible_stop_vertices(size_t tr, const std::string& station_name,
-                         const std::vector<size_t>& edges_to_consider = {}) {
+                         const std::vector<size_t>& edges_to_consider = {})
+      const {
     /**
      * This method returns the possible stop vertices for a train at a station
      * together with the respective stop edges
@@ -212,7 +289,8 @@ public:
   [[nodiscard]] std::vector<std::pair<size_t, std::vector<std::vector<size_t>>>>
   possible_stop_vertices(const std::string&         train_name,
                          const std::string&         station_name,
-                         const std::vector<size_t>& edges_to_consider = {}) {
+                         const std::vector<size_t>& edges_to_consider = {})
+      const {
     return possible_stop_vertices(
         get_timetable().get_train_list().get_train_index(train_name),
         station_name, edges_to_consider);
@@ -226,16 +304,27 @@ public:
   time_interval(const std::string& train_name) const {
     return timetable.time_interval(train_name);
   };
+  [[nodiscard]] TrainIntervalIndex get_train_interval_index() const {
+    return timetable.get_train_interval_index();
+  };
 
   // RouteMap functions
   void add_empty_route(const std::string& train_name) {
     routes.add_empty_route(train_name, get_train_list());
+    update_train_route_index(train_name);
   };
 
   void push_back_edge_to_route(const std::string& train_name,
                                size_t             edge_index) {
     routes.push_back_edge(train_name, edge_index, this->const_n());
   };
+  void push_back_edge_to_route(size_t train_index, size_t edge_index) {
+    if (!has_route(train_index)) {
+      throw exceptions::ConsistencyException("Train does not have a route.");
+    }
+    routes.push_back_edge(train_route_index[train_index].value(), edge_index,
+                          this->const_n());
+  };
   void push_back_edge_to_route(const std::string& train_name, size_t source,
                                size_t target) {
     routes.push_back_edge(train_name, source, target, this->const_n());
@@ -274,11 +363,12 @@ public:
      * @return true if every train has a route, false otherwise
      */
 
-    return std::all_of(get_train_list().begin(), get_train_list().end(),
-                       [this](const auto& tr) {
-                         return has_route(tr.name) &&
-                                !get_route(tr.name).empty();
-                       });
+    for (size_t tr = 0; tr < get_train_list().size(); ++tr) {
+      if (!has_route(tr) || get_route(tr).empty()) {
+        return false;
+      }
+    }
+    return true;
   };
   [[nodiscard]] std::vector<size_t>
   trains_in_section(const std::vector<size_t>& section) const {
@@ -291,9 +381,8 @@ public:
 
     std::vector<size_t> tr_in_sec;
     for (size_t i = 0; i < get_train_list().size(); ++i) {
-      auto tr_name        = get_train_list().get_train(i).name;
-      auto tr_route       = get_route(tr_name).get_edges();
-      bool tr_in_sec_flag = false;
+      const auto& tr_route       = get_route(i).get_edges();
+      bool        tr_in_sec_flag = false;
       for (size_t j = 0; j < section.size() && !tr_in_sec_flag; ++j) {
         for (size_t k = 0; k < tr_route.size() && !tr_in_sec_flag; ++k) {
           if (section[j] == tr_route[k]) {
@@ -307,37 +396,37 @@ public:
     return tr_in_sec;
   };
   [[nodiscard]] std::vector<size_t>
-  edges_used_by_train(const std::string& train_name, bool fixed_routes,
+  edges_used_by_train(size_t train_id, bool fixed_routes,
                       bool error_if_no_route = true) const {
     /**
      * Returns edges potentially used by a specific train.
      *
-     * @param train_name the name of the train
+     * @param train_id the index of the train
      * @param fixed_routes specifies if the routes are fixed, if not returns all
      * edges
      *
      * @return edges potentially used by a specific train
      */
 
-    if (!fixed_routes || (!error_if_no_route && !has_route(train_name))) {
+    if (!fixed_routes || (!error_if_no_route && !has_route(train_id))) {
       // return vector with values 0, 1, ..., num_edges-1
       std::vector<size_t> return_edges(this->const_n().number_of_edges());
       std::iota(return_edges.begin(), return_edges.end(), 0);
       return return_edges;
     }
-    return get_route(train_name).get_edges();
+    return get_route(train_id).get_edges();
   };
   [[nodiscard]] std::vector<size_t>
-  edges_used_by_train(size_t train_id, bool fixed_routes,
+  edges_used_by_train(const std::string& train_name, bool fixed_routes,
                       bool error_if_no_route = true) const {
-    return edges_used_by_train(get_train_list().get_train(train_id).name,
+    return edges_used_by_train(get_train_list().get_train_index(train_name),
                                fixed_routes, error_if_no_route);
   };
   [[nodiscard]] std::vector<size_t>
-  vertices_used_by_train(const std::string& tr_name, bool fixed_routes,
+  vertices_used_by_train(size_t tr_id, bool fixed_routes,
                          bool error_if_no_route = true) const {
     const auto edges =
-        edges_used_by_train(tr_name, fixed_routes, error_if_no_route);
+        edges_used_by_train(tr_id, fixed_routes, error_if_no_route);
     std::vector<size_t> return_vertices;
     for (const auto& e_id : edges) {
       const auto& edge = this->const_n().get_edge(e_id);
@@ -353,18 +442,18 @@ public:
     return return_vertices;
   };
   [[nodiscard]] std::vector<size_t>
-  vertices_used_by_train(size_t tr_id, bool fixed_routes,
+  vertices_used_by_train(const std::string& tr_name, bool fixed_routes,
                          bool error_if_no_route = true) const {
-    return vertices_used_by_train(get_train_list().get_train(tr_id).name,
+    return vertices_used_by_train(get_train_list().get_train_index(tr_name),
                                   fixed_routes, error_if_no_route);
   };
   [[nodiscard]] std::vector<size_t>
-  sections_used_by_train(const std::string&                      tr_name,
+  sections_used_by_train(size_t                                  tr_id,
                          const std::vector<std::vector<size_t>>& sections,
                          bool                                    fixed_routes,
                          bool error_if_no_route = true) const {
     const auto edges =
-        edges_used_by_train(tr_name, fixed_routes, error_if_no_route);
+        edges_used_by_train(tr_id, fixed_routes, error_if_no_route);
     std::vector<size_t> return_sections;
     for (size_t section_id = 0; section_id < sections.size(); ++section_id) {
       const auto& section     = sections[section_id];
@@ -381,10 +470,12 @@ public:
     }
     return return_sections;
   };
-  [[nodiscard]] std::vector<size_t> sections_used_by_train(
-      size_t tr_id, const std::vector<std::vector<size_t>>& sections,
-      bool fixed_routes, bool error_if_no_route = true) const {
-    return sections_used_by_train(get_train_list().get_train(tr_id).name,
+  [[nodiscard]] std::vector<size_t>
+  sections_used_by_train(const std::string&                      tr_name,
+                         const std::vector<std::vector<size_t>>& sections,
+                         bool                                    fixed_routes,
+                         bool error_if_no_route = true) const {
+    return sections_used_by_train(get_train_list().get_train_index(tr_name),
                                   sections, fixed_routes, error_if_no_route);
   };
   [[nodiscard]] std::vector<size_t>
@@ -404,6 +495,31 @@ public:
     }
     return tr_in_sec;
   };
+  [[nodiscard]] TrainUsageIndex
+  get_train_usage_index(const std::vector<std::vector<size_t>>& sections,
+                        bool                                    fixed_routes,
+                        bool error_if_no_route = true) const {
+    /**
+     * Builds an index answering which trains use which edges, vertices and
+     * sections, consistent with edges_used_by_train, vertices_used_by_train,
+     * sections_used_by_train, trains_in_section and
+     * trains_on_edge_mixed_routing.
+     *
+     * @param sections: the sections to index, e.g., TTD sections
+     * @param fixed_routes specifies if the routes are fixed, if not every train
+     * uses all edges
+     *
+     * @return the index
+     */
+
+    std::vector<std::vector<size_t>> edges_used_by_trains;
+    edges_used_by_trains.reserve(get_train_list().size());
+    for (size_t tr = 0; tr < get_train_list().size(); ++tr) {
+      edges_used_by_trains.emplace_back(
+          edges_used_by_train(tr, fixed_routes, error_if_no_route));
+    }
+    return {this->const_n(), std::move(edges_used_by_trains), sections};
+  };
   [[nodiscard]] std::vector<size_t>
   trains_on_edge(size_t edge_id, bool fixed_routes,
                  const std::vector<size_t>& trains_to_consider,
@@ -431,13 +547,10 @@ public:
     std::vector<size_t> return_trains;
     for (const auto tr : trains_to_consider) {
       bool add_train = false;
-      if (!error_if_not_route &&
-          !has_route(get_train_list().get_train(tr).name)) {
+      if (!error_if_not_route && !has_route(tr)) {
         add_train = true;
       } else {
-        const auto& tr_route =
-            this->get_route(get_train_list().get_train(tr).name);
-        if (tr_route.contains_edge(edge_id)) {
+        if (get_route(tr).contains_edge(edge_id)) {
           add_train = true;
         }
       }
@@ -472,14 +585,37 @@ public:
   [[nodiscard]] bool has_route(const std::string& train_name) const {
     return routes.has_route(train_name);
   };
+  [[nodiscard]] bool has_route(size_t train_index) const {
+    if (train_index >= train_route_index.size()) {
+      throw exceptions::TrainNotExistentException(train_index);
+    }
+    return train_route_index[train_index].has_value();
+  };
   [[nodiscard]] size_t       route_map_size() const { return routes.size(); };
   [[nodiscard]] const Route& get_route(const std::string& train_name) const {
     return routes.get_route(train_name);
   };
+  [[nodiscard]] const Route& get_route(size_t train_index) const {
+    if (!has_route(train_index)) {
+      throw exceptions::ConsistencyException("Train does not have a route.");
+    }
+    return routes.get_route(train_route_index[train_index].value());
+  };
 
   [[nodiscard]] double route_length(const std::string& train_name) const {
     return routes.length(train_name, this->const_n());
   };
+  [[nodiscard]] double route_length(size_t train_index) const {
+    return get_route(train_index).length(this->const_n());
+  };
+  [[nodiscard]] std::pair<double, double>
+  route_edge_pos(size_t train_index, size_t edge) const {
+    return get_route(train_index).edge_pos(edge, this->const_n());
+  };
+  [[nodiscard]] std::pair<double, double>
+  route_edge_pos(size_t train_index, const std::vector<size_t>& edges) const {
+    return get_route(train_index).edge_pos(edges, this->const_n());
+  };
   [[nodiscard]] std::pair<double, double>
   route_edge_pos(const std::string& train_name, size_t edge) const {
     return routes.edge_pos(train_name, edge, this->const_n());
@@ -524,17 +660,15 @@ public:
     };
     for (size_t tr_index = 0; tr_index < timetable.get_train_list().size();
          tr_index++) {
-      const auto& tr_name = timetable.get_train_list().get_train(tr_index).name;
-      if (routes.has_route(tr_name)) {
-        size_t entry = timetable.get_schedule(tr_index).get_entry();
-        size_t exit  = timetable.get_schedule(tr_index).get_exit();
-        if (routes.get_route(tr_name).get_edge(0, this->const_n()).source !=
-            entry) {
+      if (has_route(tr_index)) {
+        const auto& tr_route = get_route(tr_index);
+        size_t      entry    = timetable.get_schedule(tr_index).get_entry();
+        size_t      exit     = timetable.get_schedule(tr_index).get_exit();
+        if (tr_route.get_edge(0, this->const_n()).source != entry) {
           return false;
         }
-        if (routes.get_route(tr_name)
-                .get_edge(routes.get_route(tr_name).size() - 1, this->const_n())
-                .target != exit) {
+        if (tr_route.get_edge(tr_route.size() - 1, this->const_n()).target !=
+            exit) {
           return false;
         }
       }
@@ -552,6 +686,8 @@ protected:
   SolutionStatus status  = SolutionStatus::Unknown;
   double         obj     = -1;
   bool           has_sol = false;
+  // Format of the solution files written by export_solution
+  SolutionFormat solution_format = SolutionFormat::JSON;
 
   SolGeneralProblemInstance() = default;
   explicit SolGeneralProblemInstance(const T& instance) : instance(instance) {};
@@ -572,10 +708,7 @@ protected:
     }
 
     if (export_data) {
-      json data;
-      data["status"]       = static_cast<int>(status);
-      data["obj"]          = obj;
-      data["has_solution"] = has_sol;
+      const auto    data = get_general_solution_data();
       std::ofstream data_file(p / "solution" / "data.json");
       data_file << data << std::endl;
       data_file.close();
@@ -584,9 +717,10 @@ protected:
 
   [[nodiscard]] json get_general_solution_data() const {
     json data;
-    data["status"]       = static_cast<int>(status);
-    data["obj"]          = obj;
-    data["has_solution"] = has_sol;
+    data["status"]          = static_cast<int>(status);
+    data["obj"]             = obj;
+    data["has_solution"]    = has_sol;
+    data["solution_format"] = static_cast<int>(solution_format);
     return data;
   };
 
@@ -594,6 +728,25 @@ protected:
     this->status  = static_cast<SolutionStatus>(data["status"].get<int>());
     this->obj     = data["obj"].get<double>();
     this->has_sol = data["has_solution"].get<bool>();
+    // Solutions exported before the binary format existed are JSON
+    this->solution_format =
+        data.contains("solution_format")
+            ? static_cast<SolutionFormat>(data["solution_format"].get<int>())
+            : SolutionFormat::JSON;
+  };
+
+  static void
+  remove_solution_files(const std::filesystem::path&    p,
+                        const std::vector<std::string>& file_names) {
+    /**
+     * Removes the given files from p / solution if they exist, e.g., files of
+     * the solution format that is not exported, so that they cannot be
+     * mistaken for the current solution.
+     */
+
+    for (const auto& file_name : file_names) {
+      std::filesystem::remove(p / "solution" / file_name);
+    }
   };
 
   [[nodiscard]] bool check_general_solution_data_consistency() const {
@@ -616,6 +769,12 @@ public:
   void set_obj(double new_obj) { obj = new_obj; };
   void set_solution_found() { has_sol = true; };
   void set_solution_not_found() { has_sol = false; };
+  [[nodiscard]] SolutionFormat get_solution_format() const {
+    return solution_format;
+  };
+  void set_solution_format(SolutionFormat new_solution_format) {
+    solution_format = new_solution_format;
+  };
 
   virtual void export_solution(const std::filesystem::path& p,
                                bool export_instance) const = 0;
@@ -672,11 +831,8 @@ public:
 
   // RouteMap functions
   void reset_routes() {
-    for (const auto& tr : this->instance.get_train_list()) {
-      if (this->instance.has_route(tr.name)) {
-        this->instance.routes.remove_route(tr.name);
-      }
-    }
+    // Routes only exist for trains of the instance, hence, all are removed
+    this->instance.set_routes(RouteMap());
   }
   void add_empty_route(const std::string& train_name) {
     this->instance.add_empty_route(train_name);
@@ -686,6 +842,9 @@ public:
                                size_t             edge_index) {
     this->instance.push_back_edge_to_route(train_name, edge_index);
   };
+  void push_back_edge_to_route(size_t train_index, size_t edge_index) {
+    this->instance.push_back_edge_to_route(train_index, edge_index);
+  };
   void push_back_edge_to_route(const std::string& train_name, size_t source,
                                size_t target) {
     this->instance.push_back_edge_to_route(train_name, source, target);
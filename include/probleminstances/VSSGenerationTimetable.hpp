@@ -91,6 +91,8 @@ private:
   bool   postprocessed = false;
 
   void initialize_vectors();
+  void export_trajectories_binary(const std::filesystem::path& p) const;
+  void import_trajectories_binary(const std::filesystem::path& p);
 
 public:
   // Constructor
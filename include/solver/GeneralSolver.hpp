@@ -3,6 +3,7 @@
 #include "probleminstances/GeneralProblemInstance.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <plog/Appenders/ColorConsoleAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Initializers/ConsoleInitializer.h>
@@ -26,7 +27,7 @@ protected:
   int64_t                                             create_time = 0;
   int64_t                                             solve_time  = 0;
 
-  void solve_init_general(int time_limit, bool debug_input) {
+  void solve_init_general(bool debug_input) {
     if (plog::get() == nullptr) {
       static plog::ColorConsoleAppender<plog::TxtFormatter> console_appender;
       plog::init(plog::debug, &console_appender);
@@ -34,9 +35,7 @@ protected:
 
     plog::get()->setMaxSeverity(debug_input ? plog::debug : plog::info);
 
-    if (plog::get()->checkSeverity(plog::debug) || time_limit > 0) {
-      start = std::chrono::high_resolution_clock::now();
-    }
+    start = std::chrono::high_resolution_clock::now();
   }
 
   GeneralSolver() = default;
@@ -49,6 +48,11 @@ public:
   [[nodiscard]] const T& get_instance() const { return instance; }
   [[nodiscard]] T&       editable_instance() { return instance; }
 
+  // Times of the last solve in milliseconds, only measured if a time limit is
+  // set or debug output is enabled
+  [[nodiscard]] int64_t get_create_time() const { return create_time; }
+  [[nodiscard]] int64_t get_solve_time() const { return solve_time; }
+
   [[nodiscard]] S         solve() { return solve(-1, false); };
   [[nodiscard]] virtual S solve(int time_limit, bool debug_input) = 0;
 
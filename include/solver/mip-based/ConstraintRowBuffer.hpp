@@ -0,0 +1,46 @@
+#pragma once
+
+#include "gurobi_c++.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cda_rail::solver::mip_based {
+
+class ConstraintRowBuffer {
+  /**
+   * Buffer of linear constraints (rows) expr (sense) rhs, where expr holds the
+   * variables and coefficients of the row and rhs is a constant.
+   * Rows are created without touching the model. Hence, several threads can
+   * fill buffers of their own concurrently. The rows are added to the model
+   * afterward using a single batched call.
+   */
+private:
+  std::vector<GRBLinExpr>  exprs;
+  std::vector<char>        senses;
+  std::vector<double>      rhs_values;
+  std::vector<std::string> names;
+
+public:
+  void add(const GRBLinExpr& lhs, char sense, const GRBLinExpr& rhs,
+           std::string name);
+  void append(ConstraintRowBuffer&& other);
+  void clear();
+
+  [[nodiscard]] size_t size() const { return exprs.size(); };
+  [[nodiscard]] bool   empty() const { return exprs.empty(); };
+
+  [[nodiscard]] const GRBLinExpr& get_expr(size_t row) const {
+    return exprs.at(row);
+  };
+  [[nodiscard]] char   get_sense(size_t row) const { return senses.at(row); };
+  [[nodiscard]] double get_rhs(size_t row) const { return rhs_values.at(row); };
+  [[nodiscard]] const std::string& get_name(size_t row) const {
+    return names.at(row);
+  };
+
+  size_t add_to_model(GRBModel& model) const;
+};
+
+} // namespace cda_rail::solver::mip_based
@@ -2,14 +2,21 @@
 
 #include "Definitions.hpp"
 #include "datastructure/GeneralTimetable.hpp"
+#include "datastructure/TrainUsageIndex.hpp"
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 #include "solver/GeneralSolver.hpp"
+#include "solver/mip-based/ConstraintRowBuffer.hpp"
 #include "solver/mip-based/GeneralMIPSolver.hpp"
+#include "solver/mip-based/LazyConstraintPool.hpp"
 
 #include "gtest/gtest_prod.h"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <optional>
+#include <set>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -40,6 +47,11 @@ struct ModelDetail {
       VelocityRefinementStrategy::MinOneStep;
   bool simplify_headway_constraints          = false;
   bool strengthen_vertex_headway_constraints = false;
+  // If true, entry times of interchangeable trains are ordered by train index
+  bool break_train_symmetries = false;
+  // If true, timing variables are bounded using the schedule and minimal
+  // travel times, and headway constraints use big-M values per train pair
+  bool tighten_timing_bounds = false;
 };
 
 enum class LazyConstraintSelectionStrategy : std::uint8_t {
@@ -63,6 +75,49 @@ struct SolverStrategyMovingBlock {
   LazyTrainSelectionStrategy lazy_train_selection_strategy =
       LazyTrainSelectionStrategy::OnlyAdjacent;
   double abs_mip_gap = 10;
+  // Number of threads used to separate lazy constraints within one callback.
+  // If 0, std::thread::hardware_concurrency() is used.
+  size_t lazy_separation_threads = 1;
+  // If true, lazy constraints are added in the same order regardless of the
+  // number of threads used for separation.
+  bool deterministic_lazy_separation = true;
+  // If true, lazy constraints found in previous solves of the same solver
+  // object (or imported into its pool) are added to the model upfront. They
+  // use Gurobi's Lazy attribute with value lazy_constraint_pool_level, where 0
+  // adds them as usual constraints.
+  bool use_lazy_constraint_pool   = false;
+  int  lazy_constraint_pool_level = 1;
+  // If true, headway and TTD inequalities violated by the LP relaxation of a
+  // node are added as user cuts, at most max_cuts_per_node per node. Only used
+  // if use_lazy_constraints is true.
+  bool   separate_fractional_cuts = false;
+  size_t max_cuts_per_node        = 20;
+  // Number of threads used to create the constraints of the initial model.
+  // If 0, std::thread::hardware_concurrency() is used.
+  size_t model_creation_threads = 1;
+  // If true, the model is kept after solve(). It can be modified using the
+  // update_* functions and solved again using resolve() until release_model()
+  // or solve() is called.
+  bool keep_model = false;
+  // If true, the timetable is checked for conflicts no solution can resolve
+  // before the model is created. If any are found, no model is created and
+  // the returned object has no solution.
+  bool check_timetable_conflicts = false;
+  // If true, optional trains involved in such conflicts are not scheduled
+  // instead, as long as this resolves all conflicts found.
+  bool drop_conflicting_optional_trains = false;
+};
+
+struct RollingHorizonSettings {
+  // Number of trains optimized within one window
+  size_t window_size = 10;
+  // Number of trains of a window that are optimized again in the next window
+  size_t window_overlap = 2;
+  // Time limit per window in seconds. If -1, no time limit is set.
+  int window_time_limit = -1;
+  // If true, the full instance is solved afterward using the stitched
+  // solution as a start.
+  bool final_polish = false;
 };
 
 class GenPOMovingBlockMIPSolver
@@ -84,6 +139,9 @@ private:
   size_t                           num_ttd           = 0;
   int                              max_t             = 0;
   std::vector<std::vector<size_t>> ttd_sections;
+  // Edges, vertices and TTD sections potentially used by every train and
+  // vice versa, built once per solve
+  TrainUsageIndex train_usage;
   // tr_stop_data:
   // For every train, for every station, list of possible stop vertices together
   // with respective edges
@@ -92,6 +150,30 @@ private:
                                                 tr_stop_data;
   std::vector<std::vector<std::vector<double>>> velocity_extensions;
   std::vector<std::pair<size_t, size_t>>        relevant_reverse_edges;
+  // vertex_time_bounds:
+  // For every train and vertex, interval containing all times the train can
+  // be at the vertex. Only tighter than [0, ub_timing_variable(tr)] if
+  // model_detail.tighten_timing_bounds is true.
+  std::vector<std::vector<std::pair<double, double>>> vertex_time_bounds;
+  std::vector<std::vector<double>>                    ttd_departure_ubs;
+  // Lazy constraints separated so far, persists across solves
+  LazyConstraintPool lazy_constraint_pool;
+  // Values of variables (identified by name) that are fixed or used as MIP
+  // start in the next solve. Set by solve_rolling_horizon.
+  std::unordered_map<std::string, double> fixed_variable_values;
+  std::unordered_map<std::string, double> start_variable_values;
+  // If true, solve() stores the solution values of all variables that only
+  // belong to a single train, i.e., train name -> (variable name -> value).
+  bool store_train_variable_values = false;
+  std::unordered_map<std::string, std::unordered_map<std::string, double>>
+      train_variable_values;
+  // Instance before discretizing stops. Only set while a model is kept, see
+  // SolverStrategyMovingBlock::keep_model.
+  std::optional<instances::GeneralPerformanceOptimizationInstance>
+      persistent_instance;
+  // Pairs of trains (tr1, tr2) for which the model contains the row
+  // symmetry_breaking_<tr1>_<tr2>, see create_symmetry_breaking_constraints.
+  std::vector<std::pair<size_t, size_t>> symmetry_breaking_pairs;
 
   void initialize_variables(
       const SolutionSettingsMovingBlock& solution_settings_input,
@@ -99,9 +181,53 @@ private:
       const ModelDetail&                 model_detail_input);
 
   double ub_timing_variable(size_t tr) const;
+  [[nodiscard]] double lb_timing_variable(size_t tr, size_t v) const {
+    return vertex_time_bounds.at(tr).at(v).first;
+  };
+  [[nodiscard]] double ub_timing_variable(size_t tr, size_t v) const {
+    return vertex_time_bounds.at(tr).at(v).second;
+  };
+  [[nodiscard]] double ub_ttd_departure(size_t tr, size_t ttd) const {
+    return ttd_departure_ubs.at(tr).at(ttd);
+  };
+  [[nodiscard]] double get_headway_big_m(size_t tr, size_t v, double rhs_ub,
+                                         double default_big_m) const;
+  [[nodiscard]] std::vector<double>
+  get_minimal_travel_times(size_t tr, size_t v, bool forward) const;
+  [[nodiscard]] std::string get_lazy_constraint_pool_fingerprint() const;
+  [[nodiscard]] std::vector<size_t>
+  get_lazy_constraint_pool_train_signatures() const;
+
+  size_t apply_variable_values();
+  void   check_persistent_model() const;
+  void   remove_symmetry_breaking_constraints(size_t tr);
+  void   extract_train_variable_values();
+  [[nodiscard]] static instances::GeneralPerformanceOptimizationInstance
+  get_sub_instance(
+      const instances::GeneralPerformanceOptimizationInstance& full_instance,
+      const std::vector<size_t>&                               trains);
+  static void copy_train_solution(
+      const instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>& from,
+      instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>& to,
+      const std::string&                                      tr_name);
+  static void export_solution_without_model(
+      instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>& solution,
+      const SolutionSettingsMovingBlock&                      settings);
+  [[nodiscard]] std::optional<
+      instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>>
+  solve_with_timetable_check(
+      const ModelDetail&                 model_detail_input,
+      const SolverStrategyMovingBlock&   solver_strategy_input,
+      const SolutionSettingsMovingBlock& solution_settings_input,
+      int time_limit, bool debug_input);
 
   void fill_tr_stop_data();
   void fill_relevant_reverse_edges();
+  void fill_vertex_time_bounds();
   void fill_velocity_extensions();
   void fill_velocity_extensions_using_none_strategy();
   void fill_velocity_extensions_using_min_one_step_strategy();
@@ -133,6 +259,13 @@ private:
   void create_vertex_headway_constraints();
   void create_headway_constraints();
   void create_simplified_headway_constraints();
+  void create_symmetry_breaking_constraints();
+  // Creates the rows of every item (e.g., train or edge) in parallel and adds
+  // them to the model in item order.
+  void add_rows_in_parallel(
+      size_t num_items,
+      const std::function<void(size_t, ConstraintRowBuffer&)>&
+          create_item_rows);
 
   // Helper for headway normal and lazy constraints
   [[nodiscard]] GRBLinExpr
@@ -149,7 +282,51 @@ private:
 
   class LazyCallback : public MessageCallback {
   private:
-    GenPOMovingBlockMIPSolver* solver;
+    enum class LazyConstraintType : std::uint8_t {
+      EdgeHeadway           = 0,
+      TTDHeadway            = 1,
+      SimplifiedEdgeHeadway = 2,
+      SimplifiedTTDHeadway  = 3,
+      VertexOrder           = 4,
+      VertexHeadway         = 5,
+      ReverseOrder          = 6,
+      ReverseHeadway        = 7
+    };
+
+    // Canonical identifier of a lazy constraint, i.e., (constraint type, train,
+    // other train, edge/section, vertex, auxiliary edge, velocity index,
+    // sub-index)
+    using LazyConstraintKey = LazyConstraintPool::Key;
+
+    // Represents the constraint expr (sense) 0
+    struct LazyConstraintCandidate {
+      LazyConstraintKey key = {};
+      GRBLinExpr        expr;
+      char              sense = GRB_GREATER_EQUAL;
+      // Index of the train (or reverse edge pair) the constraint was separated
+      // for and its position within this item. Used for deterministic ordering.
+      size_t item = 0;
+      size_t seq  = 0;
+    };
+
+    // Solution values needed for separation. They are queried on the
+    // callback thread beforehand, so that the separation itself can run in
+    // parallel without calling getSolution.
+    struct LazySolutionValues {
+      MultiArray<double>                 t_front_arrival;
+      MultiArray<double>                 t_front_departure;
+      MultiArray<double>                 t_rear_departure;
+      MultiArray<double>                 t_ttd_departure;
+      std::unordered_map<size_t, double> order;
+    };
+
+    GenPOMovingBlockMIPSolver*  solver;
+    std::set<LazyConstraintKey> added_constraint_keys;
+    // If true, values are taken from the node relaxation (GRB_CB_MIPNODE)
+    // instead of the new incumbent (GRB_CB_MIPSOL)
+    bool use_node_relaxation = false;
+
+    double get_value(const GRBVar& var);
 
     std::vector<std::vector<std::pair<size_t, double>>> get_routes();
     std::vector<std::unordered_map<size_t, double>>     get_train_velocities(
@@ -158,7 +335,32 @@ private:
                           std::vector<std::pair<size_t, bool>>>>
     get_train_orders_on_edges(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes);
-    std::vector<std::vector<size_t>> get_train_orders_on_ttd();
+    std::vector<std::vector<size_t>> get_train_orders_on_ttd(
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes);
+    LazySolutionValues get_solution_values(
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                                train_orders_on_edges,
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd);
+    [[nodiscard]] double get_order_value(const LazySolutionValues& values,
+                                         size_t tr1, size_t tr2,
+                                         size_t e) const;
+
+    std::vector<LazyConstraintCandidate> separate_candidates(
+        size_t num_items,
+        const std::function<void(size_t,
+                                 std::vector<LazyConstraintCandidate>&)>&
+             separate_item,
+        bool only_one_constraint);
+    bool separate_and_add_lazy_constraints(
+        size_t num_items,
+        const std::function<void(size_t,
+                                 std::vector<LazyConstraintCandidate>&)>&
+            separate_item);
+    void   add_lazy_constraint(const GRBLinExpr& expr, char sense);
+    double get_expr_value(const GRBLinExpr& expr);
+    void   separate_fractional_cuts();
 
     bool create_lazy_edge_and_ttd_headway_constraints(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes,
@@ -166,24 +368,65 @@ private:
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
                                                 train_orders_on_edges,
-        const std::vector<std::vector<size_t>>& train_orders_on_ttd);
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values);
     bool create_lazy_simplified_edge_constraints(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes,
         const std::vector<std::unordered_map<size_t, double>>& train_velocities,
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
                                                 train_orders_on_edges,
-        const std::vector<std::vector<size_t>>& train_orders_on_ttd);
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values);
     bool create_lazy_vertex_headway_constraints(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes,
         const std::vector<std::unordered_map<size_t, double>>& train_velocities,
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
-            train_orders_on_edges);
+                                  train_orders_on_edges,
+        const LazySolutionValues& values);
     bool create_lazy_reverse_edge_constraints(
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
-            train_orders_on_edges);
+                                  train_orders_on_edges,
+        const LazySolutionValues& values);
+
+    void separate_edge_and_ttd_headway_constraints(
+        size_t                                                     tr,
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::unordered_map<size_t, double>>& train_velocities,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                                train_orders_on_edges,
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values,
+        std::vector<LazyConstraintCandidate>&   constraints);
+    void separate_simplified_edge_constraints(
+        size_t                                                     tr,
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::unordered_map<size_t, double>>& train_velocities,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                                train_orders_on_edges,
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values,
+        std::vector<LazyConstraintCandidate>&   constraints);
+    void separate_vertex_headway_constraints(
+        size_t                                                     tr,
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::unordered_map<size_t, double>>& train_velocities,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                              train_orders_on_edges,
+        const LazySolutionValues&             values,
+        std::vector<LazyConstraintCandidate>& constraints);
+    void separate_reverse_edge_constraints(
+        size_t idx,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                              train_orders_on_edges,
+        const LazySolutionValues&             values,
+        std::vector<LazyConstraintCandidate>& constraints);
 
   public:
     explicit LazyCallback(GenPOMovingBlockMIPSolver* solver) : solver(solver) {}
@@ -192,6 +435,9 @@ private:
     void callback() override;
   };
 
+  // Has to outlive the model it is set for
+  std::optional<LazyCallback> lazy_callback;
+
 protected:
   virtual void cleanup() override;
 
@@ -239,6 +485,53 @@ public:
         const SolverStrategyMovingBlock&   solver_strategy_input,
         const SolutionSettingsMovingBlock& solution_settings_input,
         int time_limit = -1, bool debug_input = false);
+
+  [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+  solve_rolling_horizon(
+      const ModelDetail&                 model_detail_input,
+      const SolverStrategyMovingBlock&   solver_strategy_input,
+      const SolutionSettingsMovingBlock& solution_settings_input,
+      const RollingHorizonSettings&      rolling_horizon_settings,
+      int time_limit = -1, bool debug_input = false);
+
+  [[nodiscard]] const LazyConstraintPool& get_lazy_constraint_pool() const {
+    return lazy_constraint_pool;
+  };
+  void clear_lazy_constraint_pool() { lazy_constraint_pool.clear(); };
+  void export_lazy_constraint_pool(const std::filesystem::path& p) const {
+    lazy_constraint_pool.export_pool(p);
+  };
+  void import_lazy_constraint_pool(const std::filesystem::path& p) {
+    lazy_constraint_pool = LazyConstraintPool::import_pool(p);
+  };
+
+  [[nodiscard]] bool has_persistent_model() const {
+    return persistent_instance.has_value();
+  };
+  [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+  resolve(int time_limit = -1);
+  void update_train_weight(size_t tr, double weight);
+  void update_train_weight(const std::string& tr_name, double weight) {
+    update_train_weight(instance.get_train_list().get_train_index(tr_name),
+                        weight);
+  };
+  void update_entry_time_window(size_t tr, std::pair<int, int> t_0_range);
+  void update_entry_time_window(const std::string&  tr_name,
+                                std::pair<int, int> t_0_range) {
+    update_entry_time_window(
+        instance.get_train_list().get_train_index(tr_name), t_0_range);
+  };
+  void update_exit_time_window(size_t tr, std::pair<int, int> t_n_range);
+  void update_exit_time_window(const std::string&  tr_name,
+                               std::pair<int, int> t_n_range) {
+    update_exit_time_window(instance.get_train_list().get_train_index(tr_name),
+                            t_n_range);
+  };
+  void update_variable_bounds(const std::string& var_name, double lb,
+                              double ub);
+  void release_model();
 };
 
 } // namespace cda_rail::solver::mip_based
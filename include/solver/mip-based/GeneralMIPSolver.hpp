@@ -1,28 +1,35 @@
 #pragma once
 
+#include "CustomExceptions.hpp"
 #include "MultiArray.hpp"
 #include "gurobi_c++.h"
 #include "solver/GeneralSolver.hpp"
+#include "solver/mip-based/GurobiEnvironmentPool.hpp"
 
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <plog/Log.h>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace cda_rail::solver::mip_based {
 
 struct SolutionSettings {
-  bool         postprocess   = false;
-  ExportOption export_option = ExportOption::NoExport;
-  std::string  name          = "model";
-  std::string  path;
+  bool           postprocess     = false;
+  ExportOption   export_option   = ExportOption::NoExport;
+  std::string    name            = "model";
+  std::string    path;
+  SolutionFormat solution_format = SolutionFormat::JSON;
 };
 
 struct SolutionSettingsMovingBlock {
-  ExportOption export_option = ExportOption::NoExport;
-  std::string  name          = "model";
-  std::string  path;
+  ExportOption   export_option   = ExportOption::NoExport;
+  std::string    name            = "model";
+  std::string    path;
+  SolutionFormat solution_format = SolutionFormat::JSON;
 };
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay)
@@ -58,10 +65,15 @@ protected:
   std::vector<GRBTempConstr> lazy_constraints;
 
   // Gurobi variables
-  std::optional<GRBEnv>                               env;
+  // Borrowed from GurobiEnvironmentPool and returned in cleanup()
+  std::unique_ptr<GRBEnv>                             env;
   std::optional<GRBModel>                             model;
   std::unordered_map<std::string, MultiArray<GRBVar>> vars;
   GRBLinExpr                                          objective_expr;
+  // Number of threads used by Gurobi, 0 for Gurobi's default
+  int threads = 0;
+  // Per solver, since Gurobi stores callback data in the callback object
+  MessageCallback message_callback;
 
   virtual void cleanup() {
     objective_expr = 0;
@@ -69,26 +81,51 @@ protected:
     model->reset(1);
     vars.clear();
     model.reset();
-    env.reset();
+    GurobiEnvironmentPool::get_instance().release(std::move(env));
   };
 
-  void solve_init_general_mip(int time_limit, bool debug_input) {
-    static auto message_callback = MessageCallback();
-    this->solve_init_general_mip(time_limit, debug_input, &message_callback);
+  void solve_init_general_mip(bool debug_input) {
+    this->solve_init_general_mip(debug_input, &this->message_callback);
   };
 
-  void solve_init_general_mip(int time_limit, bool debug_input,
-                              GRBCallback* cb) {
-    this->solve_init_general(time_limit, debug_input);
+  void solve_init_general_mip(bool debug_input, GRBCallback* cb) {
+    this->solve_init_general(debug_input);
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    PLOGD << "Create Gurobi environment and model";
-    this->env.emplace(true);
-    this->env->start();
-    this->model.emplace(env.value());
+    PLOGD << "Acquire Gurobi environment and create model";
+    this->env = GurobiEnvironmentPool::get_instance().acquire();
+    this->model.emplace(*this->env);
 
     this->model->setCallback(cb);
     this->model->set(GRB_IntParam_LogToConsole, 0);
+    if (this->threads > 0) {
+      this->model->set(GRB_IntParam_Threads, this->threads);
+    }
+  };
+
+  size_t set_start_to_incumbent() {
+    /**
+     * Uses the current incumbent, if any, as MIP start of the next
+     * optimization.
+     *
+     * @return: number of variables started
+     */
+
+    if (this->model->get(GRB_IntAttr_SolCount) == 0) {
+      return 0;
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+    auto*     model_vars = this->model->getVars();
+    const int num_vars   = this->model->get(GRB_IntAttr_NumVars);
+    for (int i = 0; i < num_vars; i++) {
+      model_vars[i].set(GRB_DoubleAttr_Start,
+                        model_vars[i].get(GRB_DoubleAttr_X));
+    }
+    delete[] model_vars;
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+
+    return static_cast<size_t>(num_vars);
   };
 
   GeneralMIPSolver() = default;
@@ -99,5 +136,15 @@ protected:
   explicit GeneralMIPSolver(const std::string& path)
       : GeneralSolver<T, S>(path) {};
   explicit GeneralMIPSolver(const char* path) : GeneralSolver<T, S>(path) {};
+
+public:
+  void set_threads(int new_threads) {
+    if (new_threads < 0) {
+      throw exceptions::InvalidInputException(
+          "Number of threads must be non-negative.");
+    }
+    threads = new_threads;
+  };
+  [[nodiscard]] int get_threads() const { return threads; };
 };
 } // namespace cda_rail::solver::mip_based
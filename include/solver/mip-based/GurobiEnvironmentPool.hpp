@@ -0,0 +1,64 @@
+#pragma once
+
+#include "gurobi_c++.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cda_rail::solver::mip_based {
+
+class GurobiEnvironmentPool {
+  /**
+   * Process-wide pool of started Gurobi environments. Starting an environment
+   * might be expensive, e.g., when using a token or compute server license.
+   * Hence, solvers borrow environments from the pool and return them
+   * afterward instead of creating a new one for every solve.
+   * Returned environments have their parameters reset. At most max_size idle
+   * environments are kept, surplus ones are destroyed on return.
+   * All methods are thread-safe.
+   */
+public:
+  struct Metrics {
+    // Number of environments handed out
+    size_t num_acquired = 0;
+    // Number of environments that had to be created and started
+    size_t num_created = 0;
+    // Number of environments taken from the pool
+    size_t num_reused = 0;
+    // Time spent in acquire() in seconds
+    double total_acquisition_time = 0;
+    double max_acquisition_time   = 0;
+  };
+
+private:
+  mutable std::mutex                   mutex;
+  std::vector<std::unique_ptr<GRBEnv>> idle_environments;
+  size_t                               max_size = 1;
+  Metrics                              metrics;
+
+  GurobiEnvironmentPool() = default;
+
+public:
+  GurobiEnvironmentPool(const GurobiEnvironmentPool&)            = delete;
+  GurobiEnvironmentPool(GurobiEnvironmentPool&&)                 = delete;
+  GurobiEnvironmentPool& operator=(const GurobiEnvironmentPool&) = delete;
+  GurobiEnvironmentPool& operator=(GurobiEnvironmentPool&&)      = delete;
+  ~GurobiEnvironmentPool()                                       = default;
+
+  static GurobiEnvironmentPool& get_instance();
+
+  [[nodiscard]] std::unique_ptr<GRBEnv> acquire();
+  void                                  release(std::unique_ptr<GRBEnv> env);
+
+  void                 set_max_size(size_t new_max_size);
+  [[nodiscard]] size_t get_max_size() const;
+  [[nodiscard]] size_t number_of_idle_environments() const;
+  void                 clear();
+
+  [[nodiscard]] Metrics get_metrics() const;
+  void                  reset_metrics();
+};
+
+} // namespace cda_rail::solver::mip_based
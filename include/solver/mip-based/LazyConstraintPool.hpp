@@ -0,0 +1,125 @@
+#pragma once
+
+#include "gurobi_c++.h"
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cda_rail::solver::mip_based {
+
+class LazyConstraintPool {
+  /**
+   * Pool of lazy constraints separated by a callback. Every constraint is
+   * identified by a canonical key, e.g., (constraint type, train, other train,
+   * edge, vertex, auxiliary edge, velocity index, sub-index), and stored as
+   * expr (sense) 0. The second and third entry of every key are the indices of
+   * the trains the constraint refers to.
+   * The pool survives single callbacks and solves. Hence, it is used to
+   * suppress duplicate constraints, to count how often a constraint is
+   * separated again and to add previously found constraints directly to the
+   * model of a subsequent solve. For the latter, constraints are stored using
+   * variable names, so that they can be exported and imported as well.
+   * The fingerprint identifies the instance the keys refer to. The
+   * coefficients, e.g., big-Ms, depend on the data of the respective trains,
+   * which is identified by one signature per train. If the signature of a
+   * train changes, only its constraints are dropped.
+   */
+public:
+  using Key = std::array<size_t, 8>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const noexcept;
+  };
+
+  struct Entry {
+    // Only valid while the model the constraint was created for exists
+    GRBLinExpr expr;
+    char       sense = GRB_GREATER_EQUAL;
+    // Name based representation, filled by store_variable_names
+    std::vector<std::pair<std::string, double>> terms;
+    double                                      constant = 0;
+    size_t                                      hits     = 0;
+    // True if the constraint is part of the model, i.e., it is enforced by
+    // Gurobi itself
+    bool in_model = false;
+  };
+
+private:
+  std::unordered_map<Key, Entry, KeyHash> entries;
+  // Identifies the instance the keys refer to
+  std::string fingerprint;
+  // Identifies the data of every train (by index) the coefficients depend on
+  std::vector<size_t> train_signatures;
+
+public:
+  LazyConstraintPool() = default;
+
+  [[nodiscard]] size_t size() const { return entries.size(); };
+  [[nodiscard]] bool   empty() const { return entries.empty(); };
+  [[nodiscard]] bool   contains(const Key& key) const {
+    return entries.find(key) != entries.end();
+  };
+  [[nodiscard]] const Entry&       get_entry(const Key& key) const;
+  [[nodiscard]] size_t             get_hits(const Key& key) const {
+    return get_entry(key).hits;
+  };
+  [[nodiscard]] size_t             total_hits() const;
+  [[nodiscard]] const std::string& get_fingerprint() const {
+    return fingerprint;
+  };
+  [[nodiscard]] const std::vector<size_t>& get_train_signatures() const {
+    return train_signatures;
+  };
+  [[nodiscard]] const std::unordered_map<Key, Entry, KeyHash>&
+  get_entries() const {
+    return entries;
+  };
+
+  bool insert(const Key& key, const GRBLinExpr& expr, char sense);
+  void record_hit(const Key& key);
+  void clear() {
+    entries.clear();
+    fingerprint.clear();
+    train_signatures.clear();
+  };
+
+  void store_variable_names(const std::string&         fingerprint_input,
+                            const std::vector<size_t>& train_signatures_input);
+  void release_model();
+
+  size_t remove_outdated(const std::string&         fingerprint_input,
+                         const std::vector<size_t>& train_signatures_input);
+  size_t add_to_model(GRBModel&                  model,
+                      const std::string&         fingerprint_input,
+                      const std::vector<size_t>& train_signatures_input,
+                      int                        lazy_level);
+
+  [[nodiscard]] static double        get_violation(double value, char sense);
+  [[nodiscard]] static bool          is_violated(double value, char sense);
+  [[nodiscard]] static GRBTempConstr to_temp_constr(const GRBLinExpr& expr,
+                                                    char              sense);
+
+  void export_pool(const std::string& path) const {
+    export_pool(std::filesystem::path(path));
+  };
+  void export_pool(const char* path) const {
+    export_pool(std::filesystem::path(path));
+  };
+  void export_pool(const std::filesystem::path& p) const;
+
+  [[nodiscard]] static LazyConstraintPool import_pool(const std::string& path) {
+    return import_pool(std::filesystem::path(path));
+  };
+  [[nodiscard]] static LazyConstraintPool import_pool(const char* path) {
+    return import_pool(std::filesystem::path(path));
+  };
+  [[nodiscard]] static LazyConstraintPool
+  import_pool(const std::filesystem::path& p);
+};
+
+} // namespace cda_rail::solver::mip_based
@@ -2,6 +2,7 @@
 #include "Definitions.hpp"
 #include "GeneralMIPSolver.hpp"
 #include "VSSModel.hpp"
+#include "datastructure/TrainIntervalIndex.hpp"
 #include "gurobi_c++.h"
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 #include "probleminstances/VSSGenerationTimetable.hpp"
@@ -10,7 +11,9 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace cda_rail::solver::mip_based {
 
@@ -66,6 +69,8 @@ private:
   std::vector<std::vector<size_t>>       unbreakable_sections;
   std::vector<std::vector<size_t>>       no_border_vss_sections;
   std::vector<std::pair<size_t, size_t>> train_interval;
+  TrainIntervalIndex                     train_presence;
+  std::vector<std::vector<size_t>>       trains_at_time_step;
   std::vector<std::pair<std::optional<size_t>, std::optional<size_t>>>
                       breakable_edges_pairs;
   std::vector<size_t> no_border_vss_vertices;
@@ -86,11 +91,22 @@ private:
   bool                iterative_include_cuts_tmp = true;
   bool                postprocess                = false;
   ExportOption        export_option              = ExportOption::NoExport;
+  SolutionFormat      solution_format            = SolutionFormat::JSON;
   std::vector<size_t> max_vss_per_edge_in_iteration;
   std::unordered_map<size_t, size_t> breakable_edge_indices;
   std::vector<std::pair<std::vector<size_t>, std::vector<size_t>>>
       fwd_bwd_sections;
 
+  // Best objective bound of the last solve, -1 if not available
+  double obj_bound = -1;
+
+  // Warm start
+  std::optional<instances::SolVSSGenerationTimetable> warm_start_solution;
+  bool warm_start_use_hints = false;
+  // Trains whose positions are bounded around the warm start, see
+  // solve_coarse_to_fine
+  std::unordered_set<std::string> warm_start_bounded_trains;
+
   // Variable functions
   void create_variables();
   void create_general_variables();
@@ -159,6 +175,8 @@ private:
       const SolutionSettings& solution_settings);
   [[nodiscard]] std::vector<size_t>
                        unbreakable_section_indices(size_t train_index) const;
+  [[nodiscard]] std::vector<std::pair<size_t, size_t>>
+                       train_time_intervals(int end_offset) const;
   void                 calculate_fwd_bwd_sections();
   void                 calculate_fwd_bwd_sections_discretized();
   void                 calculate_fwd_bwd_sections_non_discretized();
@@ -196,16 +214,23 @@ private:
                   GRBLinExpr& cut_expr);
   void update_max_vss_on_edge(size_t relevant_edge_index, size_t new_max_vss,
                               GRBLinExpr& cut_expr);
+  size_t apply_warm_start();
+  size_t apply_warm_start_train_variables(size_t tr, size_t prior_tr);
+  size_t apply_warm_start_vss_variables();
+  void   set_warm_start_value(GRBVar& var, double value) const;
+  [[nodiscard]] std::unordered_set<std::string> trains_without_tight_headways(
+      const instances::SolVSSGenerationTimetable& sol) const;
+
   [[nodiscard]] std::optional<instances::VSSGenerationTimetable>
   initialize_variables(const ModelDetail&      model_detail,
                        const ModelSettings&    model_settings,
                        const SolverStrategy&   solver_strategy,
                        const SolutionSettings& solution_settings,
-                       int time_limit, bool debug_input);
+                       bool                    debug_input);
 
 protected:
-  void solve_init_vss_gen_timetable(int time_limit, bool debug_input) {
-    this->solve_init_general_mip(time_limit, debug_input);
+  void solve_init_vss_gen_timetable(bool debug_input) {
+    this->solve_init_general_mip(debug_input);
   };
 
 public:
@@ -229,6 +254,26 @@ public:
   solve(int time_limit, bool debug_input) override {
     return solve({}, {}, {}, {}, time_limit, debug_input);
   }
+
+  void
+  set_warm_start(const instances::SolVSSGenerationTimetable& prior_solution,
+                 bool use_hints = false);
+  void set_warm_start(const std::filesystem::path& prior_solution_path,
+                      bool                         use_hints = false);
+  void clear_warm_start() { warm_start_solution.reset(); };
+  [[nodiscard]] bool has_warm_start() const {
+    return warm_start_solution.has_value();
+  };
+
+  [[nodiscard]] double get_obj_bound() const { return obj_bound; };
+
+  [[nodiscard]] instances::SolVSSGenerationTimetable
+  solve_coarse_to_fine(const ModelDetail&      model_detail,
+                       const std::vector<int>& coarse_delta_t,
+                       const ModelSettings&    model_settings    = {},
+                       const SolverStrategy&   solver_strategy   = {},
+                       const SolutionSettings& solution_settings = {},
+                       int time_limit = -1, bool debug_input = false);
 };
 
 class VSSGenTimetableSolverWithMovingBlockInformation
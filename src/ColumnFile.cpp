@@ -0,0 +1,190 @@
+#include "ColumnFile.hpp"
+
+#include "CustomExceptions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr std::array<char, 7> MAGIC = {'C', 'D', 'A', 'C', 'O', 'L', '\0'};
+
+constexpr uint8_t  VERSION           = 1;
+constexpr uint8_t  ZERO_DELTA        = 0x80;
+constexpr size_t   BYTES_PER_DOUBLE  = 8;
+constexpr size_t   BITS_PER_BYTE     = 8;
+constexpr uint64_t BYTE_MASK         = 0xFF;
+constexpr uint8_t  CONTROL_HIGH_BITS = 4;
+constexpr uint8_t  CONTROL_LOW_MASK  = 0x0F;
+} // namespace
+
+cda_rail::ColumnFileWriter::ColumnFileWriter(const std::filesystem::path& p)
+    : file(p, std::ios::binary) {
+  if (!file.is_open()) {
+    throw exceptions::ExportException("Could not open file " + p.string());
+  }
+  file.write(MAGIC.data(), MAGIC.size());
+  write_bytes(VERSION, 1);
+}
+
+void cda_rail::ColumnFileWriter::write_bytes(uint64_t val, size_t num_bytes) {
+  for (size_t i = 0; i < num_bytes; ++i) {
+    file.put(static_cast<char>((val >> (BITS_PER_BYTE * i)) & BYTE_MASK));
+  }
+}
+
+void cda_rail::ColumnFileWriter::write_size(size_t val) {
+  write_bytes(static_cast<uint64_t>(val), sizeof(uint64_t));
+}
+
+void cda_rail::ColumnFileWriter::write_int(int64_t val) {
+  write_bytes(static_cast<uint64_t>(val), sizeof(uint64_t));
+}
+
+void cda_rail::ColumnFileWriter::write_bool(bool val) {
+  write_bytes(val ? 1 : 0, 1);
+}
+
+void cda_rail::ColumnFileWriter::write_string(const std::string& val) {
+  write_size(val.size());
+  file.write(val.data(), static_cast<std::streamsize>(val.size()));
+}
+
+void cda_rail::ColumnFileWriter::write_column(
+    const std::vector<double>& column) {
+  /**
+   * Writes the number of values followed by one control byte per value and
+   * the non-zero bytes of the XOR with the previous value. The upper four bits
+   * of the control byte are the number of leading zero bytes, the lower four
+   * bits the number of trailing zero bytes. A XOR of zero is written as
+   * ZERO_DELTA without any further bytes.
+   */
+
+  write_size(column.size());
+  uint64_t prev = 0;
+  for (const auto val : column) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &val, sizeof(bits));
+    const auto delta = bits ^ prev;
+    prev             = bits;
+    if (delta == 0) {
+      write_bytes(ZERO_DELTA, 1);
+      continue;
+    }
+
+    size_t leading = 0;
+    while (((delta >> (BITS_PER_BYTE * (BYTES_PER_DOUBLE - 1 - leading))) &
+            BYTE_MASK) == 0) {
+      leading++;
+    }
+    size_t trailing = 0;
+    while (((delta >> (BITS_PER_BYTE * trailing)) & BYTE_MASK) == 0) {
+      trailing++;
+    }
+    write_bytes((leading << CONTROL_HIGH_BITS) | trailing, 1);
+    write_bytes(delta >> (BITS_PER_BYTE * trailing),
+                BYTES_PER_DOUBLE - leading - trailing);
+  }
+}
+
+void cda_rail::ColumnFileWriter::close() {
+  file.close();
+  if (file.fail()) {
+    throw exceptions::ExportException("Could not write column file");
+  }
+}
+
+cda_rail::ColumnFileReader::ColumnFileReader(const std::filesystem::path& p)
+    : file(p, std::ios::binary) {
+  if (!file.is_open()) {
+    throw exceptions::ImportException("Could not open file " + p.string());
+  }
+  file_size = std::filesystem::file_size(p);
+  std::array<char, MAGIC.size()> magic{};
+  file.read(magic.data(), magic.size());
+  if (!file || magic != MAGIC) {
+    throw exceptions::ImportException(p.string() + " is not a column file");
+  }
+  if (read_bytes(1) != VERSION) {
+    throw exceptions::ImportException("Unsupported version of column file " +
+                                      p.string());
+  }
+}
+
+uint64_t cda_rail::ColumnFileReader::read_bytes(size_t num_bytes) {
+  uint64_t val = 0;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    const auto byte = file.get();
+    if (byte == std::char_traits<char>::eof()) {
+      throw exceptions::ImportException("Unexpected end of column file");
+    }
+    val |= (static_cast<uint64_t>(byte) & BYTE_MASK) << (BITS_PER_BYTE * i);
+  }
+  return val;
+}
+
+uint64_t cda_rail::ColumnFileReader::remaining_bytes() {
+  const auto pos = file.tellg();
+  if (pos < 0) {
+    throw exceptions::ImportException("Could not read column file");
+  }
+  return static_cast<uint64_t>(file_size - static_cast<uintmax_t>(pos));
+}
+
+size_t cda_rail::ColumnFileReader::read_size() {
+  return static_cast<size_t>(read_bytes(sizeof(uint64_t)));
+}
+
+int64_t cda_rail::ColumnFileReader::read_int() {
+  return static_cast<int64_t>(read_bytes(sizeof(uint64_t)));
+}
+
+bool cda_rail::ColumnFileReader::read_bool() { return read_bytes(1) != 0; }
+
+std::string cda_rail::ColumnFileReader::read_string() {
+  const auto size = read_size();
+  if (size > remaining_bytes()) {
+    throw exceptions::ImportException("Unexpected end of column file");
+  }
+  std::string val(size, '\0');
+  file.read(val.data(), static_cast<std::streamsize>(val.size()));
+  if (!file) {
+    throw exceptions::ImportException("Unexpected end of column file");
+  }
+  return val;
+}
+
+std::vector<double> cda_rail::ColumnFileReader::read_column() {
+  /**
+   * Reads a column written by ColumnFileWriter::write_column.
+   */
+
+  const auto size = read_size();
+  // Every value takes at least its control byte
+  if (size > remaining_bytes()) {
+    throw exceptions::ImportException("Unexpected end of column file");
+  }
+  std::vector<double> column;
+  column.reserve(size);
+  uint64_t prev = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const auto control = read_bytes(1);
+    if (control != ZERO_DELTA) {
+      const auto leading  = static_cast<size_t>(control >> CONTROL_HIGH_BITS);
+      const auto trailing = static_cast<size_t>(control & CONTROL_LOW_MASK);
+      if (leading + trailing >= BYTES_PER_DOUBLE) {
+        throw exceptions::ImportException("Invalid value in column file");
+      }
+      prev ^= read_bytes(BYTES_PER_DOUBLE - leading - trailing)
+              << (BITS_PER_BYTE * trailing);
+    }
+    double val = 0;
+    std::memcpy(&val, &prev, sizeof(val));
+    column.push_back(val);
+  }
+  return column;
+}
@@ -0,0 +1,123 @@
+#include "EdgePairsSaxParser.hpp"
+
+#include "CustomExceptions.hpp"
+#include "nlohmann/json.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+void cda_rail::EdgePairsSaxParser::parse(const std::filesystem::path& p,
+                                         KeyCallback                  on_key,
+                                         PairCallback                 on_pair) {
+  /**
+   * Parses the file at path p and calls the callbacks for every key and every
+   * pair of vertex names in the order they appear in the file.
+   *
+   * @param p Path to the json file
+   * @param on_key Called with the key whenever a new key is read
+   * @param on_pair Called with the current key and both vertex names of every
+   * pair
+   */
+
+  std::ifstream file(p);
+  if (!file.is_open()) {
+    throw exceptions::ImportException("Could not open file " + p.string());
+  }
+  EdgePairsSaxParser parser(std::move(on_key), std::move(on_pair));
+  nlohmann::json::sax_parse(file, &parser);
+}
+
+void cda_rail::EdgePairsSaxParser::throw_unexpected(const std::string& what) {
+  throw exceptions::ImportException("Unexpected " + what +
+                                    " in file of vertex pairs");
+}
+
+bool cda_rail::EdgePairsSaxParser::null() {
+  if (depth != 0) {
+    throw_unexpected("null");
+  }
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::boolean(bool /*val*/) {
+  throw_unexpected("boolean");
+}
+
+bool cda_rail::EdgePairsSaxParser::number_integer(number_integer_t /*val*/) {
+  throw_unexpected("number");
+}
+
+bool cda_rail::EdgePairsSaxParser::number_unsigned(
+    number_unsigned_t /*val*/) {
+  throw_unexpected("number");
+}
+
+bool cda_rail::EdgePairsSaxParser::number_float(number_float_t /*val*/,
+                                                const string_t& /*s*/) {
+  throw_unexpected("number");
+}
+
+bool cda_rail::EdgePairsSaxParser::string(string_t& val) {
+  if (depth != 3 || num_vertices >= 2) {
+    throw_unexpected("string " + val);
+  }
+  if (num_vertices == 0) {
+    current_v_0 = std::move(val);
+  } else {
+    current_v_1 = std::move(val);
+  }
+  num_vertices++;
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::binary(binary_t& /*val*/) {
+  throw_unexpected("binary value");
+}
+
+bool cda_rail::EdgePairsSaxParser::start_object(std::size_t /*elements*/) {
+  if (depth != 0) {
+    throw_unexpected("object");
+  }
+  depth++;
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::key(string_t& val) {
+  current_key = std::move(val);
+  on_key(current_key);
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::end_object() {
+  depth--;
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::start_array(std::size_t /*elements*/) {
+  if (depth != 1 && depth != 2) {
+    throw_unexpected("array");
+  }
+  depth++;
+  num_vertices = 0;
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::end_array() {
+  if (depth == 3) {
+    if (num_vertices != 2) {
+      throw_unexpected("number of vertices");
+    }
+    on_pair(current_key, current_v_0, current_v_1);
+  }
+  depth--;
+  return true;
+}
+
+bool cda_rail::EdgePairsSaxParser::parse_error(
+    std::size_t /*position*/, const std::string& /*last_token*/,
+    const nlohmann::detail::exception& ex) {
+  throw exceptions::ImportException(ex.what());
+}
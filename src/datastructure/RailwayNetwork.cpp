@@ -2,6 +2,7 @@
 
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
+#include "EdgePairsSaxParser.hpp"
 #include "MultiArray.hpp"
 #include "nlohmann/json.hpp"
 
@@ -216,20 +217,20 @@ void cda_rail::Network::read_successors(const std::filesystem::path& p) {
    * @param path Path to successors file
    */
 
-  std::ifstream f((p / "successors_cpp.json"));
-  json          data = json::parse(f);
-
-  for (const auto& [key, val] : data.items()) {
-    std::string source_name;
-    std::string target_name;
-    extract_vertices_from_key(key, source_name, target_name);
-    auto const edge_id_in = get_edge_index(source_name, target_name);
-    for (auto& tuple : val) {
-      auto const edge_id_out = get_edge_index(tuple[0].get<std::string>(),
-                                              tuple[1].get<std::string>());
-      add_successor(edge_id_in, edge_id_out);
-    }
-  }
+  size_t edge_id_in = 0;
+  EdgePairsSaxParser::parse(
+      p / "successors_cpp.json",
+      [this, &edge_id_in](const std::string& key) {
+        std::string source_name;
+        std::string target_name;
+        extract_vertices_from_key(key, source_name, target_name);
+        edge_id_in = get_edge_index(source_name, target_name);
+      },
+      [this, &edge_id_in](const std::string& /*key*/,
+                          const std::string& source_name,
+                          const std::string& target_name) {
+        add_successor(edge_id_in, get_edge_index(source_name, target_name));
+      });
 }
 
 size_t cda_rail::Network::add_vertex(const std::string& name, VertexType type,
@@ -246,6 +247,7 @@ size_t cda_rail::Network::add_vertex(const std::string& name, VertexType type,
     throw exceptions::InvalidInputException("Vertex already exists");
   }
   vertices.emplace_back(name, type, headway);
+  edge_index_by_vertices.emplace_back();
   vertex_name_to_index[name] = vertices.size() - 1;
   return vertex_name_to_index[name];
 }
@@ -280,9 +282,25 @@ size_t cda_rail::Network::add_edge(size_t source, size_t target, double length,
   edges.emplace_back(source, target, length, max_speed, breakable,
                      min_block_length, min_stop_block_length);
   successors.emplace_back();
+  edge_index_by_vertices[source][target] = edges.size() - 1;
   return edges.size() - 1;
 }
 
+void cda_rail::Network::change_edge_source(size_t edge_index,
+                                           size_t new_source) {
+  /**
+   * Changes the source vertex of an edge and keeps the edge index up to date.
+   *
+   * @param edge_index Index of edge
+   * @param new_source Index of new source vertex
+   */
+
+  auto& edge = edges[edge_index];
+  edge_index_by_vertices[edge.source].erase(edge.target);
+  edge.source                                     = new_source;
+  edge_index_by_vertices[new_source][edge.target] = edge_index;
+}
+
 void cda_rail::Network::add_successor(size_t edge_in, size_t edge_out) {
   /**
    * Add successor to edge, but only if the edges are adjacent to each other
@@ -393,12 +411,12 @@ size_t cda_rail::Network::get_edge_index(size_t source_id,
   if (!has_vertex(target_id)) {
     throw exceptions::VertexNotExistentException(target_id);
   }
-  for (size_t i = 0; i < edges.size(); i++) {
-    if (edges[i].source == source_id && edges[i].target == target_id) {
-      return i;
-    }
+  const auto& out_edges = edge_index_by_vertices[source_id];
+  const auto  it        = out_edges.find(target_id);
+  if (it == out_edges.end()) {
+    throw exceptions::EdgeNotExistentException(source_id, target_id);
   }
-  throw exceptions::EdgeNotExistentException(source_id, target_id);
+  return it->second;
 }
 
 bool cda_rail::Network::has_edge(size_t source_id, size_t target_id) const {
@@ -416,10 +434,7 @@ bool cda_rail::Network::has_edge(size_t source_id, size_t target_id) const {
   if (!has_vertex(target_id)) {
     throw exceptions::VertexNotExistentException(target_id);
   }
-  return std::any_of(
-      edges.begin(), edges.end(), [source_id, target_id](const Edge& edge) {
-        return edge.source == source_id && edge.target == target_id;
-      });
+  return edge_index_by_vertices[source_id].count(target_id) > 0;
 }
 
 bool cda_rail::Network::has_edge(const std::string& source_name,
@@ -471,6 +486,7 @@ void cda_rail::Network::change_edge_length(size_t index, double new_length) {
     throw exceptions::EdgeNotExistentException(index);
   }
   edges[index].length = new_length;
+  edge_length_version++;
 }
 
 void cda_rail::Network::change_edge_max_speed(size_t index,
@@ -984,7 +1000,7 @@ cda_rail::Network::separate_edge_at(
   if (!new_edge_breakable) {
     set_edge_unbreakable(edge_index);
   }
-  edges[edge_index].source = new_vertices.back();
+  change_edge_source(edge_index, new_vertices.back());
   new_edges.emplace_back(edge_index);
 
   // Update successors, i.e.,
@@ -1034,7 +1050,7 @@ cda_rail::Network::separate_edge_at(
     if (!new_edge_breakable) {
       set_edge_unbreakable(reverse_edge_index);
     }
-    edges[reverse_edge_index].source = new_vertices.front();
+    change_edge_source(reverse_edge_index, new_vertices.front());
     new_reverse_edges.emplace_back(reverse_edge_index);
 
     for (const auto& incoming_edge_index : in_edges(edge.target)) {
@@ -2122,3 +2138,70 @@ cda_rail::Network::shortest_path_using_edges(
 
   return {std::nullopt, {}};
 }
+
+std::vector<double> cda_rail::Network::shortest_path_distances(
+    const std::vector<size_t>&                 sources,
+    const std::unordered_set<size_t>&          usable_edges,
+    const std::function<double(const Edge&)>& edge_weight,
+    bool                                       forward) const {
+  /**
+   * Overload of the predicate version using only the edges in usable_edges.
+   */
+
+  return shortest_path_distances(
+      sources,
+      [&usable_edges](size_t e) { return usable_edges.count(e) > 0; },
+      edge_weight, forward);
+}
+
+std::vector<double> cda_rail::Network::shortest_path_distances(
+    const std::vector<size_t>&                 sources,
+    const std::function<bool(size_t)>&         is_usable,
+    const std::function<double(const Edge&)>& edge_weight,
+    bool                                       forward) const {
+  /**
+   * Calculates the shortest distance from any of the source vertices to every
+   * vertex (if forward is true) or from every vertex to any of the source
+   * vertices (otherwise) using Dijkstra's algorithm. Only edges e with
+   * is_usable(e) are used, weighted by edge_weight, which must be
+   * non-negative. Successor relations are not considered. Unreachable
+   * vertices have infinite distance.
+   */
+
+  std::vector<double> distances(number_of_vertices(),
+                                std::numeric_limits<double>::infinity());
+  // Priority queue where the element with the smallest .first is returned
+  std::priority_queue<std::pair<double, size_t>,
+                      std::vector<std::pair<double, size_t>>, std::greater<>>
+      pq;
+  for (const auto v : sources) {
+    if (!has_vertex(v)) {
+      throw exceptions::VertexNotExistentException(v);
+    }
+    distances[v] = 0;
+    pq.emplace(0, v);
+  }
+
+  while (!pq.empty()) {
+    const auto [dist, u] = pq.top();
+    pq.pop();
+    if (dist > distances[u]) {
+      // Relict from later update due to shorter path
+      continue;
+    }
+    for (const auto e : forward ? out_edges(u) : in_edges(u)) {
+      if (!is_usable(e)) {
+        continue;
+      }
+      const auto& edge   = get_edge(e);
+      const auto  w      = forward ? edge.target : edge.source;
+      const auto  dist_w = dist + edge_weight(edge);
+      if (dist_w < distances[w]) {
+        distances[w] = dist_w;
+        pq.emplace(dist_w, w);
+      }
+    }
+  }
+
+  return distances;
+}
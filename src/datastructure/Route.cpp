@@ -2,10 +2,17 @@
 
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
+#include "EdgePairsSaxParser.hpp"
 #include "datastructure/RailwayNetwork.hpp"
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -27,6 +34,14 @@ void cda_rail::Route::push_back_edge(size_t         edge_index,
     throw exceptions::ConsistencyException("Edge is not a valid successor.");
   }
   edges.emplace_back(edge_index);
+  if (edge_length_version == network.get_edge_length_version()) {
+    cumulative_lengths.emplace_back(
+        (cumulative_lengths.empty() ? 0.0 : cumulative_lengths.back()) +
+        network.get_edge(edge_index).length);
+  } else {
+    update_cumulative_lengths(network);
+  }
+  edge_route_index.try_emplace(edge_index, edges.size() - 1);
 }
 
 void cda_rail::Route::push_front_edge(size_t         edge_index,
@@ -48,6 +63,8 @@ void cda_rail::Route::push_front_edge(size_t         edge_index,
     throw exceptions::ConsistencyException("Edge is not a valid predecessor.");
   }
   edges.insert(edges.begin(), edge_index);
+  update_cumulative_lengths(network);
+  update_edge_route_index();
 }
 
 void cda_rail::Route::remove_first_edge() {
@@ -59,7 +76,13 @@ void cda_rail::Route::remove_first_edge() {
   if (edges.empty()) {
     throw exceptions::ConsistencyException("Route is empty.");
   }
+  const auto first_length = cumulative_lengths.front();
   edges.erase(edges.begin());
+  cumulative_lengths.erase(cumulative_lengths.begin());
+  for (auto& cum_length : cumulative_lengths) {
+    cum_length -= first_length;
+  }
+  update_edge_route_index();
 }
 
 void cda_rail::Route::remove_last_edge() {
@@ -72,6 +95,8 @@ void cda_rail::Route::remove_last_edge() {
     throw exceptions::ConsistencyException("Route is empty.");
   }
   edges.pop_back();
+  cumulative_lengths.pop_back();
+  update_edge_route_index();
 }
 
 size_t cda_rail::Route::get_edge(size_t route_index) const {
@@ -132,26 +157,66 @@ bool cda_rail::Route::check_consistency(const Network& network) const {
 double cda_rail::Route::length(const Network& network) const {
   /***
    * Returns the length of the route, i.e., the sum of the lengths of all edges.
-   * Throws an error if an edge does not exist in the network.
+   * The sum is kept up to date when changing the route, hence, this is done in
+   * constant time.
    *
    * @param network The network to which the route belongs.
    * @return The length of the route.
    */
 
-  return std::accumulate(edges.begin(), edges.end(), 0.0,
-                         [&network](double sum, size_t edge) {
-                           return sum + network.get_edge(edge).length;
-                         });
+  if (edges.empty()) {
+    return 0;
+  }
+  check_edge_length_version(network);
+  return cumulative_lengths.back();
+}
+
+void cda_rail::Route::update_cumulative_lengths(const Network& network) {
+  cumulative_lengths.clear();
+  cumulative_lengths.reserve(edges.size());
+  double sum = 0;
+  for (const auto edge : edges) {
+    sum += network.get_edge(edge).length;
+    cumulative_lengths.push_back(sum);
+  }
+  edge_length_version = network.get_edge_length_version();
+}
+
+void cda_rail::Route::check_edge_length_version(const Network& network) const {
+  /**
+   * Throws a ConsistencyException if the cached lengths were computed before
+   * the last change of an edge length of the network, i.e., if
+   * update_edge_lengths has not been called after changing the network.
+   *
+   * @param network The network to which the route belongs.
+   */
+
+  if (!edges.empty() &&
+      edge_length_version != network.get_edge_length_version()) {
+    throw exceptions::ConsistencyException(
+        "Cached route lengths are outdated, call update_edge_lengths after "
+        "changing edge lengths.");
+  }
+}
+
+void cda_rail::Route::update_edge_route_index() {
+  edge_route_index.clear();
+  edge_route_index.reserve(edges.size());
+  for (size_t i = 0; i < edges.size(); i++) {
+    edge_route_index.try_emplace(edges[i], i);
+  }
 }
 
 void cda_rail::Route::update_after_discretization(
-    const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges) {
+    const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges,
+    const Network&                                             network) {
   /**
    * This method updates the route after the discretization of the network
    * accordingly. For every pair (v, {v_1, ..., v_n}), v is replaced by v_1,
    * ..., v_n.
    *
    * @param new_edges The new edges of the network.
+   * @param network The discretized network.
    */
 
   std::vector<size_t> edges_updated;
@@ -171,6 +236,8 @@ void cda_rail::Route::update_after_discretization(
   }
 
   edges = std::move(edges_updated);
+  update_cumulative_lengths(network);
+  update_edge_route_index();
 }
 
 std::pair<double, double>
@@ -188,22 +255,15 @@ cda_rail::Route::edge_pos(size_t edge, const Network& network) const {
     throw exceptions::EdgeNotExistentException(edge);
   }
 
-  std::pair<double, double> return_pos = {0, 0};
-  bool                      edge_found = false;
-  for (const auto i : edges) {
-    return_pos.second += network.get_edge(i).length;
-    if (i == edge) {
-      edge_found = true;
-      break;
-    }
-    return_pos.first += network.get_edge(i).length;
-  }
-
-  if (!edge_found) {
+  const auto it = edge_route_index.find(edge);
+  if (it == edge_route_index.end()) {
     throw exceptions::ConsistencyException("Edge does not exist in route.");
   }
 
-  return return_pos;
+  check_edge_length_version(network);
+  const auto route_index = it->second;
+  return {route_index == 0 ? 0.0 : cumulative_lengths[route_index - 1],
+          cumulative_lengths[route_index]};
 }
 
 std::pair<double, double>
@@ -249,15 +309,20 @@ cda_rail::Route::get_edge_at_pos(double                   pos,
     throw exceptions::InvalidInputException("Position must be non-negative.");
   }
 
-  double current_pos = 0;
-  for (const auto& edge : edges) {
-    const auto edge_length = network.get_edge(edge).length;
-    if (current_pos + edge_length > pos) {
-      return edge;
-    }
-    current_pos += edge_length;
+  if (edges.empty()) {
+    throw exceptions::ConsistencyException("Position is not on the route.");
+  }
+
+  check_edge_length_version(network);
+
+  // First edge ending after pos
+  const auto it = std::upper_bound(cumulative_lengths.begin(),
+                                   cumulative_lengths.end(), pos);
+  if (it != cumulative_lengths.end()) {
+    return edges[static_cast<size_t>(
+        std::distance(cumulative_lengths.begin(), it))];
   }
-  if (std::abs(current_pos - pos) < GRB_EPS) {
+  if (std::abs(cumulative_lengths.back() - pos) < GRB_EPS) {
     return edges.back();
   }
   throw exceptions::ConsistencyException("Position is not on the route.");
@@ -271,10 +336,11 @@ void cda_rail::RouteMap::add_empty_route(const std::string& train_name) {
    * @param train_name The name of the train.
    */
 
-  if (routes.find(train_name) != routes.end()) {
+  if (has_route(train_name)) {
     throw exceptions::InvalidInputException("Train already has a route.");
   }
-  routes[train_name] = Route();
+  route_name_to_index[train_name] = routes.size();
+  routes.emplace_back(train_name, Route());
 }
 
 void cda_rail::RouteMap::add_empty_route(const std::string& train_name,
@@ -302,10 +368,7 @@ void cda_rail::RouteMap::remove_first_edge(const std::string& train_name) {
    * @param train_name The name of the train.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].remove_first_edge();
+  editable_route(train_name).remove_first_edge();
 }
 
 void cda_rail::RouteMap::remove_last_edge(const std::string& train_name) {
@@ -316,10 +379,7 @@ void cda_rail::RouteMap::remove_last_edge(const std::string& train_name) {
    * @param train_name The name of the train.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].remove_last_edge();
+  editable_route(train_name).remove_last_edge();
 }
 
 const cda_rail::Route&
@@ -333,10 +393,47 @@ cda_rail::RouteMap::get_route(const std::string& train_name) const {
    * @return The route of the given train.
    */
 
-  if (routes.find(train_name) == routes.end()) {
+  return get_route(get_route_index(train_name));
+}
+
+size_t
+cda_rail::RouteMap::get_route_index(const std::string& train_name) const {
+  /**
+   * Returns the index of the route of the given train within the route map.
+   * Indices are dense and assigned in the order in which the routes are added.
+   * Throws an error if the train does not have a route.
+   *
+   * @param train_name The name of the train.
+   *
+   * @return The index of the route of the given train.
+   */
+
+  const auto it = route_name_to_index.find(train_name);
+  if (it == route_name_to_index.end()) {
     throw exceptions::ConsistencyException("Train does not have a route.");
   }
-  return routes.at(train_name);
+  return it->second;
+}
+
+const cda_rail::Route&
+cda_rail::RouteMap::get_route(size_t route_index) const {
+  /**
+   * Returns the route with the given index as returned by get_route_index.
+   *
+   * @param route_index The index of the route.
+   *
+   * @return The route with the given index.
+   */
+
+  if (route_index >= routes.size()) {
+    throw exceptions::ConsistencyException("Route index out of range.");
+  }
+  return routes[route_index].second;
+}
+
+cda_rail::Route&
+cda_rail::RouteMap::editable_route(const std::string& train_name) {
+  return routes[get_route_index(train_name)].second;
 }
 
 bool cda_rail::RouteMap::check_consistency(
@@ -410,10 +507,25 @@ void cda_rail::RouteMap::push_back_edge(const std::string& train_name,
    * @param network The network to which the routes belong.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
+  editable_route(train_name).push_back_edge(edge_index, network);
+}
+
+void cda_rail::RouteMap::push_back_edge(size_t         route_index,
+                                        size_t         edge_index,
+                                        const Network& network) {
+  /**
+   * Adds the edge to the end of the route with the given index as returned by
+   * get_route_index.
+   *
+   * @param route_index The index of the route.
+   * @param edge_index The index of the edge in the network.
+   * @param network The network to which the routes belong.
+   */
+
+  if (route_index >= routes.size()) {
+    throw exceptions::ConsistencyException("Route index out of range.");
   }
-  routes[train_name].push_back_edge(edge_index, network);
+  routes[route_index].second.push_back_edge(edge_index, network);
 }
 
 void cda_rail::RouteMap::push_back_edge(const std::string& train_name,
@@ -429,10 +541,7 @@ void cda_rail::RouteMap::push_back_edge(const std::string& train_name,
    * @param network The network to which the routes belong.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].push_back_edge(source, target, network);
+  editable_route(train_name).push_back_edge(source, target, network);
 }
 
 void cda_rail::RouteMap::push_back_edge(const std::string& train_name,
@@ -449,10 +558,7 @@ void cda_rail::RouteMap::push_back_edge(const std::string& train_name,
    * @param network The network to which the routes belong.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].push_back_edge(source, target, network);
+  editable_route(train_name).push_back_edge(source, target, network);
 }
 
 void cda_rail::RouteMap::push_front_edge(const std::string& train_name,
@@ -467,10 +573,7 @@ void cda_rail::RouteMap::push_front_edge(const std::string& train_name,
    * @param network The network to which the routes belong.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].push_front_edge(edge_index, network);
+  editable_route(train_name).push_front_edge(edge_index, network);
 }
 
 void cda_rail::RouteMap::push_front_edge(const std::string& train_name,
@@ -486,10 +589,7 @@ void cda_rail::RouteMap::push_front_edge(const std::string& train_name,
    * @param network The network to which the routes belong.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].push_front_edge(source, target, network);
+  editable_route(train_name).push_front_edge(source, target, network);
 }
 
 void cda_rail::RouteMap::push_front_edge(const std::string& train_name,
@@ -506,10 +606,7 @@ void cda_rail::RouteMap::push_front_edge(const std::string& train_name,
    * @param network The network to which the routes belong.
    */
 
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
-  }
-  routes[train_name].push_front_edge(source, target, network);
+  editable_route(train_name).push_front_edge(source, target, network);
 }
 
 cda_rail::RouteMap::RouteMap(const std::filesystem::path& p,
@@ -531,16 +628,13 @@ cda_rail::RouteMap::RouteMap(const std::filesystem::path& p,
     throw exceptions::ImportException("Path is not a directory.");
   }
 
-  std::ifstream file(p / "routes.json");
-  json          data = json::parse(file);
-
-  for (const auto& [name, route] : data.items()) {
-    this->add_empty_route(name);
-    for (auto& edge : route) {
-      this->push_back_edge(name, edge[0].get<std::string>(),
-                           edge[1].get<std::string>(), network);
-    }
-  }
+  EdgePairsSaxParser::parse(
+      p / "routes.json",
+      [this](const std::string& name) { this->add_empty_route(name); },
+      [this, &network](const std::string& name, const std::string& source,
+                       const std::string& target) {
+        this->push_back_edge(name, source, target, network);
+      });
 }
 
 double cda_rail::RouteMap::length(const std::string& train_name,
@@ -558,23 +652,48 @@ double cda_rail::RouteMap::length(const std::string& train_name,
 }
 
 void cda_rail::RouteMap::update_after_discretization(
-    const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges) {
+    const std::vector<std::pair<size_t, std::vector<size_t>>>& new_edges,
+    const Network&                                             network) {
   /**
    * This method updates the routes after the discretization of the network
    * accordingly. For every pair (v, {v_1, ..., v_n}), v is replaced by v_1,
    * ..., v_n.
    *
    * @param new_edges The new edges of the network.
+   * @param network The discretized network.
    */
 
   for (auto& [train_name, route] : routes) {
-    route.update_after_discretization(new_edges);
+    route.update_after_discretization(new_edges, network);
   }
 }
 
 void cda_rail::RouteMap::remove_route(const std::string& train_name) {
-  if (routes.find(train_name) == routes.end()) {
-    throw exceptions::ConsistencyException("Train does not have a route.");
+  /**
+   * Removes the route of the given train. The indices of all routes added
+   * afterwards decrease by one.
+   * Throws an error if the train does not have a route.
+   *
+   * @param train_name The name of the train.
+   */
+
+  const auto route_index = get_route_index(train_name);
+  routes.erase(routes.begin() + static_cast<std::ptrdiff_t>(route_index));
+  route_name_to_index.erase(train_name);
+  for (size_t i = route_index; i < routes.size(); ++i) {
+    route_name_to_index[routes[i].first] = i;
+  }
+}
+
+void cda_rail::RouteMap::update_edge_lengths(const Network& network) {
+  /**
+   * Updates the lengths cached by all routes. Has to be called after changing
+   * edge lengths of the network, e.g., via Network::change_edge_length.
+   *
+   * @param network The network to which the routes belong.
+   */
+
+  for (auto& route : routes) {
+    route.second.update_edge_lengths(network);
   }
-  routes.erase(train_name);
 }
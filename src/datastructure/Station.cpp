@@ -2,9 +2,11 @@
 
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
+#include "EdgePairsSaxParser.hpp"
 #include "datastructure/RailwayNetwork.hpp"
 #include "nlohmann/json.hpp"
 
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -12,19 +14,62 @@
 
 using json = nlohmann::json;
 
-const cda_rail::Station&
-cda_rail::StationList::get_station(const std::string& name) const {
+size_t cda_rail::StationList::add_station(const std::string& name) {
+  /**
+   * Adds an empty station with the given name. If the station already exists,
+   * its tracks are removed.
+   *
+   * @param name The name of the station.
+   *
+   * @return The index of the station.
+   */
+
+  const auto it = station_name_to_index.find(name);
+  if (it != station_name_to_index.end()) {
+    stations[it->second].second = Station{name};
+    return it->second;
+  }
+  station_name_to_index[name] = stations.size();
+  stations.emplace_back(name, Station{name});
+  return stations.size() - 1;
+}
+
+size_t
+cda_rail::StationList::get_station_index(const std::string& name) const {
   /**
-   * Returns the station with the given name.
+   * Returns the index of the station with the given name.
    *
    * @param name The name of the station.
    *
-   * @return The station with the given name.
+   * @return The index of the station with the given name.
    */
-  if (!has_station(name)) {
+
+  const auto it = station_name_to_index.find(name);
+  if (it == station_name_to_index.end()) {
     throw exceptions::StationNotExistentException(name);
   }
-  return stations.at(name);
+  return it->second;
+}
+
+const cda_rail::Station&
+cda_rail::StationList::get_station(size_t index) const {
+  /**
+   * Returns the station with the given index.
+   *
+   * @param index The index of the station.
+   *
+   * @return The station with the given index.
+   */
+
+  if (!has_station(index)) {
+    throw exceptions::StationNotExistentException(index);
+  }
+  return stations[index].second;
+}
+
+cda_rail::Station&
+cda_rail::StationList::editable_station(const std::string& name) {
+  return stations[get_station_index(name)].second;
 }
 
 void cda_rail::StationList::add_track_to_station(const std::string& name,
@@ -35,17 +80,13 @@ void cda_rail::StationList::add_track_to_station(const std::string& name,
    * @param name The name of the station.
    * @param track The index of the track to add.
    */
-  if (!has_station(name)) {
-    throw exceptions::StationNotExistentException(name);
-  }
+  auto& tracks = editable_station(name).tracks;
 
-  // If stations.at(name).tracks already contains track, nothing happens.
-  if (std::find(stations.at(name).tracks.begin(),
-                stations.at(name).tracks.end(),
-                track) != stations.at(name).tracks.end()) {
+  // If tracks already contains track, nothing happens.
+  if (std::find(tracks.begin(), tracks.end(), track) != tracks.end()) {
     return;
   }
-  stations.at(name).tracks.emplace_back(track);
+  tracks.emplace_back(track);
 }
 
 void cda_rail::StationList::export_stations(const std::string& path,
@@ -95,8 +136,8 @@ void cda_rail::StationList::export_stations(const std::filesystem::path& p,
 
 std::vector<std::string> cda_rail::StationList::get_station_names() const {
   /**
-   * This method returns a vector of all station names, i.e., the keys of
-   * stations.
+   * This method returns a vector of all station names ordered by their
+   * indices.
    *
    * @return A vector of all station names.
    */
@@ -127,16 +168,13 @@ cda_rail::StationList::StationList(const std::filesystem::path& p,
     throw exceptions::ImportException("Path is not a directory.");
   }
 
-  std::ifstream file(p / "stations.json");
-  json          data = json::parse(file);
-
-  for (const auto& [name, edges] : data.items()) {
-    this->add_station(name);
-    for (const auto& edge : edges) {
-      this->add_track_to_station(name, edge[0].get<std::string>(),
-                                 edge[1].get<std::string>(), network);
-    }
-  }
+  EdgePairsSaxParser::parse(
+      p / "stations.json",
+      [this](const std::string& name) { this->add_station(name); },
+      [this, &network](const std::string& name, const std::string& source,
+                       const std::string& target) {
+        this->add_track_to_station(name, source, target, network);
+      });
 }
 
 void cda_rail::StationList::update_after_discretization(
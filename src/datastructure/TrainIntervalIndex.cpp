@@ -0,0 +1,242 @@
+#include "datastructure/TrainIntervalIndex.hpp"
+
+#include "CustomExceptions.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace {
+int ceil_div(int a, int b) {
+  // Rounds a / b up for b > 0, also if a is negative
+  return a / b + (a % b > 0 ? 1 : 0);
+}
+} // namespace
+
+cda_rail::TrainIntervalIndex::TrainIntervalIndex(
+    std::vector<std::pair<int, int>> intervals)
+    : intervals(std::move(intervals)) {
+  /**
+   * Builds the index.
+   *
+   * @param intervals: for every train (by index) the interval [t_0, t_n) in
+   * which it is present
+   */
+
+  for (size_t tr = 0; tr < this->intervals.size(); tr++) {
+    if (this->intervals.at(tr).first < this->intervals.at(tr).second) {
+      trains_by_start.push_back(tr);
+    }
+  }
+  std::stable_sort(trains_by_start.begin(), trains_by_start.end(),
+                   [this](size_t tr1, size_t tr2) {
+                     return this->intervals.at(tr1).first <
+                            this->intervals.at(tr2).first;
+                   });
+
+  build_node(trains_by_start);
+}
+
+std::optional<size_t>
+cda_rail::TrainIntervalIndex::build_node(std::vector<size_t> trains) {
+  /**
+   * Recursively builds the subtree containing the given (non-empty) intervals
+   * and returns the index of its root within nodes. The center is the median
+   * start. Every interval starting there contains the center, hence, both
+   * subtrees contain at most half of the intervals.
+   */
+
+  if (trains.empty()) {
+    return {};
+  }
+
+  std::vector<int> starts;
+  starts.reserve(trains.size());
+  for (const auto tr : trains) {
+    starts.push_back(intervals.at(tr).first);
+  }
+  const auto median =
+      starts.begin() + static_cast<std::ptrdiff_t>(starts.size() / 2);
+  std::nth_element(starts.begin(), median, starts.end());
+  const int center = *median;
+
+  std::vector<size_t> left_trains;
+  std::vector<size_t> right_trains;
+  std::vector<size_t> center_trains;
+  for (const auto tr : trains) {
+    const auto& [t_0, t_n] = intervals.at(tr);
+    if (t_n <= center) {
+      left_trains.push_back(tr);
+    } else if (t_0 > center) {
+      right_trains.push_back(tr);
+    } else {
+      center_trains.push_back(tr);
+    }
+  }
+
+  const auto node_index = nodes.size();
+  nodes.emplace_back();
+  nodes.at(node_index).center = center;
+
+  // trains are sorted by start, which is preserved by the partition
+  auto by_end = center_trains;
+  std::stable_sort(by_end.begin(), by_end.end(),
+                   [this](size_t tr1, size_t tr2) {
+                     return intervals.at(tr1).second >
+                            intervals.at(tr2).second;
+                   });
+  nodes.at(node_index).by_start = std::move(center_trains);
+  nodes.at(node_index).by_end   = std::move(by_end);
+
+  // nodes might be reallocated during the recursion
+  const auto left  = build_node(std::move(left_trains));
+  const auto right = build_node(std::move(right_trains));
+  nodes.at(node_index).left  = left;
+  nodes.at(node_index).right = right;
+
+  return node_index;
+}
+
+void cda_rail::TrainIntervalIndex::collect_trains_at_t(
+    int t, std::vector<size_t>& trains) const {
+  /**
+   * Appends all trains present at time t in the order they are found in the
+   * tree.
+   */
+
+  std::optional<size_t> node_index;
+  if (!nodes.empty()) {
+    node_index = 0;
+  }
+  while (node_index.has_value()) {
+    const auto& node = nodes.at(node_index.value());
+    if (t < node.center) {
+      // All intervals of the node end after t
+      for (const auto tr : node.by_start) {
+        if (intervals.at(tr).first > t) {
+          break;
+        }
+        trains.push_back(tr);
+      }
+      node_index = node.left;
+    } else {
+      // All intervals of the node start before or at t
+      for (const auto tr : node.by_end) {
+        if (intervals.at(tr).second <= t) {
+          break;
+        }
+        trains.push_back(tr);
+      }
+      node_index = node.right;
+    }
+  }
+}
+
+void cda_rail::TrainIntervalIndex::check_train(size_t tr) const {
+  if (tr >= number_of_trains()) {
+    throw exceptions::TrainNotExistentException(tr);
+  }
+}
+
+const std::pair<int, int>&
+cda_rail::TrainIntervalIndex::get_interval(size_t tr) const {
+  check_train(tr);
+  return intervals.at(tr);
+}
+
+bool cda_rail::TrainIntervalIndex::is_present(size_t tr, int t) const {
+  const auto& [t_0, t_n] = get_interval(tr);
+  return t_0 <= t && t < t_n;
+}
+
+std::vector<size_t> cda_rail::TrainIntervalIndex::trains_at_t(int t) const {
+  /**
+   * Returns all trains present at time t, sorted by index.
+   */
+
+  std::vector<size_t> trains;
+  collect_trains_at_t(t, trains);
+  std::sort(trains.begin(), trains.end());
+  return trains;
+}
+
+std::vector<size_t> cda_rail::TrainIntervalIndex::trains_at_t(
+    int t, const std::vector<size_t>& trains_to_consider) const {
+  /**
+   * Returns all trains of trains_to_consider present at time t in the order of
+   * trains_to_consider. Every train is checked in constant time.
+   */
+
+  std::vector<size_t> trains;
+  for (const auto tr : trains_to_consider) {
+    if (is_present(tr, t)) {
+      trains.push_back(tr);
+    }
+  }
+  return trains;
+}
+
+std::vector<size_t>
+cda_rail::TrainIntervalIndex::trains_in_time_window(int t_0, int t_n) const {
+  /**
+   * Returns all trains present at some time within [t_0, t_n), sorted by
+   * index. These are the trains present at t_0 and the ones entering within
+   * (t_0, t_n).
+   */
+
+  if (t_n <= t_0) {
+    throw exceptions::InvalidInputException(
+        "Time window must not be empty, i.e., t_0 < t_n.");
+  }
+
+  std::vector<size_t> trains;
+  collect_trains_at_t(t_0, trains);
+
+  const auto first = std::upper_bound(
+      trains_by_start.begin(), trains_by_start.end(), t_0,
+      [this](int t, size_t tr) { return t < intervals.at(tr).first; });
+  const auto last = std::lower_bound(
+      first, trains_by_start.end(), t_n,
+      [this](size_t tr, int t) { return intervals.at(tr).first < t; });
+  trains.insert(trains.end(), first, last);
+
+  std::sort(trains.begin(), trains.end());
+  return trains;
+}
+
+std::vector<std::vector<size_t>>
+cda_rail::TrainIntervalIndex::trains_at_time_steps(int dt,
+                                                   size_t num_t) const {
+  /**
+   * Returns for every time step t = 0, ..., num_t - 1 all trains present at
+   * time t * dt, sorted by index. Every train is added to the consecutive
+   * steps it is present at without any further search, hence, the matrix is
+   * built in time linear in the number of trains, steps and entries.
+   *
+   * @param dt: length of a time step
+   * @param num_t: number of time steps
+   */
+
+  if (dt <= 0) {
+    throw exceptions::InvalidInputException("dt must be positive.");
+  }
+
+  std::vector<std::vector<size_t>> trains(num_t);
+  for (size_t tr = 0; tr < intervals.size(); tr++) {
+    const auto& [t_0, t_n] = intervals.at(tr);
+    if (t_n <= 0 || t_0 >= t_n) {
+      continue;
+    }
+    // Present at step t iff t_0 <= t * dt < t_n
+    const auto first_step =
+        static_cast<size_t>(std::max(0, ceil_div(t_0, dt)));
+    const auto last_step =
+        std::min(num_t, static_cast<size_t>(ceil_div(t_n, dt)));
+    for (size_t t = first_step; t < last_step; t++) {
+      trains.at(t).push_back(tr);
+    }
+  }
+  return trains;
+}
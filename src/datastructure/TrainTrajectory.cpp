@@ -0,0 +1,248 @@
+#include "datastructure/TrainTrajectory.hpp"
+
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+size_t cda_rail::TrainTrajectory::get_or_insert_index(double t) {
+  /**
+   * Returns the index of time t. If t is not present, a row without position
+   * and speed is inserted. Appending at the end is done in constant time.
+   */
+
+  if (times.empty() || times.back() < t) {
+    times.push_back(t);
+    positions.push_back(std::numeric_limits<double>::quiet_NaN());
+    speeds.push_back(std::numeric_limits<double>::quiet_NaN());
+    return times.size() - 1;
+  }
+
+  const auto it  = std::lower_bound(times.begin(), times.end(), t);
+  const auto idx = static_cast<size_t>(std::distance(times.begin(), it));
+  if (it != times.end() && *it == t) {
+    return idx;
+  }
+
+  const auto offset = static_cast<std::ptrdiff_t>(idx);
+  times.insert(it, t);
+  positions.insert(positions.begin() + offset,
+                   std::numeric_limits<double>::quiet_NaN());
+  speeds.insert(speeds.begin() + offset,
+                std::numeric_limits<double>::quiet_NaN());
+  return idx;
+}
+
+void cda_rail::TrainTrajectory::update_monotonicity(size_t idx) {
+  /**
+   * Checks if the position at index idx is consistent with non-decreasing
+   * positions of its direct neighbors. Once violated, positions are treated
+   * as unordered for good, which is only slower but never wrong.
+   */
+
+  if (idx > 0 && !std::isnan(positions[idx - 1]) &&
+      positions[idx - 1] > positions[idx]) {
+    positions_non_decreasing = false;
+  }
+  if (idx + 1 < size() && !std::isnan(positions[idx + 1]) &&
+      positions[idx] > positions[idx + 1]) {
+    positions_non_decreasing = false;
+  }
+}
+
+void cda_rail::TrainTrajectory::check_index(size_t idx) const {
+  if (idx >= size()) {
+    throw exceptions::InvalidInputException(
+        "Trajectory index " + std::to_string(idx) + " out of range.");
+  }
+}
+
+double cda_rail::TrainTrajectory::get_time(size_t idx) const {
+  check_index(idx);
+  return times[idx];
+}
+
+bool cda_rail::TrainTrajectory::has_pos(size_t idx) const {
+  check_index(idx);
+  return !std::isnan(positions[idx]);
+}
+
+bool cda_rail::TrainTrajectory::has_speed(size_t idx) const {
+  check_index(idx);
+  return !std::isnan(speeds[idx]);
+}
+
+double cda_rail::TrainTrajectory::get_pos(size_t idx) const {
+  if (!has_pos(idx)) {
+    throw exceptions::ConsistencyException(
+        "No position at time " + std::to_string(times[idx]));
+  }
+  return positions[idx];
+}
+
+double cda_rail::TrainTrajectory::get_speed(size_t idx) const {
+  if (!has_speed(idx)) {
+    throw exceptions::ConsistencyException("No speed at time " +
+                                           std::to_string(times[idx]));
+  }
+  return speeds[idx];
+}
+
+std::optional<size_t> cda_rail::TrainTrajectory::find_time(double t) const {
+  /**
+   * Returns the index of exactly time t, if present, in O(log n).
+   */
+
+  const auto it = std::lower_bound(times.begin(), times.end(), t);
+  if (it == times.end() || *it != t) {
+    return {};
+  }
+  return static_cast<size_t>(std::distance(times.begin(), it));
+}
+
+std::optional<size_t> cda_rail::TrainTrajectory::find_pos(double pos) const {
+  /**
+   * Returns the index of the first time at which the position is within
+   * GRB_EPS of pos. Uses binary search if positions are non-decreasing and
+   * a linear scan otherwise.
+   */
+
+  if (has_non_decreasing_positions()) {
+    const auto it =
+        std::upper_bound(positions.begin(), positions.end(), pos - GRB_EPS);
+    if (it == positions.end() || *it >= pos + GRB_EPS) {
+      return {};
+    }
+    return static_cast<size_t>(std::distance(positions.begin(), it));
+  }
+
+  for (size_t i = 0; i < size(); i++) {
+    if (!std::isnan(positions[i]) && std::abs(positions[i] - pos) < GRB_EPS) {
+      return i;
+    }
+  }
+  return {};
+}
+
+std::optional<std::pair<size_t, size_t>>
+cda_rail::TrainTrajectory::get_bracket(double t) const {
+  /**
+   * Returns the indices of the two consecutive times enclosing t in O(log n).
+   * If a time is within GRB_EPS of t, both indices are the index of this
+   * time. If t lies outside the trajectory, nothing is returned.
+   */
+
+  const auto it = std::upper_bound(times.begin(), times.end(), t - GRB_EPS);
+  if (it == times.end()) {
+    return {};
+  }
+  const auto idx = static_cast<size_t>(std::distance(times.begin(), it));
+  if (*it < t + GRB_EPS) {
+    return std::make_pair(idx, idx);
+  }
+  if (idx == 0) {
+    return {};
+  }
+  return std::make_pair(idx - 1, idx);
+}
+
+std::vector<double> cda_rail::TrainTrajectory::get_times_with_speed() const {
+  /**
+   * Returns all times at which the speed is known in increasing order.
+   */
+
+  if (num_speeds == size()) {
+    return times;
+  }
+  std::vector<double> ret_val;
+  ret_val.reserve(num_speeds);
+  for (size_t i = 0; i < size(); i++) {
+    if (!std::isnan(speeds[i])) {
+      ret_val.push_back(times[i]);
+    }
+  }
+  return ret_val;
+}
+
+void cda_rail::TrainTrajectory::set_pos(double t, double pos) {
+  const auto idx = get_or_insert_index(t);
+  if (std::isnan(positions[idx])) {
+    num_positions++;
+  }
+  positions[idx] = pos;
+  update_monotonicity(idx);
+}
+
+void cda_rail::TrainTrajectory::set_speed(double t, double speed) {
+  const auto idx = get_or_insert_index(t);
+  if (std::isnan(speeds[idx])) {
+    num_speeds++;
+  }
+  speeds[idx] = speed;
+}
+
+void cda_rail::TrainTrajectory::reserve(size_t n) {
+  times.reserve(n);
+  positions.reserve(n);
+  speeds.reserve(n);
+}
+
+void cda_rail::TrainTrajectoryBuilder::add(double t, double pos,
+                                           double speed) {
+  times.push_back(t);
+  positions.push_back(pos);
+  speeds.push_back(speed);
+}
+
+void cda_rail::TrainTrajectoryBuilder::reserve(size_t n) {
+  times.reserve(n);
+  positions.reserve(n);
+  speeds.reserve(n);
+}
+
+cda_rail::TrainTrajectory cda_rail::TrainTrajectoryBuilder::build() const {
+  /**
+   * Sorts the collected points by time once and returns the trajectory.
+   * Points with equal time are merged, the one added last is kept.
+   */
+
+  std::vector<size_t> order(times.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t i, size_t j) {
+    return times[i] < times[j];
+  });
+
+  TrainTrajectory trajectory;
+  trajectory.reserve(order.size());
+  for (const auto i : order) {
+    if (!trajectory.times.empty() && trajectory.times.back() == times[i]) {
+      trajectory.positions.back() = positions[i];
+      trajectory.speeds.back()    = speeds[i];
+      continue;
+    }
+    trajectory.times.push_back(times[i]);
+    trajectory.positions.push_back(positions[i]);
+    trajectory.speeds.push_back(speeds[i]);
+  }
+  trajectory.num_positions = static_cast<size_t>(
+      std::count_if(trajectory.positions.begin(), trajectory.positions.end(),
+                    [](double pos) { return !std::isnan(pos); }));
+  for (size_t i = 0; i + 1 < trajectory.size(); i++) {
+    if (trajectory.positions[i] > trajectory.positions[i + 1]) {
+      trajectory.positions_non_decreasing = false;
+    }
+  }
+  trajectory.num_speeds = static_cast<size_t>(
+      std::count_if(trajectory.speeds.begin(), trajectory.speeds.end(),
+                    [](double v) { return !std::isnan(v); }));
+  return trajectory;
+}
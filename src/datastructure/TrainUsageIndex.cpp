@@ -0,0 +1,156 @@
+#include "datastructure/TrainUsageIndex.hpp"
+
+#include "CustomExceptions.hpp"
+#include "datastructure/RailwayNetwork.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+cda_rail::TrainUsageIndex::TrainUsageIndex(
+    const Network&                          network,
+    std::vector<std::vector<size_t>>        edges_used_by_trains,
+    const std::vector<std::vector<size_t>>& sections)
+    : edges_of_train(std::move(edges_used_by_trains)) {
+  /**
+   * Builds the index.
+   *
+   * @param network: network the edges refer to
+   * @param edges_used_by_trains: for every train (by index) the edges it might
+   * use, e.g., its route if routes are fixed and all edges otherwise
+   * @param sections: sections (lists of edges), e.g., TTD sections
+   */
+
+  const auto num_tr       = edges_of_train.size();
+  const auto num_edges    = network.number_of_edges();
+  const auto num_vertices = network.number_of_vertices();
+
+  train_edge_bitmap.assign(num_tr, std::vector<bool>(num_edges, false));
+  train_section_bitmap.assign(num_tr,
+                              std::vector<bool>(sections.size(), false));
+  vertices_of_train.resize(num_tr);
+  sections_of_train.resize(num_tr);
+  trains_of_edge.resize(num_edges);
+  trains_of_section.resize(sections.size());
+
+  for (const auto& section : sections) {
+    for (const auto e : section) {
+      if (!network.has_edge(e)) {
+        throw exceptions::EdgeNotExistentException(e);
+      }
+    }
+  }
+
+  for (size_t tr = 0; tr < num_tr; tr++) {
+    auto&             edge_bits = train_edge_bitmap.at(tr);
+    std::vector<bool> vertex_used(num_vertices, false);
+    for (const auto e : edges_of_train.at(tr)) {
+      if (!network.has_edge(e)) {
+        throw exceptions::EdgeNotExistentException(e);
+      }
+      if (edge_bits.at(e)) {
+        continue;
+      }
+      edge_bits.at(e) = true;
+      trains_of_edge.at(e).push_back(tr);
+
+      const auto& edge = network.get_edge(e);
+      for (const auto v : {edge.source, edge.target}) {
+        if (!vertex_used.at(v)) {
+          vertex_used.at(v) = true;
+          vertices_of_train.at(tr).push_back(v);
+        }
+      }
+    }
+
+    for (size_t section_id = 0; section_id < sections.size(); section_id++) {
+      const auto& section = sections.at(section_id);
+      if (std::any_of(section.begin(), section.end(),
+                      [&edge_bits](size_t e) { return edge_bits.at(e); })) {
+        train_section_bitmap.at(tr).at(section_id) = true;
+        sections_of_train.at(tr).push_back(section_id);
+        trains_of_section.at(section_id).push_back(tr);
+      }
+    }
+  }
+}
+
+void cda_rail::TrainUsageIndex::check_train(size_t tr) const {
+  if (tr >= number_of_trains()) {
+    throw exceptions::TrainNotExistentException(tr);
+  }
+}
+
+void cda_rail::TrainUsageIndex::check_edge(size_t e) const {
+  if (e >= number_of_edges()) {
+    throw exceptions::EdgeNotExistentException(e);
+  }
+}
+
+void cda_rail::TrainUsageIndex::check_section(size_t section) const {
+  if (section >= number_of_sections()) {
+    throw exceptions::InvalidInputException("Section " +
+                                            std::to_string(section) +
+                                            " does not exist in index.");
+  }
+}
+
+bool cda_rail::TrainUsageIndex::uses_edge(size_t tr, size_t e) const {
+  check_train(tr);
+  check_edge(e);
+  return train_edge_bitmap.at(tr).at(e);
+}
+
+bool cda_rail::TrainUsageIndex::uses_section(size_t tr, size_t section) const {
+  check_train(tr);
+  check_section(section);
+  return train_section_bitmap.at(tr).at(section);
+}
+
+const std::vector<size_t>&
+cda_rail::TrainUsageIndex::edges_used_by_train(size_t tr) const {
+  check_train(tr);
+  return edges_of_train.at(tr);
+}
+
+const std::vector<size_t>&
+cda_rail::TrainUsageIndex::vertices_used_by_train(size_t tr) const {
+  check_train(tr);
+  return vertices_of_train.at(tr);
+}
+
+const std::vector<size_t>&
+cda_rail::TrainUsageIndex::sections_used_by_train(size_t tr) const {
+  check_train(tr);
+  return sections_of_train.at(tr);
+}
+
+const std::vector<size_t>&
+cda_rail::TrainUsageIndex::trains_on_edge(size_t e) const {
+  check_edge(e);
+  return trains_of_edge.at(e);
+}
+
+const std::vector<size_t>&
+cda_rail::TrainUsageIndex::trains_in_section(size_t section) const {
+  check_section(section);
+  return trains_of_section.at(section);
+}
+
+std::vector<size_t> cda_rail::TrainUsageIndex::trains_on_edges(
+    const std::vector<size_t>& edges) const {
+  /**
+   * Returns all trains using at least one of the given edges, sorted by index.
+   */
+
+  std::vector<size_t> trains;
+  for (const auto e : edges) {
+    const auto& tr_on_e = trains_on_edge(e);
+    trains.insert(trains.end(), tr_on_e.begin(), tr_on_e.end());
+  }
+  std::sort(trains.begin(), trains.end());
+  trains.erase(std::unique(trains.begin(), trains.end()), trains.end());
+  return trains;
+}
@@ -1,9 +1,39 @@
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 
+#include "CustomExceptions.hpp"
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
 #include "probleminstances/VSSGenerationTimetable.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+std::string to_string_with_unit(double value, const std::string& unit) {
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(1) << value << " " << unit;
+  return stream.str();
+}
+} // namespace
+
 void cda_rail::instances::GeneralPerformanceOptimizationInstance::
     discretize_stops() {
   /**
@@ -17,7 +47,8 @@ void cda_rail::instances::GeneralPerformanceOptimizationInstance::
         this->get_station_list().get_station(station_name).tracks;
     const auto new_edges = this->n().separate_stop_edges(station_tracks);
     this->editable_timetable().update_after_discretization(new_edges);
-    this->editable_routes().update_after_discretization(new_edges);
+    this->editable_routes().update_after_discretization(new_edges,
+                                                     this->const_n());
   }
 }
 
@@ -75,3 +106,606 @@ cda_rail::instances::GeneralPerformanceOptimizationInstance::
                                                        throw_error),
       this->get_routes());
 }
+
+bool cda_rail::instances::GeneralPerformanceOptimizationInstance::
+    are_trains_interchangeable(size_t tr1, size_t tr2) const {
+  /**
+   * Two trains are interchangeable if swapping them maps every solution to a
+   * solution with the same objective, i.e., they have identical properties,
+   * schedules, routes (if any), weights and optionality.
+   */
+
+  const auto& tr1_object = this->get_train_list().get_train(tr1);
+  const auto& tr2_object = this->get_train_list().get_train(tr2);
+  if (tr1_object.length != tr2_object.length ||
+      tr1_object.max_speed != tr2_object.max_speed ||
+      tr1_object.acceleration != tr2_object.acceleration ||
+      tr1_object.deceleration != tr2_object.deceleration ||
+      tr1_object.tim != tr2_object.tim) {
+    return false;
+  }
+
+  if (train_weights.at(tr1) != train_weights.at(tr2) ||
+      train_optional.at(tr1) != train_optional.at(tr2)) {
+    return false;
+  }
+
+  const auto& schedule1 = this->get_schedule(tr1);
+  const auto& schedule2 = this->get_schedule(tr2);
+  if (schedule1.get_entry() != schedule2.get_entry() ||
+      schedule1.get_exit() != schedule2.get_exit() ||
+      schedule1.get_t_0_range() != schedule2.get_t_0_range() ||
+      schedule1.get_t_n_range() != schedule2.get_t_n_range() ||
+      schedule1.get_v_0() != schedule2.get_v_0() ||
+      schedule1.get_v_n() != schedule2.get_v_n()) {
+    return false;
+  }
+  const auto& stops1 = schedule1.get_stops();
+  const auto& stops2 = schedule2.get_stops();
+  if (stops1.size() != stops2.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < stops1.size(); i++) {
+    if (stops1.at(i).get_station_name() != stops2.at(i).get_station_name() ||
+        stops1.at(i).get_begin_range() != stops2.at(i).get_begin_range() ||
+        stops1.at(i).get_end_range() != stops2.at(i).get_end_range() ||
+        stops1.at(i).get_min_stopping_time() !=
+            stops2.at(i).get_min_stopping_time()) {
+      return false;
+    }
+  }
+
+  const bool has_route1 = this->has_route(tr1_object.name);
+  if (has_route1 != this->has_route(tr2_object.name)) {
+    return false;
+  }
+  return !has_route1 || this->get_route(tr1_object.name).get_edges() ==
+                            this->get_route(tr2_object.name).get_edges();
+}
+
+std::vector<std::vector<size_t>> cda_rail::instances::
+    GeneralPerformanceOptimizationInstance::get_interchangeable_train_classes()
+        const {
+  /**
+   * Partitions the trains into classes of pairwise interchangeable trains.
+   * Only classes of at least two trains are returned, each sorted by train
+   * index.
+   */
+
+  const auto                       num_tr = this->get_train_list().size();
+  std::vector<bool>                assigned(num_tr, false);
+  std::vector<std::vector<size_t>> train_classes;
+  for (size_t tr1 = 0; tr1 < num_tr; tr1++) {
+    if (assigned.at(tr1)) {
+      continue;
+    }
+    std::vector<size_t> train_class = {tr1};
+    for (size_t tr2 = tr1 + 1; tr2 < num_tr; tr2++) {
+      if (!assigned.at(tr2) && are_trains_interchangeable(tr1, tr2)) {
+        assigned.at(tr2) = true;
+        train_class.push_back(tr2);
+      }
+    }
+    if (train_class.size() > 1) {
+      train_classes.push_back(std::move(train_class));
+    }
+  }
+  return train_classes;
+}
+
+std::vector<cda_rail::instances::TimetableConflict> cda_rail::instances::
+    GeneralPerformanceOptimizationInstance::check_timetable_conflicts(
+        bool fixed_routes) const {
+  /**
+   * Checks the timetable for conflicts that no solution can resolve before
+   * any model is created. These are trains that cannot meet their time
+   * windows even without any other train, as well as sets of trains that
+   * cannot meet them together, because they exceed the length of a station,
+   * block each other on a track or cannot enter or leave at the same vertex
+   * within their time windows. Only necessary conditions are checked, hence,
+   * the instance might still be infeasible if no conflict is found.
+   *
+   * @param fixed_routes: if true, trains with a route only use its edges
+   *
+   * @return: all conflicts found
+   */
+
+  std::vector<TimetableConflict> conflicts;
+  std::vector<ForcedStop>        forced_stops;
+  for (size_t tr = 0; tr < this->get_train_list().size(); tr++) {
+    check_running_times(tr, fixed_routes, conflicts, forced_stops);
+  }
+  check_station_capacities(forced_stops, conflicts);
+  check_opposite_tracks(forced_stops, conflicts);
+  check_headways(conflicts);
+  return conflicts;
+}
+
+std::optional<std::vector<size_t>> cda_rail::instances::
+    GeneralPerformanceOptimizationInstance::optional_trains_resolving_conflicts(
+        const std::vector<TimetableConflict>& conflicts) const {
+  /**
+   * Greedily selects optional trains such that every conflict contains at
+   * least one of them. Conflicts with fewer trains are considered first. If a
+   * conflict does not contain a selected train yet, its optional train of
+   * smallest weight is selected. Not scheduling the selected trains does not
+   * necessarily resolve all conflicts, e.g., if a station is overbooked by
+   * more than one train, hence, the remaining trains should be checked again.
+   *
+   * @return: the selected trains sorted by index, or an empty optional if
+   * some conflict does not contain any optional train
+   */
+
+  std::vector<size_t> conflict_order(conflicts.size());
+  std::iota(conflict_order.begin(), conflict_order.end(), 0);
+  std::stable_sort(conflict_order.begin(), conflict_order.end(),
+                   [&conflicts](size_t c1, size_t c2) {
+                     return conflicts.at(c1).trains.size() <
+                            conflicts.at(c2).trains.size();
+                   });
+
+  std::vector<bool> selected(this->get_train_list().size(), false);
+  for (const auto c : conflict_order) {
+    const auto& trains = conflicts.at(c).trains;
+    if (std::any_of(trains.begin(), trains.end(),
+                    [&selected](size_t tr) { return selected.at(tr); })) {
+      continue;
+    }
+    std::optional<size_t> tr_to_select;
+    for (const auto tr : trains) {
+      if (train_optional.at(tr) &&
+          (!tr_to_select.has_value() ||
+           train_weights.at(tr) < train_weights.at(tr_to_select.value()))) {
+        tr_to_select = tr;
+      }
+    }
+    if (!tr_to_select.has_value()) {
+      return {};
+    }
+    selected.at(tr_to_select.value()) = true;
+  }
+
+  std::vector<size_t> selected_trains;
+  for (size_t tr = 0; tr < selected.size(); tr++) {
+    if (selected.at(tr)) {
+      selected_trains.push_back(tr);
+    }
+  }
+  return selected_trains;
+}
+
+void cda_rail::instances::GeneralPerformanceOptimizationInstance::
+    check_running_times(size_t tr, bool fixed_routes,
+                        std::vector<TimetableConflict>& conflicts,
+                        std::vector<ForcedStop>&        forced_stops) const {
+  /**
+   * Propagates the earliest possible times of train tr along its schedule and
+   * adds a conflict if it misses a time window even without any other train.
+   * Between entry, stops and exit, the train needs at least the time of the
+   * fastest path at maximal speed, as well as the time the equations of
+   * motion need on the shortest path given the scheduled speeds. Since the
+   * exit time bounds the departure of the rear, the minimal leaving time is
+   * added at the exit. At most one conflict is added per train. The forced
+   * stops of the train are added to forced_stops.
+   */
+
+  const auto& tr_object   = this->get_train_list().get_train(tr);
+  const auto& tr_schedule = this->get_schedule(tr);
+  const auto  tr_edges    = this->edges_used_by_train(tr, fixed_routes, false);
+  const std::unordered_set<size_t> usable_edges(tr_edges.begin(),
+                                                tr_edges.end());
+
+  const auto v_max = std::max(
+      {tr_object.max_speed, tr_schedule.get_v_0(), tr_schedule.get_v_n()});
+
+  const auto min_section_time = [&](const std::vector<size_t>& from,
+                                    double                     v_1,
+                                    const std::vector<size_t>& to,
+                                    double                     v_2) {
+    const auto distances = this->const_n().shortest_path_distances(
+        from, usable_edges, [](const Edge& edge) { return edge.length; });
+    const auto times = this->const_n().shortest_path_distances(
+        from, usable_edges, [&tr_object](const Edge& edge) {
+          return edge.length / std::min(tr_object.max_speed, edge.max_speed);
+        });
+    double distance = std::numeric_limits<double>::infinity();
+    double time     = std::numeric_limits<double>::infinity();
+    for (const auto v : to) {
+      distance = std::min(distance, distances.at(v));
+      time     = std::min(time, times.at(v));
+    }
+    if (std::isinf(distance)) {
+      return distance;
+    }
+    // Speed changes need a certain distance, even on shorter paths
+    const auto eom_distance =
+        v_1 <= v_2 ? (v_2 * v_2 - v_1 * v_1) / (2 * tr_object.acceleration)
+                   : (v_1 * v_1 - v_2 * v_2) / (2 * tr_object.deceleration);
+    return std::max(time, cda_rail::min_travel_time(
+                              v_1, v_2, v_max, tr_object.acceleration,
+                              tr_object.deceleration,
+                              std::max(distance, eom_distance)));
+  };
+
+  const auto add_conflict = [&](const std::string& explanation) {
+    conflicts.push_back({TimetableConflictType::RunningTime,
+                         {tr},
+                         "Train " + tr_object.name + " " + explanation});
+  };
+
+  double              t      = tr_schedule.get_t_0_range().first;
+  double              v_from = tr_schedule.get_v_0();
+  std::vector<size_t> from   = {tr_schedule.get_entry()};
+  for (const auto& stop : tr_schedule.get_stops()) {
+    const auto& station_name = stop.get_station_name();
+    const auto  stop_vertices =
+        this->possible_stop_vertices(tr, station_name, tr_edges);
+    if (stop_vertices.empty()) {
+      conflicts.push_back({TimetableConflictType::StationCapacity,
+                           {tr},
+                           "Train " + tr_object.name +
+                               " does not fit onto the usable tracks of "
+                               "station " +
+                               station_name + "."});
+      return;
+    }
+
+    std::vector<size_t> to;
+    std::vector<size_t> forced_edges;
+    bool                first_path = true;
+    for (const auto& [v, stop_paths] : stop_vertices) {
+      to.push_back(v);
+      for (auto p : stop_paths) {
+        std::sort(p.begin(), p.end());
+        if (first_path) {
+          forced_edges = std::move(p);
+          first_path   = false;
+          continue;
+        }
+        std::vector<size_t> intersection;
+        std::set_intersection(forced_edges.begin(), forced_edges.end(),
+                              p.begin(), p.end(),
+                              std::back_inserter(intersection));
+        forced_edges = std::move(intersection);
+      }
+    }
+
+    const auto section_time = min_section_time(from, v_from, to, 0);
+    if (std::isinf(section_time)) {
+      add_conflict("cannot reach station " + station_name + ".");
+      return;
+    }
+    const auto arrival = t + section_time;
+    if (arrival > stop.get_begin_range().second + GRB_EPS) {
+      add_conflict(
+          "arrives at station " + station_name + " at the earliest at " +
+          to_string_with_unit(arrival, "s") + ", but has to arrive by " +
+          to_string_with_unit(stop.get_begin_range().second, "s") + ".");
+      return;
+    }
+    const auto departure =
+        std::max({std::max(arrival, static_cast<double>(
+                                        stop.get_begin_range().first)) +
+                      stop.get_min_stopping_time(),
+                  static_cast<double>(stop.get_end_range().first)});
+    if (departure > stop.get_end_range().second + GRB_EPS) {
+      add_conflict(
+          "departs from station " + station_name + " at the earliest at " +
+          to_string_with_unit(departure, "s") + ", but has to depart by " +
+          to_string_with_unit(stop.get_end_range().second, "s") + ".");
+      return;
+    }
+
+    if (const auto interval = stop.get_forced_stopping_interval();
+        interval.first < interval.second) {
+      forced_stops.push_back(
+          {tr, station_name, interval, std::move(forced_edges)});
+    }
+
+    t      = departure;
+    v_from = 0;
+    from   = std::move(to);
+  }
+
+  const auto section_time = min_section_time(
+      from, v_from, {tr_schedule.get_exit()}, tr_schedule.get_v_n());
+  const auto& exit_name =
+      this->const_n().get_vertex(tr_schedule.get_exit()).name;
+  if (std::isinf(section_time)) {
+    add_conflict("cannot reach its exit " + exit_name + ".");
+    return;
+  }
+  const auto exit_time =
+      t + section_time + get_minimal_leaving_time(tr, tr_schedule.get_v_n());
+  if (exit_time > tr_schedule.get_t_n_range().second + GRB_EPS) {
+    add_conflict(
+        "leaves the network at " + exit_name + " at the earliest at " +
+        to_string_with_unit(exit_time, "s") + ", but has to leave by " +
+        to_string_with_unit(tr_schedule.get_t_n_range().second, "s") + ".");
+  }
+}
+
+void cda_rail::instances::GeneralPerformanceOptimizationInstance::
+    check_station_capacities(const std::vector<ForcedStop>&  forced_stops,
+                             std::vector<TimetableConflict>& conflicts) const {
+  /**
+   * Adds a conflict for every set of trains forced to stop at the same
+   * station at the same time, whose total length exceeds the length of the
+   * station tracks. An edge and its reverse edge are the same track and
+   * counted once.
+   */
+
+  std::map<std::string, std::vector<size_t>> stops_by_station;
+  for (size_t i = 0; i < forced_stops.size(); i++) {
+    stops_by_station[forced_stops.at(i).station].push_back(i);
+  }
+
+  for (const auto& [station_name, stop_ids] : stops_by_station) {
+    const auto& tracks =
+        this->get_station_list().get_station(station_name).tracks;
+    const std::unordered_set<size_t> track_set(tracks.begin(), tracks.end());
+    double                           capacity = 0;
+    for (const auto e : tracks) {
+      const auto reverse_e = this->const_n().get_reverse_edge_index(e);
+      if (!reverse_e.has_value() || reverse_e.value() > e ||
+          track_set.count(reverse_e.value()) == 0) {
+        capacity += this->const_n().get_edge(e).length;
+      }
+    }
+
+    std::set<std::vector<size_t>> reported;
+    for (const auto i : stop_ids) {
+      // Trains forced to stop when train i starts to be forced to stop
+      const auto          t = forced_stops.at(i).interval.first;
+      std::vector<size_t> trains;
+      double              total_length = 0;
+      for (const auto j : stop_ids) {
+        const auto& [lb, ub] = forced_stops.at(j).interval;
+        if (lb <= t && t < ub) {
+          trains.push_back(forced_stops.at(j).train);
+          total_length +=
+              this->get_train_list().get_train(forced_stops.at(j).train).length;
+        }
+      }
+      std::sort(trains.begin(), trains.end());
+      if (total_length <= capacity + GRB_EPS ||
+          !reported.insert(trains).second) {
+        continue;
+      }
+      std::string train_names;
+      for (const auto tr : trains) {
+        train_names += (train_names.empty() ? "" : ", ") +
+                       this->get_train_list().get_train(tr).name;
+      }
+      conflicts.push_back(
+          {TimetableConflictType::StationCapacity, trains,
+           "Trains " + train_names + " are forced to stop at station " +
+               station_name + " at " + to_string_with_unit(t, "s") +
+               " with a total length of " +
+               to_string_with_unit(total_length, "m") +
+               ", but its tracks only have a length of " +
+               to_string_with_unit(capacity, "m") + "."});
+    }
+  }
+}
+
+void cda_rail::instances::GeneralPerformanceOptimizationInstance::
+    check_opposite_tracks(const std::vector<ForcedStop>&  forced_stops,
+                          std::vector<TimetableConflict>& conflicts) const {
+  /**
+   * Adds a conflict for every pair of trains forced to stop at the same time
+   * on the same track in opposite directions. Each of them occupies the end
+   * of the track it is heading to. Since trains cannot turn, the one arriving
+   * later would have to pass the other one.
+   */
+
+  for (size_t i = 0; i < forced_stops.size(); i++) {
+    const auto& stop_i = forced_stops.at(i);
+    for (size_t j = i + 1; j < forced_stops.size(); j++) {
+      const auto& stop_j = forced_stops.at(j);
+      if (stop_i.train == stop_j.train ||
+          std::max(stop_i.interval.first, stop_j.interval.first) >=
+              std::min(stop_i.interval.second, stop_j.interval.second)) {
+        continue;
+      }
+      for (const auto e : stop_i.edges) {
+        const auto reverse_e = this->const_n().get_reverse_edge_index(e);
+        if (!reverse_e.has_value() ||
+            std::find(stop_j.edges.begin(), stop_j.edges.end(),
+                      reverse_e.value()) == stop_j.edges.end()) {
+          continue;
+        }
+        const auto& edge = this->const_n().get_edge(e);
+        conflicts.push_back(
+            {TimetableConflictType::OppositeTracks,
+             {std::min(stop_i.train, stop_j.train),
+              std::max(stop_i.train, stop_j.train)},
+             "Trains " + this->get_train_list().get_train(stop_i.train).name +
+                 " and " +
+                 this->get_train_list().get_train(stop_j.train).name +
+                 " are forced to stop at the same time in opposite "
+                 "directions on the track between " +
+                 this->const_n().get_vertex(edge.source).name + " and " +
+                 this->const_n().get_vertex(edge.target).name + "."});
+        break;
+      }
+    }
+  }
+}
+
+void cda_rail::instances::GeneralPerformanceOptimizationInstance::
+    check_headways(std::vector<TimetableConflict>& conflicts) const {
+  /**
+   * Adds a conflict for every pair of trains entering (or leaving) at the
+   * same vertex, for which neither order fits into the time windows.
+   * The front of the second train cannot enter before the rear of the first
+   * train has entered, which takes at least the time needed to travel the
+   * length of the first train accelerating from its entry speed. At the exit,
+   * the rear of the second train departs at least its minimal leaving time
+   * after the rear of the first train has departed.
+   */
+
+  const auto          num_tr = this->get_train_list().size();
+  std::vector<double> entry_headways;
+  std::vector<double> exit_headways;
+  entry_headways.reserve(num_tr);
+  exit_headways.reserve(num_tr);
+  for (size_t tr = 0; tr < num_tr; tr++) {
+    const auto& tr_object   = this->get_train_list().get_train(tr);
+    const auto& tr_schedule = this->get_schedule(tr);
+    const auto  v_0         = tr_schedule.get_v_0();
+    const auto  v_max       = std::max(tr_object.max_speed, v_0);
+    const auto  v_reached   = std::min(
+        v_max, std::sqrt(v_0 * v_0 +
+                           2 * tr_object.acceleration * tr_object.length));
+    entry_headways.push_back(cda_rail::min_travel_time(
+        v_0, v_reached, v_max, tr_object.acceleration, tr_object.deceleration,
+        tr_object.length));
+    exit_headways.push_back(
+        get_minimal_leaving_time(tr, tr_schedule.get_v_n()));
+  }
+
+  const auto add_conflict = [&](TimetableConflictType type, size_t tr1,
+                                size_t tr2, const std::string& what,
+                                size_t v, double h_1, double h_2) {
+    const auto& tr1_name = this->get_train_list().get_train(tr1).name;
+    const auto& tr2_name = this->get_train_list().get_train(tr2).name;
+    conflicts.push_back(
+        {type,
+         {tr1, tr2},
+         "Trains " + tr1_name + " and " + tr2_name + " cannot both " + what +
+             " at " + this->const_n().get_vertex(v).name +
+             " within their time windows, since they need at least " +
+             to_string_with_unit(h_1, "s") + " respectively " +
+             to_string_with_unit(h_2, "s") + " to pass it."});
+  };
+
+  for (size_t tr1 = 0; tr1 < num_tr; tr1++) {
+    const auto& schedule1 = this->get_schedule(tr1);
+    for (size_t tr2 = tr1 + 1; tr2 < num_tr; tr2++) {
+      const auto& schedule2 = this->get_schedule(tr2);
+      if (schedule1.get_entry() == schedule2.get_entry() &&
+          schedule1.get_t_0_range().first + entry_headways.at(tr1) >
+              schedule2.get_t_0_range().second + GRB_EPS &&
+          schedule2.get_t_0_range().first + entry_headways.at(tr2) >
+              schedule1.get_t_0_range().second + GRB_EPS) {
+        add_conflict(TimetableConflictType::EntryHeadway, tr1, tr2, "enter",
+                     schedule1.get_entry(), entry_headways.at(tr1),
+                     entry_headways.at(tr2));
+      }
+      if (schedule1.get_exit() == schedule2.get_exit() &&
+          schedule1.get_t_n_range().first + exit_headways.at(tr2) >
+              schedule2.get_t_n_range().second + GRB_EPS &&
+          schedule2.get_t_n_range().first + exit_headways.at(tr1) >
+              schedule1.get_t_n_range().second + GRB_EPS) {
+        add_conflict(TimetableConflictType::ExitHeadway, tr1, tr2, "leave",
+                     schedule1.get_exit(), exit_headways.at(tr1),
+                     exit_headways.at(tr2));
+      }
+    }
+  }
+}
+
+cda_rail::instances::GeneralPerformanceOptimizationInstance cda_rail::
+    instances::GeneralPerformanceOptimizationInstance::import_instance_async(
+        const std::filesystem::path&   path,
+        std::map<std::string, double>* import_times) {
+  /**
+   * Imports a general performance optimization instance from a directory.
+   * The network, trains, schedules and problem data do not depend on each
+   * other and are read concurrently. Stations and routes refer to the network
+   * and are read (concurrently) as soon as the network is available. Finally,
+   * the timetable and instance are assembled. The result is identical to the
+   * constructor from a path.
+   *
+   * @param path The path to the instance directory.
+   * @param import_times If not nullptr, the wall time in milliseconds of
+   * every part is stored with the respective file as key, as well as the
+   * total time with key "total".
+   */
+
+  using Clock      = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  if (!std::filesystem::exists(path)) {
+    throw exceptions::ImportException("Path does not exist.");
+  }
+  if (!std::filesystem::is_directory(path)) {
+    throw exceptions::ImportException("Path is not a directory.");
+  }
+
+  // Every time is only written by its own task and read after the
+  // respective future has been waited for.
+  double network_time      = 0;
+  double trains_time       = 0;
+  double schedules_time    = 0;
+  double problem_data_time = 0;
+  double stations_time     = 0;
+  double routes_time       = 0;
+
+  const auto timed = [](double& time, const auto& task) {
+    const auto task_start = Clock::now();
+    auto       result     = task();
+    time = std::chrono::duration<double, std::milli>(Clock::now() - task_start)
+               .count();
+    return result;
+  };
+  const auto parse_json = [](const std::filesystem::path& p) {
+    std::ifstream file(p);
+    return json::parse(file);
+  };
+
+  auto network_future = std::async(std::launch::async, [&]() {
+    return timed(network_time, [&]() {
+      return std::make_shared<Network>(path / "network");
+    });
+  });
+  auto trains_future = std::async(std::launch::async, [&]() {
+    return timed(trains_time, [&]() {
+      return TrainList::import_trains(path / "timetable");
+    });
+  });
+  auto schedules_future = std::async(std::launch::async, [&]() {
+    return timed(schedules_time, [&]() {
+      return parse_json(path / "timetable" / "schedules.json");
+    });
+  });
+  auto problem_data_future = std::async(std::launch::async, [&]() {
+    return timed(problem_data_time,
+                 [&]() { return parse_json(path / "problem_data.json"); });
+  });
+
+  const std::shared_ptr<Network> network = network_future.get();
+
+  auto stations_future = std::async(std::launch::async, [&]() {
+    return timed(stations_time, [&]() {
+      return StationList::import_stations(path / "timetable", *network);
+    });
+  });
+  auto routes_future = std::async(std::launch::async, [&]() {
+    return timed(routes_time, [&]() {
+      return RouteMap::import_routes(path / "routes", *network);
+    });
+  });
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable(
+      stations_future.get(), trains_future.get(), schedules_future.get(),
+      *network);
+  GeneralPerformanceOptimizationInstance instance(
+      network, std::move(timetable), routes_future.get(),
+      problem_data_future.get());
+
+  if (import_times != nullptr) {
+    (*import_times)["network"]                  = network_time;
+    (*import_times)["timetable/trains.json"]    = trains_time;
+    (*import_times)["timetable/schedules.json"] = schedules_time;
+    (*import_times)["timetable/stations.json"]  = stations_time;
+    (*import_times)["routes/routes.json"]       = routes_time;
+    (*import_times)["problem_data.json"]        = problem_data_time;
+    (*import_times)["total"] =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+  }
+
+  return instance;
+}
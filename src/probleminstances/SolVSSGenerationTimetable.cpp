@@ -1,3 +1,4 @@
+#include "ColumnFile.hpp"
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
 #include "nlohmann/json.hpp"
@@ -5,9 +6,12 @@
 #include "solver/mip-based/VSSGenTimetableSolver.hpp"
 
 #include <cmath>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <plog/Log.h>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 using json = nlohmann::json;
@@ -280,6 +284,10 @@ void cda_rail::instances::SolVSSGenerationTimetable::export_solution(
    * - train_pos and train_speed are exported to p / solution / train_pos.json
    * and p / solution / train_speed.json The method throws a
    * ConsistencyException if the solution is not consistent.
+   * - If the solution format is binary, train_pos and train_speed are instead
+   * exported to p / solution / trajectories.bin
+   * - Files of the other solution format are removed, the format itself is
+   * stored in data.json
    *
    * @param p the path to the folder where the solution should be exported
    * @param export_instance whether the instance should be exported next to the
@@ -320,6 +328,13 @@ void cda_rail::instances::SolVSSGenerationTimetable::export_solution(
   vss_pos_file << vss_pos_json << std::endl;
   vss_pos_file.close();
 
+  if (get_solution_format() == SolutionFormat::Binary) {
+    export_trajectories_binary(p);
+    remove_solution_files(p, {"train_pos.json", "train_speed.json"});
+    return;
+  }
+  remove_solution_files(p, {"trajectories.bin"});
+
   json train_pos_json;
   json train_speed_json;
   for (size_t tr_id = 0; tr_id < instance.get_train_list().size(); ++tr_id) {
@@ -363,8 +378,8 @@ cda_rail::instances::SolVSSGenerationTimetable::SolVSSGenerationTimetable(
   }
 
   if (import_routes) {
-    this->instance.editable_routes() =
-        RouteMap(p / "instance" / "routes", this->instance.const_n());
+    this->instance.set_routes(
+        RouteMap(p / "instance" / "routes", this->instance.const_n()));
   }
 
   if (!this->instance.check_consistency(true)) {
@@ -394,6 +409,11 @@ cda_rail::instances::SolVSSGenerationTimetable::SolVSSGenerationTimetable(
     set_vss_pos(source_name, target_name, vss_pos_vector);
   }
 
+  if (get_solution_format() == SolutionFormat::Binary) {
+    import_trajectories_binary(p);
+    return;
+  }
+
   // Read train_pos
   std::ifstream train_pos_file(p / "solution" / "train_pos.json");
   json          train_pos_json = json::parse(train_pos_file);
@@ -413,6 +433,49 @@ cda_rail::instances::SolVSSGenerationTimetable::SolVSSGenerationTimetable(
   }
 }
 
+void cda_rail::instances::SolVSSGenerationTimetable::export_trajectories_binary(
+    const std::filesystem::path& p) const {
+  /**
+   * Writes train_pos and train_speed to p / solution / trajectories.bin. For
+   * every train, its name, the first time step and the position and speed
+   * columns are written.
+   */
+
+  ColumnFileWriter writer(p / "solution" / "trajectories.bin");
+  writer.write_size(instance.get_train_list().size());
+  for (size_t tr_id = 0; tr_id < instance.get_train_list().size(); ++tr_id) {
+    const auto tr_t0 = instance.time_index_interval(tr_id, dt, true).first;
+    writer.write_string(instance.get_train_list().get_train(tr_id).name);
+    writer.write_int(static_cast<int64_t>(tr_t0) * dt);
+    writer.write_column(train_pos.at(tr_id));
+    writer.write_column(train_speed.at(tr_id));
+  }
+  writer.close();
+}
+
+void cda_rail::instances::SolVSSGenerationTimetable::import_trajectories_binary(
+    const std::filesystem::path& p) {
+  ColumnFileReader reader(p / "solution" / "trajectories.bin");
+  const auto       num_trains = reader.read_size();
+  for (size_t i = 0; i < num_trains; ++i) {
+    const auto tr_name = reader.read_string();
+    const auto t_0     = reader.read_int();
+    auto       pos     = reader.read_column();
+    auto       speed   = reader.read_column();
+
+    const auto tr_id = instance.get_train_list().get_train_index(tr_name);
+    const auto tr_t0 = instance.time_index_interval(tr_id, dt, true).first;
+    if (t_0 != static_cast<int64_t>(tr_t0) * dt ||
+        pos.size() != train_pos.at(tr_id).size() ||
+        speed.size() != train_speed.at(tr_id).size()) {
+      throw exceptions::ImportException("Time steps of train " + tr_name +
+                                        " do not match the instance");
+    }
+    train_pos.at(tr_id)   = std::move(pos);
+    train_speed.at(tr_id) = std::move(speed);
+  }
+}
+
 void cda_rail::instances::SolVSSGenerationTimetable::initialize_vectors() {
   vss_pos = std::vector<std::vector<double>>(
       this->instance.const_n().number_of_edges());
@@ -628,17 +691,17 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
     sol_obj.reset_routes();
     PLOGD << "Extracting routes";
     for (size_t tr = 0; tr < num_tr; ++tr) {
-      const auto train = instance.get_train_list().get_train(tr);
-      sol_obj.add_empty_route(train.name);
-      size_t current_vertex = instance.get_schedule(tr).get_entry();
+      sol_obj.add_empty_route(instance.get_train_list().get_train(tr).name);
+      // Stays valid while edges are added, since no route is added meanwhile
+      const auto& tr_route       = sol_obj.get_instance().get_route(tr);
+      size_t      current_vertex = instance.get_schedule(tr).get_entry();
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
         std::unordered_set<size_t> edge_list;
         for (int e = 0; e < num_edges; ++e) {
           const auto tr_on_edge =
               vars.at("x").at(tr, t, e).get(GRB_DoubleAttr_X) > 0.5;
-          if (tr_on_edge &&
-              !sol_obj.get_instance().get_route(train.name).contains_edge(e) &&
+          if (tr_on_edge && !tr_route.contains_edge(e) &&
               edge_list.count(e) == 0) {
             edge_list.emplace(e);
           }
@@ -647,7 +710,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
           bool edge_added = false;
           for (const auto& e : edge_list) {
             if (instance.const_n().get_edge(e).source == current_vertex) {
-              sol_obj.push_back_edge_to_route(train.name, e);
+              sol_obj.push_back_edge_to_route(tr, e);
               current_vertex = instance.const_n().get_edge(e).target;
               edge_list.erase(e);
               edge_added = true;
@@ -663,7 +726,6 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
   }
 
   for (size_t tr = 0; tr < num_tr; ++tr) {
-    const auto train = instance.get_train_list().get_train(tr);
     for (size_t t = train_interval[tr].first;
          t <= train_interval[tr].second + 1; ++t) {
       const auto train_speed_val =
@@ -673,9 +735,9 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
   }
 
   for (size_t tr = 0; tr < num_tr; ++tr) {
-    const auto  train  = instance.get_train_list().get_train(tr);
-    const auto& tr_len = train.length;
-    const auto& r_len  = sol_obj.get_instance().route_length(train.name);
+    const auto& tr_len   = instance.get_train_list().get_train(tr).length;
+    const auto& tr_route = sol_obj.get_instance().get_route(tr);
+    const auto  r_len    = tr_route.length(sol_obj.get_instance().const_n());
     for (auto t = train_interval[tr].first; t <= train_interval[tr].second;
          ++t) {
       double train_pos = r_len;
@@ -688,16 +750,15 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
         if (len_in > EPS) {
           train_pos = -len_in;
         } else {
-          for (auto e_index :
-               sol_obj.get_instance().get_route(train.name).get_edges()) {
+          for (auto e_index : tr_route.get_edges()) {
             const bool e_used =
                 vars.at("x").at(tr, t, e_index).get(GRB_DoubleAttr_X) > 0.5;
             if (e_used) {
               const double lda_val =
                   vars.at("e_lda").at(tr, t, e_index).get(GRB_DoubleAttr_X);
-              const double e_pos = sol_obj.get_instance()
-                                       .route_edge_pos(train.name, e_index)
-                                       .first;
+              const double e_pos =
+                  tr_route.edge_pos(e_index, sol_obj.get_instance().const_n())
+                      .first;
               if (lda_val + e_pos < train_pos) {
                 train_pos = lda_val + e_pos;
               }
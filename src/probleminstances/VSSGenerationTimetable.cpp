@@ -17,13 +17,15 @@ void cda_rail::instances::VSSGenerationTimetable::discretize(
 
   const auto new_edges = this->n().discretize(sep_func);
   this->editable_timetable().update_after_discretization(new_edges);
-  this->editable_routes().update_after_discretization(new_edges);
+  this->editable_routes().update_after_discretization(new_edges,
+                                                     this->const_n());
 }
 
 std::vector<size_t>
 cda_rail::instances::VSSGenerationTimetable::trains_at_t(int t) const {
   /**
-   * Returns a list of all trains present at time t.
+   * Returns a list of all trains present at time t. Every train is checked,
+   * for repeated queries use get_train_interval_index instead.
    *
    * @param t the time
    * @return a list of all trains present at time t.
@@ -0,0 +1,90 @@
+#include "solver/mip-based/ConstraintRowBuffer.hpp"
+
+#include "CustomExceptions.hpp"
+#include "gurobi_c++.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+void cda_rail::solver::mip_based::ConstraintRowBuffer::add(
+    const GRBLinExpr& lhs, char sense, const GRBLinExpr& rhs,
+    std::string name) {
+  /**
+   * Adds the row lhs (sense) rhs. All variables are moved to the left-hand
+   * side, all constants to the right-hand side.
+   *
+   * @param lhs: left-hand side of the constraint
+   * @param sense: GRB_LESS_EQUAL, GRB_GREATER_EQUAL or GRB_EQUAL
+   * @param rhs: right-hand side of the constraint
+   * @param name: name of the constraint
+   */
+
+  if (sense != GRB_LESS_EQUAL && sense != GRB_GREATER_EQUAL &&
+      sense != GRB_EQUAL) {
+    throw exceptions::InvalidInputException("Invalid constraint sense.");
+  }
+
+  GRBLinExpr   expr     = lhs - rhs;
+  const double constant = expr.getConstant();
+  expr -= constant;
+
+  exprs.push_back(std::move(expr));
+  senses.push_back(sense);
+  rhs_values.push_back(-constant);
+  names.push_back(std::move(name));
+}
+
+void cda_rail::solver::mip_based::ConstraintRowBuffer::append(
+    ConstraintRowBuffer&& other) {
+  /**
+   * Moves all rows of other to the end of this buffer, keeping their order.
+   */
+
+  exprs.insert(exprs.end(), std::make_move_iterator(other.exprs.begin()),
+               std::make_move_iterator(other.exprs.end()));
+  senses.insert(senses.end(), other.senses.begin(), other.senses.end());
+  rhs_values.insert(rhs_values.end(), other.rhs_values.begin(),
+                    other.rhs_values.end());
+  names.insert(names.end(), std::make_move_iterator(other.names.begin()),
+               std::make_move_iterator(other.names.end()));
+  other.clear();
+}
+
+void cda_rail::solver::mip_based::ConstraintRowBuffer::clear() {
+  exprs.clear();
+  senses.clear();
+  rhs_values.clear();
+  names.clear();
+}
+
+size_t cda_rail::solver::mip_based::ConstraintRowBuffer::add_to_model(
+    GRBModel& model) const {
+  /**
+   * Adds all rows to the model in the order they were added to the buffer.
+   * Must not be called concurrently for the same model.
+   *
+   * @param model: model to add the constraints to
+   *
+   * @return: number of constraints added
+   */
+
+  constexpr auto max_batch_size =
+      static_cast<size_t>(std::numeric_limits<int>::max());
+
+  for (size_t first = 0; first < exprs.size(); first += max_batch_size) {
+    const auto batch_size = std::min(max_batch_size, exprs.size() - first);
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+    const auto* constrs = model.addConstrs(
+        exprs.data() + first, senses.data() + first, rhs_values.data() + first,
+        names.data() + first, static_cast<int>(batch_size));
+    delete[] constrs;
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+  }
+
+  return exprs.size();
+}
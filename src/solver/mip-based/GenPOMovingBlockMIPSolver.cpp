@@ -7,10 +7,15 @@
 #include "solver/mip-based/GeneralMIPSolver.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <optional>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -37,15 +42,25 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
    * @return: respective solution object
    */
 
-  std::optional<LazyCallback> cb;
+  release_model();
+
+  if (solver_strategy_input.check_timetable_conflicts) {
+    if (auto checked_sol = solve_with_timetable_check(
+            model_detail_input, solver_strategy_input, solution_settings_input,
+            time_limit, debug_input);
+        checked_sol.has_value()) {
+      return checked_sol.value();
+    }
+  }
+
   if (solver_strategy_input.use_lazy_constraints) {
-    cb = LazyCallback(this);
-    this->solve_init_general_mip(time_limit, debug_input, &(cb.value()));
+    lazy_callback = LazyCallback(this);
+    this->solve_init_general_mip(debug_input, &(lazy_callback.value()));
   } else {
-    this->solve_init_general_mip(time_limit, debug_input);
+    this->solve_init_general_mip(debug_input);
   }
 
-  if (!instance.n().is_consistent_for_transformation()) {
+  if (!instance.const_n().is_consistent_for_transformation()) {
     PLOGE << "Instance is not consistent for transformation.";
     throw exceptions::ConsistencyException();
   }
@@ -68,6 +83,28 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
 
   model->update();
 
+  const auto pool_fingerprint      = get_lazy_constraint_pool_fingerprint();
+  const auto pool_train_signatures =
+      get_lazy_constraint_pool_train_signatures();
+  if (solver_strategy.use_lazy_constraint_pool) {
+    PLOGD << "Add constraints from lazy constraint pool";
+    const auto num_pool_constraints = lazy_constraint_pool.add_to_model(
+        model.value(), pool_fingerprint, pool_train_signatures,
+        solver_strategy.lazy_constraint_pool_level);
+    model->update();
+    PLOGD << "Added " << num_pool_constraints << " constraints from pool";
+  } else {
+    lazy_constraint_pool.remove_outdated(pool_fingerprint,
+                                         pool_train_signatures);
+  }
+
+  if (!fixed_variable_values.empty() || !start_variable_values.empty()) {
+    PLOGD << "Fix variables and set MIP start";
+    const auto num_applied = apply_variable_values();
+    model->update();
+    PLOGD << "Applied values to " << num_applied << " variables";
+  }
+
   PLOGD << "Fix numerical issues with small coefficients";
   // TODO: Can we prevent this from being necessary by rounding at the source.
   // On the other hand, this does not take long to fix.
@@ -90,31 +127,33 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
   PLOGD << "Fixed " << num_fixed << " coefficients";
 
   PLOGI << "Model created. Optimize.";
-  if (plog::get()->checkSeverity(plog::debug) || time_limit > 0) {
-    model_created = std::chrono::high_resolution_clock::now();
-    create_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      model_created - start)
-                      .count();
-
-    auto time_left = time_limit - create_time / 1000;
-    if (time_left < 0 && time_limit > 0) {
-      time_left = 1;
-    }
-    if (time_limit > 0) {
-      model->set(GRB_DoubleParam_TimeLimit, static_cast<double>(time_left));
-    }
-    PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
-          << " s";
-    if (time_limit > 0) {
-      PLOGD << "Time left: " << time_left << " s";
-    } else {
-      PLOGD << "Time left: "
-            << "No Limit";
-    }
+  model_created = std::chrono::high_resolution_clock::now();
+  create_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    model_created - start)
+                    .count();
+
+  auto time_left = time_limit - create_time / 1000;
+  if (time_left < 0 && time_limit > 0) {
+    time_left = 1;
+  }
+  if (time_limit > 0) {
+    model->set(GRB_DoubleParam_TimeLimit, static_cast<double>(time_left));
+  }
+  PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
+        << " s";
+  if (time_limit > 0) {
+    PLOGD << "Time left: " << time_left << " s";
+  } else {
+    PLOGD << "Time left: "
+          << "No Limit";
   }
 
   if (solver_strategy.use_lazy_constraints) {
     model->set(GRB_IntParam_LazyConstraints, 1);
+    if (solver_strategy.separate_fractional_cuts) {
+      // User cuts refer to the original model
+      model->set(GRB_IntParam_PreCrush, 1);
+    }
   }
 
   PLOGD << "Set absolute MIP gap to " << solver_strategy.abs_mip_gap;
@@ -122,21 +161,29 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
 
   model->optimize();
 
-  IF_PLOG(plog::debug) {
-    model_solved = std::chrono::high_resolution_clock::now();
-    solve_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
-                     model_solved - model_created)
-                     .count();
-    PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
-          << " s";
-    PLOGD << "Model solved in " << (static_cast<double>(solve_time) / 1000.0)
-          << " s";
-    PLOGD << "Total time "
-          << (static_cast<double>(create_time + solve_time) / 1000.0) << " s";
-  }
+  lazy_constraint_pool.store_variable_names(
+      get_lazy_constraint_pool_fingerprint(),
+      get_lazy_constraint_pool_train_signatures());
+  PLOGD << "Lazy constraint pool contains " << lazy_constraint_pool.size()
+        << " constraints, " << lazy_constraint_pool.total_hits()
+        << " of them were separated again";
+
+  model_solved = std::chrono::high_resolution_clock::now();
+  solve_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   model_solved - model_created)
+                   .count();
+  PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
+        << " s";
+  PLOGD << "Model solved in " << (static_cast<double>(solve_time) / 1000.0)
+        << " s";
+  PLOGD << "Total time "
+        << (static_cast<double>(create_time + solve_time) / 1000.0) << " s";
 
   instances::SolGeneralPerformanceOptimizationInstance solution(old_instance);
   extract_solution(solution);
+  if (store_train_variable_values) {
+    extract_train_variable_values();
+  }
 
   if (solution_settings.export_option == ExportOption::ExportLP ||
       solution_settings.export_option == ExportOption::ExportSolutionAndLP ||
@@ -178,9 +225,17 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
     PLOGI << "Saving solution";
     std::filesystem::path path = solution_settings.path;
     path /= solution_settings.name;
+    solution.set_solution_format(solution_settings.solution_format);
     solution.export_solution(path, export_instance);
   }
 
+  if (solver_strategy.keep_model) {
+    PLOGD << "Keep model for subsequent solves";
+    persistent_instance = old_instance;
+    set_start_to_incumbent();
+    return solution;
+  }
+
   cleanup();
 
   this->instance = old_instance;
@@ -205,25 +260,24 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   vars["t_ttd_departure"]   = MultiArray<GRBVar>(num_tr, num_ttd);
 
   for (size_t tr = 0; tr < num_tr; tr++) {
-    const double ub_timing_dept = ub_timing_variable(tr);
-    const auto&  tr_name        = instance.get_train_list().get_train(tr).name;
-    for (const auto v :
-         instance.vertices_used_by_train(tr, model_detail.fix_routes, false)) {
+    const auto& tr_name = instance.get_train_list().get_train(tr).name;
+    for (const auto v : train_usage.vertices_used_by_train(tr)) {
       const auto& v_name = instance.const_n().get_vertex(v).name;
+      const auto  lb_v   = lb_timing_variable(tr, v);
+      const auto  ub_v   = ub_timing_variable(tr, v);
       vars["t_front_arrival"](tr, v) =
-          model->addVar(0.0, ub_timing_dept, 0.0, GRB_CONTINUOUS,
+          model->addVar(lb_v, ub_v, 0.0, GRB_CONTINUOUS,
                         "t_front_arrival_" + tr_name + "_" + v_name);
       vars["t_front_departure"](tr, v) =
-          model->addVar(0.0, ub_timing_dept, 0.0, GRB_CONTINUOUS,
+          model->addVar(lb_v, ub_v, 0.0, GRB_CONTINUOUS,
                         "t_front_departure_" + tr_name + "_" + v_name);
       vars["t_rear_departure"](tr, v) =
-          model->addVar(0.0, ub_timing_dept, 0.0, GRB_CONTINUOUS,
+          model->addVar(lb_v, ub_v, 0.0, GRB_CONTINUOUS,
                         "t_rear_departure_" + tr_name + "_" + v_name);
     }
-    for (const auto& ttd : instance.sections_used_by_train(
-             tr, ttd_sections, model_detail.fix_routes, false)) {
+    for (const auto& ttd : train_usage.sections_used_by_train(tr)) {
       vars["t_ttd_departure"](tr, ttd) = model->addVar(
-          0.0, ub_timing_dept, 0.0, GRB_CONTINUOUS,
+          0.0, ub_ttd_departure(tr, ttd), 0.0, GRB_CONTINUOUS,
           "t_ttd_departure_" + tr_name + "_" + std::to_string(ttd));
     }
   }
@@ -238,22 +292,19 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
   for (size_t tr = 0; tr < num_tr; tr++) {
     const auto& tr_name = instance.get_train_list().get_train(tr).name;
-    for (const auto e :
-         instance.edges_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto e : train_usage.edges_used_by_train(tr)) {
       vars["x"](tr, e) = model->addVar(0.0, 1.0, 0.0, GRB_BINARY,
                                        "x_" + tr_name + "_" +
                                            instance.const_n().get_edge_name(e));
     }
-    for (const auto& ttd : instance.sections_used_by_train(
-             tr, ttd_sections, model_detail.fix_routes, false)) {
+    for (const auto& ttd : train_usage.sections_used_by_train(tr)) {
       vars["x_ttd"](tr, ttd) =
           model->addVar(0.0, 1.0, 0.0, GRB_BINARY,
                         "x_ttd_" + tr_name + "_" + std::to_string(ttd));
     }
   }
   for (size_t e = 0; e < num_edges; e++) {
-    const auto tr_on_e = instance.trains_on_edge_mixed_routing(
-        e, model_detail.fix_routes, false);
+    const auto& tr_on_e = train_usage.trains_on_edge(e);
     const auto& e_name = instance.const_n().get_edge_name(e);
     for (const auto& tr1 : tr_on_e) {
       const auto& tr1_name = instance.get_train_list().get_train(tr1).name;
@@ -268,8 +319,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     }
   }
   for (size_t ttd = 0; ttd < num_ttd; ttd++) {
-    const auto tr_on_ttd = instance.trains_in_section(
-        ttd_sections.at(ttd), model_detail.fix_routes, false);
+    const auto& tr_on_ttd = train_usage.trains_in_section(ttd);
     for (const auto& tr1 : tr_on_ttd) {
       const auto& tr1_name = instance.get_train_list().get_train(tr1).name;
       for (const auto& tr2 : tr_on_ttd) {
@@ -320,8 +370,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
   for (size_t tr = 0; tr < num_tr; tr++) {
     const auto& train = instance.get_train_list().get_train(tr);
-    for (const auto e :
-         instance.edges_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto e : train_usage.edges_used_by_train(tr)) {
       const auto& edge = instance.const_n().get_edge(e);
       const auto& edge_name =
           instance.const_n().get_edge_name(edge.source, edge.target);
@@ -362,11 +411,10 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
   for (size_t idx = 0; idx < relevant_reverse_edges.size(); idx++) {
     const auto& [e1, e2] = relevant_reverse_edges.at(idx);
-    const auto tr_list =
-        instance.trains_in_section({e1, e2}, model_detail.fix_routes, false);
-    const auto  e_obj   = instance.const_n().get_edge(e1);
-    const auto& v1_name = instance.const_n().get_vertex(e_obj.source).name;
-    const auto& v2_name = instance.const_n().get_vertex(e_obj.target).name;
+    const auto  tr_list  = train_usage.trains_on_edges({e1, e2});
+    const auto  e_obj    = instance.const_n().get_edge(e1);
+    const auto& v1_name  = instance.const_n().get_vertex(e_obj.source).name;
+    const auto& v2_name  = instance.const_n().get_vertex(e_obj.target).name;
     for (size_t idx_tr1 = 0; idx_tr1 < tr_list.size(); idx_tr1++) {
       const auto  tr1      = tr_list.at(idx_tr1);
       const auto& tr1_name = instance.get_train_list().get_train(tr1).name;
@@ -414,6 +462,10 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   create_train_rear_constraints();
   PLOGD << "Create stopping constraints";
   create_stopping_constraints();
+  if (this->model_detail.break_train_symmetries) {
+    PLOGD << "Create symmetry breaking constraints";
+    create_symmetry_breaking_constraints();
+  }
   if (!solver_strategy.use_lazy_constraints) {
     PLOGD << "Create basic order constraints";
     create_basic_order_constraints();
@@ -431,6 +483,68 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   }
 }
 
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    add_rows_in_parallel(
+        size_t num_items,
+        const std::function<void(size_t, ConstraintRowBuffer&)>&
+            create_item_rows) {
+  /**
+   * Calls create_item_rows for every item in [0, num_items), e.g., every
+   * train, without touching the model. Items are distributed dynamically over
+   * the threads specified by model_creation_threads, each item writing into a
+   * buffer of its own. Afterward, all rows are added to the model using a
+   * single batched call. Rows are ordered by item, which coincides with the
+   * order of a sequential creation.
+   */
+
+  size_t num_threads = solver_strategy.model_creation_threads;
+  if (num_threads == 0) {
+    num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  num_threads = std::max<size_t>(std::min(num_threads, num_items), 1);
+
+  std::vector<ConstraintRowBuffer> item_rows(num_items);
+  std::atomic<size_t>              next_item{0};
+
+  const auto worker = [&]() {
+    for (size_t item = next_item++; item < num_items; item = next_item++) {
+      create_item_rows(item, item_rows[item]);
+    }
+  };
+
+  if (num_threads == 1) {
+    worker();
+  } else {
+    std::vector<std::thread>        threads;
+    std::vector<std::exception_ptr> exceptions(num_threads);
+    threads.reserve(num_threads);
+    for (size_t thread_idx = 0; thread_idx < num_threads; thread_idx++) {
+      threads.emplace_back([&worker, &exceptions, thread_idx]() {
+        try {
+          worker();
+        } catch (...) {
+          exceptions[thread_idx] = std::current_exception();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& exception : exceptions) {
+      if (exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+
+  ConstraintRowBuffer rows;
+  for (auto& buffer : item_rows) {
+    rows.append(std::move(buffer));
+  }
+  const auto num_rows = rows.add_to_model(model.value());
+  PLOGD << "Added " << num_rows << " constraints";
+}
+
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     fill_tr_stop_data() {
   tr_stop_data.clear();
@@ -443,8 +557,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     tr_data.reserve(instance.get_schedule(tr).get_stops().size());
     for (const auto& stop : instance.get_schedule(tr).get_stops()) {
       tr_data.emplace_back(instance.possible_stop_vertices(
-          tr, stop.get_station_name(),
-          instance.edges_used_by_train(tr, model_detail.fix_routes, false)));
+          tr, stop.get_station_name(), train_usage.edges_used_by_train(tr)));
     }
     tr_stop_data.emplace_back(tr_data);
   }
@@ -483,8 +596,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       std::vector<double> v_velocity_extensions = {0};
       const double        max_vertex_speed      = std::min(
           instance.const_n().maximal_vertex_speed(
-              v,
-              instance.edges_used_by_train(tr, model_detail.fix_routes, false)),
+              v, train_usage.edges_used_by_train(tr)),
           tr_max_speed);
       double speed = 0;
       while (speed < max_vertex_speed) {
@@ -520,8 +632,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
       const double max_vertex_speed = std::min(
           instance.const_n().maximal_vertex_speed(
-              v,
-              instance.edges_used_by_train(tr, model_detail.fix_routes, false)),
+              v, train_usage.edges_used_by_train(tr)),
           tr_max_speed);
       double min_n_length =
           instance.const_n().minimal_neighboring_edge_length(v);
@@ -586,25 +697,27 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   this->solution_settings = solution_settings_input;
   this->solver_strategy   = solver_strategy_input;
   this->model_detail      = model_detail_input;
-  this->ttd_sections      = instance.n().unbreakable_sections();
+  this->ttd_sections      = instance.const_n().unbreakable_sections();
   this->num_ttd           = this->ttd_sections.size();
+  this->train_usage       = instance.get_train_usage_index(
+      this->ttd_sections, model_detail.fix_routes, false);
   this->fill_tr_stop_data();
   this->fill_velocity_extensions();
   this->fill_relevant_reverse_edges();
+  this->fill_vertex_time_bounds();
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_general_path_constraints() {
-  for (size_t tr = 0; tr < num_tr; tr++) {
+  add_rows_in_parallel(num_tr, [this](size_t tr, ConstraintRowBuffer& rows) {
     const auto& tr_object = instance.get_train_list().get_train(tr);
-    for (const auto& e :
-         instance.edges_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto& e : train_usage.edges_used_by_train(tr)) {
       const auto&      edge       = instance.const_n().get_edge(e);
       const auto&      source_obj = instance.const_n().get_vertex(edge.source);
       const auto&      target_obj = instance.const_n().get_vertex(edge.target);
       const auto&      v1_values  = velocity_extensions.at(tr).at(edge.source);
       const auto&      v2_values  = velocity_extensions.at(tr).at(edge.target);
-      const GRBLinExpr lhs        = vars["x"](tr, e);
+      const GRBLinExpr lhs        = vars.at("x")(tr, e);
       GRBLinExpr       rhs        = 0;
       const auto tmp_max_speed = std::min(tr_object.max_speed, edge.max_speed);
       for (size_t i = 0; i < v1_values.size(); i++) {
@@ -618,74 +731,65 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           if (cda_rail::possible_by_eom(v1_values.at(i), v2_values.at(j),
                                         tr_object.acceleration,
                                         tr_object.deceleration, edge.length)) {
-            rhs += vars["y"](tr, e, i, j);
+            rhs += vars.at("y")(tr, e, i, j);
           }
         }
       }
       // Edge is used if one of the velocity extended arcs is used
-      model->addConstr(lhs == rhs, "aggregate_edge_velocity_extension_" +
-                                       tr_object.name + "_" + source_obj.name +
-                                       "-" + target_obj.name);
+      rows.add(lhs, GRB_EQUAL, rhs, "aggregate_edge_velocity_extension_" +
+                                        tr_object.name + "_" + source_obj.name +
+                                        "-" + target_obj.name);
     }
     const auto& schedule = instance.get_schedule(tr);
     const auto& entry    = schedule.get_entry();
     const auto& exit     = schedule.get_exit();
-    const auto  edges_used_by_train =
-        instance.edges_used_by_train(tr, model_detail.fix_routes, false);
-    for (const auto& v :
-         instance.vertices_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto& v : train_usage.vertices_used_by_train(tr)) {
       if (v == entry) {
         GRBLinExpr lhs = 0;
         for (const auto& e : instance.const_n().out_edges(v)) {
-          if (std::find(edges_used_by_train.begin(), edges_used_by_train.end(),
-                        e) != edges_used_by_train.end()) {
-            lhs += vars["x"](tr, e);
+          if (train_usage.uses_edge(tr, e)) {
+            lhs += vars.at("x")(tr, e);
           }
         }
         // The entry vertex is only left but not entered
-        model->addConstr(lhs == 1, "entry_vertex_" + tr_object.name + "_" +
-                                       instance.const_n().get_vertex(v).name);
+        rows.add(lhs, GRB_EQUAL, 1, "entry_vertex_" + tr_object.name + "_" +
+                                        instance.const_n().get_vertex(v).name);
       } else if (v == exit) {
         GRBLinExpr lhs = 0;
         for (const auto& e : instance.const_n().in_edges(v)) {
-          if (std::find(edges_used_by_train.begin(), edges_used_by_train.end(),
-                        e) != edges_used_by_train.end()) {
-            lhs += vars["x"](tr, e);
+          if (train_usage.uses_edge(tr, e)) {
+            lhs += vars.at("x")(tr, e);
           }
         }
         // The exit vertex is only entered but not left
-        model->addConstr(lhs == 1, "exit_vertex_" + tr_object.name + "_" +
-                                       instance.const_n().get_vertex(v).name);
+        rows.add(lhs, GRB_EQUAL, 1, "exit_vertex_" + tr_object.name + "_" +
+                                        instance.const_n().get_vertex(v).name);
       } else {
         GRBLinExpr x_in_edges  = 0;
         GRBLinExpr x_out_edges = 0;
         for (const auto& e : instance.const_n().in_edges(v)) {
-          if (std::find(edges_used_by_train.begin(), edges_used_by_train.end(),
-                        e) != edges_used_by_train.end()) {
-            x_in_edges += vars["x"](tr, e);
+          if (train_usage.uses_edge(tr, e)) {
+            x_in_edges += vars.at("x")(tr, e);
           }
         }
         for (const auto& e : instance.const_n().out_edges(v)) {
-          if (std::find(edges_used_by_train.begin(), edges_used_by_train.end(),
-                        e) != edges_used_by_train.end()) {
-            x_out_edges += vars["x"](tr, e);
+          if (train_usage.uses_edge(tr, e)) {
+            x_out_edges += vars.at("x")(tr, e);
           }
         }
         // All other vertices are entered and left at most once
-        model->addConstr(x_in_edges <= 1,
-                         "in_edges_" + tr_object.name + "_" +
-                             instance.const_n().get_vertex(v).name);
-        model->addConstr(x_out_edges <= 1,
-                         "out_edges_" + tr_object.name + "_" +
-                             instance.const_n().get_vertex(v).name);
+        rows.add(x_in_edges, GRB_LESS_EQUAL, 1,
+                 "in_edges_" + tr_object.name + "_" +
+                     instance.const_n().get_vertex(v).name);
+        rows.add(x_out_edges, GRB_LESS_EQUAL, 1,
+                 "out_edges_" + tr_object.name + "_" +
+                     instance.const_n().get_vertex(v).name);
         const auto& v1_values = velocity_extensions.at(tr).at(v);
         for (size_t i = 0; i < v1_values.size(); i++) {
           GRBLinExpr lhs = 0;
           GRBLinExpr rhs = 0;
           for (const auto& e : instance.const_n().in_edges(v)) {
-            if (std::find(edges_used_by_train.begin(),
-                          edges_used_by_train.end(),
-                          e) != edges_used_by_train.end()) {
+            if (train_usage.uses_edge(tr, e)) {
               const auto& edge = instance.const_n().get_edge(e);
               const auto& v2_values =
                   velocity_extensions.at(tr).at(edge.source);
@@ -702,15 +806,13 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                               tr_object.acceleration,
                                               tr_object.deceleration,
                                               edge.length)) {
-                  lhs += vars["y"](tr, e, j, i);
+                  lhs += vars.at("y")(tr, e, j, i);
                 }
               }
             }
           }
           for (const auto& e : instance.const_n().out_edges(v)) {
-            if (std::find(edges_used_by_train.begin(),
-                          edges_used_by_train.end(),
-                          e) != edges_used_by_train.end()) {
+            if (train_usage.uses_edge(tr, e)) {
               const auto& edge = instance.const_n().get_edge(e);
               const auto  tmp_max_speed =
                   std::min(tr_object.max_speed, edge.max_speed);
@@ -727,24 +829,23 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                               tr_object.acceleration,
                                               tr_object.deceleration,
                                               edge.length)) {
-                  rhs += vars["y"](tr, e, i, j);
+                  rhs += vars.at("y")(tr, e, i, j);
                 }
               }
             }
           }
           // And they fulfill a flow condition
-          model->addConstr(lhs == rhs,
-                           "vertex_velocity_extension_flow_condition_" +
-                               tr_object.name + "_" +
-                               instance.const_n().get_vertex(v).name + "_" +
-                               std::to_string(v1_values.at(i)));
+          rows.add(lhs, GRB_EQUAL, rhs,
+                   "vertex_velocity_extension_flow_condition_" +
+                       tr_object.name + "_" +
+                       instance.const_n().get_vertex(v).name + "_" +
+                       std::to_string(v1_values.at(i)));
         }
       }
     }
 
     // Prevent illegal paths
-    for (const auto& e :
-         instance.edges_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto& e : train_usage.edges_used_by_train(tr)) {
       const auto& e_object  = instance.const_n().get_edge(e);
       const auto& v2        = e_object.target;
       const auto& out_edges = instance.const_n().out_edges(v2);
@@ -752,27 +853,25 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       const auto& v2_name = instance.const_n().get_vertex(v2).name;
       for (const auto& e2 : out_edges) {
         if (!instance.const_n().is_valid_successor(e, e2) &&
-            std::find(edges_used_by_train.begin(), edges_used_by_train.end(),
-                      e2) != edges_used_by_train.end()) {
+            train_usage.uses_edge(tr, e2)) {
           const auto& v3_name =
               instance.const_n()
                   .get_vertex(instance.const_n().get_edge(e2).target)
                   .name;
-          model->addConstr(vars["x"](tr, e) + vars["x"](tr, e2) <= 1,
-                           "illegal_path_" + tr_object.name + "_" + v1_name +
-                               "-" + v2_name + "-" + v3_name);
+          rows.add(vars.at("x")(tr, e) + vars.at("x")(tr, e2), GRB_LESS_EQUAL,
+                   1, "illegal_path_" + tr_object.name + "_" + v1_name + "-" +
+                          v2_name + "-" + v3_name);
         }
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_travel_times_constraints() {
-  for (size_t tr = 0; tr < num_tr; tr++) {
+  add_rows_in_parallel(num_tr, [this](size_t tr, ConstraintRowBuffer& rows) {
     const auto& tr_object = instance.get_train_list().get_train(tr);
-    for (const auto& e :
-         instance.edges_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto& e : train_usage.edges_used_by_train(tr)) {
       const auto& edge          = instance.const_n().get_edge(e);
       const auto& v1_values     = velocity_extensions.at(tr).at(edge.source);
       const auto& v2_values     = velocity_extensions.at(tr).at(edge.target);
@@ -796,16 +895,16 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             const auto& max_t_arc = cda_rail::max_travel_time(
                 v1_values.at(i), v2_values.at(j), V_MIN, tr_object.acceleration,
                 tr_object.deceleration, edge.length, edge.breakable);
-            model->addConstr(
-                vars["t_front_arrival"](tr, edge.target) +
-                        (ub_timing_variable(tr) + min_t_arc) *
-                            (1 - vars["y"](tr, e, i, j)) >=
-                    vars["t_front_departure"](tr, edge.source) + min_t_arc,
-                "edge_minimal_travel_time_" + tr_object.name + "_" +
-                    instance.const_n().get_vertex(edge.source).name + "-" +
-                    instance.const_n().get_vertex(edge.target).name + "_" +
-                    std::to_string(v1_values.at(i)) + "-" +
-                    std::to_string(v2_values.at(j)));
+            rows.add(vars.at("t_front_arrival")(tr, edge.target) +
+                         (ub_timing_variable(tr) + min_t_arc) *
+                             (1 - vars.at("y")(tr, e, i, j)),
+                     GRB_GREATER_EQUAL,
+                     vars.at("t_front_departure")(tr, edge.source) + min_t_arc,
+                     "edge_minimal_travel_time_" + tr_object.name + "_" +
+                         instance.const_n().get_vertex(edge.source).name + "-" +
+                         instance.const_n().get_vertex(edge.target).name + "_" +
+                         std::to_string(v1_values.at(i)) + "-" +
+                         std::to_string(v2_values.at(j)));
 
             if (max_t_arc >= std::numeric_limits<double>::infinity()) {
               continue;
@@ -813,30 +912,27 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
             // t_front_arrival <= t_rear_departure + maximal travel time if arc
             // is used
-            model->addConstr(
-                vars["t_front_arrival"](tr, edge.target) <=
-                    vars["t_front_departure"](tr, edge.source) + max_t_arc +
-                        (ub_timing_variable(tr) - max_t_arc) *
-                            (1 - vars["y"](tr, e, i, j)),
-                "edge_maximal_travel_time_" + tr_object.name + "_" +
-                    instance.const_n().get_vertex(edge.source).name + "-" +
-                    instance.const_n().get_vertex(edge.target).name + "_" +
-                    std::to_string(v1_values.at(i)) + "-" +
-                    std::to_string(v2_values.at(j)));
+            rows.add(vars.at("t_front_arrival")(tr, edge.target),
+                     GRB_LESS_EQUAL,
+                     vars.at("t_front_departure")(tr, edge.source) + max_t_arc +
+                         (ub_timing_variable(tr) - max_t_arc) *
+                             (1 - vars.at("y")(tr, e, i, j)),
+                     "edge_maximal_travel_time_" + tr_object.name + "_" +
+                         instance.const_n().get_vertex(edge.source).name + "-" +
+                         instance.const_n().get_vertex(edge.target).name + "_" +
+                         std::to_string(v1_values.at(i)) + "-" +
+                         std::to_string(v2_values.at(j)));
           }
         }
       }
     }
 
-    const auto e_used_tr =
-        instance.edges_used_by_train(tr, model_detail.fix_routes, false);
-    for (const auto& v :
-         instance.vertices_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto& v : train_usage.vertices_used_by_train(tr)) {
       // t_front_departure >= t_front_arrival
-      model->addConstr(vars["t_front_departure"](tr, v) >=
-                           vars["t_front_arrival"](tr, v),
-                       "tr_dep_after_arrival_" + tr_object.name + "_" +
-                           instance.const_n().get_vertex(v).name);
+      rows.add(vars.at("t_front_departure")(tr, v), GRB_GREATER_EQUAL,
+               vars.at("t_front_arrival")(tr, v),
+               "tr_dep_after_arrival_" + tr_object.name + "_" +
+                   instance.const_n().get_vertex(v).name);
 
       if (velocity_extensions.at(tr).at(v).at(0) != 0) {
         continue;
@@ -846,8 +942,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       // vertex v
       GRBLinExpr speed_0_arcs = 0;
       for (const auto& e_in : instance.const_n().in_edges(v)) {
-        if (std::find(e_used_tr.begin(), e_used_tr.end(), e_in) !=
-            e_used_tr.end()) {
+        if (train_usage.uses_edge(tr, e_in)) {
           const auto& e_in_object = instance.const_n().get_edge(e_in);
           const auto& v1_velocities =
               velocity_extensions.at(tr).at(e_in_object.source);
@@ -861,14 +956,13 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             if (cda_rail::possible_by_eom(
                     v1_velocities.at(i), 0, tr_object.acceleration,
                     tr_object.deceleration, e_in_object.length)) {
-              speed_0_arcs += vars["y"](tr, e_in, i, 0);
+              speed_0_arcs += vars.at("y")(tr, e_in, i, 0);
             }
           }
         }
       }
       for (const auto& e_out : instance.const_n().out_edges(v)) {
-        if (std::find(e_used_tr.begin(), e_used_tr.end(), e_out) !=
-            e_used_tr.end()) {
+        if (train_usage.uses_edge(tr, e_out)) {
           const auto& e_out_object = instance.const_n().get_edge(e_out);
           const auto& v2_velocities =
               velocity_extensions.at(tr).at(e_out_object.target);
@@ -882,18 +976,18 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             if (cda_rail::possible_by_eom(
                     0, v2_velocities.at(i), tr_object.acceleration,
                     tr_object.deceleration, e_out_object.length)) {
-              speed_0_arcs += vars["y"](tr, e_out, 0, i);
+              speed_0_arcs += vars.at("y")(tr, e_out, 0, i);
             }
           }
         }
       }
-      model->addConstr(vars["t_front_departure"](tr, v) <=
-                           vars["t_front_arrival"](tr, v) +
-                               ub_timing_variable(tr) * speed_0_arcs,
-                       "tr_might_stop_at_vertex_" + tr_object.name + "_" +
-                           instance.const_n().get_vertex(v).name);
+      rows.add(vars.at("t_front_departure")(tr, v), GRB_LESS_EQUAL,
+               vars.at("t_front_arrival")(tr, v) +
+                   ub_timing_variable(tr) * speed_0_arcs,
+               "tr_might_stop_at_vertex_" + tr_object.name + "_" +
+                   instance.const_n().get_vertex(v).name);
     }
-  }
+  });
 }
 
 double
@@ -903,53 +997,239 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::ub_timing_variable(
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
-    create_basic_order_constraints() {
+    fill_vertex_time_bounds() {
+  /**
+   * Bound propagation for the timing variables. A train cannot be at vertex v
+   * before its earliest entry plus the minimal travel time from its entry to
+   * v. Moreover, it must have left v early enough to reach its exit by its
+   * latest exit time. Minimal travel times assume maximal speed on every edge
+   * the train might use. If v cannot be on a route of the train, the default
+   * bounds are kept.
+   */
+
+  vertex_time_bounds.clear();
+  ttd_departure_ubs.clear();
+  vertex_time_bounds.reserve(num_tr);
+  ttd_departure_ubs.reserve(num_tr);
+  for (size_t tr = 0; tr < num_tr; tr++) {
+    const auto ub_tr = ub_timing_variable(tr);
+    vertex_time_bounds.emplace_back(num_vertices, std::make_pair(0.0, ub_tr));
+    ttd_departure_ubs.emplace_back(num_ttd, ub_tr);
+    if (!model_detail.tighten_timing_bounds) {
+      continue;
+    }
+
+    const auto& tr_schedule = instance.get_schedule(tr);
+    const auto  from_entry =
+        get_minimal_travel_times(tr, tr_schedule.get_entry(), true);
+    const auto to_exit =
+        get_minimal_travel_times(tr, tr_schedule.get_exit(), false);
+    for (size_t v = 0; v < num_vertices; v++) {
+      if (std::isinf(from_entry.at(v)) || std::isinf(to_exit.at(v))) {
+        continue;
+      }
+      const auto lb_v = std::max(
+          0.0, tr_schedule.get_t_0_range().first + from_entry.at(v));
+      const auto ub_v =
+          std::min(ub_tr, tr_schedule.get_t_n_range().second - to_exit.at(v));
+      if (lb_v <= ub_v) {
+        vertex_time_bounds.at(tr).at(v) = {lb_v, ub_v};
+      }
+    }
+
+    // A TTD section is left when the rear departs from the last vertex
+    for (const auto ttd : train_usage.sections_used_by_train(tr)) {
+      double ub_ttd = 0;
+      for (const auto& e : ttd_sections.at(ttd)) {
+        if (train_usage.uses_edge(tr, e)) {
+          const auto& target = instance.const_n().get_edge(e).target;
+          ub_ttd             = std::max(ub_ttd, ub_timing_variable(tr, target));
+        }
+      }
+      ttd_departure_ubs.at(tr).at(ttd) = ub_ttd;
+    }
+  }
+}
+
+std::vector<double> cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    get_minimal_travel_times(size_t tr, size_t v, bool forward) const {
+  /**
+   * Computes the minimal travel times of a train from v to every vertex (if
+   * forward is true) or from every vertex to v (otherwise) using Dijkstra's
+   * algorithm. Only edges that might be used by the train are considered, on
+   * which it travels at maximal speed. Unreachable vertices have infinite
+   * travel time.
+   */
+
+  const auto& tr_object = instance.get_train_list().get_train(tr);
+
+  return instance.const_n().shortest_path_distances(
+      {v}, [this, tr](size_t e) { return train_usage.uses_edge(tr, e); },
+      [&tr_object](const Edge& edge) {
+        return edge.length / std::min(tr_object.max_speed, edge.max_speed);
+      },
+      forward);
+}
+
+double
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::get_headway_big_m(
+    size_t tr, size_t v, double rhs_ub, double default_big_m) const {
+  /**
+   * Big-M for a constraint of the form t(tr, v) + M * (...) >= rhs, where rhs
+   * is at most rhs_ub. The smallest valid value is rhs_ub minus the lower
+   * bound of the timing variables of tr at v. The default value is never
+   * exceeded.
+   */
+
+  if (!model_detail.tighten_timing_bounds) {
+    return default_big_m;
+  }
+  return std::min(default_big_m,
+                  std::max(0.0, rhs_ub - lb_timing_variable(tr, v)));
+}
+
+std::string cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    get_lazy_constraint_pool_fingerprint() const {
+  /**
+   * Identifies everything the keys of the lazy constraint pool depend on,
+   * i.e., the train indices, the (discretized) network, the TTD sections and
+   * the velocity extensions. The data the coefficients depend on is
+   * identified per train, see get_lazy_constraint_pool_train_signatures.
+   */
+
+  std::string fingerprint;
+  for (size_t tr = 0; tr < num_tr; tr++) {
+    fingerprint += instance.get_train_list().get_train(tr).name + ";";
+  }
+  fingerprint += "|" + std::to_string(num_vertices) + "|";
   for (size_t e = 0; e < num_edges; e++) {
-    const auto& tr_on_edge = instance.trains_on_edge_mixed_routing(
-        e, model_detail.fix_routes, false);
-    const auto e_obj = instance.const_n().get_edge(e);
-    const auto v1    = instance.const_n().get_vertex(e_obj.source);
-    const auto v2    = instance.const_n().get_vertex(e_obj.target);
+    const auto& edge = instance.const_n().get_edge(e);
+    fingerprint +=
+        std::to_string(edge.source) + "-" + std::to_string(edge.target) + ";";
+  }
+  fingerprint += "|" + std::to_string(num_ttd) + "|" +
+                 std::to_string(relevant_reverse_edges.size()) + "|" +
+                 std::to_string(model_detail.max_velocity_delta) + "|" +
+                 std::to_string(static_cast<int>(
+                     model_detail.velocity_refinement_strategy));
+  return fingerprint;
+}
+
+std::vector<size_t> cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    get_lazy_constraint_pool_train_signatures() const {
+  /**
+   * Identifies for every train the data the coefficients of its lazy
+   * constraints depend on, i.e., its parameters and schedule, the lengths,
+   * speeds and headways of the edges and vertices it might use, as well as
+   * the resulting velocity extensions and timing bounds. The signatures are
+   * hashes, hence, they are only comparable within the same build.
+   */
+
+  const auto time_range_to_string = [](const std::pair<int, int>& range) {
+    return std::to_string(range.first) + "," + std::to_string(range.second);
+  };
+
+  std::vector<size_t> signatures;
+  signatures.reserve(num_tr);
+  for (size_t tr = 0; tr < num_tr; tr++) {
+    const auto& tr_object   = instance.get_train_list().get_train(tr);
+    const auto& tr_schedule = instance.get_schedule(tr);
+    std::string signature =
+        std::to_string(tr_object.length) + "," +
+        std::to_string(tr_object.max_speed) + "," +
+        std::to_string(tr_object.acceleration) + "," +
+        std::to_string(tr_object.deceleration) + "," +
+        time_range_to_string(tr_schedule.get_t_0_range()) + "," +
+        std::to_string(tr_schedule.get_v_0()) + "," +
+        std::to_string(tr_schedule.get_entry()) + "," +
+        time_range_to_string(tr_schedule.get_t_n_range()) + "," +
+        std::to_string(tr_schedule.get_v_n()) + "," +
+        std::to_string(tr_schedule.get_exit());
+    for (const auto& stop : tr_schedule.get_stops()) {
+      signature += "," + stop.get_station_name() + "," +
+                   time_range_to_string(stop.get_begin_range()) + "," +
+                   time_range_to_string(stop.get_end_range()) + "," +
+                   std::to_string(stop.get_min_stopping_time());
+    }
+    signature += "|";
+    for (const auto e : train_usage.edges_used_by_train(tr)) {
+      const auto& edge = instance.const_n().get_edge(e);
+      signature += std::to_string(e) + ":" + std::to_string(edge.length) +
+                   "," + std::to_string(edge.max_speed) + "," +
+                   std::to_string(static_cast<int>(edge.breakable)) + "," +
+                   std::to_string(edge.min_block_length) + "," +
+                   std::to_string(edge.min_stop_block_length) + ";";
+    }
+    signature += "|";
+    for (const auto v : train_usage.vertices_used_by_train(tr)) {
+      signature += std::to_string(v) + ":" +
+                   std::to_string(instance.const_n().get_vertex(v).headway) +
+                   ";";
+    }
+    signature += "|";
+    for (size_t v = 0; v < num_vertices; v++) {
+      for (const auto vel : velocity_extensions.at(tr).at(v)) {
+        signature += std::to_string(vel) + ",";
+      }
+      const auto& [lb_v, ub_v] = vertex_time_bounds.at(tr).at(v);
+      signature += std::to_string(lb_v) + "," + std::to_string(ub_v) + ";";
+    }
+    signature += "|";
+    for (const auto ub_ttd : ttd_departure_ubs.at(tr)) {
+      signature += std::to_string(ub_ttd) + ";";
+    }
+    signatures.push_back(std::hash<std::string>{}(signature));
+  }
+  return signatures;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    create_basic_order_constraints() {
+  add_rows_in_parallel(num_edges, [this](size_t e, ConstraintRowBuffer& rows) {
+    const auto& tr_on_edge = train_usage.trains_on_edge(e);
+    const auto  e_obj      = instance.const_n().get_edge(e);
+    const auto  v1         = instance.const_n().get_vertex(e_obj.source);
+    const auto  v2         = instance.const_n().get_vertex(e_obj.target);
     for (const auto& tr1 : tr_on_edge) {
       for (const auto& tr2 : tr_on_edge) {
         if (tr1 == tr2) {
           continue;
         }
 
-        model->addConstr(
-            vars["order"](tr1, tr2, e) + vars["order"](tr2, tr1, e) <=
-                0.5 * (vars["x"](tr1, e) + vars["x"](tr2, e)),
-            "edge_order_1_" + instance.get_train_list().get_train(tr1).name +
-                "_" + instance.get_train_list().get_train(tr2).name + "_" +
-                v1.name + "-" + v2.name);
-
-        model->addConstr(
-            vars["order"](tr1, tr2, e) + vars["order"](tr2, tr1, e) >=
-                vars["x"](tr1, e) + vars["x"](tr2, e) - 1,
-            "edge_order_2_" + instance.get_train_list().get_train(tr1).name +
-                "_" + instance.get_train_list().get_train(tr2).name + "_" +
-                v1.name + "-" + v2.name);
+        rows.add(vars.at("order")(tr1, tr2, e) + vars.at("order")(tr2, tr1, e),
+                 GRB_LESS_EQUAL,
+                 0.5 * (vars.at("x")(tr1, e) + vars.at("x")(tr2, e)),
+                 "edge_order_1_" +
+                     instance.get_train_list().get_train(tr1).name + "_" +
+                     instance.get_train_list().get_train(tr2).name + "_" +
+                     v1.name + "-" + v2.name);
+
+        rows.add(vars.at("order")(tr1, tr2, e) + vars.at("order")(tr2, tr1, e),
+                 GRB_GREATER_EQUAL,
+                 vars.at("x")(tr1, e) + vars.at("x")(tr2, e) - 1,
+                 "edge_order_2_" +
+                     instance.get_train_list().get_train(tr1).name + "_" +
+                     instance.get_train_list().get_train(tr2).name + "_" +
+                     v1.name + "-" + v2.name);
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_train_rear_constraints() {
-  for (size_t tr = 0; tr < num_tr; tr++) {
+  add_rows_in_parallel(num_tr, [this](size_t tr, ConstraintRowBuffer& rows) {
     // Rear departure time is equal to front departure time at certain position
-    const auto& tr_object = instance.get_train_list().get_train(tr);
-    const auto& schedule  = instance.get_schedule(tr);
-    const auto& exit      = schedule.get_exit();
-    const auto& v_n       = schedule.get_v_n();
-    const auto  edges_used_by_train =
-        instance.edges_used_by_train(tr, model_detail.fix_routes, false);
+    const auto& tr_object           = instance.get_train_list().get_train(tr);
+    const auto& schedule            = instance.get_schedule(tr);
+    const auto& exit                = schedule.get_exit();
+    const auto& v_n                 = schedule.get_v_n();
+    const auto& edges_used_by_train = train_usage.edges_used_by_train(tr);
 
     // NOLINTNEXTLINE(readability-identifier-naming)
     const auto M = ub_timing_variable(tr);
 
-    for (const auto& v :
-         instance.vertices_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto& v : train_usage.vertices_used_by_train(tr)) {
       if (v == exit) {
         // In case the train has partially left the network use edge case
         // constraints
@@ -961,8 +1241,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         const auto          in_edges          = instance.const_n().in_edges(v);
         std::vector<size_t> relevant_in_edges = {};
         for (const auto& e : in_edges) {
-          if (std::find(edges_used_by_train.begin(), edges_used_by_train.end(),
-                        e) != edges_used_by_train.end()) {
+          if (train_usage.uses_edge(tr, e)) {
             relevant_in_edges.push_back(e);
           }
         }
@@ -997,9 +1276,9 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                         tr_object.acceleration, tr_object.deceleration,
                         e_in_object.length)) {
                   min_travel_time_expr +=
-                      vars["y"](tr, e_in, j, i) * min_t_to_full_exit;
+                      vars.at("y")(tr, e_in, j, i) * min_t_to_full_exit;
                   max_travel_time_expr +=
-                      vars["y"](tr, e_in, j, i) * max_t_to_full_exit;
+                      vars.at("y")(tr, e_in, j, i) * max_t_to_full_exit;
                 }
               }
             }
@@ -1024,30 +1303,27 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                         v1_velocities.at(j), v_exit_velocity,
                         tr_object.acceleration, tr_object.deceleration,
                         e_in_object.length)) {
-                  model->addConstr(
-                      vars["y"](tr, e_in, j, i) == 0,
-                      "y_exit_velocity_" + std::to_string(v_exit_velocity) +
-                          "_not_possible_from_" +
-                          std::to_string(v1_velocities.at(j)) + "_at_" +
-                          e_in_source_vertex.name + "_tr_" + tr_object.name);
+                  rows.add(vars.at("y")(tr, e_in, j, i), GRB_EQUAL, 0,
+                           "y_exit_velocity_" +
+                               std::to_string(v_exit_velocity) +
+                               "_not_possible_from_" +
+                               std::to_string(v1_velocities.at(j)) + "_at_" +
+                               e_in_source_vertex.name + "_tr_" +
+                               tr_object.name);
                 }
               }
             }
           }
         }
-        model->addConstr(vars["t_rear_departure"](tr, v) >=
-                             vars["t_front_departure"](tr, v) +
-                                 min_travel_time_expr,
-                         "rear_departure_vertex_c1_" + tr_object.name + "_" +
-                             instance.const_n().get_vertex(v).name);
-        model->addConstr(vars["t_rear_departure"](tr, v) <=
-                             vars["t_front_departure"](tr, v) +
-                                 max_travel_time_expr,
-                         "rear_departure_vertex_c2_" + tr_object.name + "_" +
-                             instance.const_n()
-                                 .get_vertex(v)
-                                 .name); // not needed because objective pushes
-                                         // rear departure down
+        rows.add(vars.at("t_rear_departure")(tr, v), GRB_GREATER_EQUAL,
+                 vars.at("t_front_departure")(tr, v) + min_travel_time_expr,
+                 "rear_departure_vertex_c1_" + tr_object.name + "_" +
+                     instance.const_n().get_vertex(v).name);
+        // not needed because objective pushes rear departure down
+        rows.add(vars.at("t_rear_departure")(tr, v), GRB_LESS_EQUAL,
+                 vars.at("t_front_departure")(tr, v) + max_travel_time_expr,
+                 "rear_departure_vertex_c2_" + tr_object.name + "_" +
+                     instance.const_n().get_vertex(v).name);
       } else {
         // Otherwise deduce limits from last path edge
         const auto possible_paths =
@@ -1065,10 +1341,10 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           const auto& last_edge     = p.back();
           const auto& last_edge_obj = instance.const_n().get_edge(last_edge);
 
-          GRBLinExpr lhs = vars["t_rear_departure"](tr, v) +
+          GRBLinExpr lhs = vars.at("t_rear_departure")(tr, v) +
                            M * static_cast<double>(p.size());
           for (const auto& e_p : p) {
-            lhs -= M * vars["x"](tr, e_p);
+            lhs -= M * vars.at("x")(tr, e_p);
           }
 
           if (last_edge_obj.target == exit &&
@@ -1119,25 +1395,27 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                           v1_velocities.at(j), v_exit_velocity,
                           tr_object.acceleration, tr_object.deceleration,
                           last_edge_obj.length)) {
-                    min_travel_time_expr +=
-                        vars["y"](tr, last_edge, j, i) * min_t_to_required_pos;
-                    max_travel_time_expr +=
-                        vars["y"](tr, last_edge, j, i) * max_t_to_required_pos;
+                    min_travel_time_expr += vars.at("y")(tr, last_edge, j, i) *
+                                            min_t_to_required_pos;
+                    max_travel_time_expr += vars.at("y")(tr, last_edge, j, i) *
+                                            max_t_to_required_pos;
                   }
                 }
               }
             }
 
-            model->addConstr(lhs >= vars["t_front_departure"](tr, exit) +
-                                        min_travel_time_expr,
-                             "rear_departure_half_leaving_1_" + tr_object.name +
-                                 "_" + instance.const_n().get_vertex(v).name +
-                                 "_" + std::to_string(p_ind));
-            model->addConstr(lhs <= vars["t_front_departure"](tr, exit) +
-                                        max_travel_time_expr,
-                             "rear_departure_half_leaving_2_" + tr_object.name +
-                                 "_" + instance.const_n().get_vertex(v).name +
-                                 "_" + std::to_string(p_ind));
+            rows.add(lhs, GRB_GREATER_EQUAL,
+                     vars.at("t_front_departure")(tr, exit) +
+                         min_travel_time_expr,
+                     "rear_departure_half_leaving_1_" + tr_object.name + "_" +
+                         instance.const_n().get_vertex(v).name + "_" +
+                         std::to_string(p_ind));
+            rows.add(lhs, GRB_LESS_EQUAL,
+                     vars.at("t_front_departure")(tr, exit) +
+                         max_travel_time_expr,
+                     "rear_departure_half_leaving_2_" + tr_object.name + "_" +
+                         instance.const_n().get_vertex(v).name + "_" +
+                         std::to_string(p_ind));
 
           } else {
             // The relevant point is on an actual edge
@@ -1152,18 +1430,18 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
             if (rel_pt_on_edge + 1e-6 >= last_edge_obj.length) {
               // Directly use corresponding variable
-              model->addConstr(
-                  lhs >= vars["t_front_departure"](tr, last_edge_obj.target),
-                  "rear_departure_2_" + tr_object.name + "_" +
-                      instance.const_n().get_vertex(v).name + "_" +
-                      std::to_string(p_ind));
+              rows.add(lhs, GRB_GREATER_EQUAL,
+                       vars.at("t_front_departure")(tr, last_edge_obj.target),
+                       "rear_departure_2_" + tr_object.name + "_" +
+                           instance.const_n().get_vertex(v).name + "_" +
+                           std::to_string(p_ind));
             } else {
               // Only in this case there is no corresponding variable. Note that
               // objective pushes rear departure down.
               GRBLinExpr t_ref_1 =
-                  vars["t_front_departure"](tr, last_edge_obj.source);
+                  vars.at("t_front_departure")(tr, last_edge_obj.source);
               GRBLinExpr t_ref_2 =
-                  vars["t_front_arrival"](tr, last_edge_obj.target);
+                  vars.at("t_front_arrival")(tr, last_edge_obj.target);
               const auto v_max_rel_e =
                   std::min(last_edge_obj.max_speed, tr_object.max_speed);
               for (size_t i = 0; i < v_0_velocities.size(); i++) {
@@ -1178,7 +1456,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                           v_0_velocities.at(i), v_1_velocities.at(j),
                           tr_object.acceleration, tr_object.deceleration,
                           last_edge_obj.length)) {
-                    t_ref_1 += vars["y"](tr, last_edge, i, j) *
+                    t_ref_1 += vars.at("y")(tr, last_edge, i, j) *
                                cda_rail::min_travel_time_from_start(
                                    v_0_velocities.at(i), v_1_velocities.at(j),
                                    v_max_rel_e, tr_object.acceleration,
@@ -1190,7 +1468,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                             tr_object.acceleration, tr_object.deceleration,
                             last_edge_obj.length, rel_pt_on_edge,
                             last_edge_obj.breakable);
-                    t_ref_2 -= vars["y"](tr, last_edge, i, j) *
+                    t_ref_2 -= vars.at("y")(tr, last_edge, i, j) *
                                (max_travel_time >=
                                         std::numeric_limits<double>::infinity()
                                     ? M
@@ -1199,25 +1477,51 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 }
               }
 
-              model->addConstr(lhs >= t_ref_1,
-                               "rear_departure_1_" + tr_object.name + "_" +
-                                   instance.const_n().get_vertex(v).name + "_" +
-                                   std::to_string(p_ind));
-              model->addConstr(lhs >= t_ref_2,
-                               "rear_departure_2_" + tr_object.name + "_" +
-                                   instance.const_n().get_vertex(v).name + "_" +
-                                   std::to_string(p_ind));
+              rows.add(lhs, GRB_GREATER_EQUAL, t_ref_1,
+                       "rear_departure_1_" + tr_object.name + "_" +
+                           instance.const_n().get_vertex(v).name + "_" +
+                           std::to_string(p_ind));
+              rows.add(lhs, GRB_GREATER_EQUAL, t_ref_2,
+                       "rear_departure_2_" + tr_object.name + "_" +
+                           instance.const_n().get_vertex(v).name + "_" +
+                           std::to_string(p_ind));
             }
           }
         }
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_stopping_constraints() {
+  // Auxiliary variables for the possible paths of every stop vertex, indexed
+  // by train, stop, vertex (as in tr_stop_data) and path. They are added
+  // upfront because the model must not be modified while creating rows.
+  // The following variables should be binary, however since only one
+  // direction of inference is needed, continuous should suffice
+  std::vector<std::vector<std::vector<std::vector<GRBVar>>>> stop_path_vars(
+      num_tr);
   for (size_t tr = 0; tr < num_tr; tr++) {
+    const auto& tr_object = instance.get_train_list().get_train(tr);
+    const auto& tr_stops  = instance.get_schedule(tr).get_stops();
+    stop_path_vars.at(tr).resize(tr_stops.size());
+    for (size_t stop = 0; stop < tr_stops.size(); stop++) {
+      const auto& stop_station_name = tr_stops.at(stop).get_station_name();
+      for (const auto& [v, paths] : tr_stop_data.at(tr).at(stop)) {
+        auto& v_path_vars = stop_path_vars.at(tr).at(stop).emplace_back();
+        for (size_t p_index = 0; p_index < paths.size(); p_index++) {
+          v_path_vars.push_back(model->addVar(
+              0.0, 1.0, 0.0, GRB_CONTINUOUS,
+              "stop_path_" + tr_object.name + "_" + stop_station_name +
+                  "_vertex_" + instance.const_n().get_vertex(v).name +
+                  "_path_" + std::to_string(p_index)));
+        }
+      }
+    }
+  }
+
+  add_rows_in_parallel(num_tr, [&](size_t tr, ConstraintRowBuffer& rows) {
     const auto& tr_object = instance.get_train_list().get_train(tr);
     // NOLINTNEXTLINE(readability-identifier-naming)
     const auto M = ub_timing_variable(tr);
@@ -1230,117 +1534,164 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       const auto& stop_object       = tr_stops.at(stop);
       const auto& stop_station_name = stop_object.get_station_name();
       GRBLinExpr  lhs               = 0;
-      for (const auto& [v, paths] : stop_data) {
-        lhs += vars["stop"](tr, stop, v);
+      for (size_t v_idx = 0; v_idx < stop_data.size(); v_idx++) {
+        const auto& [v, paths] = stop_data.at(v_idx);
+        lhs += vars.at("stop")(tr, stop, v);
 
         // If stopped then t_front_departure - t_front_arrival >= stop_time,
         // otherwise unconstrained Hence, >= stop_time * stop
-        model->addConstr(
-            vars["t_front_departure"](tr, v) - vars["t_front_arrival"](tr, v) >=
-                stop_object.get_min_stopping_time() * vars["stop"](tr, stop, v),
-            "min_stop_time_" + tr_object.name + "_" + stop_station_name +
-                "_vertex_" + instance.const_n().get_vertex(v).name);
+        rows.add(vars.at("t_front_departure")(tr, v) -
+                     vars.at("t_front_arrival")(tr, v),
+                 GRB_GREATER_EQUAL, stop_object.get_min_stopping_time() *
+                                        vars.at("stop")(tr, stop, v),
+                 "min_stop_time_" + tr_object.name + "_" + stop_station_name +
+                     "_vertex_" + instance.const_n().get_vertex(v).name);
 
         // If stopped then t_front_arrival is within desired arrival interval
         const auto t_0_interval = stop_object.get_begin_range();
         // t >= t_0 * stop
-        model->addConstr(vars["t_front_arrival"](tr, v) >=
-                             t_0_interval.first * vars["stop"](tr, stop, v),
-                         "min_arrival_time_" + tr_object.name + "_" +
-                             stop_station_name + "_vertex_" +
-                             instance.const_n().get_vertex(v).name);
+        rows.add(vars.at("t_front_arrival")(tr, v), GRB_GREATER_EQUAL,
+                 t_0_interval.first * vars.at("stop")(tr, stop, v),
+                 "min_arrival_time_" + tr_object.name + "_" +
+                     stop_station_name + "_vertex_" +
+                     instance.const_n().get_vertex(v).name);
         // t <= t_0 + M * (1 - stop)
-        model->addConstr(
-            vars["t_front_arrival"](tr, v) <=
-                t_0_interval.second + M * (1 - vars["stop"](tr, stop, v)),
-            "max_arrival_time_" + tr_object.name + "_" + stop_station_name +
-                "_vertex_" + instance.const_n().get_vertex(v).name);
+        rows.add(vars.at("t_front_arrival")(tr, v), GRB_LESS_EQUAL,
+                 t_0_interval.second + M * (1 - vars.at("stop")(tr, stop, v)),
+                 "max_arrival_time_" + tr_object.name + "_" +
+                     stop_station_name + "_vertex_" +
+                     instance.const_n().get_vertex(v).name);
 
         // If stopped then t_front_departure is within desired departure
         // interval
         const auto t_n_interval = stop_object.get_end_range();
         // t >= t_n * stop
-        model->addConstr(vars["t_front_departure"](tr, v) >=
-                             t_n_interval.first * vars["stop"](tr, stop, v),
-                         "min_departure_time_" + tr_object.name + "_" +
-                             stop_station_name + "_vertex_" +
-                             instance.const_n().get_vertex(v).name);
+        rows.add(vars.at("t_front_departure")(tr, v), GRB_GREATER_EQUAL,
+                 t_n_interval.first * vars.at("stop")(tr, stop, v),
+                 "min_departure_time_" + tr_object.name + "_" +
+                     stop_station_name + "_vertex_" +
+                     instance.const_n().get_vertex(v).name);
         // t <= t_n + M * (1 - stop)
-        model->addConstr(
-            vars["t_front_departure"](tr, v) <=
-                t_n_interval.second + M * (1 - vars["stop"](tr, stop, v)),
-            "max_departure_time_" + tr_object.name + "_" + stop_station_name +
-                "_vertex_" + instance.const_n().get_vertex(v).name);
+        rows.add(vars.at("t_front_departure")(tr, v), GRB_LESS_EQUAL,
+                 t_n_interval.second + M * (1 - vars.at("stop")(tr, stop, v)),
+                 "max_departure_time_" + tr_object.name + "_" +
+                     stop_station_name + "_vertex_" +
+                     instance.const_n().get_vertex(v).name);
 
         // Train can only stop if one of the valid edge paths is used
         GRBLinExpr path_expr = 0;
         for (size_t p_index = 0; p_index < paths.size(); p_index++) {
           const auto& p = paths.at(p_index);
-          // The following variable should be binary, however since only one
-          // direction of inference is needed, continuous should suffice
-          const auto tmp_var = model->addVar(
-              0.0, 1.0, 0.0, GRB_CONTINUOUS,
-              "stop_path_" + tr_object.name + "_" + stop_station_name +
-                  "_vertex_" + instance.const_n().get_vertex(v).name +
-                  "_path_" + std::to_string(p_index));
+          const auto& tmp_var =
+              stop_path_vars.at(tr).at(stop).at(v_idx).at(p_index);
           path_expr += tmp_var;
           for (const auto& e : p) {
-            model->addConstr(tmp_var <= vars["x"](tr, e),
-                             "stop_path_" + tr_object.name + "_" +
-                                 stop_station_name + "_vertex_" +
-                                 instance.const_n().get_vertex(v).name +
-                                 "_path_" + std::to_string(p_index) + "_edge_" +
-                                 std::to_string(e));
+            rows.add(tmp_var, GRB_LESS_EQUAL, vars.at("x")(tr, e),
+                     "stop_path_" + tr_object.name + "_" + stop_station_name +
+                         "_vertex_" + instance.const_n().get_vertex(v).name +
+                         "_path_" + std::to_string(p_index) + "_edge_" +
+                         std::to_string(e));
           }
-          model->addConstr(vars["stop"](tr, stop, v) >= tmp_var,
-                           "use_path_only_if_stopped_" + tr_object.name + "_" +
-                               stop_station_name + "_vertex_" +
-                               instance.const_n().get_vertex(v).name +
-                               "_path_" + std::to_string(p_index));
+          rows.add(vars.at("stop")(tr, stop, v), GRB_GREATER_EQUAL, tmp_var,
+                   "use_path_only_if_stopped_" + tr_object.name + "_" +
+                       stop_station_name + "_vertex_" +
+                       instance.const_n().get_vertex(v).name + "_path_" +
+                       std::to_string(p_index));
         }
-        model->addConstr(vars["stop"](tr, stop, v) <= path_expr,
-                         "stop_only_if_path_is_used_" + tr_object.name + "_" +
-                             stop_station_name + "_vertex_" +
-                             instance.const_n().get_vertex(v).name);
+        rows.add(vars.at("stop")(tr, stop, v), GRB_LESS_EQUAL, path_expr,
+                 "stop_only_if_path_is_used_" + tr_object.name + "_" +
+                     stop_station_name + "_vertex_" +
+                     instance.const_n().get_vertex(v).name);
       }
-      model->addConstr(lhs == 1,
-                       "stop_at_one_vertex_" +
-                           instance.get_train_list().get_train(tr).name + "_" +
-                           stop_station_name);
+      rows.add(lhs, GRB_EQUAL, 1,
+               "stop_at_one_vertex_" +
+                   instance.get_train_list().get_train(tr).name + "_" +
+                   stop_station_name);
     }
 
     // Initial
     const auto& t0_range = tr_schedule.get_t_0_range();
-    model->addConstr(vars["t_front_arrival"](tr, tr_schedule.get_entry()) >=
-                         t0_range.first,
-                     "initial_arrival_time_lb_" + tr_object.name);
-    model->addConstr(vars["t_front_arrival"](tr, tr_schedule.get_entry()) <=
-                         t0_range.second,
-                     "initial_arrival_time_ub_" + tr_object.name);
+    rows.add(vars.at("t_front_arrival")(tr, tr_schedule.get_entry()),
+             GRB_GREATER_EQUAL, t0_range.first,
+             "initial_arrival_time_lb_" + tr_object.name);
+    rows.add(vars.at("t_front_arrival")(tr, tr_schedule.get_entry()),
+             GRB_LESS_EQUAL, t0_range.second,
+             "initial_arrival_time_ub_" + tr_object.name);
 
     // Final
     const auto& tn_range = tr_schedule.get_t_n_range();
-    model->addConstr(vars["t_rear_departure"](tr, tr_schedule.get_exit()) >=
-                         tn_range.first,
-                     "final_departure_time_lb_" + tr_object.name);
-    model->addConstr(vars["t_rear_departure"](tr, tr_schedule.get_exit()) <=
-                         tn_range.second,
-                     "final_departure_time_ub_" + tr_object.name);
+    rows.add(vars.at("t_rear_departure")(tr, tr_schedule.get_exit()),
+             GRB_GREATER_EQUAL, tn_range.first,
+             "final_departure_time_lb_" + tr_object.name);
+    rows.add(vars.at("t_rear_departure")(tr, tr_schedule.get_exit()),
+             GRB_LESS_EQUAL, tn_range.second,
+             "final_departure_time_ub_" + tr_object.name);
+  });
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    create_symmetry_breaking_constraints() {
+  /**
+   * Interchangeable trains (identical properties, schedules, routes, weights
+   * and optionality) lead to symmetric solutions. Within every class of such
+   * trains, the entry times are ordered by train index, which keeps at least
+   * one optimal solution.
+   * Trains whose entry time is fixed beforehand are excluded, since they
+   * cannot be swapped with the other trains of their class.
+   */
+
+  symmetry_breaking_pairs.clear();
+  for (const auto& train_class :
+       instance.get_interchangeable_train_classes()) {
+    std::vector<size_t> free_trains;
+    for (const auto tr : train_class) {
+      const auto& tr_name = instance.get_train_list().get_train(tr).name;
+      const auto& entry_name =
+          instance.const_n()
+              .get_vertex(instance.get_schedule(tr).get_entry())
+              .name;
+      if (fixed_variable_values.count("t_front_arrival_" + tr_name + "_" +
+                                      entry_name) == 0) {
+        free_trains.push_back(tr);
+      }
+    }
+
+    IF_PLOG(plog::debug) {
+      std::string class_str;
+      for (const auto tr : train_class) {
+        class_str += (class_str.empty() ? "" : ", ") +
+                     instance.get_train_list().get_train(tr).name;
+      }
+      PLOGD << "Interchangeable trains: " << class_str << " ("
+            << free_trains.size() << " not fixed)";
+    }
+
+    for (size_t idx = 1; idx < free_trains.size(); idx++) {
+      const auto tr1 = free_trains.at(idx - 1);
+      const auto tr2 = free_trains.at(idx);
+      // Interchangeable trains share the entry vertex
+      const auto entry = instance.get_schedule(tr1).get_entry();
+      model->addConstr(
+          vars["t_front_arrival"](tr1, entry) <=
+              vars["t_front_arrival"](tr2, entry),
+          "symmetry_breaking_" +
+              instance.get_train_list().get_train(tr1).name + "_" +
+              instance.get_train_list().get_train(tr2).name);
+      symmetry_breaking_pairs.emplace_back(tr1, tr2);
+    }
   }
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_headway_constraints() {
-  for (size_t tr = 0; tr < num_tr; tr++) {
-    const auto& tr_object = instance.get_train_list().get_train(tr);
-    const auto  tr_used_edges =
-        instance.edges_used_by_train(tr, model_detail.fix_routes, false);
+  add_rows_in_parallel(num_tr, [this](size_t tr, ConstraintRowBuffer& rows) {
+    const auto& tr_object          = instance.get_train_list().get_train(tr);
+    const auto& tr_used_edges      = train_usage.edges_used_by_train(tr);
     const auto& tr_schedule_object = instance.get_schedule(tr);
     const auto& entry_node         = tr_schedule_object.get_entry();
     const auto  t_bound            = ub_timing_variable(tr);
 
-    for (const auto v :
-         instance.vertices_used_by_train(tr, model_detail.fix_routes, false)) {
+    for (const auto v : train_usage.vertices_used_by_train(tr)) {
       const auto v_velocities = velocity_extensions.at(tr).at(v);
       for (size_t v_source_index = 0; v_source_index < v_velocities.size();
            v_source_index++) {
@@ -1371,8 +1722,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               std::min(tr_object.max_speed,
                        instance.const_n().get_edge(p.front()).max_speed);
 
-          const auto tr_on_last_edge = instance.trains_on_edge_mixed_routing(
-              p.back(), model_detail.fix_routes, false);
+          const auto& tr_on_last_edge = train_usage.trains_on_edge(p.back());
 
           const auto& last_edge_object = instance.const_n().get_edge(p.back());
 
@@ -1383,17 +1733,16 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
             const auto t_bound_tmp = std::max(t_bound, ub_timing_variable(tr2));
 
-            const GRBLinExpr lhs =
-                vars["t_front_arrival"](tr, v) +
-                t_bound_tmp * (static_cast<double>(p.size()) - edge_path_expr) +
-                t_bound_tmp * (1 - vars["order"](tr, tr2, p.back()));
+            // Upper bound on all right hand sides, used for big-M
+            double                  rhs_ub = 0;
             std::vector<GRBLinExpr> rhs;
             if (p_len + EPS >= bd && p_len - EPS <= bd) {
               // Target vertex is exactly the desired moving authority
               // t_front_departure(tr, v) >= t_rear_departure(tr2, target) if
               // order(tr, tr2, e) = 1 and path p chosen.
               rhs.emplace_back(
-                  vars["t_rear_departure"](tr2, last_edge_object.target));
+                  vars.at("t_rear_departure")(tr2, last_edge_object.target));
+              rhs_ub = ub_timing_variable(tr2, last_edge_object.target);
             } else {
               assert(p_len > bd && p_len - last_edge_object.length <= bd);
               const auto  target_point = bd - p_len + last_edge_object.length;
@@ -1402,12 +1751,13 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               const auto& v_tr2_target_velocities =
                   velocity_extensions.at(tr2).at(last_edge_object.target);
               rhs.emplace_back(
-                  vars["t_rear_departure"](tr2, last_edge_object.source));
+                  vars.at("t_rear_departure")(tr2, last_edge_object.source));
               rhs.emplace_back(
-                  vars["t_rear_departure"](tr2, last_edge_object.target));
+                  vars.at("t_rear_departure")(tr2, last_edge_object.target));
               const auto& tr2_object = instance.get_train_list().get_train(tr2);
               const auto  max_speed =
                   std::min(tr2_object.max_speed, last_edge_object.max_speed);
+              double max_min_travel_time = 0;
               for (size_t v_tr2_source_index = 0;
                    v_tr2_source_index < v_tr2_source_velocities.size();
                    v_tr2_source_index++) {
@@ -1430,13 +1780,16 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                                 last_edge_object.length)) {
                     // first: += y * min_t
                     // second: -= y * max_t
-                    rhs.at(0) +=
-                        vars["y"](tr2, p.back(), v_tr2_source_index,
-                                  v_tr2_target_index) *
+                    const auto min_travel_time =
                         cda_rail::min_travel_time_from_start(
                             vel_tr2_source, vel_tr2_target, max_speed,
                             tr2_object.acceleration, tr2_object.deceleration,
                             last_edge_object.length, target_point);
+                    max_min_travel_time =
+                        std::max(max_min_travel_time, min_travel_time);
+                    rhs.at(0) += vars.at("y")(tr2, p.back(), v_tr2_source_index,
+                                           v_tr2_target_index) *
+                                 min_travel_time;
                     const auto max_travel_time =
                         cda_rail::max_travel_time_to_end(
                             vel_tr2_source, vel_tr2_target, V_MIN,
@@ -1444,22 +1797,31 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                             last_edge_object.length, target_point,
                             last_edge_object.breakable);
                     rhs.at(1) -=
-                        vars["y"](tr2, p.back(), v_tr2_source_index,
+                        vars.at("y")(tr2, p.back(), v_tr2_source_index,
                                   v_tr2_target_index) *
                         (max_travel_time > t_bound_tmp ? t_bound_tmp
                                                        : max_travel_time);
                   }
                 }
               }
+              rhs_ub = std::max(
+                  ub_timing_variable(tr2, last_edge_object.source) +
+                      max_min_travel_time,
+                  ub_timing_variable(tr2, last_edge_object.target));
             }
+
+            const auto big_m = get_headway_big_m(tr, v, rhs_ub, t_bound_tmp);
+            const GRBLinExpr lhs =
+                vars.at("t_front_arrival")(tr, v) +
+                big_m * (static_cast<double>(p.size()) - edge_path_expr) +
+                big_m * (1 - vars.at("order")(tr, tr2, p.back()));
             for (size_t rhs_idx = 0; rhs_idx < rhs.size(); rhs_idx++) {
-              model->addConstr(
-                  lhs >= rhs.at(rhs_idx),
-                  "headway_" + std::to_string(rhs_idx) + "-" +
-                      std::to_string(rhs.size()) + "_" + tr_object.name + "_" +
-                      instance.get_train_list().get_train(tr2).name + "_" +
-                      instance.const_n().get_vertex(v).name + "_" +
-                      std::to_string(vel) + "_" + std::to_string(p_index));
+              rows.add(lhs, GRB_GREATER_EQUAL, rhs.at(rhs_idx),
+                       "headway_" + std::to_string(rhs_idx) + "-" +
+                           std::to_string(rhs.size()) + "_" + tr_object.name +
+                           "_" + instance.get_train_list().get_train(tr2).name +
+                           "_" + instance.const_n().get_vertex(v).name + "_" +
+                           std::to_string(vel) + "_" + std::to_string(p_index));
             }
           }
 
@@ -1476,15 +1838,14 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 });
             GRBLinExpr edge_tmp_path_expr = 0;
             for (const auto& e_tmp : p_tmp) {
-              edge_tmp_path_expr += vars["x"](tr, e_tmp);
+              edge_tmp_path_expr += vars.at("x")(tr, e_tmp);
             }
 
             const auto obd = bd - p_tmp_len;
 
             assert(obd >= 0);
 
-            const auto tr_on_ttd = instance.trains_in_section(
-                ttd_sections.at(ttd_index), model_detail.fix_routes, false);
+            const auto& tr_on_ttd = train_usage.trains_in_section(ttd_index);
             for (const auto& tr2 : tr_on_ttd) {
               if (tr == tr2) {
                 continue;
@@ -1494,12 +1855,12 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                   std::max(t_bound, ub_timing_variable(tr2));
 
               GRBLinExpr lhs_from_rear =
-                  vars["t_front_arrival"](tr, v) +
+                  vars.at("t_front_arrival")(tr, v) +
                   t_bound_tmp *
                       (static_cast<double>(p_tmp.size()) - edge_tmp_path_expr);
               const GRBLinExpr rhs =
-                  vars["t_ttd_departure"](tr2, ttd_index) +
-                  t_bound_tmp * (vars["order_ttd"](tr, tr2, ttd_index) - 1);
+                  vars.at("t_ttd_departure")(tr2, ttd_index) +
+                  t_bound_tmp * (vars.at("order_ttd")(tr, tr2, ttd_index) - 1);
 
               bool is_relevant = obd < GRB_EPS;
 
@@ -1515,8 +1876,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 } else {
                   std::vector<size_t> rel_in_edges;
                   for (const auto& e : instance.const_n().in_edges(v)) {
-                    if (std::find(tr_used_edges.begin(), tr_used_edges.end(),
-                                  e) != tr_used_edges.end()) {
+                    if (train_usage.uses_edge(tr, e)) {
                       rel_in_edges.push_back(e);
                     }
                   }
@@ -1549,7 +1909,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                               vel_before_v, vel, tr_object.acceleration,
                               tr_object.deceleration, e_before_v_obj.length)) {
                         lhs_from_rear -=
-                            vars["y"](tr, e_before_v, v_before_v_index,
+                            vars.at("y")(tr, e_before_v, v_before_v_index,
                                       v_source_index) *
                             cda_rail::min_time_from_rear_to_ma_point(
                                 vel_before_v, vel, V_MIN, e_before_v_tmp_max,
@@ -1564,15 +1924,15 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                 e_before_v_obj.length, obd,
                                 e_before_v_obj.breakable);
                         const GRBLinExpr lhs_from_front =
-                            vars["t_front_departure"](tr, v_before_v) +
+                            vars.at("t_front_departure")(tr, v_before_v) +
                             std::min(max_from_front, t_bound_tmp) +
                             t_bound_tmp *
                                 (static_cast<double>(p_tmp.size()) + 1 -
-                                 vars["y"](tr, e_before_v, v_before_v_index,
+                                 vars.at("y")(tr, e_before_v, v_before_v_index,
                                            v_source_index) -
                                  edge_tmp_path_expr);
-                        model->addConstr(
-                            lhs_from_front >= rhs,
+                        rows.add(
+                            lhs_from_front, GRB_GREATER_EQUAL, rhs,
                             "headway_ttd_" + std::to_string(ttd_index) +
                                 "from_front_" + tr_object.name + "_" +
                                 instance.get_train_list().get_train(tr2).name +
@@ -1587,20 +1947,20 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 }
               }
               if (is_relevant) {
-                model->addConstr(
-                    lhs_from_rear >= rhs,
-                    "headway_ttd_" + tr_object.name + "_" +
-                        instance.get_train_list().get_train(tr2).name + "_" +
-                        instance.const_n().get_vertex(v).name + "_" +
-                        std::to_string(vel) + "_" + std::to_string(p_index) +
-                        "_" + std::to_string(ttd_index));
+                rows.add(lhs_from_rear, GRB_GREATER_EQUAL, rhs,
+                         "headway_ttd_" + tr_object.name + "_" +
+                             instance.get_train_list().get_train(tr2).name +
+                             "_" + instance.const_n().get_vertex(v).name + "_" +
+                             std::to_string(vel) + "_" +
+                             std::to_string(p_index) + "_" +
+                             std::to_string(ttd_index));
               }
             }
           }
         }
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
@@ -1610,12 +1970,11 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   // No problem if the solution is only used as a starting solution to fix some
   // parameters
 
-  for (size_t tr = 0; tr < num_tr; tr++) {
+  add_rows_in_parallel(num_tr, [this](size_t tr, ConstraintRowBuffer& rows) {
     const auto& tr_object = instance.get_train_list().get_train(tr);
     const auto  t_bound   = ub_timing_variable(tr);
 
-    for (const auto e : instance.edges_used_by_train(
-             tr, this->model_detail.fix_routes, false)) {
+    for (const auto e : train_usage.edges_used_by_train(tr)) {
       const auto& e_obj           = instance.const_n().get_edge(e);
       const auto& v_source        = e_obj.source;
       const auto& v_target        = e_obj.target;
@@ -1627,24 +1986,25 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
       // departure because ma might move forward, otherwise arrival and
       // departure are equal due to non-zero velocity
-      GRBVar tr_t_var = vars["t_front_departure"](tr, v_source);
+      GRBVar tr_t_var = vars.at("t_front_departure")(tr, v_source);
 
-      const auto tr_on_e = instance.trains_on_edge_mixed_routing(
-          e, model_detail.fix_routes, false);
+      const auto& tr_on_e = train_usage.trains_on_edge(e);
       for (const auto& tr2 : tr_on_e) {
         if (tr == tr2) {
           continue;
         }
         const auto t_bound_tmp = std::max(t_bound, ub_timing_variable(tr2));
-        const auto tr2_t_var   = vars["t_rear_departure"](tr2, v_target);
-
-        model->addConstr(
-            tr_t_var - tr2_t_var +
-                    (t_bound_tmp + hw_max) * (1 - vars["order"](tr, tr2, e)) >=
-                headway_tr_on_e,
-            "headway_simplified_" + tr_object.name + "_" +
-                instance.get_train_list().get_train(tr2).name + "_" +
-                v_source_object.name + "_" + v_target_object.name);
+        const auto tr2_t_var   = vars.at("t_rear_departure")(tr2, v_target);
+        const auto big_m       = get_headway_big_m(
+            tr, v_source, ub_timing_variable(tr2, v_target) + hw_max,
+            t_bound_tmp + hw_max);
+
+        rows.add(tr_t_var - tr2_t_var +
+                     big_m * (1 - vars.at("order")(tr, tr2, e)),
+                 GRB_GREATER_EQUAL, headway_tr_on_e,
+                 "headway_simplified_" + tr_object.name + "_" +
+                     instance.get_train_list().get_train(tr2).name + "_" +
+                     v_source_object.name + "_" + v_target_object.name);
       }
 
       // TTD constraint on entering edge
@@ -1665,36 +2025,35 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             });
         if (is_entering_edge) {
           // We need a constraint for each other train in the TTD section
-          const auto tr_on_ttd = instance.trains_in_section(
-              ttd_section, model_detail.fix_routes, false);
+          const auto& tr_on_ttd = train_usage.trains_in_section(ttd_index);
           for (const auto& tr2 : tr_on_ttd) {
             if (tr == tr2) {
               continue;
             }
             const auto t_bound_tmp = std::max(t_bound, ub_timing_variable(tr2));
-            const auto tr2_t_var   = vars["t_ttd_departure"](tr2, ttd_index);
-            model->addConstr(
-                tr_t_var - tr2_t_var +
-                        (t_bound_tmp + hw_max_ttd) *
-                            (1 - vars["order_ttd"](tr, tr2, ttd_index)) >=
-                    headway_tr_on_ttd,
-                "headway_simplified_ttd_" + tr_object.name + "_" +
-                    instance.get_train_list().get_train(tr2).name + "_" +
-                    v_source_object.name + "_" + v_target_object.name + "_ttd" +
-                    std::to_string(ttd_index));
+            const auto tr2_t_var   = vars.at("t_ttd_departure")(tr2, ttd_index);
+            const auto big_m       = get_headway_big_m(
+                tr, v_source, ub_ttd_departure(tr2, ttd_index) + hw_max_ttd,
+                t_bound_tmp + hw_max_ttd);
+            rows.add(tr_t_var - tr2_t_var +
+                         big_m * (1 - vars.at("order_ttd")(tr, tr2, ttd_index)),
+                     GRB_GREATER_EQUAL, headway_tr_on_ttd,
+                     "headway_simplified_ttd_" + tr_object.name + "_" +
+                         instance.get_train_list().get_train(tr2).name + "_" +
+                         v_source_object.name + "_" + v_target_object.name +
+                         "_ttd" + std::to_string(ttd_index));
           }
         }
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_basic_ttd_constraints() {
-  for (size_t i = 0; i < ttd_sections.size(); i++) {
+  add_rows_in_parallel(num_ttd, [this](size_t i, ConstraintRowBuffer& rows) {
     const auto& ttd_section = ttd_sections.at(i);
-    const auto  tr_on_ttd =
-        instance.trains_in_section(ttd_section, model_detail.fix_routes, false);
+    const auto& tr_on_ttd   = train_usage.trains_in_section(i);
     for (size_t tr_on_ttd_index = 0; tr_on_ttd_index < tr_on_ttd.size();
          tr_on_ttd_index++) {
       const auto& tr      = tr_on_ttd.at(tr_on_ttd_index);
@@ -1702,12 +2061,10 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       const auto& tr_name = instance.get_train_list().get_train(tr).name;
 
       // x_ttd aggregates x values
-      const auto e_tr =
-          instance.edges_used_by_train(tr, model_detail.fix_routes, false);
-      // relevant edges are intersection of ttd_section and e_tr
+      // relevant edges are the edges of ttd_section used by tr
       std::vector<size_t> relevant_edges;
       for (const auto& e : ttd_section) {
-        if (std::find(e_tr.begin(), e_tr.end(), e) != e_tr.end()) {
+        if (train_usage.uses_edge(tr, e)) {
           relevant_edges.push_back(e);
         }
       }
@@ -1718,12 +2075,12 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             instance.const_n().get_vertex(e_object.source).name;
         const auto v2_name =
             instance.const_n().get_vertex(e_object.target).name;
-        model->addConstr(vars["x_ttd"](tr, i) >= vars["x"](tr, e),
-                         "aggregate_edge_ttd_1_" +
-                             instance.get_train_list().get_train(tr).name +
-                             "_" + std::to_string(i) + "_" + v1_name + "-" +
-                             v2_name);
-        rhs += vars["x"](tr, e);
+        rows.add(vars.at("x_ttd")(tr, i), GRB_GREATER_EQUAL,
+                 vars.at("x")(tr, e),
+                 "aggregate_edge_ttd_1_" +
+                     instance.get_train_list().get_train(tr).name + "_" +
+                     std::to_string(i) + "_" + v1_name + "-" + v2_name);
+        rhs += vars.at("x")(tr, e);
 
         // Moreover bound t_ttd_departure
         // >= t_rear_departure(v2) * x(e)
@@ -1734,18 +2091,17 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         // t_ttd >= 0 (already by definition)
         // Because we are only interested in bounding the time from below no
         // other constraints are needed.
-        model->addConstr(vars["t_ttd_departure"](tr, i) >=
-                             vars["t_rear_departure"](tr, e_object.target) -
-                                 t_bound * (1 - vars["x"](tr, e)),
-                         "ttd_departure_bound_" +
-                             instance.get_train_list().get_train(tr).name +
-                             "_" + std::to_string(i) + "_" + v1_name + "-" +
-                             v2_name);
+        rows.add(vars.at("t_ttd_departure")(tr, i), GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr, e_object.target) -
+                     t_bound * (1 - vars.at("x")(tr, e)),
+                 "ttd_departure_bound_" +
+                     instance.get_train_list().get_train(tr).name + "_" +
+                     std::to_string(i) + "_" + v1_name + "-" + v2_name);
       }
-      model->addConstr(vars["x_ttd"](tr, i) <= rhs,
-                       "aggregate_edge_ttd_2_" +
-                           instance.get_train_list().get_train(tr).name + "_" +
-                           std::to_string(i));
+      rows.add(vars.at("x_ttd")(tr, i), GRB_LESS_EQUAL, rhs,
+               "aggregate_edge_ttd_2_" +
+                   instance.get_train_list().get_train(tr).name + "_" +
+                   std::to_string(i));
 
       for (size_t tr2_on_ttd_index = tr_on_ttd_index + 1;
            tr2_on_ttd_index < tr_on_ttd.size(); tr2_on_ttd_index++) {
@@ -1754,45 +2110,44 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         const auto& tr2_name    = instance.get_train_list().get_train(tr2).name;
 
         // Order constraints as usual
-        model->addConstr(
-            vars["order_ttd"](tr, tr2, i) + vars["order_ttd"](tr2, tr, i) <=
-                0.5 * (vars["x_ttd"](tr, i) + vars["x_ttd"](tr2, i)),
-            "ttd_order_1_" + tr_name + "_" + tr2_name + "_" +
-                std::to_string(i));
-        model->addConstr(vars["order_ttd"](tr, tr2, i) +
-                                 vars["order_ttd"](tr2, tr, i) >=
-                             vars["x_ttd"](tr, i) - vars["x_ttd"](tr2, i) - 1,
-                         "ttd_order_2_" + tr_name + "_" + tr2_name + "_" +
-                             std::to_string(i));
+        rows.add(vars.at("order_ttd")(tr, tr2, i) +
+                     vars.at("order_ttd")(tr2, tr, i),
+                 GRB_LESS_EQUAL,
+                 0.5 * (vars.at("x_ttd")(tr, i) + vars.at("x_ttd")(tr2, i)),
+                 "ttd_order_1_" + tr_name + "_" + tr2_name + "_" +
+                     std::to_string(i));
+        rows.add(vars.at("order_ttd")(tr, tr2, i) +
+                     vars.at("order_ttd")(tr2, tr, i),
+                 GRB_GREATER_EQUAL,
+                 vars.at("x_ttd")(tr, i) - vars.at("x_ttd")(tr2, i) - 1,
+                 "ttd_order_2_" + tr_name + "_" + tr2_name + "_" +
+                     std::to_string(i));
 
         // If tr1 follows tr2 then t_ttd_departure(tr1) >= t_ttd_departure(tr2)
-        model->addConstr(vars["t_ttd_departure"](tr, i) +
-                                 t_bound_tmp *
-                                     (1 - vars["order_ttd"](tr, tr2, i)) >=
-                             vars["t_ttd_departure"](tr2, i),
-                         "ttd_order_3_time_" + tr_name + "_" + tr2_name + "_" +
-                             std::to_string(i));
+        rows.add(vars.at("t_ttd_departure")(tr, i) +
+                     t_bound_tmp * (1 - vars.at("order_ttd")(tr, tr2, i)),
+                 GRB_GREATER_EQUAL, vars.at("t_ttd_departure")(tr2, i),
+                 "ttd_order_3_time_" + tr_name + "_" + tr2_name + "_" +
+                     std::to_string(i));
 
         // If tr2 follows tr1 then t_ttd_departure(tr2) >= t_ttd_departure(tr1)
-        model->addConstr(vars["t_ttd_departure"](tr2, i) +
-                                 t_bound_tmp *
-                                     (1 - vars["order_ttd"](tr2, tr, i)) >=
-                             vars["t_ttd_departure"](tr, i),
-                         "ttd_order_4_time_" + tr2_name + "_" + tr_name + "_" +
-                             std::to_string(i));
+        rows.add(vars.at("t_ttd_departure")(tr2, i) +
+                     t_bound_tmp * (1 - vars.at("order_ttd")(tr2, tr, i)),
+                 GRB_GREATER_EQUAL, vars.at("t_ttd_departure")(tr, i),
+                 "ttd_order_4_time_" + tr2_name + "_" + tr_name + "_" +
+                     std::to_string(i));
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_reverse_edge_constraints() {
-  for (size_t idx = 0; idx < relevant_reverse_edges.size(); idx++) {
-    const auto& [e1, e2] = relevant_reverse_edges.at(idx);
-    const auto tr_list_1 = instance.trains_on_edge_mixed_routing(
-        e1, model_detail.fix_routes, false);
-    const auto tr_list_2 = instance.trains_on_edge_mixed_routing(
-        e2, model_detail.fix_routes, false);
+  const auto num_rev = relevant_reverse_edges.size();
+  add_rows_in_parallel(num_rev, [this](size_t idx, ConstraintRowBuffer& rows) {
+    const auto& [e1, e2]  = relevant_reverse_edges.at(idx);
+    const auto& tr_list_1 = train_usage.trains_on_edge(e1);
+    const auto& tr_list_2 = train_usage.trains_on_edge(e2);
 
     const auto  e_obj   = instance.const_n().get_edge(e1);
     const auto& v1_name = instance.const_n().get_vertex(e_obj.source).name;
@@ -1808,48 +2163,48 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         const auto& tr2_name = instance.get_train_list().get_train(tr2).name;
         const auto  ub_val_2 = ub_timing_variable(tr2);
         const auto  t_bound  = std::max(ub_val_1, ub_val_2);
-        model->addConstr(vars["reverse_order"](tr1, tr2, idx) +
-                                 vars["reverse_order"](tr2, tr1, idx) >=
-                             vars["x"](tr1, e1) + vars["x"](tr2, e2) - 1,
-                         "reverse_order_lb_" + tr1_name + "_" + tr2_name + "_" +
-                             v1_name + "-" + v2_name);
-        model->addConstr(vars["reverse_order"](tr1, tr2, idx) +
-                                 vars["reverse_order"](tr2, tr1, idx) <=
-                             1,
-                         "reverse_order_ub_" + tr1_name + "_" + tr2_name + "_" +
-                             v1_name + "-" + v2_name);
+        rows.add(vars.at("reverse_order")(tr1, tr2, idx) +
+                     vars.at("reverse_order")(tr2, tr1, idx),
+                 GRB_GREATER_EQUAL,
+                 vars.at("x")(tr1, e1) + vars.at("x")(tr2, e2) - 1,
+                 "reverse_order_lb_" + tr1_name + "_" + tr2_name + "_" +
+                     v1_name + "-" + v2_name);
+        rows.add(vars.at("reverse_order")(tr1, tr2, idx) +
+                     vars.at("reverse_order")(tr2, tr1, idx),
+                 GRB_LESS_EQUAL, 1, "reverse_order_ub_" + tr1_name + "_" +
+                                        tr2_name + "_" + v1_name + "-" +
+                                        v2_name);
 
         // If tr1 follows tr2 then front of tr1 >= rear of tr2 at source vertex
         // (of e1)
-        model->addConstr(
-            vars["t_front_arrival"](tr1, e_obj.source) +
-                    t_bound * (1 - vars["reverse_order"](tr1, tr2, idx)) >=
-                vars["t_rear_departure"](tr2, e_obj.source),
-            "reverse_order_1_" + tr1_name + "_" + tr2_name + "_" + v1_name +
-                "-" + v2_name);
+        rows.add(vars.at("t_front_arrival")(tr1, e_obj.source) +
+                     t_bound * (1 - vars.at("reverse_order")(tr1, tr2, idx)),
+                 GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr2, e_obj.source),
+                 "reverse_order_1_" + tr1_name + "_" + tr2_name + "_" +
+                     v1_name + "-" + v2_name);
 
         // If tr2 follows tr1 then front of tr2 >= rear of tr1 at source vertex
         // of e2, hence, target vertex of e1
-        model->addConstr(
-            vars["t_front_arrival"](tr2, e_obj.target) +
-                    t_bound * (1 - vars["reverse_order"](tr2, tr1, idx)) >=
-                vars["t_rear_departure"](tr1, e_obj.target),
-            "reverse_order_2_" + tr2_name + "_" + tr1_name + "_" + v1_name +
-                "-" + v2_name);
+        rows.add(vars.at("t_front_arrival")(tr2, e_obj.target) +
+                     t_bound * (1 - vars.at("reverse_order")(tr2, tr1, idx)),
+                 GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr1, e_obj.target),
+                 "reverse_order_2_" + tr2_name + "_" + tr1_name + "_" +
+                     v1_name + "-" + v2_name);
       }
     }
-  }
+  });
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_vertex_headway_constraints() {
   // If a line headway is specified (most importantly on exit nodes), then obey
   // This only takes into account if the same previous or next edge is used
-  for (size_t e = 0; e < num_edges; e++) {
-    const auto& tr_on_edge = instance.trains_on_edge_mixed_routing(
-        e, model_detail.fix_routes, false);
+  add_rows_in_parallel(num_edges, [this](size_t e, ConstraintRowBuffer& rows) {
+    const auto& tr_on_edge = train_usage.trains_on_edge(e);
     if (tr_on_edge.size() <= 1) {
-      continue;
+      return;
     }
 
     const auto& e_object        = instance.const_n().get_edge(e);
@@ -1877,37 +2232,41 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
         // Add headway constraints to both source and target vertices depending
         // on train order
-        model->addConstr(vars["t_front_arrival"](tr1, source_v) +
-                                 (t_bound + hw_s1_max) *
-                                     (1 - vars["order"](tr1, tr2, e)) >=
-                             vars["t_rear_departure"](tr2, source_v) + hw_s1,
-                         "headway_vertex_source_1_" + tr1_object.name + "_" +
-                             tr2_object.name + "_" + source_v_object.name +
-                             "-" + target_v_object.name);
-        model->addConstr(vars["t_front_arrival"](tr2, source_v) +
-                                 (t_bound + hw_s2_max) *
-                                     (1 - vars["order"](tr2, tr1, e)) >=
-                             vars["t_rear_departure"](tr1, source_v) + hw_s2,
-                         "headway_vertex_source_2_" + tr1_object.name + "_" +
-                             tr2_object.name + "_" + source_v_object.name +
-                             "-" + target_v_object.name);
-        model->addConstr(vars["t_front_arrival"](tr1, target_v) +
-                                 (t_bound + hw_t1_max) *
-                                     (1 - vars["order"](tr1, tr2, e)) >=
-                             vars["t_rear_departure"](tr2, target_v) + hw_t1,
-                         "headway_vertex_target_1_" + tr1_object.name + "_" +
-                             tr2_object.name + "_" + source_v_object.name +
-                             "-" + target_v_object.name);
-        model->addConstr(vars["t_front_arrival"](tr2, target_v) +
-                                 (t_bound + hw_t2_max) *
-                                     (1 - vars["order"](tr2, tr1, e)) >=
-                             vars["t_rear_departure"](tr1, target_v) + hw_t2,
-                         "headway_vertex_target_2_" + tr1_object.name + "_" +
-                             tr2_object.name + "_" + source_v_object.name +
-                             "-" + target_v_object.name);
+        rows.add(vars.at("t_front_arrival")(tr1, source_v) +
+                     (t_bound + hw_s1_max) *
+                         (1 - vars.at("order")(tr1, tr2, e)),
+                 GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr2, source_v) + hw_s1,
+                 "headway_vertex_source_1_" + tr1_object.name + "_" +
+                     tr2_object.name + "_" + source_v_object.name + "-" +
+                     target_v_object.name);
+        rows.add(vars.at("t_front_arrival")(tr2, source_v) +
+                     (t_bound + hw_s2_max) *
+                         (1 - vars.at("order")(tr2, tr1, e)),
+                 GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr1, source_v) + hw_s2,
+                 "headway_vertex_source_2_" + tr1_object.name + "_" +
+                     tr2_object.name + "_" + source_v_object.name + "-" +
+                     target_v_object.name);
+        rows.add(vars.at("t_front_arrival")(tr1, target_v) +
+                     (t_bound + hw_t1_max) *
+                         (1 - vars.at("order")(tr1, tr2, e)),
+                 GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr2, target_v) + hw_t1,
+                 "headway_vertex_target_1_" + tr1_object.name + "_" +
+                     tr2_object.name + "_" + source_v_object.name + "-" +
+                     target_v_object.name);
+        rows.add(vars.at("t_front_arrival")(tr2, target_v) +
+                     (t_bound + hw_t2_max) *
+                         (1 - vars.at("order")(tr2, tr1, e)),
+                 GRB_GREATER_EQUAL,
+                 vars.at("t_rear_departure")(tr1, target_v) + hw_t2,
+                 "headway_vertex_target_2_" + tr1_object.name + "_" +
+                     tr2_object.name + "_" + source_v_object.name + "-" +
+                     target_v_object.name);
       }
     }
-  }
+  });
 }
 
 GRBLinExpr
@@ -1947,13 +2306,13 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::get_edge_path_expr(
       if (cda_rail::possible_by_eom(vel_source, vel_target,
                                     tr_object.acceleration,
                                     tr_object.deceleration, e_1_obj.length)) {
-        edge_path_expr += vars["y"](tr, e_1, v_source_index, v_target_index);
+        edge_path_expr += vars.at("y")(tr, e_1, v_source_index, v_target_index);
       }
     }
   }
   for (const auto& e_p : p) {
     if (e_p != e_1) {
-      edge_path_expr += vars["x"](tr, e_p);
+      edge_path_expr += vars.at("x")(tr, e_p);
     }
   }
 
@@ -2048,11 +2407,11 @@ std::tuple<double, GRBLinExpr, double, GRBLinExpr> cda_rail::solver::mip_based::
           // Add more headway if velocity headway is larger than vertex
           // required headway
           if (source_velocity_headway > source_v_object.headway) {
-            hw_s1 += vars["y"](tr, e, s_vel_idx, t_vel_idx) *
+            hw_s1 += vars.at("y")(tr, e, s_vel_idx, t_vel_idx) *
                      (source_velocity_headway - source_v_object.headway);
           }
           if (target_velocity_headway > target_v_object.headway) {
-            hw_t1 += vars["y"](tr, e, s_vel_idx, t_vel_idx) *
+            hw_t1 += vars.at("y")(tr, e, s_vel_idx, t_vel_idx) *
                      (target_velocity_headway - target_v_object.headway);
           }
         }
@@ -2116,10 +2475,10 @@ std::tuple<double, GRBLinExpr, double, GRBLinExpr> cda_rail::solver::mip_based::
         }
 
         headway_tr_on_e +=
-            vars["y"](tr, e, v_source_index, v_target_index) * hw_tmp;
+            vars.at("y")(tr, e, v_source_index, v_target_index) * hw_tmp;
 
         headway_tr_on_ttd +=
-            vars["y"](tr, e, v_source_index, v_target_index) * hw_tmp_ttd;
+            vars.at("y")(tr, e, v_source_index, v_target_index) * hw_tmp_ttd;
       }
     }
   }
@@ -2128,7 +2487,9 @@ std::tuple<double, GRBLinExpr, double, GRBLinExpr> cda_rail::solver::mip_based::
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::cleanup() {
+  lazy_constraint_pool.release_model();
   GeneralMIPSolver::cleanup();
+  lazy_callback.reset();
   solution_settings = {};
   model_detail      = {};
   solver_strategy   = {};
@@ -2138,9 +2499,15 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::cleanup() {
   num_ttd           = 0;
   max_t             = 0;
   ttd_sections.clear();
+  train_usage = {};
   tr_stop_data.clear();
   velocity_extensions.clear();
   relevant_reverse_edges.clear();
+  vertex_time_bounds.clear();
+  ttd_departure_ubs.clear();
+  fixed_variable_values.clear();
+  start_variable_values.clear();
+  symmetry_breaking_pairs.clear();
 }
 
 // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation)
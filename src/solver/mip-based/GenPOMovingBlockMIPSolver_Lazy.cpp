@@ -7,14 +7,20 @@
 #include "solver/mip-based/GeneralMIPSolver.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
 #include <exception>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -27,14 +33,23 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
   try {
     if (where == GRB_CB_MESSAGE) {
       MessageCallback::callback();
+    } else if (where == GRB_CB_MIPNODE &&
+               solver->solver_strategy.separate_fractional_cuts &&
+               getIntInfo(GRB_CB_MIPNODE_STATUS) == GRB_OPTIMAL) {
+      use_node_relaxation = true;
+      separate_fractional_cuts();
     } else if (where == GRB_CB_MIPSOL) {
+      use_node_relaxation              = false;
       const auto routes                = get_routes();
       const auto train_velocities      = get_train_velocities(routes);
       const auto train_orders_on_edges = get_train_orders_on_edges(routes);
-      const auto train_orders_on_ttd   = get_train_orders_on_ttd();
+      const auto train_orders_on_ttd   = get_train_orders_on_ttd(routes);
+      const auto values                = get_solution_values(
+          routes, train_orders_on_edges, train_orders_on_ttd);
+      added_constraint_keys.clear();
 
       auto constraint_created = create_lazy_vertex_headway_constraints(
-          routes, train_velocities, train_orders_on_edges);
+          routes, train_velocities, train_orders_on_edges, values);
       if (solver->solver_strategy.lazy_constraint_selection_strategy !=
               LazyConstraintSelectionStrategy::OnlyFirstFound ||
           !constraint_created) {
@@ -42,15 +57,15 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
             solver->model_detail.simplify_headway_constraints
                 ? create_lazy_simplified_edge_constraints(
                       routes, train_velocities, train_orders_on_edges,
-                      train_orders_on_ttd)
+                      train_orders_on_ttd, values)
                 : create_lazy_edge_and_ttd_headway_constraints(
                       routes, train_velocities, train_orders_on_edges,
-                      train_orders_on_ttd);
+                      train_orders_on_ttd, values);
       }
       if (solver->solver_strategy.lazy_constraint_selection_strategy !=
               LazyConstraintSelectionStrategy::OnlyFirstFound ||
           !constraint_created) {
-        create_lazy_reverse_edge_constraints(train_orders_on_edges);
+        create_lazy_reverse_edge_constraints(train_orders_on_edges, values);
       }
     }
   } catch (GRBException& e) {
@@ -70,6 +85,9 @@ std::vector<std::vector<std::pair<size_t, double>>> cda_rail::solver::
   /**
    * Extract routes from the current solution.
    * At the same time, save the distance from the start for every vertex.
+   * For a node relaxation, the route follows edges with x > 0.5, which are
+   * unique by flow conservation, and stops if no such edge exists or a vertex
+   * would be visited twice.
    */
 
   std::vector<std::vector<std::pair<size_t, double>>> routes;
@@ -80,14 +98,19 @@ std::vector<std::vector<std::pair<size_t, double>>> cda_rail::solver::
     const auto entry = solver->instance.get_schedule(tr).get_entry();
     auto       edges_to_consider = solver->instance.const_n().out_edges(entry);
 
-    double current_pos = 0;
+    double                     current_pos = 0;
+    std::unordered_set<size_t> visited_vertices{entry};
     routes[tr].emplace_back(entry, current_pos);
     while (!edges_to_consider.empty()) {
       const auto& edge_id = edges_to_consider.back();
       edges_to_consider.pop_back();
       auto& tmp_var = solver->vars["x"](tr, edge_id);
-      if (!tmp_var.sameAs(GRBVar()) && getSolution(tmp_var) > 0.5) {
+      if (!tmp_var.sameAs(GRBVar()) && get_value(tmp_var) > 0.5) {
         const auto& edge_object = solver->instance.const_n().get_edge(edge_id);
+        if (!visited_vertices.insert(edge_object.target).second) {
+          // Only possible for fractional values
+          break;
+        }
         current_pos += edge_object.length;
         routes[tr].emplace_back(edge_object.target, current_pos);
         const auto& [old_edge_id, old_edge_pos] =
@@ -102,18 +125,44 @@ std::vector<std::vector<std::pair<size_t, double>>> cda_rail::solver::
 }
 
 std::vector<std::vector<size_t>> cda_rail::solver::mip_based::
-    GenPOMovingBlockMIPSolver::LazyCallback::get_train_orders_on_ttd() {
+    GenPOMovingBlockMIPSolver::LazyCallback::get_train_orders_on_ttd(
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes) {
+  /**
+   * Order trains within every TTD section by their departure time.
+   * For a node relaxation, x_ttd might be fractional. Hence, a train is
+   * considered to use a section if its (rounded) route does, so that the
+   * orders are consistent with the routes.
+   */
+
   std::vector<std::vector<size_t>> train_orders_on_ttd;
   train_orders_on_ttd.reserve(solver->num_ttd);
   for (size_t ttd = 0; ttd < solver->num_ttd; ttd++) {
     train_orders_on_ttd.emplace_back();
     assert(train_orders_on_ttd.size() == ttd + 1);
+    const auto&                        ttd_section = solver->ttd_sections[ttd];
     std::unordered_map<size_t, double> train_ttd_times;
     for (size_t tr = 0; tr < solver->num_tr; tr++) {
-      GRBVar x_ttd = solver->vars["x_ttd"](tr, ttd);
-      GRBVar t_ttd = solver->vars["t_ttd_departure"](tr, ttd);
-      if (!x_ttd.sameAs(GRBVar()) && getSolution(x_ttd) > 0.5) {
-        train_ttd_times[tr] = getSolution(t_ttd);
+      GRBVar     x_ttd    = solver->vars["x_ttd"](tr, ttd);
+      GRBVar     t_ttd    = solver->vars["t_ttd_departure"](tr, ttd);
+      const bool uses_ttd = [&]() {
+        if (x_ttd.sameAs(GRBVar())) {
+          return false;
+        }
+        if (!use_node_relaxation) {
+          return get_value(x_ttd) > 0.5;
+        }
+        for (size_t i = 0; i + 1 < routes[tr].size(); i++) {
+          const auto e = solver->instance.const_n().get_edge_index(
+              routes[tr][i].first, routes[tr][i + 1].first);
+          if (std::find(ttd_section.begin(), ttd_section.end(), e) !=
+              ttd_section.end()) {
+            return true;
+          }
+        }
+        return false;
+      }();
+      if (uses_ttd) {
+        train_ttd_times[tr] = get_value(t_ttd);
         train_orders_on_ttd[ttd].emplace_back(tr);
       }
     }
@@ -156,8 +205,8 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
           GRBVar t_target =
               solver->vars["t_rear_departure"](tr, edge_object.target);
           // Assume they exist by choice of routes
-          train_edge_times_source[tr] = getSolution(t_source);
-          train_edge_times_target[tr] = getSolution(t_target);
+          train_edge_times_source[tr] = get_value(t_source);
+          train_edge_times_target[tr] = get_value(t_target);
           train_orders_on_edges[edge_id].first.emplace_back(
               tr, routes[tr][i].first == edge_object.source);
           train_orders_on_edges[edge_id].second.emplace_back(
@@ -192,9 +241,19 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
 std::vector<std::unordered_map<size_t, double>> cda_rail::solver::mip_based::
     GenPOMovingBlockMIPSolver::LazyCallback::get_train_velocities(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes) {
+  /**
+   * Extract the velocity of every train at every vertex of its route. For a
+   * node relaxation, the velocity with the largest y value is chosen. Routes
+   * consisting only of the entry vertex are skipped, which is only possible
+   * for a node relaxation.
+   */
+
   std::vector<std::unordered_map<size_t, double>> train_velocities(
       solver->num_tr);
   for (size_t tr = 0; tr < solver->num_tr; tr++) {
+    if (routes[tr].size() < 2) {
+      continue;
+    }
     for (size_t route_v_idx = 0; route_v_idx < routes[tr].size();
          route_v_idx++) {
       const auto& v_idx = routes[tr][route_v_idx].first;
@@ -209,16 +268,26 @@ std::vector<std::unordered_map<size_t, double>> cda_rail::solver::mip_based::
       const auto& target_velocities =
           solver->velocity_extensions.at(tr).at(edge.target);
 
-      bool vel_found = false;
-      for (size_t i = 0; i < source_velocities.size() && !vel_found; i++) {
+      bool   vel_found  = false;
+      double best_value = 0.5;
+      for (size_t i = 0; i < source_velocities.size() &&
+                         (use_node_relaxation || !vel_found);
+           i++) {
         const auto& source_v = source_velocities[i];
-        for (size_t j = 0; j < target_velocities.size() && !vel_found; j++) {
+        for (size_t j = 0; j < target_velocities.size() &&
+                           (use_node_relaxation || !vel_found);
+             j++) {
           const auto& target_v  = target_velocities[j];
           GRBVar      y_var_tmp = solver->vars["y"](tr, e_idx, i, j);
-          if (!y_var_tmp.sameAs(GRBVar()) && getSolution(y_var_tmp) > 0.5) {
+          if (y_var_tmp.sameAs(GRBVar())) {
+            continue;
+          }
+          const auto y_value = get_value(y_var_tmp);
+          if (y_value > best_value || (use_node_relaxation && !vel_found)) {
             train_velocities[tr][v_idx] =
                 edge.source == v_idx ? source_v : target_v;
-            vel_found = true;
+            best_value = y_value;
+            vel_found  = true;
           }
         }
       }
@@ -234,6 +303,337 @@ std::vector<std::unordered_map<size_t, double>> cda_rail::solver::mip_based::
   return train_velocities;
 }
 
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    LazySolutionValues
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+        get_solution_values(
+            const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+            const std::vector<
+                std::pair<std::vector<std::pair<size_t, bool>>,
+                          std::vector<std::pair<size_t, bool>>>>&
+                                                    train_orders_on_edges,
+            const std::vector<std::vector<size_t>>& train_orders_on_ttd) {
+  /**
+   * Queries all solution values needed by the separation routines, i.e., the
+   * timing variables of every train at the vertices of its route, the TTD
+   * departure times of every train within the respective sections and the
+   * order variables of trains sharing an edge.
+   * Since getSolution must only be called from the callback thread, this is
+   * done before the (possibly parallel) separation.
+   */
+
+  LazySolutionValues values{
+      MultiArray<double>(solver->num_tr, solver->num_vertices),
+      MultiArray<double>(solver->num_tr, solver->num_vertices),
+      MultiArray<double>(solver->num_tr, solver->num_vertices),
+      MultiArray<double>(solver->num_tr, solver->num_ttd),
+      {}};
+
+  for (size_t tr = 0; tr < solver->num_tr; tr++) {
+    for (const auto& [v_idx, pos] : routes.at(tr)) {
+      values.t_front_arrival(tr, v_idx) =
+          get_value(solver->vars["t_front_arrival"](tr, v_idx));
+      values.t_front_departure(tr, v_idx) =
+          get_value(solver->vars["t_front_departure"](tr, v_idx));
+      values.t_rear_departure(tr, v_idx) =
+          get_value(solver->vars["t_rear_departure"](tr, v_idx));
+    }
+  }
+
+  for (size_t ttd = 0; ttd < solver->num_ttd; ttd++) {
+    for (const auto& tr : train_orders_on_ttd.at(ttd)) {
+      values.t_ttd_departure(tr, ttd) =
+          get_value(solver->vars["t_ttd_departure"](tr, ttd));
+    }
+  }
+
+  for (size_t e = 0; e < solver->num_edges; e++) {
+    const auto& tr_order = train_orders_on_edges.at(e).first;
+    for (const auto& [tr1, tr1_direction] : tr_order) {
+      for (const auto& [tr2, tr2_direction] : tr_order) {
+        if (tr1 == tr2) {
+          continue;
+        }
+        const auto& order_var = solver->vars["order"](tr1, tr2, e);
+        if (!order_var.sameAs(GRBVar())) {
+          values.order[(tr1 * solver->num_tr + tr2) * solver->num_edges + e] =
+              get_value(order_var);
+        }
+      }
+    }
+  }
+
+  return values;
+}
+
+double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    get_order_value(const LazySolutionValues& values, size_t tr1, size_t tr2,
+                    size_t e) const {
+  const auto it =
+      values.order.find((tr1 * solver->num_tr + tr2) * solver->num_edges + e);
+  return it == values.order.end() ? 0 : it->second;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    add_lazy_constraint(const GRBLinExpr& expr, char sense) {
+  const auto constr = LazyConstraintPool::to_temp_constr(expr, sense);
+  addLazy(constr);
+  if (solver->solution_settings.export_option == ExportOption::ExportLP ||
+      solver->solution_settings.export_option ==
+          ExportOption::ExportSolutionAndLP ||
+      solver->solution_settings.export_option ==
+          ExportOption::ExportSolutionWithInstanceAndLP) {
+    // So that the constraint can be exported
+    solver->lazy_constraints.push_back(constr);
+  }
+}
+
+double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    get_value(const GRBVar& var) {
+  return use_node_relaxation ? getNodeRel(var) : getSolution(var);
+}
+
+double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    get_expr_value(const GRBLinExpr& expr) {
+  double value = expr.getConstant();
+  for (size_t i = 0; i < expr.size(); i++) {
+    value += expr.getCoeff(i) * get_value(expr.getVar(i));
+  }
+  return value;
+}
+
+std::vector<cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+                LazyCallback::LazyConstraintCandidate>
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_candidates(
+        size_t num_items,
+        const std::function<void(size_t,
+                                 std::vector<LazyConstraintCandidate>&)>&
+             separate_item,
+        bool only_one_constraint) {
+  /**
+   * Calls separate_item for every item in [0, num_items), e.g., every train,
+   * and returns the resulting candidates.
+   * Items are distributed dynamically over the threads specified by
+   * lazy_separation_threads, each collecting candidates in its own buffer.
+   * Buffers are merged afterward. If deterministic_lazy_separation or
+   * only_one_constraint is set, candidates are ordered by item, which
+   * coincides with the order of a sequential separation. If only_one_constraint
+   * is set, items after the first one with candidates might be skipped.
+   */
+
+  size_t num_threads = solver->solver_strategy.lazy_separation_threads;
+  if (num_threads == 0) {
+    num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  num_threads = std::max<size_t>(std::min(num_threads, num_items), 1);
+
+  std::vector<std::vector<LazyConstraintCandidate>> buffers(num_threads);
+  std::atomic<size_t>                               next_item{0};
+  std::atomic<size_t>                               first_found{num_items};
+
+  const auto worker = [&](size_t thread_idx) {
+    for (size_t item = next_item++; item < num_items; item = next_item++) {
+      if (only_one_constraint && item > first_found.load()) {
+        // Items are claimed in increasing order, hence, all remaining items
+        // are irrelevant as well
+        break;
+      }
+      std::vector<LazyConstraintCandidate> item_constraints;
+      separate_item(item, item_constraints);
+      if (item_constraints.empty()) {
+        continue;
+      }
+      for (size_t seq = 0; seq < item_constraints.size(); seq++) {
+        item_constraints[seq].item = item;
+        item_constraints[seq].seq  = seq;
+      }
+      if (only_one_constraint) {
+        size_t current_first = first_found.load();
+        while (item < current_first &&
+               !first_found.compare_exchange_weak(current_first, item)) {
+        }
+      }
+      buffers[thread_idx].insert(
+          buffers[thread_idx].end(),
+          std::make_move_iterator(item_constraints.begin()),
+          std::make_move_iterator(item_constraints.end()));
+    }
+  };
+
+  if (num_threads == 1) {
+    worker(0);
+  } else {
+    std::vector<std::thread>        threads;
+    std::vector<std::exception_ptr> exceptions(num_threads);
+    threads.reserve(num_threads);
+    for (size_t thread_idx = 0; thread_idx < num_threads; thread_idx++) {
+      threads.emplace_back([&worker, &exceptions, thread_idx]() {
+        try {
+          worker(thread_idx);
+        } catch (...) {
+          exceptions[thread_idx] = std::current_exception();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& exception : exceptions) {
+      if (exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+
+  std::vector<LazyConstraintCandidate> candidates;
+  for (auto& buffer : buffers) {
+    candidates.insert(candidates.end(), std::make_move_iterator(buffer.begin()),
+                      std::make_move_iterator(buffer.end()));
+  }
+
+  if (solver->solver_strategy.deterministic_lazy_separation ||
+      only_one_constraint) {
+    std::sort(candidates.begin(), candidates.end(),
+              [](const LazyConstraintCandidate& c1,
+                 const LazyConstraintCandidate& c2) {
+                return std::tie(c1.item, c1.seq) < std::tie(c2.item, c2.seq);
+              });
+  }
+
+  return candidates;
+}
+
+bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_and_add_lazy_constraints(
+        size_t num_items,
+        const std::function<void(size_t,
+                                 std::vector<LazyConstraintCandidate>&)>&
+            separate_item) {
+  /**
+   * Calls separate_item for every item in [0, num_items), e.g., every train,
+   * and adds the resulting lazy constraints to the model. Because addLazy must
+   * only be called from the callback thread, candidates are separated first
+   * (possibly in parallel) and every constraint not yet added within the
+   * current callback is added afterward.
+   * Constraints already contained in the solver's lazy constraint pool, i.e.,
+   * separated in an earlier callback, are only added again if the current
+   * solution violates them, since Gurobi might not respect previously added
+   * lazy constraints at all times. Constraints added to the model upfront are
+   * enforced by Gurobi and hence never added again.
+   * If only the first violated constraint is requested, only the candidates of
+   * the smallest item are added.
+   *
+   * @param num_items: number of independent items to separate
+   * @param separate_item: appends all candidates of one item to the given
+   * vector
+   *
+   * @return: true if at least one violated constraint was found
+   */
+
+  const bool only_one_constraint =
+      solver->solver_strategy.lazy_constraint_selection_strategy ==
+      LazyConstraintSelectionStrategy::OnlyFirstFound;
+
+  const auto candidates =
+      separate_candidates(num_items, separate_item, only_one_constraint);
+  if (candidates.empty()) {
+    return false;
+  }
+
+  auto&      pool       = solver->lazy_constraint_pool;
+  const auto first_item = candidates.front().item;
+  for (const auto& candidate : candidates) {
+    if (only_one_constraint && candidate.item != first_item) {
+      break;
+    }
+    if (!added_constraint_keys.insert(candidate.key).second) {
+      continue;
+    }
+    if (!pool.insert(candidate.key, candidate.expr, candidate.sense) &&
+        (pool.get_entry(candidate.key).in_model ||
+         !LazyConstraintPool::is_violated(get_expr_value(candidate.expr),
+                                          candidate.sense))) {
+      continue;
+    }
+    add_lazy_constraint(candidate.expr, candidate.sense);
+  }
+
+  return true;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_fractional_cuts() {
+  /**
+   * Separates headway and TTD inequalities at a node whose LP relaxation is
+   * solved to optimality. Routes, velocities and orders are rounded from the
+   * relaxation values and candidates are created by the same routines as lazy
+   * constraints, hence, they are valid for the full model. The candidates are
+   * evaluated at the relaxation and the max_cuts_per_node most violated ones
+   * are added as user cuts.
+   */
+
+  const auto routes                = get_routes();
+  const auto train_velocities      = get_train_velocities(routes);
+  const auto train_orders_on_edges = get_train_orders_on_edges(routes);
+  const auto train_orders_on_ttd   = get_train_orders_on_ttd(routes);
+  const auto values =
+      get_solution_values(routes, train_orders_on_edges, train_orders_on_ttd);
+
+  auto candidates = separate_candidates(
+      solver->num_tr,
+      [&](size_t tr, std::vector<LazyConstraintCandidate>& constraints) {
+        separate_vertex_headway_constraints(tr, routes, train_velocities,
+                                            train_orders_on_edges, values,
+                                            constraints);
+      },
+      false);
+  auto headway_candidates = separate_candidates(
+      solver->num_tr,
+      [&](size_t tr, std::vector<LazyConstraintCandidate>& constraints) {
+        if (solver->model_detail.simplify_headway_constraints) {
+          separate_simplified_edge_constraints(
+              tr, routes, train_velocities, train_orders_on_edges,
+              train_orders_on_ttd, values, constraints);
+        } else {
+          separate_edge_and_ttd_headway_constraints(
+              tr, routes, train_velocities, train_orders_on_edges,
+              train_orders_on_ttd, values, constraints);
+        }
+      },
+      false);
+  candidates.insert(candidates.end(),
+                    std::make_move_iterator(headway_candidates.begin()),
+                    std::make_move_iterator(headway_candidates.end()));
+
+  // Violation of every candidate at the current relaxation together with its
+  // index
+  std::vector<std::pair<double, size_t>> violations;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const auto violation = LazyConstraintPool::get_violation(
+        get_expr_value(candidates[i].expr), candidates[i].sense);
+    if (violation > GRB_EPS) {
+      violations.emplace_back(violation, i);
+    }
+  }
+  std::sort(violations.begin(), violations.end(),
+            [](const auto& v1, const auto& v2) {
+              return v1.first > v2.first ||
+                     (v1.first == v2.first && v1.second < v2.second);
+            });
+
+  std::set<LazyConstraintKey> added_cut_keys;
+  for (const auto& [violation, i] : violations) {
+    if (added_cut_keys.size() >= solver->solver_strategy.max_cuts_per_node) {
+      break;
+    }
+    const auto& candidate = candidates[i];
+    if (added_cut_keys.insert(candidate.key).second) {
+      addCut(candidate.expr, candidate.sense, 0);
+    }
+  }
+}
+
 bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
     create_lazy_edge_and_ttd_headway_constraints(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes,
@@ -241,421 +641,434 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
                                                 train_orders_on_edges,
-        const std::vector<std::vector<size_t>>& train_orders_on_ttd) {
-  bool       violated_constraint_found = false;
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values) {
+  return separate_and_add_lazy_constraints(
+      solver->num_tr,
+      [&](size_t tr, std::vector<LazyConstraintCandidate>& constraints) {
+        separate_edge_and_ttd_headway_constraints(
+            tr, routes, train_velocities, train_orders_on_edges,
+            train_orders_on_ttd, values, constraints);
+      });
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_edge_and_ttd_headway_constraints(
+        size_t                                                     tr,
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::unordered_map<size_t, double>>& train_velocities,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                                train_orders_on_edges,
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values,
+        std::vector<LazyConstraintCandidate>&   constraints) {
   const bool only_one_constraint =
       solver->solver_strategy.lazy_constraint_selection_strategy ==
       LazyConstraintSelectionStrategy::OnlyFirstFound;
-  for (size_t tr = 0; tr < solver->num_tr &&
-                      (!only_one_constraint || !violated_constraint_found);
-       tr++) {
-    const auto& tr_object = solver->instance.get_train_list().get_train(tr);
-    const auto  t_bound   = solver->ub_timing_variable(tr);
-    const auto& entry     = solver->instance.get_schedule(tr).get_entry();
-    // Check every vertex except the last one, because only vertex headway is
-    // imposed in that case
-    for (size_t r_v_idx = 0;
-         r_v_idx < routes.at(tr).size() - 1 &&
-         (!only_one_constraint || !violated_constraint_found);
-         r_v_idx++) {
-      const auto& [v_idx, pos] = routes.at(tr).at(r_v_idx);
-      const auto& vel          = train_velocities.at(tr).at(v_idx);
-      const auto  bd           = vel * vel / (2 * tr_object.deceleration);
-      const auto  ma_pos       = pos + bd;
-
-      const auto& tr_t_var       = solver->vars["t_front_arrival"](tr, v_idx);
-      const auto& tr_t_var_value = getSolution(tr_t_var);
-
-      if (ma_pos <= routes.at(tr).back().second) {
-        // r_ma_idx >= r_v_idx s.th. routes.at(tr).at(r_ma_idx).second <
-        // ma_pos <= routes.at(tr).at(r_ma_idx + 1).second which should be
-        // unique by design unless bd = 0, then r_ma_idx = r_v_idx
-        size_t r_ma_idx = r_v_idx;
-        while (routes.at(tr).at(r_ma_idx + 1).second < ma_pos - EPS) {
-          r_ma_idx++;
+  const auto& tr_object = solver->instance.get_train_list().get_train(tr);
+  const auto  t_bound   = solver->ub_timing_variable(tr);
+  const auto& entry     = solver->instance.get_schedule(tr).get_entry();
+  // Check every vertex except the last one, because only vertex headway is
+  // imposed in that case
+  for (size_t r_v_idx = 0; r_v_idx < routes.at(tr).size() - 1 &&
+                           (!only_one_constraint || constraints.empty());
+       r_v_idx++) {
+    const auto& [v_idx, pos] = routes.at(tr).at(r_v_idx);
+    const auto& vel          = train_velocities.at(tr).at(v_idx);
+    const auto  bd           = vel * vel / (2 * tr_object.deceleration);
+    const auto  ma_pos       = pos + bd;
+
+    const auto& v_velocities = solver->velocity_extensions.at(tr).at(v_idx);
+    const auto  vel_idx      = static_cast<size_t>(
+        std::find(v_velocities.begin(), v_velocities.end(), vel) -
+        v_velocities.begin());
+
+    const auto& tr_t_var       = solver->vars.at("t_front_arrival")(tr, v_idx);
+    const auto& tr_t_var_value = values.t_front_arrival.at(tr, v_idx);
+
+    if (ma_pos <= routes.at(tr).back().second) {
+      // r_ma_idx >= r_v_idx s.th. routes.at(tr).at(r_ma_idx).second <
+      // ma_pos <= routes.at(tr).at(r_ma_idx + 1).second which should be
+      // unique by design unless bd = 0, then r_ma_idx = r_v_idx
+      size_t r_ma_idx = r_v_idx;
+      while (routes.at(tr).at(r_ma_idx + 1).second < ma_pos - EPS) {
+        r_ma_idx++;
+      }
+      const auto& [rel_source, rel_source_pos] = routes.at(tr).at(r_ma_idx);
+      const auto& [rel_target, rel_target_pos] = routes.at(tr).at(r_ma_idx + 1);
+      assert(bd == 0 || rel_source_pos < ma_pos - EPS);
+      assert(ma_pos <= rel_target_pos);
+      const auto rel_pos_on_edge = ma_pos - rel_source_pos;
+
+      // Get used path, which is
+      // routes.at(tr).at(i) -> routes.at(tr).at(i + 1) for i in [r_v_idx,
+      // r_ma_idx]
+      const std::vector<size_t> p = [&]() {
+        std::vector<size_t> p_tmp;
+        p_tmp.reserve(r_ma_idx - r_v_idx + 1);
+        for (size_t i = r_v_idx; i <= r_ma_idx; i++) {
+          p_tmp.emplace_back(solver->instance.const_n().get_edge_index(
+              routes.at(tr).at(i).first, routes.at(tr).at(i + 1).first));
+        }
+        return p_tmp;
+      }();
+      const auto& rel_e_idx = p.back();
+      const auto& rel_e_obj = solver->instance.const_n().get_edge(rel_e_idx);
+
+      // Create path expression according to route. The first edge must
+      // use the specified velocity or faster, since only then the desired
+      // headway must hold.
+      const GRBLinExpr edge_path_expr = solver->get_edge_path_expr(
+          tr, p, vel,
+          solver->solver_strategy.include_higher_velocities_in_edge_expr);
+
+      // Get other trains that might conflict with the current train on
+      // this edge
+      std::unordered_set<size_t> other_trains;
+      const auto& tr_order = train_orders_on_edges.at(rel_e_idx).first;
+      const auto  tr_index = std::find(tr_order.begin(), tr_order.end(),
+                                       std::pair<size_t, bool>(tr, true)) -
+                            tr_order.begin();
+      assert(tr_index != tr_order.end() - tr_order.begin());
+      for (size_t tr_other_idx = 0; tr_other_idx < tr_order.size();
+           tr_other_idx++) {
+        if (tr_other_idx == tr_index) {
+          continue;
+        }
+        if (!tr_order.at(tr_other_idx).second) {
+          // The train travels in reverse direction!
+          continue;
+        }
+        if (solver->solver_strategy.lazy_train_selection_strategy ==
+                LazyTrainSelectionStrategy::OnlyAdjacent &&
+            std::abs(static_cast<int>(tr_other_idx) -
+                     static_cast<int>(tr_index)) > 1) {
+          continue;
+        }
+        if (!solver->solver_strategy.include_reverse_headways &&
+            tr_other_idx > tr_index) {
+          // In this case tr_other follows tr, which is irrelevant for tr ma
+          continue;
         }
-        const auto& [rel_source, rel_source_pos] = routes.at(tr).at(r_ma_idx);
-        const auto& [rel_target, rel_target_pos] =
-            routes.at(tr).at(r_ma_idx + 1);
-        assert(bd == 0 || rel_source_pos < ma_pos - EPS);
-        assert(ma_pos <= rel_target_pos);
-        const auto rel_pos_on_edge = ma_pos - rel_source_pos;
-
-        // Get used path, which is
-        // routes.at(tr).at(i) -> routes.at(tr).at(i + 1) for i in [r_v_idx,
-        // r_ma_idx]
-        const std::vector<size_t> p = [&]() {
-          std::vector<size_t> p_tmp;
-          p_tmp.reserve(r_ma_idx - r_v_idx + 1);
-          for (size_t i = r_v_idx; i <= r_ma_idx; i++) {
-            p_tmp.emplace_back(solver->instance.const_n().get_edge_index(
-                routes.at(tr).at(i).first, routes.at(tr).at(i + 1).first));
+        other_trains.insert(tr_order.at(tr_other_idx).first);
+      }
+      for (const auto& tr_other_idx : other_trains) {
+        const auto& tr_other_object =
+            solver->instance.get_train_list().get_train(tr_other_idx);
+        const auto& tr_other_source_speed =
+            train_velocities.at(tr_other_idx).at(rel_source);
+        const auto& tr_other_target_speed =
+            train_velocities.at(tr_other_idx).at(rel_target);
+
+        const auto& tr_other_source_var =
+            solver->vars.at("t_rear_departure")(tr_other_idx, rel_source);
+        const auto& tr_other_target_var =
+            solver->vars.at("t_rear_departure")(tr_other_idx, rel_target);
+
+        const auto& tr_other_max_speed =
+            std::min(tr_other_object.max_speed, rel_e_obj.max_speed);
+
+        // Check if this constraint should be added
+        bool add_constr =
+            (solver->solver_strategy.lazy_constraint_selection_strategy ==
+             LazyConstraintSelectionStrategy::AllChecked);
+        if (!add_constr &&
+            tr_t_var_value <
+                values.t_rear_departure.at(tr_other_idx, rel_source) +
+                    cda_rail::min_travel_time_from_start(
+                        tr_other_source_speed, tr_other_target_speed,
+                        tr_other_max_speed, tr_other_object.acceleration,
+                        tr_other_object.deceleration, rel_e_obj.length,
+                        rel_pos_on_edge) -
+                    GRB_EPS) {
+          add_constr = true;
+        }
+        if (!add_constr && rel_pos_on_edge > EPS &&
+            tr_t_var_value <
+                values.t_rear_departure.at(tr_other_idx, rel_target) -
+                    cda_rail::max_travel_time_to_end(
+                        tr_other_source_speed, tr_other_target_speed, V_MIN,
+                        tr_other_object.acceleration,
+                        tr_other_object.deceleration, rel_e_obj.length,
+                        rel_pos_on_edge, rel_e_obj.breakable) -
+                    GRB_EPS) {
+          add_constr = true;
+        }
+
+        const auto t_bound_tmp =
+            std::max(t_bound, solver->ub_timing_variable(tr_other_idx));
+
+        if (add_constr) {
+          // Upper bound on all right hand sides, used for big-M
+          double                  rhs_ub = 0;
+          std::vector<GRBLinExpr> rhs;
+          if (std::abs(rel_e_obj.length - rel_pos_on_edge) < EPS) {
+            rhs.emplace_back(tr_other_target_var);
+            rhs_ub = solver->ub_timing_variable(tr_other_idx, rel_target);
+          } else if (rel_pos_on_edge < EPS) {
+            rhs.emplace_back(tr_other_source_var);
+            rhs_ub = solver->ub_timing_variable(tr_other_idx, rel_source);
+          } else {
+            rhs.emplace_back(tr_other_source_var);
+            rhs.emplace_back(tr_other_target_var);
+            double max_min_travel_time = 0;
+
+            const auto& v_tr_other_source_velocities =
+                solver->velocity_extensions.at(tr_other_idx).at(rel_source);
+            const auto& v_tr_other_target_velocities =
+                solver->velocity_extensions.at(tr_other_idx).at(rel_target);
+
+            for (size_t v_tr_other_source_index = 0;
+                 v_tr_other_source_index < v_tr_other_source_velocities.size();
+                 v_tr_other_source_index++) {
+              const auto& vel_tr_other_source =
+                  v_tr_other_source_velocities.at(v_tr_other_source_index);
+              if (vel_tr_other_source > tr_other_max_speed) {
+                continue;
+              }
+              for (size_t v_tr_other_target_index = 0;
+                   v_tr_other_target_index <
+                   v_tr_other_target_velocities.size();
+                   v_tr_other_target_index++) {
+                const auto& vel_tr_other_target =
+                    v_tr_other_target_velocities.at(v_tr_other_target_index);
+                if (vel_tr_other_target > tr_other_max_speed) {
+                  continue;
+                }
+                if (cda_rail::possible_by_eom(
+                        vel_tr_other_source, vel_tr_other_target,
+                        tr_other_object.acceleration,
+                        tr_other_object.deceleration, rel_e_obj.length)) {
+                  const auto min_travel_time =
+                      cda_rail::min_travel_time_from_start(
+                          vel_tr_other_source, vel_tr_other_target,
+                          tr_other_max_speed, tr_other_object.acceleration,
+                          tr_other_object.deceleration, rel_e_obj.length,
+                          rel_pos_on_edge);
+                  max_min_travel_time =
+                      std::max(max_min_travel_time, min_travel_time);
+                  rhs.at(0) += solver->vars.at("y")(tr_other_idx, rel_e_idx,
+                                                    v_tr_other_source_index,
+                                                    v_tr_other_target_index) *
+                               min_travel_time;
+                  const auto max_travel_time = cda_rail::max_travel_time_to_end(
+                      vel_tr_other_source, vel_tr_other_target, V_MIN,
+                      tr_other_object.acceleration,
+                      tr_other_object.deceleration, rel_e_obj.length,
+                      rel_pos_on_edge, rel_e_obj.breakable);
+                  rhs.at(1) -=
+                      solver->vars.at("y")(tr_other_idx, rel_e_idx,
+                                           v_tr_other_source_index,
+                                           v_tr_other_target_index) *
+                      (max_travel_time > t_bound_tmp ? t_bound_tmp
+                                                     : max_travel_time);
+                }
+              }
+            }
+            rhs_ub = std::max(
+                solver->ub_timing_variable(tr_other_idx, rel_source) +
+                    max_min_travel_time,
+                solver->ub_timing_variable(tr_other_idx, rel_target));
+          }
+
+          const auto big_m =
+              solver->get_headway_big_m(tr, v_idx, rhs_ub, t_bound_tmp);
+          const GRBLinExpr lhs =
+              tr_t_var +
+              big_m * (static_cast<double>(p.size()) - edge_path_expr) +
+              big_m *
+                  (1 - solver->vars.at("order")(tr, tr_other_idx, p.back()));
+
+          // Previous simple order constraint deleted, because making sure
+          // that the order variable has the correct semantic value is ensured
+          // by vertex headway constraints
+
+          for (size_t rhs_idx = 0; rhs_idx < rhs.size(); rhs_idx++) {
+            constraints.push_back(
+                {{static_cast<size_t>(LazyConstraintType::EdgeHeadway), tr,
+                  tr_other_idx, rel_e_idx, v_idx, p.front(), vel_idx,
+                  rhs.size() == 1 ? 0 : rhs_idx + 1},
+                 lhs - rhs.at(rhs_idx)});
+          }
+        }
+      }
+
+      // Is there a conflict with TTD constraints
+      const auto intersecting_ttd =
+          cda_rail::Network::get_intersecting_ttd(p, solver->ttd_sections);
+      for (const auto& [ttd_index, e_index] : intersecting_ttd) {
+        const auto& p_tmp = std::vector<size_t>(p.begin(), p.begin() + e_index);
+        const auto  p_tmp_len = std::accumulate(
+            p_tmp.begin(), p_tmp.end(), 0.0,
+            [this](double sum, const auto& edge_index) {
+              return sum +
+                     solver->instance.const_n().get_edge(edge_index).length;
+            });
+        GRBLinExpr edge_tmp_path_expr = 0;
+        for (const auto& e_tmp : p_tmp) {
+          edge_tmp_path_expr += solver->vars.at("x")(tr, e_tmp);
+        }
+
+        const auto obd = bd - p_tmp_len;
+        assert(obd >= 0);
+
+        double                t_reduction = 0;
+        std::optional<double> t_addition;
+
+        std::optional<size_t> prev_v_idx;
+        std::optional<double> prev_pos;
+        std::optional<double> prev_vel;
+        std::optional<GRBVar> prev_t_var;
+        std::optional<double> prev_t_var_value;
+        std::optional<size_t> prev_edge_index;
+
+        bool skip = false;
+        if (v_idx == entry) {
+          t_reduction = vel <= GRB_EPS ? 0 : obd / vel;
+        } else {
+          assert(r_v_idx >= 1);
+          prev_v_idx = routes.at(tr).at(r_v_idx - 1).first;
+          prev_pos   = routes.at(tr).at(r_v_idx - 1).second;
+          prev_vel   = train_velocities.at(tr).at(prev_v_idx.value());
+          const auto& prev_bd = prev_vel.value() * prev_vel.value() /
+                                (2 * tr_object.deceleration);
+          const auto& prev_ma_pos = prev_pos.value() + prev_bd;
+          prev_edge_index         = solver->instance.const_n().get_edge_index(
+              prev_v_idx.value(), v_idx);
+          const auto& prev_edge_object =
+              solver->instance.const_n().get_edge(prev_edge_index.value());
+          prev_t_var =
+              solver->vars.at("t_front_departure")(tr, prev_v_idx.value());
+          prev_t_var_value =
+              values.t_front_departure.at(tr, prev_v_idx.value());
+          const auto& prev_max_speed =
+              std::min(prev_edge_object.max_speed, tr_object.max_speed);
+          if (prev_ma_pos > pos + p_tmp_len) {
+            skip = true;
+            // obd is too long and relevant vertex is earlier
+          } else {
+            t_reduction = cda_rail::min_time_from_rear_to_ma_point(
+                prev_vel.value(), vel, V_MIN, prev_max_speed,
+                tr_object.acceleration, tr_object.deceleration,
+                prev_edge_object.length, obd);
+            const auto tmp_max = cda_rail::max_time_from_front_to_ma_point(
+                prev_vel.value(), vel, V_MIN, tr_object.acceleration,
+                tr_object.deceleration, prev_edge_object.length, obd,
+                prev_edge_object.breakable);
+            if (tmp_max < std::numeric_limits<double>::infinity()) {
+              t_addition = tmp_max;
+            }
           }
-          return p_tmp;
-        }();
-        const auto& rel_e_idx = p.back();
-        const auto& rel_e_obj = solver->instance.const_n().get_edge(rel_e_idx);
-
-        // Create path expression according to route. The first edge must
-        // use the specified velocity or faster, since only then the desired
-        // headway must hold.
-        const GRBLinExpr edge_path_expr = solver->get_edge_path_expr(
-            tr, p, vel,
-            solver->solver_strategy.include_higher_velocities_in_edge_expr);
+        }
+
+        if (skip) {
+          continue;
+        }
 
         // Get other trains that might conflict with the current train on
-        // this edge
-        std::unordered_set<size_t> other_trains;
-        const auto& tr_order = train_orders_on_edges.at(rel_e_idx).first;
-        const auto  tr_index = std::find(tr_order.begin(), tr_order.end(),
-                                         std::pair<size_t, bool>(tr, true)) -
-                              tr_order.begin();
-        assert(tr_index != tr_order.end() - tr_order.begin());
-        for (size_t tr_other_idx = 0; tr_other_idx < tr_order.size();
+        // this TTD section
+        const auto& rel_tr_order_ttd = train_orders_on_ttd.at(ttd_index);
+        std::unordered_set<size_t> other_trains_ttd;
+        const auto                 tr_index_ttd =
+            std::find(rel_tr_order_ttd.begin(), rel_tr_order_ttd.end(), tr) -
+            rel_tr_order_ttd.begin();
+        assert(tr_index_ttd !=
+               rel_tr_order_ttd.end() - rel_tr_order_ttd.begin());
+        for (size_t tr_other_idx = 0; tr_other_idx < rel_tr_order_ttd.size();
              tr_other_idx++) {
-          if (tr_other_idx == tr_index) {
-            continue;
-          }
-          if (!tr_order.at(tr_other_idx).second) {
-            // The train travels in reverse direction!
+          if (tr_other_idx == tr_index_ttd) {
             continue;
           }
           if (solver->solver_strategy.lazy_train_selection_strategy ==
                   LazyTrainSelectionStrategy::OnlyAdjacent &&
               std::abs(static_cast<int>(tr_other_idx) -
-                       static_cast<int>(tr_index)) > 1) {
+                       static_cast<int>(tr_index_ttd)) > 1) {
             continue;
           }
           if (!solver->solver_strategy.include_reverse_headways &&
-              tr_other_idx > tr_index) {
+              tr_other_idx > tr_index_ttd) {
             // In this case tr_other follows tr, which is irrelevant for tr ma
             continue;
           }
-          other_trains.insert(tr_order.at(tr_other_idx).first);
+          other_trains_ttd.insert(rel_tr_order_ttd.at(tr_other_idx));
         }
-        for (const auto& tr_other_idx : other_trains) {
-          const auto& tr_other_object =
-              solver->instance.get_train_list().get_train(tr_other_idx);
-          const auto& tr_other_source_speed =
-              train_velocities.at(tr_other_idx).at(rel_source);
-          const auto& tr_other_target_speed =
-              train_velocities.at(tr_other_idx).at(rel_target);
-
-          const auto& tr_other_source_var =
-              solver->vars["t_rear_departure"](tr_other_idx, rel_source);
-          const auto& tr_other_target_var =
-              solver->vars["t_rear_departure"](tr_other_idx, rel_target);
-
-          const auto& tr_other_max_speed =
-              std::min(tr_other_object.max_speed, rel_e_obj.max_speed);
 
-          // Check if this constraint should be added
+        for (const size_t other_tr : other_trains_ttd) {
+          // Check if TTD constraint is violated or not and add if needed
           bool add_constr =
               (solver->solver_strategy.lazy_constraint_selection_strategy ==
                LazyConstraintSelectionStrategy::AllChecked);
-          if (!add_constr &&
-              tr_t_var_value <
-                  getSolution(tr_other_source_var) +
-                      cda_rail::min_travel_time_from_start(
-                          tr_other_source_speed, tr_other_target_speed,
-                          tr_other_max_speed, tr_other_object.acceleration,
-                          tr_other_object.deceleration, rel_e_obj.length,
-                          rel_pos_on_edge) -
-                      GRB_EPS) {
+          const auto& other_tr_t_variable =
+              solver->vars.at("t_ttd_departure")(other_tr, ttd_index);
+          const auto other_tr_t_value =
+              values.t_ttd_departure.at(other_tr, ttd_index);
+          if (!add_constr && tr_t_var_value - t_reduction < other_tr_t_value) {
             add_constr = true;
           }
-          if (!add_constr && rel_pos_on_edge > EPS &&
-              tr_t_var_value <
-                  getSolution(tr_other_target_var) -
-                      cda_rail::max_travel_time_to_end(
-                          tr_other_source_speed, tr_other_target_speed, V_MIN,
-                          tr_other_object.acceleration,
-                          tr_other_object.deceleration, rel_e_obj.length,
-                          rel_pos_on_edge, rel_e_obj.breakable) -
-                      GRB_EPS) {
+          if (!add_constr && prev_t_var_value.has_value() &&
+              t_addition.has_value() &&
+              prev_t_var_value.value() + t_addition.value() <
+                  other_tr_t_value - GRB_EPS) {
             add_constr = true;
           }
 
-          const auto t_bound_tmp =
-              std::max(t_bound, solver->ub_timing_variable(tr_other_idx));
-
           if (add_constr) {
-            const GRBLinExpr lhs =
-                tr_t_var +
-                t_bound_tmp * (static_cast<double>(p.size()) - edge_path_expr) +
+            const auto t_bound_tmp =
+                std::max(t_bound, solver->ub_timing_variable(other_tr));
+            GRBLinExpr rhs =
+                other_tr_t_variable +
                 t_bound_tmp *
-                    (1 - solver->vars["order"](tr, tr_other_idx, p.back()));
-            std::vector<GRBLinExpr> rhs;
-            if (std::abs(rel_e_obj.length - rel_pos_on_edge) < EPS) {
-              rhs.emplace_back(tr_other_target_var);
-            } else if (rel_pos_on_edge < EPS) {
-              rhs.emplace_back(tr_other_source_var);
-            } else {
-              rhs.emplace_back(tr_other_source_var);
-              rhs.emplace_back(tr_other_target_var);
-
-              const auto& v_tr_other_source_velocities =
-                  solver->velocity_extensions.at(tr_other_idx).at(rel_source);
-              const auto& v_tr_other_target_velocities =
-                  solver->velocity_extensions.at(tr_other_idx).at(rel_target);
-
-              for (size_t v_tr_other_source_index = 0;
-                   v_tr_other_source_index <
-                   v_tr_other_source_velocities.size();
-                   v_tr_other_source_index++) {
-                const auto& vel_tr_other_source =
-                    v_tr_other_source_velocities.at(v_tr_other_source_index);
-                if (vel_tr_other_source > tr_other_max_speed) {
-                  continue;
-                }
-                for (size_t v_tr_other_target_index = 0;
-                     v_tr_other_target_index <
-                     v_tr_other_target_velocities.size();
-                     v_tr_other_target_index++) {
-                  const auto& vel_tr_other_target =
-                      v_tr_other_target_velocities.at(v_tr_other_target_index);
-                  if (vel_tr_other_target > tr_other_max_speed) {
-                    continue;
-                  }
-                  if (cda_rail::possible_by_eom(
-                          vel_tr_other_source, vel_tr_other_target,
-                          tr_other_object.acceleration,
-                          tr_other_object.deceleration, rel_e_obj.length)) {
-                    rhs.at(0) +=
-                        solver->vars["y"](tr_other_idx, rel_e_idx,
-                                          v_tr_other_source_index,
-                                          v_tr_other_target_index) *
-                        cda_rail::min_travel_time_from_start(
-                            vel_tr_other_source, vel_tr_other_target,
-                            tr_other_max_speed, tr_other_object.acceleration,
-                            tr_other_object.deceleration, rel_e_obj.length,
-                            rel_pos_on_edge);
-                    const auto max_travel_time =
-                        cda_rail::max_travel_time_to_end(
-                            vel_tr_other_source, vel_tr_other_target, V_MIN,
-                            tr_other_object.acceleration,
-                            tr_other_object.deceleration, rel_e_obj.length,
-                            rel_pos_on_edge, rel_e_obj.breakable);
-                    rhs.at(1) -=
-                        solver->vars["y"](tr_other_idx, rel_e_idx,
-                                          v_tr_other_source_index,
-                                          v_tr_other_target_index) *
-                        (max_travel_time > t_bound_tmp ? t_bound_tmp
-                                                       : max_travel_time);
-                  }
-                }
-              }
-            }
-
-            // Previous simple order constraint deleted, because making sure
-            // that the order variable has the correct semantic value is ensured
-            // by vertex headway constraints
-
-            for (const auto& rhs_expr : rhs) {
-              addLazy(lhs >= rhs_expr);
-              if (solver->solution_settings.export_option ==
-                      ExportOption::ExportLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionAndLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionWithInstanceAndLP) {
-                solver->lazy_constraints.push_back(lhs >= rhs_expr);
-              }
-              violated_constraint_found = true;
-            }
-          }
-        }
-
-        // Is there a conflict with TTD constraints
-        const auto intersecting_ttd =
-            cda_rail::Network::get_intersecting_ttd(p, solver->ttd_sections);
-        for (const auto& [ttd_index, e_index] : intersecting_ttd) {
-          const auto& p_tmp =
-              std::vector<size_t>(p.begin(), p.begin() + e_index);
-          const auto p_tmp_len = std::accumulate(
-              p_tmp.begin(), p_tmp.end(), 0.0,
-              [this](double sum, const auto& edge_index) {
-                return sum +
-                       solver->instance.const_n().get_edge(edge_index).length;
-              });
-          GRBLinExpr edge_tmp_path_expr = 0;
-          for (const auto& e_tmp : p_tmp) {
-            edge_tmp_path_expr += solver->vars["x"](tr, e_tmp);
-          }
-
-          const auto obd = bd - p_tmp_len;
-          assert(obd >= 0);
-
-          double                t_reduction = 0;
-          std::optional<double> t_addition;
-
-          std::optional<size_t> prev_v_idx;
-          std::optional<double> prev_pos;
-          std::optional<double> prev_vel;
-          std::optional<GRBVar> prev_t_var;
-          std::optional<double> prev_t_var_value;
-          std::optional<size_t> prev_edge_index;
-
-          bool skip = false;
-          if (v_idx == entry) {
-            t_reduction = vel <= GRB_EPS ? 0 : obd / vel;
-          } else {
-            assert(r_v_idx >= 1);
-            prev_v_idx = routes.at(tr).at(r_v_idx - 1).first;
-            prev_pos   = routes.at(tr).at(r_v_idx - 1).second;
-            prev_vel   = train_velocities.at(tr).at(prev_v_idx.value());
-            const auto& prev_bd = prev_vel.value() * prev_vel.value() /
-                                  (2 * tr_object.deceleration);
-            const auto& prev_ma_pos = prev_pos.value() + prev_bd;
-            prev_edge_index         = solver->instance.const_n().get_edge_index(
-                prev_v_idx.value(), v_idx);
-            const auto& prev_edge_object =
-                solver->instance.const_n().get_edge(prev_edge_index.value());
-            prev_t_var =
-                solver->vars["t_front_departure"](tr, prev_v_idx.value());
-            prev_t_var_value = getSolution(prev_t_var.value());
-            const auto& prev_max_speed =
-                std::min(prev_edge_object.max_speed, tr_object.max_speed);
-            if (prev_ma_pos > pos + p_tmp_len) {
-              skip = true;
-              // obd is too long and relevant vertex is earlier
-            } else {
-              t_reduction = cda_rail::min_time_from_rear_to_ma_point(
-                  prev_vel.value(), vel, V_MIN, prev_max_speed,
-                  tr_object.acceleration, tr_object.deceleration,
-                  prev_edge_object.length, obd);
-              const auto tmp_max = cda_rail::max_time_from_front_to_ma_point(
-                  prev_vel.value(), vel, V_MIN, tr_object.acceleration,
-                  tr_object.deceleration, prev_edge_object.length, obd,
-                  prev_edge_object.breakable);
-              if (tmp_max < std::numeric_limits<double>::infinity()) {
-                t_addition = tmp_max;
-              }
-            }
-          }
-
-          if (skip) {
-            continue;
-          }
-
-          // Get other trains that might conflict with the current train on
-          // this TTD section
-          const auto& rel_tr_order_ttd = train_orders_on_ttd.at(ttd_index);
-          std::unordered_set<size_t> other_trains_ttd;
-          const auto                 tr_index =
-              std::find(rel_tr_order_ttd.begin(), rel_tr_order_ttd.end(), tr) -
-              rel_tr_order_ttd.begin();
-          assert(tr_index != rel_tr_order_ttd.end() - rel_tr_order_ttd.begin());
-          for (size_t tr_other_idx = 0; tr_other_idx < rel_tr_order_ttd.size();
-               tr_other_idx++) {
-            if (tr_other_idx == tr_index) {
-              continue;
-            }
-            if (solver->solver_strategy.lazy_train_selection_strategy ==
-                    LazyTrainSelectionStrategy::OnlyAdjacent &&
-                std::abs(static_cast<int>(tr_other_idx) -
-                         static_cast<int>(tr_index)) > 1) {
-              continue;
-            }
-            if (!solver->solver_strategy.include_reverse_headways &&
-                tr_other_idx > tr_index) {
-              // In this case tr_other follows tr, which is irrelevant for tr ma
-              continue;
-            }
-            other_trains_ttd.insert(rel_tr_order_ttd.at(tr_other_idx));
-          }
-
-          for (const size_t other_tr : other_trains_ttd) {
-            // Check if TTD constraint is violated or not and add if needed
-            bool add_constr =
-                (solver->solver_strategy.lazy_constraint_selection_strategy ==
-                 LazyConstraintSelectionStrategy::AllChecked);
-            const auto& other_tr_t_variable =
-                solver->vars["t_ttd_departure"](other_tr, ttd_index);
-            if (!add_constr && tr_t_var_value - t_reduction <
-                                   getSolution(other_tr_t_variable)) {
-              add_constr = true;
-            }
-            if (!add_constr && prev_t_var_value.has_value() &&
-                t_addition.has_value() &&
-                prev_t_var_value.value() + t_addition.value() <
-                    getSolution(other_tr_t_variable) - GRB_EPS) {
-              add_constr = true;
-            }
-
-            if (add_constr) {
-              const auto t_bound_tmp =
-                  std::max(t_bound, solver->ub_timing_variable(other_tr));
-              GRBLinExpr rhs =
-                  other_tr_t_variable +
+                    (solver->vars.at("order_ttd")(tr, other_tr, ttd_index) - 1);
+            std::vector<GRBLinExpr> lhs;
+            size_t                  prev_vel_idx = 0;
+            if (prev_edge_index.has_value()) {
+              assert(prev_vel.has_value());
+              const auto& prev_v_velocities =
+                  solver->velocity_extensions.at(tr).at(prev_v_idx.value());
+              prev_vel_idx = static_cast<size_t>(
+                  std::find(prev_v_velocities.begin(), prev_v_velocities.end(),
+                            prev_vel.value()) -
+                  prev_v_velocities.begin());
+              lhs.emplace_back(
+                  tr_t_var - t_reduction +
                   t_bound_tmp *
-                      (solver->vars["order_ttd"](tr, other_tr, ttd_index) - 1);
-              std::vector<GRBLinExpr> lhs;
-              if (prev_edge_index.has_value()) {
-                assert(prev_vel.has_value());
-                const auto vel_idx =
-                    std::find(
-                        solver->velocity_extensions.at(tr).at(v_idx).begin(),
-                        solver->velocity_extensions.at(tr).at(v_idx).end(),
-                        vel) -
-                    solver->velocity_extensions.at(tr).at(v_idx).begin();
-                const auto prev_vel_idx =
-                    std::find(solver->velocity_extensions.at(tr)
-                                  .at(prev_v_idx.value())
-                                  .begin(),
-                              solver->velocity_extensions.at(tr)
-                                  .at(prev_v_idx.value())
-                                  .end(),
-                              prev_vel.value()) -
-                    solver->velocity_extensions.at(tr)
-                        .at(prev_v_idx.value())
-                        .begin();
+                      (static_cast<double>(p_tmp.size()) - edge_tmp_path_expr +
+                       1 -
+                       solver->vars.at("y")(tr, prev_edge_index.value(),
+                                            prev_vel_idx, vel_idx)));
+              if (t_addition.has_value()) {
+                assert(prev_t_var.has_value());
                 lhs.emplace_back(
-                    tr_t_var - t_reduction +
+                    prev_t_var.value() + t_addition.value() +
                     t_bound_tmp *
                         (static_cast<double>(p_tmp.size()) -
                          edge_tmp_path_expr + 1 -
-                         solver->vars["y"](tr, prev_edge_index.value(),
-                                           prev_vel_idx, vel_idx)));
-                if (t_addition.has_value()) {
-                  assert(prev_t_var.has_value());
-                  lhs.emplace_back(
-                      prev_t_var.value() + t_addition.value() +
-                      t_bound_tmp *
-                          (static_cast<double>(p_tmp.size()) -
-                           edge_tmp_path_expr + 1 -
-                           solver->vars["y"](tr, prev_edge_index.value(),
-                                             prev_vel_idx, vel_idx)));
-                }
-              } else {
-                // Entry node
-                assert(v_idx == entry);
-                lhs.emplace_back(tr_t_var - t_reduction +
-                                 t_bound_tmp *
-                                     (static_cast<double>(p_tmp.size()) -
-                                      edge_tmp_path_expr));
+                         solver->vars.at("y")(tr, prev_edge_index.value(),
+                                              prev_vel_idx, vel_idx)));
               }
+            } else {
+              // Entry node
+              assert(v_idx == entry);
+              lhs.emplace_back(tr_t_var - t_reduction +
+                               t_bound_tmp *
+                                   (static_cast<double>(p_tmp.size()) -
+                                    edge_tmp_path_expr));
+            }
 
-              for (const auto& lhs_expr : lhs) {
-                addLazy(lhs_expr >= rhs);
-                if (solver->solution_settings.export_option ==
-                        ExportOption::ExportLP ||
-                    solver->solution_settings.export_option ==
-                        ExportOption::ExportSolutionAndLP ||
-                    solver->solution_settings.export_option ==
-                        ExportOption::ExportSolutionWithInstanceAndLP) {
-                  solver->lazy_constraints.push_back(lhs_expr >= rhs);
-                }
-                violated_constraint_found = true;
-              }
+            for (size_t lhs_idx = 0; lhs_idx < lhs.size(); lhs_idx++) {
+              constraints.push_back(
+                  {{static_cast<size_t>(LazyConstraintType::TTDHeadway), tr,
+                    other_tr, ttd_index, v_idx,
+                    prev_edge_index.value_or(solver->num_edges), vel_idx,
+                    2 * prev_vel_idx + lhs_idx},
+                   lhs.at(lhs_idx) - rhs});
             }
           }
         }
       }
     }
   }
-
-  return violated_constraint_found;
 }
 
 bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
@@ -664,298 +1077,328 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
         const std::vector<std::unordered_map<size_t, double>>& train_velocities,
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
-            train_orders_on_edges) {
+                                  train_orders_on_edges,
+        const LazySolutionValues& values) {
+  return separate_and_add_lazy_constraints(
+      solver->num_tr,
+      [&](size_t tr, std::vector<LazyConstraintCandidate>& constraints) {
+        separate_vertex_headway_constraints(tr, routes, train_velocities,
+                                            train_orders_on_edges, values,
+                                            constraints);
+      });
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_vertex_headway_constraints(
+        size_t                                                     tr,
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::unordered_map<size_t, double>>& train_velocities,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                              train_orders_on_edges,
+        const LazySolutionValues&             values,
+        std::vector<LazyConstraintCandidate>& constraints) {
   // Check for violated vertex headways
-  bool violated_constraint_found = false;
-  bool only_one_constraint =
+  const bool only_one_constraint =
       solver->solver_strategy.lazy_constraint_selection_strategy ==
       LazyConstraintSelectionStrategy::OnlyFirstFound;
 
-  for (size_t tr = 0; tr < solver->num_tr &&
-                      (!only_one_constraint || !violated_constraint_found);
-       tr++) {
-    const auto tr_t_bound = solver->ub_timing_variable(tr);
-    const auto tr_object  = solver->instance.get_train_list().get_train(tr);
-    // Check every vertex on the route
-    for (size_t r_v_idx = 0;
-         r_v_idx < routes.at(tr).size() - 1 &&
-         (!only_one_constraint || !violated_constraint_found);
-         r_v_idx++) {
-      const auto& v_source   = routes.at(tr).at(r_v_idx).first;
-      const auto& v_target   = routes.at(tr).at(r_v_idx + 1).first;
-      const auto& vel_source = train_velocities.at(tr).at(v_source);
-      const auto& vel_target = train_velocities.at(tr).at(v_target);
-      const auto& edge_index =
-          solver->instance.const_n().get_edge_index(v_source, v_target);
-
-      const auto& [rel_tr_order_source, rel_tr_order_target] =
-          train_orders_on_edges.at(edge_index);
-
-      const auto& v_source_obj =
-          solver->instance.const_n().get_vertex(v_source);
-      const auto& v_target_obj =
-          solver->instance.const_n().get_vertex(v_target);
-
-      // Variables to possibly strengthen the constraints
-      auto [hw_s1_max, hw_s1, hw_t1_max, hw_t1] =
-          solver->get_vertex_headway_expressions(tr, edge_index);
-
-      auto hw_s1_value = std::max(
-          v_source_obj.headway,
-          min_time_to_push_ma_fully_backward(vel_source, tr_object.acceleration,
-                                             tr_object.deceleration));
-      auto hw_t1_value = std::max(
-          v_target_obj.headway,
-          min_time_to_push_ma_fully_backward(vel_target, tr_object.acceleration,
-                                             tr_object.deceleration));
-
-      const auto tr_idx_source =
-          std::find(rel_tr_order_source.begin(), rel_tr_order_source.end(),
-                    std::pair<size_t, bool>(tr, true)) -
-          rel_tr_order_source.begin();
-      const auto tr_idx_target =
-          std::find(rel_tr_order_target.begin(), rel_tr_order_target.end(),
-                    std::pair<size_t, bool>(tr, true)) -
-          rel_tr_order_target.begin();
-      assert(tr_idx_source < rel_tr_order_source.size());
-      assert(tr_idx_target < rel_tr_order_target.size());
-      size_t       lb_idx = 0;
-      const size_t ub_idx = static_cast<int>(tr_idx_source);
-      // Depending on strategy, not all trains are considered
-      if (solver->solver_strategy.lazy_train_selection_strategy ==
-          LazyTrainSelectionStrategy::OnlyAdjacent) {
-        lb_idx = std::max<int>(static_cast<int>(lb_idx),
-                               static_cast<int>(tr_idx_source) - 1);
+  const auto  tr_t_bound = solver->ub_timing_variable(tr);
+  const auto& tr_object  = solver->instance.get_train_list().get_train(tr);
+  // Check every vertex on the route
+  for (size_t r_v_idx = 0; r_v_idx < routes.at(tr).size() - 1 &&
+                           (!only_one_constraint || constraints.empty());
+       r_v_idx++) {
+    const auto& v_source   = routes.at(tr).at(r_v_idx).first;
+    const auto& v_target   = routes.at(tr).at(r_v_idx + 1).first;
+    const auto& vel_source = train_velocities.at(tr).at(v_source);
+    const auto& vel_target = train_velocities.at(tr).at(v_target);
+    const auto& edge_index =
+        solver->instance.const_n().get_edge_index(v_source, v_target);
+
+    const auto& [rel_tr_order_source, rel_tr_order_target] =
+        train_orders_on_edges.at(edge_index);
+
+    const auto& v_source_obj = solver->instance.const_n().get_vertex(v_source);
+    const auto& v_target_obj = solver->instance.const_n().get_vertex(v_target);
+
+    // Variables to possibly strengthen the constraints
+    auto [hw_s1_max, hw_s1, hw_t1_max, hw_t1] =
+        solver->get_vertex_headway_expressions(tr, edge_index);
+
+    auto hw_s1_value = std::max(
+        v_source_obj.headway,
+        min_time_to_push_ma_fully_backward(vel_source, tr_object.acceleration,
+                                           tr_object.deceleration));
+    auto hw_t1_value = std::max(
+        v_target_obj.headway,
+        min_time_to_push_ma_fully_backward(vel_target, tr_object.acceleration,
+                                           tr_object.deceleration));
+
+    const auto tr_idx_source =
+        std::find(rel_tr_order_source.begin(), rel_tr_order_source.end(),
+                  std::pair<size_t, bool>(tr, true)) -
+        rel_tr_order_source.begin();
+    const auto tr_idx_target =
+        std::find(rel_tr_order_target.begin(), rel_tr_order_target.end(),
+                  std::pair<size_t, bool>(tr, true)) -
+        rel_tr_order_target.begin();
+    assert(tr_idx_source < rel_tr_order_source.size());
+    assert(tr_idx_target < rel_tr_order_target.size());
+    size_t       lb_idx = 0;
+    const size_t ub_idx = static_cast<int>(tr_idx_source);
+    // Depending on strategy, not all trains are considered
+    if (solver->solver_strategy.lazy_train_selection_strategy ==
+        LazyTrainSelectionStrategy::OnlyAdjacent) {
+      lb_idx = std::max<int>(static_cast<int>(lb_idx),
+                             static_cast<int>(tr_idx_source) - 1);
+    }
+    // Note reverse orders are always included anyway
+
+    const auto& tr_t_var_source_front =
+        solver->vars.at("t_front_arrival")(tr, v_source);
+    const auto& tr_t_var_source_rear =
+        solver->vars.at("t_rear_departure")(tr, v_source);
+    const auto& tr_t_var_target_front =
+        solver->vars.at("t_front_arrival")(tr, v_target);
+    const auto& tr_t_var_target_rear =
+        solver->vars.at("t_rear_departure")(tr, v_target);
+
+    for (size_t edge_order_other_tr_idx = lb_idx;
+         edge_order_other_tr_idx < ub_idx &&
+         (!only_one_constraint || constraints.empty());
+         edge_order_other_tr_idx++) {
+      const auto& [other_tr, other_tr_direction] =
+          rel_tr_order_source.at(edge_order_other_tr_idx);
+      if (!other_tr_direction) {
+        // The train travels in reverse direction!
+        continue;
       }
-      // Note reverse orders are always included anyway
-
-      auto tr_t_var_source_front =
-          solver->vars["t_front_arrival"](tr, v_source);
-      auto tr_t_var_source_rear =
-          solver->vars["t_rear_departure"](tr, v_source);
-      auto tr_t_var_target_front =
-          solver->vars["t_front_arrival"](tr, v_target);
-      auto tr_t_var_target_rear =
-          solver->vars["t_rear_departure"](tr, v_target);
-
-      for (size_t edge_order_other_tr_idx = lb_idx;
-           edge_order_other_tr_idx < ub_idx &&
-           (!only_one_constraint || !violated_constraint_found);
-           edge_order_other_tr_idx++) {
-        const auto& [other_tr, other_tr_direction] =
-            rel_tr_order_source.at(edge_order_other_tr_idx);
-        if (!other_tr_direction) {
-          // The train travels in reverse direction!
-          continue;
-        }
 
-        auto other_tr_t_var_source_front =
-            solver->vars["t_front_arrival"](other_tr, v_source);
-        auto other_tr_t_var_source_rear =
-            solver->vars["t_rear_departure"](other_tr, v_source);
-        auto other_tr_t_var_target_front =
-            solver->vars["t_front_arrival"](other_tr, v_target);
-        auto other_tr_t_var_target_rear =
-            solver->vars["t_rear_departure"](other_tr, v_target);
-
-        // If train order differs between source and target, also add vertex
-        // constraints
-        const auto other_tr_idx_target =
-            std::find(rel_tr_order_target.begin(), rel_tr_order_target.end(),
-                      std::pair<size_t, bool>(other_tr, true)) -
-            rel_tr_order_target.begin();
-        assert(other_tr_idx_target < rel_tr_order_target.size());
-        const bool same_order = other_tr_idx_target <
-                                tr_idx_target; // Because < at source by design
-        const auto wrong_order_var_is_one =
-            getSolution(solver->vars["order"](other_tr, tr, edge_index)) > 0.5;
-
-        // Check if specified vertex headway is fulfilled
-        if (!same_order || wrong_order_var_is_one ||
-            solver->solver_strategy.lazy_constraint_selection_strategy ==
-                LazyConstraintSelectionStrategy::AllChecked ||
-            getSolution(tr_t_var_source_front) -
-                    getSolution(other_tr_t_var_source_rear) <
-                hw_s1_value - GRB_EPS ||
-            getSolution(tr_t_var_target_front) -
-                    getSolution(other_tr_t_var_target_rear) <
-                hw_t1_value - GRB_EPS) {
-          const auto t_bound_tmp =
-              std::max(tr_t_bound, solver->ub_timing_variable(other_tr));
-
-          // Introduce basic constraints on order
-          GRBLinExpr order_expr =
-              solver->vars["order"](tr, other_tr, edge_index) +
-              solver->vars["order"](other_tr, tr, edge_index);
-          GRBLinExpr edge_expr = solver->vars["x"](tr, edge_index) +
-                                 solver->vars["x"](other_tr, edge_index);
-          addLazy(order_expr <= 0.5 * edge_expr);
-          addLazy(order_expr >= edge_expr - 1);
-
-          // Add headway constraints
-          GRBLinExpr lhs_source =
-              tr_t_var_source_front +
-              (t_bound_tmp + hw_s1_max) *
-                  (1 - solver->vars["order"](tr, other_tr, edge_index));
-          GRBLinExpr rhs_source = other_tr_t_var_source_rear + hw_s1;
-
-          GRBLinExpr lhs_target =
-              tr_t_var_target_front +
-              (t_bound_tmp + hw_t1_max) *
-                  (1 - solver->vars["order"](tr, other_tr, edge_index));
-          GRBLinExpr rhs_target = other_tr_t_var_target_rear + hw_t1;
-
-          // Reverse constraints are needed. Otherwise, the solver can
-          // reschedule the trains the exact same way by setting the order
-          // variable to the wrong value
-          auto [hw_s2_max, hw_s2, hw_t2_max, hw_t2] =
-              solver->get_vertex_headway_expressions(other_tr, edge_index);
-
-          GRBLinExpr lhs_source_2 =
-              other_tr_t_var_source_front +
-              (t_bound_tmp + hw_s2_max) *
-                  (1 - solver->vars["order"](other_tr, tr, edge_index));
-          GRBLinExpr rhs_source_2 = tr_t_var_source_rear + hw_s2;
-
-          GRBLinExpr lhs_target_2 =
-              other_tr_t_var_target_front +
-              (t_bound_tmp + hw_t2_max) *
-                  (1 - solver->vars["order"](other_tr, tr, edge_index));
-          GRBLinExpr rhs_target_2 = tr_t_var_target_rear + hw_t2;
-
-          addLazy(lhs_source >= rhs_source);
-          addLazy(lhs_target >= rhs_target);
-          addLazy(lhs_source_2 >= rhs_source_2);
-          addLazy(lhs_target_2 >= rhs_target_2);
-          if (solver->solution_settings.export_option ==
-                  ExportOption::ExportLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionAndLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionWithInstanceAndLP) {
-            // So that the constraint can be exported
-            solver->lazy_constraints.push_back(order_expr <= 0.5 * edge_expr);
-            solver->lazy_constraints.push_back(order_expr >= edge_expr - 1);
-            solver->lazy_constraints.push_back(lhs_source >= rhs_source);
-            solver->lazy_constraints.push_back(lhs_target >= rhs_target);
-            solver->lazy_constraints.push_back(lhs_source_2 >= rhs_source_2);
-            solver->lazy_constraints.push_back(lhs_target_2 >= rhs_target_2);
-          }
-          violated_constraint_found = true;
-        }
+      const auto& other_tr_t_var_source_front =
+          solver->vars.at("t_front_arrival")(other_tr, v_source);
+      const auto& other_tr_t_var_source_rear =
+          solver->vars.at("t_rear_departure")(other_tr, v_source);
+      const auto& other_tr_t_var_target_front =
+          solver->vars.at("t_front_arrival")(other_tr, v_target);
+      const auto& other_tr_t_var_target_rear =
+          solver->vars.at("t_rear_departure")(other_tr, v_target);
+
+      // If train order differs between source and target, also add vertex
+      // constraints
+      const auto other_tr_idx_target =
+          std::find(rel_tr_order_target.begin(), rel_tr_order_target.end(),
+                    std::pair<size_t, bool>(other_tr, true)) -
+          rel_tr_order_target.begin();
+      assert(other_tr_idx_target < rel_tr_order_target.size());
+      const bool same_order = other_tr_idx_target <
+                              tr_idx_target; // Because < at source by design
+      const auto wrong_order_var_is_one =
+          get_order_value(values, other_tr, tr, edge_index) > 0.5;
+
+      // Check if specified vertex headway is fulfilled
+      if (!same_order || wrong_order_var_is_one ||
+          solver->solver_strategy.lazy_constraint_selection_strategy ==
+              LazyConstraintSelectionStrategy::AllChecked ||
+          values.t_front_arrival.at(tr, v_source) -
+                  values.t_rear_departure.at(other_tr, v_source) <
+              hw_s1_value - GRB_EPS ||
+          values.t_front_arrival.at(tr, v_target) -
+                  values.t_rear_departure.at(other_tr, v_target) <
+              hw_t1_value - GRB_EPS) {
+        const auto t_bound_tmp =
+            std::max(tr_t_bound, solver->ub_timing_variable(other_tr));
+
+        // Introduce basic constraints on order
+        GRBLinExpr order_expr =
+            solver->vars.at("order")(tr, other_tr, edge_index) +
+            solver->vars.at("order")(other_tr, tr, edge_index);
+        GRBLinExpr edge_expr = solver->vars.at("x")(tr, edge_index) +
+                               solver->vars.at("x")(other_tr, edge_index);
+
+        // Add headway constraints
+        GRBLinExpr lhs_source =
+            tr_t_var_source_front +
+            (t_bound_tmp + hw_s1_max) *
+                (1 - solver->vars.at("order")(tr, other_tr, edge_index));
+        GRBLinExpr rhs_source = other_tr_t_var_source_rear + hw_s1;
+
+        GRBLinExpr lhs_target =
+            tr_t_var_target_front +
+            (t_bound_tmp + hw_t1_max) *
+                (1 - solver->vars.at("order")(tr, other_tr, edge_index));
+        GRBLinExpr rhs_target = other_tr_t_var_target_rear + hw_t1;
+
+        // Reverse constraints are needed. Otherwise, the solver can
+        // reschedule the trains the exact same way by setting the order
+        // variable to the wrong value
+        auto [hw_s2_max, hw_s2, hw_t2_max, hw_t2] =
+            solver->get_vertex_headway_expressions(other_tr, edge_index);
+
+        GRBLinExpr lhs_source_2 =
+            other_tr_t_var_source_front +
+            (t_bound_tmp + hw_s2_max) *
+                (1 - solver->vars.at("order")(other_tr, tr, edge_index));
+        GRBLinExpr rhs_source_2 = tr_t_var_source_rear + hw_s2;
+
+        GRBLinExpr lhs_target_2 =
+            other_tr_t_var_target_front +
+            (t_bound_tmp + hw_t2_max) *
+                (1 - solver->vars.at("order")(other_tr, tr, edge_index));
+        GRBLinExpr rhs_target_2 = tr_t_var_target_rear + hw_t2;
+
+        const auto order_type =
+            static_cast<size_t>(LazyConstraintType::VertexOrder);
+        const auto headway_type =
+            static_cast<size_t>(LazyConstraintType::VertexHeadway);
+        const auto tr_min = std::min(tr, other_tr);
+        const auto tr_max = std::max(tr, other_tr);
+        constraints.push_back({{order_type, tr_min, tr_max, edge_index, 0, 0,
+                                0, 0},
+                               order_expr - 0.5 * edge_expr, GRB_LESS_EQUAL});
+        constraints.push_back({{order_type, tr_min, tr_max, edge_index, 0, 0,
+                                0, 1},
+                               order_expr - edge_expr + 1});
+        constraints.push_back(
+            {{headway_type, tr, other_tr, edge_index, v_source, 0, 0, 0},
+             lhs_source - rhs_source});
+        constraints.push_back(
+            {{headway_type, tr, other_tr, edge_index, v_target, 0, 0, 1},
+             lhs_target - rhs_target});
+        constraints.push_back(
+            {{headway_type, other_tr, tr, edge_index, v_source, 0, 0, 0},
+             lhs_source_2 - rhs_source_2});
+        constraints.push_back(
+            {{headway_type, other_tr, tr, edge_index, v_target, 0, 0, 1},
+             lhs_target_2 - rhs_target_2});
       }
     }
   }
-
-  return violated_constraint_found;
 }
 
 bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
     create_lazy_reverse_edge_constraints(
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
-            train_orders_on_edges) {
+                                  train_orders_on_edges,
+        const LazySolutionValues& values) {
   // Prevent trains from front crashing into each other
-  bool violated_constraint_found = false;
-  bool only_one_constraint =
+  // Only check relevant breakable edges, which are bidirectional
+  return separate_and_add_lazy_constraints(
+      solver->relevant_reverse_edges.size(),
+      [&](size_t idx, std::vector<LazyConstraintCandidate>& constraints) {
+        separate_reverse_edge_constraints(idx, train_orders_on_edges, values,
+                                          constraints);
+      });
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_reverse_edge_constraints(
+        size_t idx,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                              train_orders_on_edges,
+        const LazySolutionValues&             values,
+        std::vector<LazyConstraintCandidate>& constraints) {
+  const bool only_one_constraint =
       solver->solver_strategy.lazy_constraint_selection_strategy ==
       LazyConstraintSelectionStrategy::OnlyFirstFound;
 
-  // Only check relevant breakable edges, which are bidirectional
-  for (size_t idx = 0; idx < solver->relevant_reverse_edges.size() &&
-                       (!only_one_constraint || !violated_constraint_found);
-       idx++) {
-    const auto& [e1, e2] = solver->relevant_reverse_edges.at(idx);
-    const auto& e_obj    = solver->instance.const_n().get_edge(e1);
-    for (size_t i = 0;
-         i < 2 && (!only_one_constraint || !violated_constraint_found); i++) {
-      const auto& tr_order = i == 0 ? train_orders_on_edges.at(e1).first
-                                    : train_orders_on_edges.at(e1).second;
-      for (size_t tr1_idx = 1;
-           tr1_idx < tr_order.size() &&
-           (!only_one_constraint || !violated_constraint_found);
-           tr1_idx++) {
-        const auto& [tr1, tr1_direction] = tr_order.at(tr1_idx);
-        const auto& tr1_t_var_front      = solver->vars["t_front_arrival"](
-            tr1, tr1_direction ? e_obj.source : e_obj.target);
-        const auto& tr1_t_var_value_front = getSolution(tr1_t_var_front);
-        const auto& tr1_t_var_rear        = solver->vars["t_rear_departure"](
-            tr1, tr1_direction ? e_obj.target : e_obj.source);
-        const auto tr1_t_bound = solver->ub_timing_variable(tr1);
-
-        size_t       lb_idx = 0;
-        const size_t ub_idx = tr1_idx;
-        // Depending on strategy, not all trains are considered
-        if (solver->solver_strategy.lazy_train_selection_strategy ==
-            LazyTrainSelectionStrategy::OnlyAdjacent) {
-          lb_idx = std::max<int>(static_cast<int>(lb_idx),
-                                 static_cast<int>(tr1_idx) - 1);
-        }
-        // Note reverse orders are always included anyway to ensure correctness
-
-        for (size_t tr2_idx = lb_idx;
-             tr2_idx < ub_idx &&
-             (!only_one_constraint || !violated_constraint_found);
-             tr2_idx++) {
-          assert(tr1_idx != tr2_idx);
-          const auto& [tr2, tr2_direction] = tr_order.at(tr2_idx);
-          if (tr1_direction == tr2_direction) {
-            // The trains travel in the same direction!
-            continue;
-          }
-          const auto& tr2_t_var_front = solver->vars["t_front_arrival"](
-              tr2, tr2_direction ? e_obj.source : e_obj.target);
-          const auto& tr2_t_var_rear = solver->vars["t_rear_departure"](
-              tr2, tr2_direction ? e_obj.target : e_obj.source);
-          const auto& tr2_t_var_value_rear = getSolution(tr2_t_var_rear);
-
-          // Check if trains do not crash as specified
-          if (solver->solver_strategy.lazy_constraint_selection_strategy ==
-                  LazyConstraintSelectionStrategy::AllChecked ||
-              tr1_t_var_value_front < tr2_t_var_value_rear - GRB_EPS) {
-            const auto  tr2_t_bound = solver->ub_timing_variable(tr2);
-            const auto  t_bound     = std::max(tr1_t_bound, tr2_t_bound);
-            const auto& tr1_edge    = tr1_direction ? e1 : e2;
-            const auto& tr2_edge    = tr2_direction ? e1 : e2;
-
-            GRBLinExpr lhs1 = solver->vars["reverse_order"](tr1, tr2, idx) +
-                              solver->vars["reverse_order"](tr2, tr1, idx);
-            GRBLinExpr rhs1 = solver->vars["x"](tr1, tr1_edge) +
-                              solver->vars["x"](tr2, tr2_edge) - 1;
-
-            GRBLinExpr lhs2 =
-                tr1_t_var_front +
-                t_bound * (1 - solver->vars["reverse_order"](tr1, tr2, idx));
-            GRBLinExpr rhs2 = tr2_t_var_rear;
-            GRBLinExpr lhs3 =
-                tr2_t_var_front +
-                t_bound * (1 - solver->vars["reverse_order"](tr2, tr1, idx));
-            GRBLinExpr rhs3 = tr1_t_var_rear;
-
-            addLazy(lhs1 >= rhs1);
-            addLazy(lhs1 <= 1);
-            addLazy(lhs2 >= rhs2);
-            addLazy(lhs3 >= rhs3);
-
-            if (solver->solution_settings.export_option ==
-                    ExportOption::ExportLP ||
-                solver->solution_settings.export_option ==
-                    ExportOption::ExportSolutionAndLP ||
-                solver->solution_settings.export_option ==
-                    ExportOption::ExportSolutionWithInstanceAndLP) {
-              solver->lazy_constraints.push_back(lhs1 >= rhs1);
-              solver->lazy_constraints.push_back(lhs1 <= 1);
-              solver->lazy_constraints.push_back(lhs2 >= rhs2);
-              solver->lazy_constraints.push_back(lhs3 >= rhs3);
-            }
+  const auto& [e1, e2] = solver->relevant_reverse_edges.at(idx);
+  const auto& e_obj    = solver->instance.const_n().get_edge(e1);
+  for (size_t i = 0; i < 2 && (!only_one_constraint || constraints.empty());
+       i++) {
+    const auto& tr_order = i == 0 ? train_orders_on_edges.at(e1).first
+                                  : train_orders_on_edges.at(e1).second;
+    for (size_t tr1_idx = 1; tr1_idx < tr_order.size() &&
+                             (!only_one_constraint || constraints.empty());
+         tr1_idx++) {
+      const auto& [tr1, tr1_direction] = tr_order.at(tr1_idx);
+      const auto& tr1_front_vertex =
+          tr1_direction ? e_obj.source : e_obj.target;
+      const auto& tr1_rear_vertex =
+          tr1_direction ? e_obj.target : e_obj.source;
+      const auto& tr1_t_var_front =
+          solver->vars.at("t_front_arrival")(tr1, tr1_front_vertex);
+      const auto tr1_t_var_value_front =
+          values.t_front_arrival.at(tr1, tr1_front_vertex);
+      const auto& tr1_t_var_rear =
+          solver->vars.at("t_rear_departure")(tr1, tr1_rear_vertex);
+      const auto tr1_t_bound = solver->ub_timing_variable(tr1);
 
-            violated_constraint_found = true;
-          }
+      size_t       lb_idx = 0;
+      const size_t ub_idx = tr1_idx;
+      // Depending on strategy, not all trains are considered
+      if (solver->solver_strategy.lazy_train_selection_strategy ==
+          LazyTrainSelectionStrategy::OnlyAdjacent) {
+        lb_idx = std::max<int>(static_cast<int>(lb_idx),
+                               static_cast<int>(tr1_idx) - 1);
+      }
+      // Note reverse orders are always included anyway to ensure correctness
+
+      for (size_t tr2_idx = lb_idx;
+           tr2_idx < ub_idx && (!only_one_constraint || constraints.empty());
+           tr2_idx++) {
+        assert(tr1_idx != tr2_idx);
+        const auto& [tr2, tr2_direction] = tr_order.at(tr2_idx);
+        if (tr1_direction == tr2_direction) {
+          // The trains travel in the same direction!
+          continue;
+        }
+        const auto& tr2_front_vertex =
+            tr2_direction ? e_obj.source : e_obj.target;
+        const auto& tr2_rear_vertex =
+            tr2_direction ? e_obj.target : e_obj.source;
+        const auto& tr2_t_var_front =
+            solver->vars.at("t_front_arrival")(tr2, tr2_front_vertex);
+        const auto& tr2_t_var_rear =
+            solver->vars.at("t_rear_departure")(tr2, tr2_rear_vertex);
+        const auto tr2_t_var_value_rear =
+            values.t_rear_departure.at(tr2, tr2_rear_vertex);
+
+        // Check if trains do not crash as specified
+        if (solver->solver_strategy.lazy_constraint_selection_strategy ==
+                LazyConstraintSelectionStrategy::AllChecked ||
+            tr1_t_var_value_front < tr2_t_var_value_rear - GRB_EPS) {
+          const auto  tr2_t_bound = solver->ub_timing_variable(tr2);
+          const auto  t_bound     = std::max(tr1_t_bound, tr2_t_bound);
+          const auto& tr1_edge    = tr1_direction ? e1 : e2;
+          const auto& tr2_edge    = tr2_direction ? e1 : e2;
+
+          GRBLinExpr lhs1 = solver->vars.at("reverse_order")(tr1, tr2, idx) +
+                            solver->vars.at("reverse_order")(tr2, tr1, idx);
+          GRBLinExpr rhs1 = solver->vars.at("x")(tr1, tr1_edge) +
+                            solver->vars.at("x")(tr2, tr2_edge) - 1;
+
+          GRBLinExpr lhs2 =
+              tr1_t_var_front +
+              t_bound * (1 - solver->vars.at("reverse_order")(tr1, tr2, idx));
+          GRBLinExpr rhs2 = tr2_t_var_rear;
+          GRBLinExpr lhs3 =
+              tr2_t_var_front +
+              t_bound * (1 - solver->vars.at("reverse_order")(tr2, tr1, idx));
+          GRBLinExpr rhs3 = tr1_t_var_rear;
+
+          const auto order_type =
+              static_cast<size_t>(LazyConstraintType::ReverseOrder);
+          const auto headway_type =
+              static_cast<size_t>(LazyConstraintType::ReverseHeadway);
+          const auto tr_min = std::min(tr1, tr2);
+          const auto tr_max = std::max(tr1, tr2);
+          constraints.push_back(
+              {{order_type, tr_min, tr_max, idx, 0, 0, 0, 0}, lhs1 - rhs1});
+          constraints.push_back(
+              {{order_type, tr_min, tr_max, idx, 0, 0, 0, 1},
+               lhs1 - 1,
+               GRB_LESS_EQUAL});
+          constraints.push_back(
+              {{headway_type, tr1, tr2, idx, 0, 0, 0, 0}, lhs2 - rhs2});
+          constraints.push_back(
+              {{headway_type, tr2, tr1, idx, 0, 0, 0, 0}, lhs3 - rhs3});
         }
       }
     }
   }
-  return violated_constraint_found;
 }
 
 bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
@@ -965,195 +1408,203 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
         const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
                                     std::vector<std::pair<size_t, bool>>>>&
                                                 train_orders_on_edges,
-        const std::vector<std::vector<size_t>>& train_orders_on_ttd) {
-  bool violated_constraint_found = false;
-  bool only_one_constraint =
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values) {
+  return separate_and_add_lazy_constraints(
+      solver->num_tr,
+      [&](size_t tr, std::vector<LazyConstraintCandidate>& constraints) {
+        separate_simplified_edge_constraints(
+            tr, routes, train_velocities, train_orders_on_edges,
+            train_orders_on_ttd, values, constraints);
+      });
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_simplified_edge_constraints(
+        size_t                                                     tr,
+        const std::vector<std::vector<std::pair<size_t, double>>>& routes,
+        const std::vector<std::unordered_map<size_t, double>>& train_velocities,
+        const std::vector<std::pair<std::vector<std::pair<size_t, bool>>,
+                                    std::vector<std::pair<size_t, bool>>>>&
+                                                train_orders_on_edges,
+        const std::vector<std::vector<size_t>>& train_orders_on_ttd,
+        const LazySolutionValues&               values,
+        std::vector<LazyConstraintCandidate>&   constraints) {
+  const bool only_one_constraint =
       solver->solver_strategy.lazy_constraint_selection_strategy ==
       LazyConstraintSelectionStrategy::OnlyFirstFound;
 
-  for (size_t tr = 0; tr < solver->num_tr &&
-                      (!only_one_constraint || !violated_constraint_found);
-       tr++) {
-    const auto tr_t_bound = solver->ub_timing_variable(tr);
-    const auto tr_object  = solver->instance.get_train_list().get_train(tr);
-    // Check every vertex on the route
-    for (size_t r_v_idx = 0;
-         r_v_idx < routes.at(tr).size() - 1 &&
-         (!only_one_constraint || !violated_constraint_found);
-         r_v_idx++) {
-      const auto& v_source   = routes.at(tr).at(r_v_idx).first;
-      const auto& v_target   = routes.at(tr).at(r_v_idx + 1).first;
-      const auto& vel_source = train_velocities.at(tr).at(v_source);
-      const auto& vel_target = train_velocities.at(tr).at(v_target);
-      const auto& edge_index =
-          solver->instance.const_n().get_edge_index(v_source, v_target);
-      const auto& edge_object = solver->instance.const_n().get_edge(edge_index);
-
-      const auto hw_edge =
-          cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::headway(
-              tr_object, edge_object, vel_source, vel_target, r_v_idx == 0);
-
-      // Variables to possibly strengthen the constraints
-      auto [hw_max, headway_tr_on_e, hw_max_ttd, headway_tr_on_ttd] =
-          solver->get_edge_headway_expressions(tr, edge_index);
-      const auto& tr_t_var = solver->vars["t_front_departure"](tr, v_source);
-      const auto  tr_t_var_value = getSolution(tr_t_var);
+  const auto  tr_t_bound = solver->ub_timing_variable(tr);
+  const auto& tr_object  = solver->instance.get_train_list().get_train(tr);
+  // Check every vertex on the route
+  for (size_t r_v_idx = 0; r_v_idx < routes.at(tr).size() - 1 &&
+                           (!only_one_constraint || constraints.empty());
+       r_v_idx++) {
+    const auto& v_source   = routes.at(tr).at(r_v_idx).first;
+    const auto& v_target   = routes.at(tr).at(r_v_idx + 1).first;
+    const auto& vel_source = train_velocities.at(tr).at(v_source);
+    const auto& vel_target = train_velocities.at(tr).at(v_target);
+    const auto& edge_index =
+        solver->instance.const_n().get_edge_index(v_source, v_target);
+    const auto& edge_object = solver->instance.const_n().get_edge(edge_index);
+
+    const auto hw_edge =
+        cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::headway(
+            tr_object, edge_object, vel_source, vel_target, r_v_idx == 0);
+
+    // Variables to possibly strengthen the constraints
+    auto [hw_max, headway_tr_on_e, hw_max_ttd, headway_tr_on_ttd] =
+        solver->get_edge_headway_expressions(tr, edge_index);
+    const auto& tr_t_var = solver->vars.at("t_front_departure")(tr, v_source);
+    const auto  tr_t_var_value = values.t_front_departure.at(tr, v_source);
+
+    std::unordered_set<size_t> other_trains;
+    const auto& tr_order = train_orders_on_edges.at(edge_index).first;
+    const auto  tr_index = std::find(tr_order.begin(), tr_order.end(),
+                                     std::pair<size_t, bool>(tr, true)) -
+                          tr_order.begin();
+    assert(tr_index != tr_order.end() - tr_order.begin());
+    for (size_t tr_other_idx = 0; tr_other_idx < tr_order.size();
+         tr_other_idx++) {
+      if (tr_other_idx == tr_index) {
+        continue;
+      }
+      if (!tr_order.at(tr_other_idx).second) {
+        // The train travels in reverse direction!
+        continue;
+      }
+      if (solver->solver_strategy.lazy_train_selection_strategy ==
+              LazyTrainSelectionStrategy::OnlyAdjacent &&
+          std::abs(static_cast<int>(tr_other_idx) -
+                   static_cast<int>(tr_index)) > 1) {
+        continue;
+      }
+      if (!solver->solver_strategy.include_reverse_headways &&
+          tr_other_idx > tr_index) {
+        // In this case tr_other follows tr, which is irrelevant for tr ma
+        continue;
+      }
+      other_trains.insert(tr_order.at(tr_other_idx).first);
+    }
 
-      std::unordered_set<size_t> other_trains;
-      const auto& tr_order = train_orders_on_edges.at(edge_index).first;
-      const auto  tr_index = std::find(tr_order.begin(), tr_order.end(),
-                                       std::pair<size_t, bool>(tr, true)) -
-                            tr_order.begin();
-      assert(tr_index != tr_order.end() - tr_order.begin());
-      for (size_t tr_other_idx = 0; tr_other_idx < tr_order.size();
-           tr_other_idx++) {
-        if (tr_other_idx == tr_index) {
-          continue;
-        }
-        if (!tr_order.at(tr_other_idx).second) {
-          // The train travels in reverse direction!
-          continue;
-        }
-        if (solver->solver_strategy.lazy_train_selection_strategy ==
-                LazyTrainSelectionStrategy::OnlyAdjacent &&
-            std::abs(static_cast<int>(tr_other_idx) -
-                     static_cast<int>(tr_index)) > 1) {
-          continue;
-        }
-        if (!solver->solver_strategy.include_reverse_headways &&
-            tr_other_idx > tr_index) {
-          // In this case tr_other follows tr, which is irrelevant for tr ma
-          continue;
-        }
-        other_trains.insert(tr_order.at(tr_other_idx).first);
+    for (const auto& tr_other_idx : other_trains) {
+      const auto& tr_other_t_var =
+          solver->vars.at("t_rear_departure")(tr_other_idx, v_target);
+      const auto tr_other_var_value =
+          values.t_rear_departure.at(tr_other_idx, v_target);
+
+      // Check if this constraint should be added
+      bool add_constr =
+          (solver->solver_strategy.lazy_constraint_selection_strategy ==
+           LazyConstraintSelectionStrategy::AllChecked);
+      if (!add_constr &&
+          tr_t_var_value - tr_other_var_value < hw_edge - GRB_EPS) {
+        add_constr = true;
       }
 
-      for (const auto& tr_other_idx : other_trains) {
-        const auto& tr_other_t_var =
-            solver->vars["t_rear_departure"](tr_other_idx, v_target);
-        const auto& tr_other_var_value = getSolution(tr_other_t_var);
+      const auto t_bound_tmp =
+          std::max(tr_t_bound, solver->ub_timing_variable(tr_other_idx));
+
+      if (add_constr) {
+        const auto big_m = solver->get_headway_big_m(
+            tr, v_source,
+            solver->ub_timing_variable(tr_other_idx, v_target) + hw_max,
+            t_bound_tmp + hw_max);
+        GRBLinExpr lhs =
+            tr_t_var - tr_other_t_var +
+            big_m *
+                (1 - solver->vars.at("order")(tr, tr_other_idx, edge_index));
+        GRBLinExpr rhs = headway_tr_on_e;
+        constraints.push_back(
+            {{static_cast<size_t>(LazyConstraintType::SimplifiedEdgeHeadway),
+              tr, tr_other_idx, edge_index, v_source, 0, 0, 0},
+             lhs - rhs});
+      }
+    }
 
-        // Check if this constraint should be added
-        bool add_constr =
-            (solver->solver_strategy.lazy_constraint_selection_strategy ==
-             LazyConstraintSelectionStrategy::AllChecked);
-        if (!add_constr &&
-            tr_t_var_value - tr_other_var_value < hw_edge - GRB_EPS) {
-          add_constr = true;
+    // TTD constraint on entering edge
+    const auto neighboring_edges =
+        solver->instance.const_n().neighboring_edges(v_source);
+    const auto intersecting_ttd = cda_rail::Network::get_intersecting_ttd(
+        {edge_index}, solver->ttd_sections);
+    for (const auto& [ttd_index, _] : intersecting_ttd) {
+      const auto& ttd_section = solver->ttd_sections.at(ttd_index);
+      // If all of neighboring_edges are in ttd_section, then it is not an
+      // entering edge Hence, if at least one neighboring edge is not in
+      // ttd_section, then we have an entering edge
+      const bool is_entering_edge =
+          std::any_of(neighboring_edges.begin(), neighboring_edges.end(),
+                      [&ttd_section](const auto& e_tmp) {
+                        return std::find(ttd_section.begin(), ttd_section.end(),
+                                         e_tmp) == ttd_section.end();
+                      });
+      if (is_entering_edge) {
+        // Check TTD condition on entering edge
+        const auto& tr_order_ttd = train_orders_on_ttd.at(ttd_index);
+        std::unordered_set<size_t> other_trains_ttd;
+        const auto                 tr_index_ttd =
+            std::find(tr_order_ttd.begin(), tr_order_ttd.end(), tr) -
+            tr_order_ttd.begin();
+        assert(tr_index_ttd < tr_order_ttd.end() - tr_order_ttd.begin());
+
+        for (size_t tr_other_idx_ttd = 0;
+             tr_other_idx_ttd < tr_order_ttd.size(); tr_other_idx_ttd++) {
+          if (tr_other_idx_ttd == tr_index_ttd) {
+            continue;
+          }
+          if (solver->solver_strategy.lazy_train_selection_strategy ==
+                  LazyTrainSelectionStrategy::OnlyAdjacent &&
+              std::abs(static_cast<int>(tr_other_idx_ttd) -
+                       static_cast<int>(tr_index_ttd)) > 1) {
+            continue;
+          }
+          if (!solver->solver_strategy.include_reverse_headways &&
+              tr_other_idx_ttd > tr_index_ttd) {
+            // In this case tr_other follows tr, which is irrelevant for tr ma
+            continue;
+          }
+          other_trains_ttd.insert(tr_order_ttd.at(tr_other_idx_ttd));
         }
 
-        const auto t_bound_tmp =
-            std::max(tr_t_bound, solver->ub_timing_variable(tr_other_idx));
+        const auto hw_ttd_value = cda_rail::min_time_to_push_ma_fully_backward(
+            vel_source, tr_object.acceleration, tr_object.deceleration);
 
-        if (add_constr) {
-          GRBLinExpr lhs =
-              tr_t_var - tr_other_t_var +
-              (t_bound_tmp + hw_max) *
-                  (1 - solver->vars["order"](tr, tr_other_idx, edge_index));
-          GRBLinExpr rhs = headway_tr_on_e;
-          addLazy(lhs >= rhs);
-          if (solver->solution_settings.export_option ==
-                  ExportOption::ExportLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionAndLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionWithInstanceAndLP) {
-            solver->lazy_constraints.push_back(lhs >= rhs);
-          }
-          violated_constraint_found = true;
-        }
-      }
+        for (const auto& tr_other_ttd : other_trains_ttd) {
+          const auto& tr_other_t_var_ttd =
+              solver->vars.at("t_ttd_departure")(tr_other_ttd, ttd_index);
+          const auto tr_other_t_var_value_ttd =
+              values.t_ttd_departure.at(tr_other_ttd, ttd_index);
 
-      // TTD constraint on entering edge
-      const auto neighboring_edges =
-          solver->instance.const_n().neighboring_edges(v_source);
-      const auto intersecting_ttd = cda_rail::Network::get_intersecting_ttd(
-          {edge_index}, solver->ttd_sections);
-      for (const auto& [ttd_index, _] : intersecting_ttd) {
-        const auto& ttd_section = solver->ttd_sections.at(ttd_index);
-        // If all of neighboring_edges are in ttd_section, then it is not an
-        // entering edge Hence, if at least one neighboring edge is not in
-        // ttd_section, then we have an entering edge
-        const bool is_entering_edge = std::any_of(
-            neighboring_edges.begin(), neighboring_edges.end(),
-            [&ttd_section](const auto& e_tmp) {
-              return std::find(ttd_section.begin(), ttd_section.end(), e_tmp) ==
-                     ttd_section.end();
-            });
-        if (is_entering_edge) {
-          // Check TTD condition on entering edge
-          const auto& tr_order_ttd = train_orders_on_ttd.at(ttd_index);
-          std::unordered_set<size_t> other_trains_ttd;
-          const auto                 tr_index_ttd =
-              std::find(tr_order_ttd.begin(), tr_order_ttd.end(), tr) -
-              tr_order_ttd.begin();
-          assert(tr_index_ttd < tr_order_ttd.end() - tr_order_ttd.begin());
-
-          for (size_t tr_other_idx_ttd = 0;
-               tr_other_idx_ttd < tr_order_ttd.size(); tr_other_idx_ttd++) {
-            if (tr_other_idx_ttd == tr_index_ttd) {
-              continue;
-            }
-            if (solver->solver_strategy.lazy_train_selection_strategy ==
-                    LazyTrainSelectionStrategy::OnlyAdjacent &&
-                std::abs(static_cast<int>(tr_other_idx_ttd) -
-                         static_cast<int>(tr_index_ttd)) > 1) {
-              continue;
-            }
-            if (!solver->solver_strategy.include_reverse_headways &&
-                tr_other_idx_ttd > tr_index_ttd) {
-              // In this case tr_other follows tr, which is irrelevant for tr ma
-              continue;
-            }
-            other_trains_ttd.insert(tr_order_ttd.at(tr_other_idx_ttd));
+          // Check if this constraint should be added
+          bool add_constr =
+              (solver->solver_strategy.lazy_constraint_selection_strategy ==
+               LazyConstraintSelectionStrategy::AllChecked);
+          if (!add_constr && tr_t_var_value - tr_other_t_var_value_ttd <
+                                 hw_ttd_value - GRB_EPS) {
+            add_constr = true;
           }
 
-          const auto hw_ttd_value =
-              cda_rail::min_time_to_push_ma_fully_backward(
-                  vel_source, tr_object.acceleration, tr_object.deceleration);
-
-          for (const auto& tr_other_ttd : other_trains_ttd) {
-            const auto& tr_other_t_var_ttd =
-                solver->vars["t_ttd_departure"](tr_other_ttd, ttd_index);
-            const auto& tr_other_t_var_value_ttd =
-                getSolution(tr_other_t_var_ttd);
-
-            // Check if this constraint should be added
-            bool add_constr =
-                (solver->solver_strategy.lazy_constraint_selection_strategy ==
-                 LazyConstraintSelectionStrategy::AllChecked);
-            if (!add_constr && tr_t_var_value - tr_other_t_var_value_ttd <
-                                   hw_ttd_value - GRB_EPS) {
-              add_constr = true;
-            }
+          const auto t_bound_tmp =
+              std::max(tr_t_bound, solver->ub_timing_variable(tr_other_ttd));
 
-            const auto t_bound_tmp =
-                std::max(tr_t_bound, solver->ub_timing_variable(tr_other_ttd));
-
-            if (add_constr) {
-              GRBLinExpr lhs = tr_t_var - tr_other_t_var_ttd +
-                               (t_bound_tmp + hw_max_ttd) *
-                                   (1 - solver->vars["order_ttd"](
-                                            tr, tr_other_ttd, ttd_index));
-              GRBLinExpr rhs = headway_tr_on_ttd;
-              addLazy(lhs >= rhs);
-              if (solver->solution_settings.export_option ==
-                      ExportOption::ExportLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionAndLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionWithInstanceAndLP) {
-                solver->lazy_constraints.push_back(lhs >= rhs);
-              }
-              violated_constraint_found = true;
-            }
+          if (add_constr) {
+            const auto big_m = solver->get_headway_big_m(
+                tr, v_source,
+                solver->ub_ttd_departure(tr_other_ttd, ttd_index) + hw_max_ttd,
+                t_bound_tmp + hw_max_ttd);
+            GRBLinExpr lhs = tr_t_var - tr_other_t_var_ttd +
+                             big_m * (1 - solver->vars.at("order_ttd")(
+                                              tr, tr_other_ttd, ttd_index));
+            GRBLinExpr rhs = headway_tr_on_ttd;
+            constraints.push_back(
+                {{static_cast<size_t>(LazyConstraintType::SimplifiedTTDHeadway),
+                  tr, tr_other_ttd, ttd_index, v_source, edge_index, 0, 0},
+                 lhs - rhs});
           }
         }
       }
     }
   }
-
-  return violated_constraint_found;
 }
 
 // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation)
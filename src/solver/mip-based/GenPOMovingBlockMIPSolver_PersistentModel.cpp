@@ -0,0 +1,244 @@
+#include "CustomExceptions.hpp"
+#include "gurobi_c++.h"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+#include "solver/mip-based/GeneralMIPSolver.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+// NOLINTBEGIN(performance-inefficient-string-concatenation)
+
+cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::resolve(
+    int time_limit) {
+  /**
+   * Optimizes the model kept by the previous solve() again, e.g., after
+   * changing weights or time windows using the update_* functions. The
+   * previous incumbent is used as MIP start. Export options are ignored.
+   *
+   * @param time_limit: time limit for the solver in seconds. If -1, no time
+   * limit is set.
+   *
+   * @return: respective solution object
+   */
+
+  check_persistent_model();
+
+  PLOGI << "Optimize kept model";
+  model->set(GRB_DoubleParam_TimeLimit,
+             time_limit > 0 ? static_cast<double>(time_limit) : GRB_INFINITY);
+  model->optimize();
+
+  lazy_constraint_pool.store_variable_names(
+      get_lazy_constraint_pool_fingerprint(),
+      get_lazy_constraint_pool_train_signatures());
+
+  instances::SolGeneralPerformanceOptimizationInstance solution(
+      persistent_instance.value());
+  extract_solution(solution);
+  if (store_train_variable_values) {
+    extract_train_variable_values();
+  }
+
+  set_start_to_incumbent();
+
+  return solution;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    update_train_weight(size_t tr, double weight) {
+  /**
+   * Changes the weight of a train in the objective of the kept model.
+   *
+   * @param tr: index of the train
+   * @param weight: new weight of the train
+   */
+
+  check_persistent_model();
+  remove_symmetry_breaking_constraints(tr);
+
+  instance.set_train_weight(tr, weight);
+  persistent_instance->set_train_weight(tr, weight);
+  set_objective();
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    update_entry_time_window(size_t tr, std::pair<int, int> t_0_range) {
+  /**
+   * Changes the entry time window of a train in the kept model by changing the
+   * right-hand sides of the respective constraints. The new window has to be
+   * within the time bounds the model was created with, otherwise a new model
+   * is needed.
+   *
+   * @param tr: index of the train
+   * @param t_0_range: new interval of possible entry times
+   */
+
+  check_persistent_model();
+
+  const auto& tr_name = instance.get_train_list().get_train(tr).name;
+  const auto  entry   = instance.get_schedule(tr).get_entry();
+  if (t_0_range.first > t_0_range.second ||
+      t_0_range.first < lb_timing_variable(tr, entry) ||
+      t_0_range.second > ub_timing_variable(tr, entry)) {
+    throw exceptions::InvalidInputException(
+        "Entry time window of train " + tr_name +
+        " is invalid or exceeds the bounds of the kept model.");
+  }
+
+  remove_symmetry_breaking_constraints(tr);
+  model->getConstrByName("initial_arrival_time_lb_" + tr_name)
+      .set(GRB_DoubleAttr_RHS, t_0_range.first);
+  model->getConstrByName("initial_arrival_time_ub_" + tr_name)
+      .set(GRB_DoubleAttr_RHS, t_0_range.second);
+
+  instance.editable_schedule(tr).set_t_0_range(t_0_range);
+  persistent_instance->editable_schedule(tr).set_t_0_range(t_0_range);
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    update_exit_time_window(size_t tr, std::pair<int, int> t_n_range) {
+  /**
+   * Changes the exit time window of a train in the kept model by changing the
+   * right-hand sides of the respective constraints. The objective is updated
+   * accordingly. The latest exit time must not exceed the one the model was
+   * created with, since it is used for bounds and big-M values.
+   *
+   * @param tr: index of the train
+   * @param t_n_range: new interval of possible exit times
+   */
+
+  check_persistent_model();
+
+  const auto& tr_name = instance.get_train_list().get_train(tr).name;
+  const auto  exit    = instance.get_schedule(tr).get_exit();
+  if (t_n_range.first > t_n_range.second || t_n_range.first < 0 ||
+      t_n_range.second > ub_timing_variable(tr, exit)) {
+    throw exceptions::InvalidInputException(
+        "Exit time window of train " + tr_name +
+        " is invalid or exceeds the bounds of the kept model.");
+  }
+
+  remove_symmetry_breaking_constraints(tr);
+  model->getConstrByName("final_departure_time_lb_" + tr_name)
+      .set(GRB_DoubleAttr_RHS, t_n_range.first);
+  model->getConstrByName("final_departure_time_ub_" + tr_name)
+      .set(GRB_DoubleAttr_RHS, t_n_range.second);
+
+  instance.editable_schedule(tr).set_t_n_range(t_n_range);
+  persistent_instance->editable_schedule(tr).set_t_n_range(t_n_range);
+  // The objective measures delay with respect to the earliest exit time
+  set_objective();
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    update_variable_bounds(const std::string& var_name, double lb, double ub) {
+  /**
+   * Changes the bounds of a variable of the kept model. Symmetry breaking
+   * constraints of all trains the variable belongs to are removed.
+   *
+   * @param var_name: name of the variable
+   * @param lb: new lower bound
+   * @param ub: new upper bound
+   */
+
+  check_persistent_model();
+
+  if (lb > ub) {
+    throw exceptions::InvalidInputException(
+        "Lower bound of variable " + var_name + " exceeds its upper bound.");
+  }
+
+  GRBVar var;
+  try {
+    var = model->getVarByName(var_name);
+  } catch (const GRBException&) {
+    throw exceptions::InvalidInputException("Variable " + var_name +
+                                            " does not exist.");
+  }
+
+  // Variables of a train contain its name delimited by underscores
+  const auto contains_train_name = [&var_name](const std::string& tr_name) {
+    const auto token = "_" + tr_name;
+    auto       pos   = var_name.find(token);
+    while (pos != std::string::npos) {
+      const auto end = pos + token.size();
+      if (end == var_name.size() || var_name.at(end) == '_') {
+        return true;
+      }
+      pos = var_name.find(token, pos + 1);
+    }
+    return false;
+  };
+  std::unordered_set<size_t> symmetric_trains;
+  for (const auto& [tr1, tr2] : symmetry_breaking_pairs) {
+    symmetric_trains.insert(tr1);
+    symmetric_trains.insert(tr2);
+  }
+  for (const auto tr : symmetric_trains) {
+    if (contains_train_name(instance.get_train_list().get_train(tr).name)) {
+      remove_symmetry_breaking_constraints(tr);
+    }
+  }
+
+  var.set(GRB_DoubleAttr_LB, lb);
+  var.set(GRB_DoubleAttr_UB, ub);
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::release_model() {
+  /**
+   * Frees the model kept by the previous solve(), if any.
+   */
+
+  if (!persistent_instance.has_value()) {
+    return;
+  }
+
+  PLOGD << "Release kept model";
+  cleanup();
+  instance = std::move(persistent_instance.value());
+  persistent_instance.reset();
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    remove_symmetry_breaking_constraints(size_t tr) {
+  /**
+   * Removes all rows of the kept model that order the entry time of train tr
+   * relative to other trains of its interchangeable class. After changing its
+   * weight, time windows or variables, the train is no longer interchangeable,
+   * hence, these rows might cut off all optimal solutions. The remaining rows
+   * only order trains that are still interchangeable.
+   *
+   * @param tr: index of the train
+   */
+
+  for (auto it = symmetry_breaking_pairs.begin();
+       it != symmetry_breaking_pairs.end();) {
+    if (it->first != tr && it->second != tr) {
+      ++it;
+      continue;
+    }
+    const auto& tr1_name = instance.get_train_list().get_train(it->first).name;
+    const auto& tr2_name =
+        instance.get_train_list().get_train(it->second).name;
+    PLOGD << "Remove symmetry breaking constraint of trains " << tr1_name
+          << " and " << tr2_name;
+    model->remove(
+        model->getConstrByName("symmetry_breaking_" + tr1_name + "_" +
+                               tr2_name));
+    it = symmetry_breaking_pairs.erase(it);
+  }
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    check_persistent_model() const {
+  if (!has_persistent_model()) {
+    throw exceptions::ModelCreationException(
+        "No model kept. Solve with keep_model set to true first.");
+  }
+}
+
+// NOLINTEND(performance-inefficient-string-concatenation)
@@ -0,0 +1,392 @@
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+#include "MultiArray.hpp"
+#include "gurobi_c++.h"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+#include "solver/mip-based/GeneralMIPSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation)
+
+cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve_rolling_horizon(
+    const ModelDetail&                 model_detail_input,
+    const SolverStrategyMovingBlock&   solver_strategy_input,
+    const SolutionSettingsMovingBlock& solution_settings_input,
+    const RollingHorizonSettings& rolling_horizon_settings, int time_limit,
+    bool debug_input) {
+  /**
+   * Heuristically solves the instance using a rolling horizon. Trains are
+   * sorted by their earliest entry time. Every window optimizes the next
+   * window_size trains, while the trajectories of previously committed trains
+   * (whose time windows overlap the window) are fixed as obstacles. Of every
+   * window but the last, the first window_size - window_overlap trains are
+   * committed, the remaining ones are optimized again in the next window
+   * starting from their current solution.
+   * The committed trajectories are stitched into one solution of the full
+   * instance. Optionally, the full instance is solved afterward using the
+   * stitched solution as MIP start.
+   *
+   * @param rolling_horizon_settings: window size, overlap, time limit per
+   * window and whether to polish the solution
+   * @param time_limit: time limit for the final polish in seconds. If -1, no
+   * time limit is set.
+   * @param debug_input: if true, the debug output is enabled.
+   *
+   * @return: stitched (or polished) solution. If a window cannot be solved,
+   * the returned object has no solution.
+   */
+
+  if (rolling_horizon_settings.window_size == 0) {
+    throw exceptions::InvalidInputException("Window size must be positive.");
+  }
+  if (rolling_horizon_settings.window_overlap >=
+      rolling_horizon_settings.window_size) {
+    throw exceptions::InvalidInputException(
+        "Window overlap must be smaller than window size.");
+  }
+
+  const auto num_trains = instance.get_train_list().size();
+  const auto step       = rolling_horizon_settings.window_size -
+                    rolling_horizon_settings.window_overlap;
+
+  std::vector<size_t> train_order(num_trains);
+  std::iota(train_order.begin(), train_order.end(), 0);
+  std::stable_sort(train_order.begin(), train_order.end(),
+                   [this](size_t tr1, size_t tr2) {
+                     return instance.get_schedule(tr1).get_t_0_range().first <
+                            instance.get_schedule(tr2).get_t_0_range().first;
+                   });
+
+  instances::SolGeneralPerformanceOptimizationInstance solution(instance);
+  solution.reset_routes();
+
+  // Windows are not exported, only the final solution
+  const SolutionSettingsMovingBlock window_solution_settings = {};
+  std::vector<size_t>               committed_trains;
+  std::unordered_map<std::string, std::unordered_map<std::string, double>>
+                                          committed_values;
+  std::unordered_map<std::string, double> window_start_values;
+
+  for (size_t window_start = 0; window_start < num_trains;
+       window_start += step) {
+    const auto window_end =
+        std::min(window_start + rolling_horizon_settings.window_size,
+                 num_trains);
+    const bool                last_window = window_end == num_trains;
+    const std::vector<size_t> window_trains(train_order.begin() + window_start,
+                                            train_order.begin() + window_end);
+
+    int window_t_min = std::numeric_limits<int>::max();
+    int window_t_max = std::numeric_limits<int>::min();
+    for (const auto tr : window_trains) {
+      window_t_min = std::min(window_t_min,
+                              instance.get_schedule(tr).get_t_0_range().first);
+      window_t_max = std::max(
+          window_t_max, instance.get_schedule(tr).get_t_n_range().second);
+    }
+
+    // Committed trains that can be within the network at the same time are
+    // obstacles
+    std::vector<size_t> sub_trains;
+    for (const auto tr : committed_trains) {
+      const auto& tr_schedule = instance.get_schedule(tr);
+      if (tr_schedule.get_t_0_range().first <= window_t_max &&
+          tr_schedule.get_t_n_range().second >= window_t_min) {
+        sub_trains.push_back(tr);
+      }
+    }
+    const auto num_obstacles = sub_trains.size();
+    sub_trains.insert(sub_trains.end(), window_trains.begin(),
+                      window_trains.end());
+
+    PLOGI << "Solve window with trains " << window_start << " to "
+          << window_end - 1 << " and " << num_obstacles << " obstacles";
+
+    GenPOMovingBlockMIPSolver window_solver(get_sub_instance(instance,
+                                                             sub_trains));
+    window_solver.store_train_variable_values = true;
+    for (size_t idx = 0; idx < num_obstacles; idx++) {
+      const auto& values = committed_values.at(
+          instance.get_train_list().get_train(sub_trains.at(idx)).name);
+      window_solver.fixed_variable_values.insert(values.begin(), values.end());
+    }
+    window_solver.start_variable_values = window_start_values;
+
+    const auto window_sol = window_solver.solve(
+        model_detail_input, solver_strategy_input, window_solution_settings,
+        rolling_horizon_settings.window_time_limit, debug_input);
+
+    if (!window_sol.has_solution()) {
+      PLOGE << "No solution found for window with trains " << window_start
+            << " to " << window_end - 1;
+      solution.set_status(window_sol.get_status());
+      solution.set_solution_not_found();
+      return solution;
+    }
+
+    const auto num_commit = last_window ? window_trains.size() : step;
+    window_start_values.clear();
+    for (size_t idx = 0; idx < window_trains.size(); idx++) {
+      const auto  tr      = window_trains.at(idx);
+      const auto& tr_name = instance.get_train_list().get_train(tr).name;
+      const auto& values  = window_solver.train_variable_values[tr_name];
+      if (idx < num_commit) {
+        copy_train_solution(window_sol, solution, tr_name);
+        committed_values[tr_name] = values;
+        committed_trains.push_back(tr);
+      } else {
+        window_start_values.insert(values.begin(), values.end());
+      }
+    }
+
+    if (last_window) {
+      break;
+    }
+  }
+
+  double obj           = 0;
+  double tr_weight_sum = 0;
+  for (size_t tr = 0; tr < num_trains; tr++) {
+    const auto& tr_name       = instance.get_train_list().get_train(tr).name;
+    const auto  tr_times      = solution.get_train_times(tr_name);
+    const auto  tr_weight     = instance.get_train_weight(tr);
+    const auto  min_exit_time = instance.get_schedule(tr).get_t_n_range().first;
+    tr_weight_sum += tr_weight;
+    if (!tr_times.empty()) {
+      obj += tr_weight * (tr_times.back() - min_exit_time);
+    }
+  }
+  solution.set_status(SolutionStatus::Feasible);
+  solution.set_obj(std::round(obj / tr_weight_sum));
+  solution.set_solution_found();
+  PLOGI << "Rolling horizon objective: " << solution.get_obj();
+
+  if (rolling_horizon_settings.final_polish) {
+    PLOGI << "Polish stitched solution";
+    for (const auto& [tr_name, values] : committed_values) {
+      start_variable_values.insert(values.begin(), values.end());
+    }
+    const auto polished_sol =
+        solve(model_detail_input, solver_strategy_input,
+              window_solution_settings, time_limit, debug_input);
+    if (polished_sol.has_solution() &&
+        polished_sol.get_obj() <= solution.get_obj() + GRB_EPS) {
+      solution = polished_sol;
+    }
+  }
+
+  // The stitched solution has no model, hence, only the solution is exported
+  export_solution_without_model(solution, solution_settings_input);
+
+  return solution;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    export_solution_without_model(
+        instances::SolGeneralPerformanceOptimizationInstance<
+            instances::GeneralPerformanceOptimizationInstance>& solution,
+        const SolutionSettingsMovingBlock&                      settings) {
+  /**
+   * Exports a solution that was not extracted from a model of this solver,
+   * e.g., because it is stitched together from other solutions. Hence, only
+   * the solution (and possibly the instance) is exported, but no model.
+   */
+
+  if (settings.export_option == ExportOption::NoExport ||
+      settings.export_option == ExportOption::ExportLP) {
+    return;
+  }
+  const bool export_instance =
+      (settings.export_option == ExportOption::ExportSolutionWithInstance ||
+       settings.export_option ==
+           ExportOption::ExportSolutionWithInstanceAndLP);
+  PLOGI << "Saving solution";
+  std::filesystem::path path = settings.path;
+  path /= settings.name;
+  solution.set_solution_format(settings.solution_format);
+  solution.export_solution(path, export_instance);
+}
+
+size_t cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    apply_variable_values() {
+  /**
+   * Fixes the variables in fixed_variable_values and sets the MIP start of
+   * the variables in start_variable_values. Variables are matched by name,
+   * unknown names are ignored. Fixed values are clamped to the bounds of the
+   * variable and rounded for integer variables.
+   *
+   * @return: number of variables fixed or started
+   */
+
+  size_t num_applied = 0;
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+  auto*     model_vars = model->getVars();
+  const int num_vars   = model->get(GRB_IntAttr_NumVars);
+  for (int i = 0; i < num_vars; i++) {
+    auto&       var  = model_vars[i];
+    const auto& name = var.get(GRB_StringAttr_VarName);
+    if (const auto fixed_it = fixed_variable_values.find(name);
+        fixed_it != fixed_variable_values.end()) {
+      auto value = std::clamp(fixed_it->second, var.get(GRB_DoubleAttr_LB),
+                              var.get(GRB_DoubleAttr_UB));
+      if (var.get(GRB_CharAttr_VType) != GRB_CONTINUOUS) {
+        value = std::round(value);
+      }
+      var.set(GRB_DoubleAttr_LB, value);
+      var.set(GRB_DoubleAttr_UB, value);
+      num_applied++;
+    } else if (const auto start_it = start_variable_values.find(name);
+               start_it != start_variable_values.end()) {
+      var.set(GRB_DoubleAttr_Start, start_it->second);
+      num_applied++;
+    }
+  }
+  delete[] model_vars;
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+
+  return num_applied;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    extract_train_variable_values() {
+  /**
+   * Stores the solution values of all variables that belong to a single
+   * train, so that they can be fixed or used as start in a model containing
+   * the same train. Variables of train pairs, e.g., orders, are not stored.
+   */
+
+  train_variable_values.clear();
+  for (const auto& tr_object : instance.get_train_list()) {
+    train_variable_values[tr_object.name];
+  }
+  if (model->get(GRB_IntAttr_SolCount) < 1) {
+    return;
+  }
+
+  const auto store_value = [this](size_t tr, const GRBVar& var) {
+    if (var.sameAs(GRBVar())) {
+      return;
+    }
+    train_variable_values.at(instance.get_train_list().get_train(tr).name)
+        .emplace(var.get(GRB_StringAttr_VarName), var.get(GRB_DoubleAttr_X));
+  };
+
+  for (const auto* family : {"t_front_arrival", "t_front_departure",
+                             "t_rear_departure", "t_ttd_departure", "x",
+                             "x_ttd"}) {
+    const auto& var_array = vars.at(family);
+    const auto& shape     = var_array.get_shape();
+    for (size_t tr = 0; tr < shape.at(0); tr++) {
+      for (size_t i = 0; i < shape.at(1); i++) {
+        store_value(tr, var_array.at(tr, i));
+      }
+    }
+  }
+
+  const auto& stop_vars  = vars.at("stop");
+  const auto& stop_shape = stop_vars.get_shape();
+  for (size_t tr = 0; tr < stop_shape.at(0); tr++) {
+    for (size_t stop = 0; stop < stop_shape.at(1); stop++) {
+      for (size_t v = 0; v < stop_shape.at(2); v++) {
+        store_value(tr, stop_vars.at(tr, stop, v));
+      }
+    }
+  }
+
+  const auto& y_vars  = vars.at("y");
+  const auto& y_shape = y_vars.get_shape();
+  for (size_t tr = 0; tr < y_shape.at(0); tr++) {
+    for (size_t e = 0; e < y_shape.at(1); e++) {
+      for (size_t i = 0; i < y_shape.at(2); i++) {
+        for (size_t j = 0; j < y_shape.at(3); j++) {
+          store_value(tr, y_vars.at(tr, e, i, j));
+        }
+      }
+    }
+  }
+}
+
+cda_rail::instances::GeneralPerformanceOptimizationInstance
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::get_sub_instance(
+    const instances::GeneralPerformanceOptimizationInstance& full_instance,
+    const std::vector<size_t>&                               trains) {
+  /**
+   * Creates an instance on the same network and stations containing only the
+   * specified trains (in the given order) together with their schedules,
+   * routes, weights and optionality.
+   */
+
+  TrainList sub_train_list;
+  std::vector<GeneralSchedule<GeneralScheduledStop>> sub_schedules;
+  sub_schedules.reserve(trains.size());
+  for (const auto tr : trains) {
+    const auto& tr_object = full_instance.get_train_list().get_train(tr);
+    sub_train_list.add_train(tr_object.name, tr_object.length,
+                             tr_object.max_speed, tr_object.acceleration,
+                             tr_object.deceleration, tr_object.tim);
+    sub_schedules.push_back(full_instance.get_schedule(tr));
+  }
+
+  RouteMap sub_routes;
+  for (const auto tr : trains) {
+    const auto& tr_name = full_instance.get_train_list().get_train(tr).name;
+    if (!full_instance.has_route(tr_name)) {
+      continue;
+    }
+    sub_routes.add_empty_route(tr_name);
+    for (const auto edge : full_instance.get_route(tr_name).get_edges()) {
+      sub_routes.push_back_edge(tr_name, edge, full_instance.const_n());
+    }
+  }
+
+  instances::GeneralPerformanceOptimizationInstance sub_instance(
+      full_instance.const_n(),
+      GeneralTimetable<GeneralSchedule<GeneralScheduledStop>>(
+          full_instance.get_station_list(), sub_train_list, sub_schedules),
+      sub_routes);
+  for (size_t idx = 0; idx < trains.size(); idx++) {
+    sub_instance.set_train_weight(
+        idx, full_instance.get_train_weights().at(trains.at(idx)));
+    sub_instance.set_train_optionality_value(
+        idx, full_instance.get_train_optional().at(trains.at(idx)));
+  }
+  sub_instance.set_lambda(full_instance.get_lambda());
+
+  return sub_instance;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    copy_train_solution(
+        const instances::SolGeneralPerformanceOptimizationInstance<
+            instances::GeneralPerformanceOptimizationInstance>& from,
+        instances::SolGeneralPerformanceOptimizationInstance<
+            instances::GeneralPerformanceOptimizationInstance>& to,
+        const std::string&                                      tr_name) {
+  /**
+   * Copies route, positions and speeds of one train between solutions of
+   * instances on the same network.
+   */
+
+  to.add_empty_route(tr_name);
+  if (from.get_instance().has_route(tr_name)) {
+    for (const auto edge :
+         from.get_instance().get_route(tr_name).get_edges()) {
+      to.push_back_edge_to_route(tr_name, edge);
+    }
+  }
+  to.set_train_routed_value(tr_name, from.get_train_routed(tr_name));
+  to.set_train_trajectory(tr_name, from.get_train_trajectory(tr_name));
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation)
@@ -1,6 +1,7 @@
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
 #include "MultiArray.hpp"
+#include "datastructure/TrainTrajectory.hpp"
 #include "gurobi_c++.h"
 #include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
 #include "solver/mip-based/GeneralMIPSolver.hpp"
@@ -77,7 +78,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::extract_solution(
         const auto& [old_edge_id, old_edge_pos] =
             instance.const_n().get_old_edge(edge_id);
         if (old_edge_pos == 0) {
-          sol.push_back_edge_to_route(tr_object.name, old_edge_id);
+          sol.push_back_edge_to_route(tr, old_edge_id);
           tr_routed = true;
         }
         edges_to_consider = instance.const_n().out_edges(
@@ -85,7 +86,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::extract_solution(
       }
     }
     route_markers.push_back(route_marker_tr);
-    sol.set_train_routed_value(tr_object.name, tr_routed);
+    sol.set_train_routed_value(tr, tr_routed);
   }
 
   // Save routing times
@@ -93,27 +94,27 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::extract_solution(
   for (int tr = 0; tr < num_tr; tr++) {
     const auto& tr_object   = instance.get_train_list().get_train(tr);
     const auto& tr_schedule = instance.get_schedule(tr);
+    TrainTrajectoryBuilder trajectory;
+    trajectory.reserve(2 * route_markers[tr].size() + 1);
     for (const auto& [vertex_id, pos] : route_markers[tr]) {
       const auto time_1 =
           vars.at("t_front_arrival").at(tr, vertex_id).get(GRB_DoubleAttr_X);
       const auto time_2 =
           vars.at("t_front_departure").at(tr, vertex_id).get(GRB_DoubleAttr_X);
       const auto vertex_speed = extract_speed(tr, vertex_id);
-      sol.add_train_pos(tr_object.name, time_1, pos);
-      sol.add_train_speed(tr_object.name, time_1, vertex_speed);
+      trajectory.add(time_1, pos, vertex_speed);
       if (time_2 > time_1 + GRB_EPS) {
-        sol.add_train_pos(tr_object.name, time_2, pos);
-        sol.add_train_speed(tr_object.name, time_2, vertex_speed);
+        trajectory.add(time_2, pos, vertex_speed);
       }
 
       if (vertex_id == tr_schedule.get_exit()) {
         const auto last_time =
             vars.at("t_rear_departure").at(tr, vertex_id).get(GRB_DoubleAttr_X);
-        const auto last_speed = tr_schedule.get_v_n();
-        sol.add_train_pos(tr_object.name, last_time, pos + tr_object.length);
-        sol.add_train_speed(tr_object.name, last_time, last_speed);
+        trajectory.add(last_time, pos + tr_object.length,
+                       tr_schedule.get_v_n());
       }
     }
+    sol.set_train_trajectory(tr, trajectory.build());
   }
 
   PLOGI << "DONE! Solution extracted.";
@@ -124,12 +125,10 @@ double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::extract_speed(
   assert(model->get(GRB_IntAttr_SolCount) >= 1);
   const auto& tr_object      = instance.get_train_list().get_train(tr);
   const auto  delta_consider = instance.const_n().neighboring_edges(vertex_id);
-  const auto  edges_used_by_td =
-      instance.edges_used_by_train(tr, model_detail.fix_routes, false);
+
   std::vector<size_t> edges_to_consider;
   for (const auto& edge_id : delta_consider) {
-    if (std::find(edges_used_by_td.begin(), edges_used_by_td.end(), edge_id) !=
-        edges_used_by_td.end()) {
+    if (train_usage.uses_edge(tr, edge_id)) {
       edges_to_consider.push_back(edge_id);
     }
   }
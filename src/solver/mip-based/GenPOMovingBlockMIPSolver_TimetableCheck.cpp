@@ -0,0 +1,121 @@
+#include "Definitions.hpp"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+#include "solver/mip-based/GeneralMIPSolver.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation)
+
+std::optional<cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>>
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    solve_with_timetable_check(
+        const ModelDetail&                 model_detail_input,
+        const SolverStrategyMovingBlock&   solver_strategy_input,
+        const SolutionSettingsMovingBlock& solution_settings_input,
+        int time_limit, bool debug_input) {
+  /**
+   * Checks the timetable for conflicts that no solution can resolve, see
+   * GeneralPerformanceOptimizationInstance::check_timetable_conflicts. If
+   * drop_conflicting_optional_trains is set, optional trains are removed
+   * until no conflict remains among the other trains, which are then solved
+   * as a sub-instance. Dropped trains are not routed in the returned solution
+   * and not part of its objective.
+   *
+   * @return: empty if no conflict is found, i.e., the full instance has to be
+   * solved as usual. Otherwise, the solution of the remaining trains or, if
+   * the conflicts cannot be resolved, an infeasible object without solution.
+   */
+
+  PLOGI << "Check timetable for conflicts";
+
+  const auto          num_trains = instance.get_train_list().size();
+  std::vector<size_t> kept_trains(num_trains);
+  std::iota(kept_trains.begin(), kept_trains.end(), 0);
+  auto checked_instance = instance;
+
+  instances::SolGeneralPerformanceOptimizationInstance solution(instance);
+  while (true) {
+    const auto conflicts = checked_instance.check_timetable_conflicts(
+        model_detail_input.fix_routes);
+    if (conflicts.empty()) {
+      break;
+    }
+    for (const auto& conflict : conflicts) {
+      PLOGW << conflict.explanation;
+    }
+
+    std::optional<std::vector<size_t>> trains_to_drop;
+    if (solver_strategy_input.drop_conflicting_optional_trains) {
+      trains_to_drop =
+          checked_instance.optional_trains_resolving_conflicts(conflicts);
+    }
+    if (!trains_to_drop.has_value()) {
+      PLOGE << "Timetable conflicts cannot be resolved";
+      solution.set_status(SolutionStatus::Infeasible);
+      solution.set_solution_not_found();
+      return solution;
+    }
+
+    // Indices of the checked instance are positions within kept_trains
+    std::vector<size_t> remaining_trains;
+    for (size_t idx = 0; idx < kept_trains.size(); idx++) {
+      const auto tr = kept_trains.at(idx);
+      if (std::binary_search(trains_to_drop->begin(), trains_to_drop->end(),
+                             idx)) {
+        PLOGW << "Do not schedule optional train "
+              << instance.get_train_list().get_train(tr).name;
+      } else {
+        remaining_trains.push_back(tr);
+      }
+    }
+    kept_trains      = std::move(remaining_trains);
+    checked_instance = get_sub_instance(instance, kept_trains);
+  }
+
+  if (kept_trains.size() == num_trains) {
+    PLOGI << "No timetable conflicts found";
+    return {};
+  }
+
+  solution.reset_routes();
+  if (kept_trains.empty()) {
+    PLOGW << "No train remains to be scheduled";
+    solution.set_status(SolutionStatus::Optimal);
+    solution.set_obj(0);
+    solution.set_solution_found();
+    export_solution_without_model(solution, solution_settings_input);
+    return solution;
+  }
+
+  PLOGI << "Solve remaining " << kept_trains.size() << " of " << num_trains
+        << " trains";
+  auto sub_solver_strategy                      = solver_strategy_input;
+  sub_solver_strategy.check_timetable_conflicts = false;
+  sub_solver_strategy.keep_model                = false;
+  GenPOMovingBlockMIPSolver sub_solver(checked_instance);
+  const auto                sub_sol = sub_solver.solve(
+      model_detail_input, sub_solver_strategy, {}, time_limit, debug_input);
+
+  solution.set_status(sub_sol.get_status());
+  if (!sub_sol.has_solution()) {
+    solution.set_solution_not_found();
+    return solution;
+  }
+  for (const auto tr : kept_trains) {
+    copy_train_solution(sub_sol, solution,
+                        instance.get_train_list().get_train(tr).name);
+  }
+  solution.set_obj(sub_sol.get_obj());
+  solution.set_solution_found();
+
+  export_solution_without_model(solution, solution_settings_input);
+
+  return solution;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation)
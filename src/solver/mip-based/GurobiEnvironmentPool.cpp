@@ -0,0 +1,142 @@
+#include "solver/mip-based/GurobiEnvironmentPool.hpp"
+
+#include "gurobi_c++.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <plog/Log.h>
+#include <utility>
+#include <vector>
+
+cda_rail::solver::mip_based::GurobiEnvironmentPool&
+cda_rail::solver::mip_based::GurobiEnvironmentPool::get_instance() {
+  static GurobiEnvironmentPool pool;
+  return pool;
+}
+
+std::unique_ptr<GRBEnv>
+cda_rail::solver::mip_based::GurobiEnvironmentPool::acquire() {
+  /**
+   * Returns a started environment. An idle one is reused if possible,
+   * otherwise a new one is created. The environment should be returned using
+   * release() once no model using it exists anymore.
+   */
+
+  const auto start = std::chrono::steady_clock::now();
+
+  std::unique_ptr<GRBEnv> env;
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (!idle_environments.empty()) {
+      env = std::move(idle_environments.back());
+      idle_environments.pop_back();
+    }
+  }
+
+  const bool reused = env != nullptr;
+  if (!reused) {
+    // Not locked, since starting might take a while
+    env = std::make_unique<GRBEnv>(true);
+    env->start();
+  }
+
+  const double acquisition_time =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    metrics.num_acquired++;
+    if (reused) {
+      metrics.num_reused++;
+    } else {
+      metrics.num_created++;
+    }
+    metrics.total_acquisition_time += acquisition_time;
+    metrics.max_acquisition_time =
+        std::max(metrics.max_acquisition_time, acquisition_time);
+  }
+
+  PLOGD << (reused ? "Reused" : "Created") << " Gurobi environment in "
+        << acquisition_time << " seconds";
+
+  return env;
+}
+
+void cda_rail::solver::mip_based::GurobiEnvironmentPool::release(
+    std::unique_ptr<GRBEnv> env) {
+  /**
+   * Returns an environment to the pool. Its parameters are reset to their
+   * default values. If the pool is full, the environment is destroyed.
+   */
+
+  if (env == nullptr) {
+    return;
+  }
+  env->resetParams();
+
+  const std::lock_guard<std::mutex> lock(mutex);
+  if (idle_environments.size() < max_size) {
+    idle_environments.push_back(std::move(env));
+  }
+}
+
+void cda_rail::solver::mip_based::GurobiEnvironmentPool::set_max_size(
+    size_t new_max_size) {
+  /**
+   * Sets the maximal number of idle environments. If 0, environments are not
+   * reused at all. Surplus idle environments are destroyed.
+   */
+
+  std::vector<std::unique_ptr<GRBEnv>> surplus;
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    max_size = new_max_size;
+    if (idle_environments.size() > max_size) {
+      surplus.insert(
+          surplus.end(),
+          std::make_move_iterator(idle_environments.begin() +
+                                  static_cast<std::ptrdiff_t>(max_size)),
+          std::make_move_iterator(idle_environments.end()));
+      idle_environments.resize(max_size);
+    }
+  }
+}
+
+size_t cda_rail::solver::mip_based::GurobiEnvironmentPool::get_max_size()
+    const {
+  const std::lock_guard<std::mutex> lock(mutex);
+  return max_size;
+}
+
+size_t cda_rail::solver::mip_based::GurobiEnvironmentPool::
+    number_of_idle_environments() const {
+  const std::lock_guard<std::mutex> lock(mutex);
+  return idle_environments.size();
+}
+
+void cda_rail::solver::mip_based::GurobiEnvironmentPool::clear() {
+  /**
+   * Destroys all idle environments, e.g., to free license tokens.
+   */
+
+  std::vector<std::unique_ptr<GRBEnv>> to_destroy;
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    to_destroy.swap(idle_environments);
+  }
+}
+
+cda_rail::solver::mip_based::GurobiEnvironmentPool::Metrics
+cda_rail::solver::mip_based::GurobiEnvironmentPool::get_metrics() const {
+  const std::lock_guard<std::mutex> lock(mutex);
+  return metrics;
+}
+
+void cda_rail::solver::mip_based::GurobiEnvironmentPool::reset_metrics() {
+  const std::lock_guard<std::mutex> lock(mutex);
+  metrics = {};
+}
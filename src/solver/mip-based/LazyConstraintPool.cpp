@@ -0,0 +1,355 @@
+#include "solver/mip-based/LazyConstraintPool.hpp"
+
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+#include "gurobi_c++.h"
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+
+size_t cda_rail::solver::mip_based::LazyConstraintPool::KeyHash::operator()(
+    const Key& key) const noexcept {
+  size_t seed = 0;
+  for (const auto& val : key) {
+    seed ^= std::hash<size_t>{}(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+const cda_rail::solver::mip_based::LazyConstraintPool::Entry&
+cda_rail::solver::mip_based::LazyConstraintPool::get_entry(
+    const Key& key) const {
+  const auto it = entries.find(key);
+  if (it == entries.end()) {
+    throw exceptions::InvalidInputException(
+        "Lazy constraint does not exist in pool.");
+  }
+  return it->second;
+}
+
+size_t cda_rail::solver::mip_based::LazyConstraintPool::total_hits() const {
+  return std::accumulate(entries.begin(), entries.end(), static_cast<size_t>(0),
+                         [](size_t sum, const auto& key_entry) {
+                           return sum + key_entry.second.hits;
+                         });
+}
+
+bool cda_rail::solver::mip_based::LazyConstraintPool::insert(
+    const Key& key, const GRBLinExpr& expr, char sense) {
+  /**
+   * Inserts a constraint expr (sense) 0 into the pool.
+   *
+   * @param key: canonical key of the constraint
+   * @param expr: left-hand side of the constraint
+   * @param sense: GRB_LESS_EQUAL, GRB_GREATER_EQUAL or GRB_EQUAL
+   *
+   * @return: true if the constraint was inserted, false if a constraint with
+   * the same key exists already. In the latter case, the hit count is
+   * increased.
+   */
+
+  const auto [it, inserted] = entries.try_emplace(key);
+  if (!inserted) {
+    it->second.hits++;
+    return false;
+  }
+  it->second.expr  = expr;
+  it->second.sense = sense;
+  return true;
+}
+
+void cda_rail::solver::mip_based::LazyConstraintPool::record_hit(
+    const Key& key) {
+  const auto it = entries.find(key);
+  if (it == entries.end()) {
+    throw exceptions::InvalidInputException(
+        "Lazy constraint does not exist in pool.");
+  }
+  it->second.hits++;
+}
+
+double
+cda_rail::solver::mip_based::LazyConstraintPool::get_violation(double value,
+                                                               char   sense) {
+  /**
+   * Returns by how much value (sense) 0 is violated, i.e., a non-positive
+   * number if it is fulfilled.
+   */
+
+  if (sense == GRB_LESS_EQUAL) {
+    return value;
+  }
+  if (sense == GRB_GREATER_EQUAL) {
+    return -value;
+  }
+  return std::abs(value);
+}
+
+bool cda_rail::solver::mip_based::LazyConstraintPool::is_violated(double value,
+                                                                 char   sense) {
+  /**
+   * Checks if value (sense) 0 is violated, using Gurobi's feasibility
+   * tolerance.
+   */
+
+  return get_violation(value, sense) > GRB_EPS;
+}
+
+GRBTempConstr cda_rail::solver::mip_based::LazyConstraintPool::to_temp_constr(
+    const GRBLinExpr& expr, char sense) {
+  if (sense == GRB_LESS_EQUAL) {
+    return expr <= 0;
+  }
+  if (sense == GRB_GREATER_EQUAL) {
+    return expr >= 0;
+  }
+  return expr == 0;
+}
+
+void cda_rail::solver::mip_based::LazyConstraintPool::store_variable_names(
+    const std::string&         fingerprint_input,
+    const std::vector<size_t>& train_signatures_input) {
+  /**
+   * Stores all constraints using variable names, so that they remain available
+   * after the model is destroyed. Must be called while the model still exists
+   * and outside a callback.
+   *
+   * @param fingerprint_input: identifies the instance the keys refer to
+   * @param train_signatures_input: identifies the data of every train the
+   * coefficients depend on
+   */
+
+  for (auto& [key, entry] : entries) {
+    if (entry.expr.size() == 0) {
+      // Already stored or a constant constraint
+      continue;
+    }
+    entry.terms.clear();
+    entry.terms.reserve(entry.expr.size());
+    for (size_t i = 0; i < entry.expr.size(); i++) {
+      entry.terms.emplace_back(
+          entry.expr.getVar(i).get(GRB_StringAttr_VarName),
+          entry.expr.getCoeff(i));
+    }
+    entry.constant = entry.expr.getConstant();
+  }
+  fingerprint      = fingerprint_input;
+  train_signatures = train_signatures_input;
+}
+
+void cda_rail::solver::mip_based::LazyConstraintPool::release_model() {
+  /**
+   * Removes all references to variables of the current model. Only the name
+   * based representation is kept.
+   */
+
+  for (auto& [key, entry] : entries) {
+    entry.expr     = 0;
+    entry.in_model = false;
+  }
+}
+
+size_t cda_rail::solver::mip_based::LazyConstraintPool::remove_outdated(
+    const std::string&         fingerprint_input,
+    const std::vector<size_t>& train_signatures_input) {
+  /**
+   * Removes all constraints that are not valid for the instance identified by
+   * the given fingerprint and train signatures. If the fingerprint differs,
+   * the keys refer to another instance and all constraints are removed.
+   * Otherwise, only constraints of trains whose signature changed are
+   * removed, e.g., after changing their time windows or the lengths of edges
+   * they might use. Since such constraints contain big-M coefficients of the
+   * previous data, they might cut off feasible solutions.
+   *
+   * @param fingerprint_input: identifies the current instance
+   * @param train_signatures_input: identifies the current data of every train
+   *
+   * @return: number of constraints removed
+   */
+
+  const auto num_entries = entries.size();
+  if (fingerprint != fingerprint_input) {
+    entries.clear();
+  } else {
+    const auto is_unchanged = [this, &train_signatures_input](size_t tr) {
+      return tr < train_signatures.size() &&
+             tr < train_signatures_input.size() &&
+             train_signatures.at(tr) == train_signatures_input.at(tr);
+    };
+    for (auto it = entries.begin(); it != entries.end();) {
+      const auto& key = it->first;
+      if (is_unchanged(key.at(1)) && is_unchanged(key.at(2))) {
+        it++;
+      } else {
+        it = entries.erase(it);
+      }
+    }
+  }
+  fingerprint      = fingerprint_input;
+  train_signatures = train_signatures_input;
+  return num_entries - entries.size();
+}
+
+size_t cda_rail::solver::mip_based::LazyConstraintPool::add_to_model(
+    GRBModel&                  model,
+    const std::string&         fingerprint_input,
+    const std::vector<size_t>& train_signatures_input,
+    int                        lazy_level) {
+  /**
+   * Adds all stored constraints that are valid for the instance of the model
+   * to it, see remove_outdated. Variables are matched by name, constraints
+   * referring to variables not present in the model are dropped. The model
+   * must be updated beforehand.
+   *
+   * @param model: model to add the constraints to
+   * @param fingerprint_input: identifies the instance of the model
+   * @param train_signatures_input: identifies the data of every train of the
+   * instance
+   * @param lazy_level: value of Gurobi's Lazy attribute. If 0, the constraints
+   * are added as usual constraints.
+   *
+   * @return: number of constraints added
+   */
+
+  if (lazy_level < 0 || lazy_level > 3) {
+    throw exceptions::InvalidInputException("Lazy level must be in [0, 3].");
+  }
+
+  remove_outdated(fingerprint_input, train_signatures_input);
+
+  std::unordered_map<std::string, GRBVar> vars_by_name;
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+  auto*     model_vars = model.getVars();
+  const int num_vars   = model.get(GRB_IntAttr_NumVars);
+  vars_by_name.reserve(num_vars);
+  for (int i = 0; i < num_vars; i++) {
+    vars_by_name.emplace(model_vars[i].get(GRB_StringAttr_VarName),
+                         model_vars[i]);
+  }
+  delete[] model_vars;
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-owning-memory)
+
+  size_t num_added = 0;
+  for (auto it = entries.begin(); it != entries.end();) {
+    auto&      entry     = it->second;
+    GRBLinExpr expr      = entry.constant;
+    bool       all_found = !entry.terms.empty();
+    for (const auto& [name, coeff] : entry.terms) {
+      const auto var_it = vars_by_name.find(name);
+      if (var_it == vars_by_name.end()) {
+        all_found = false;
+        break;
+      }
+      expr += coeff * var_it->second;
+    }
+    if (!all_found) {
+      it = entries.erase(it);
+      continue;
+    }
+
+    auto constr = model.addConstr(to_temp_constr(expr, entry.sense),
+                                  "PoolLazy" + std::to_string(num_added));
+    if (lazy_level > 0) {
+      constr.set(GRB_IntAttr_Lazy, lazy_level);
+    }
+    entry.expr     = expr;
+    entry.in_model = true;
+    num_added++;
+    it++;
+  }
+
+  return num_added;
+}
+
+void cda_rail::solver::mip_based::LazyConstraintPool::export_pool(
+    const std::filesystem::path& p) const {
+  /**
+   * This method exports all stored constraints to a directory in
+   * lazy_constraint_pool.json. Constraints are sorted by key.
+   *
+   * @param p The path to the directory to export to.
+   */
+
+  if (!is_directory_and_create(p)) {
+    throw exceptions::ExportException("Could not create directory " +
+                                      p.string());
+  }
+
+  std::vector<const std::pair<const Key, Entry>*> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  for (const auto& key_entry : entries) {
+    sorted_entries.push_back(&key_entry);
+  }
+  std::sort(sorted_entries.begin(), sorted_entries.end(),
+            [](const auto* e1, const auto* e2) {
+              return e1->first < e2->first;
+            });
+
+  json j;
+  j["fingerprint"]      = fingerprint;
+  j["train_signatures"] = train_signatures;
+  j["constraints"]      = json::array();
+  for (const auto* key_entry : sorted_entries) {
+    const auto& [key, entry] = *key_entry;
+    j["constraints"].push_back({{"key", key},
+                                {"sense", std::string(1, entry.sense)},
+                                {"constant", entry.constant},
+                                {"hits", entry.hits},
+                                {"terms", entry.terms}});
+  }
+
+  std::ofstream file(p / "lazy_constraint_pool.json");
+  file << j << std::endl;
+}
+
+cda_rail::solver::mip_based::LazyConstraintPool
+cda_rail::solver::mip_based::LazyConstraintPool::import_pool(
+    const std::filesystem::path& p) {
+  /**
+   * Import constraints from lazy_constraint_pool.json within the given
+   * directory.
+   */
+
+  if (!std::filesystem::exists(p)) {
+    throw exceptions::ImportException("Path does not exist.");
+  }
+  if (!std::filesystem::is_directory(p)) {
+    throw exceptions::ImportException("Path is not a directory.");
+  }
+  if (!std::filesystem::exists(p / "lazy_constraint_pool.json")) {
+    throw exceptions::ImportException("File lazy_constraint_pool.json does not "
+                                      "exist.");
+  }
+
+  std::ifstream f(p / "lazy_constraint_pool.json");
+  json          data = json::parse(f);
+
+  LazyConstraintPool pool;
+  pool.fingerprint = data["fingerprint"].get<std::string>();
+  if (data.contains("train_signatures")) {
+    pool.train_signatures = data["train_signatures"].get<std::vector<size_t>>();
+  }
+  for (const auto& constr : data["constraints"]) {
+    Entry entry;
+    entry.sense    = constr["sense"].get<std::string>().at(0);
+    entry.constant = constr["constant"].get<double>();
+    entry.hits     = constr["hits"].get<size_t>();
+    entry.terms =
+        constr["terms"].get<std::vector<std::pair<std::string, double>>>();
+    pool.entries.emplace(constr["key"].get<Key>(), std::move(entry));
+  }
+
+  return pool;
+}
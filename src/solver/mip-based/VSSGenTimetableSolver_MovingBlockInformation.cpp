@@ -56,7 +56,7 @@ cda_rail::instances::SolVSSGenerationTimetable cda_rail::solver::mip_based::
                             model_detail_mb_information.train_dynamics,
                             model_detail_mb_information.braking_curves},
                            model_settings, solver_strategy, solution_settings,
-                           time_limit, debug_input);
+                           debug_input);
 
   assert(!old_instance.has_value());
 
@@ -71,6 +71,7 @@ cda_rail::instances::SolVSSGenerationTimetable cda_rail::solver::mip_based::
   set_objective();
   create_constraints();
   include_additional_information();
+  apply_warm_start();
 
   set_timeout(time_limit);
 
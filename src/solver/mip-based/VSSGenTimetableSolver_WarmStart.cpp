@@ -0,0 +1,511 @@
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+#include "gurobi_c++.h"
+#include "probleminstances/VSSGenerationTimetable.hpp"
+#include "solver/mip-based/VSSGenTimetableSolver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <plog/Log.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::set_warm_start(
+    const instances::SolVSSGenerationTimetable& prior_solution,
+    bool                                        use_hints) {
+  /**
+   * Uses a previous solution, e.g., of the day before, as starting point of
+   * all following solves. The prior solution does not have to belong to the
+   * same instance. Trains are matched by name, edges by the names of their
+   * vertices and times by their absolute value. Values that cannot be mapped
+   * are left open and completed by Gurobi.
+   *
+   * @param prior_solution: solution to start from
+   * @param use_hints: if true, the values are used as variable hints
+   * (VarHintVal) instead of a MIP start (Start)
+   */
+
+  if (!prior_solution.has_solution()) {
+    throw exceptions::InvalidInputException(
+        "Prior solution used for warm start contains no solution.");
+  }
+
+  warm_start_solution  = prior_solution;
+  warm_start_use_hints = use_hints;
+}
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::set_warm_start(
+    const std::filesystem::path& prior_solution_path, bool use_hints) {
+  /**
+   * Same as above, but imports the prior solution (including its instance)
+   * from the given path.
+   */
+
+  set_warm_start(instances::SolVSSGenerationTimetable::import_solution(
+                     prior_solution_path),
+                 use_hints);
+}
+
+size_t cda_rail::solver::mip_based::VSSGenTimetableSolver::apply_warm_start() {
+  /**
+   * Sets start or hint values of the created model according to the warm start
+   * solution, if any.
+   *
+   * @return: number of variables whose value was set
+   */
+
+  if (!warm_start_solution.has_value()) {
+    return 0;
+  }
+
+  PLOGD << "Applying warm start";
+  // Attributes of new variables can only be read after an update
+  model->update();
+
+  const auto& prior_train_list =
+      warm_start_solution->get_instance().get_train_list();
+  const auto& train_list = instance.get_train_list();
+
+  size_t num_set = 0;
+  for (size_t tr = 0; tr < num_tr; ++tr) {
+    const auto& tr_name = train_list.get_train(tr).name;
+    if (!prior_train_list.has_train(tr_name)) {
+      PLOGD << "Train " << tr_name << " not part of warm start";
+      continue;
+    }
+    num_set += apply_warm_start_train_variables(
+        tr, prior_train_list.get_train_index(tr_name));
+  }
+
+  if (vss_model.get_model_type() != vss::ModelType::Discrete) {
+    num_set += apply_warm_start_vss_variables();
+  }
+
+  PLOGI << "Warm start sets " << num_set << " variables";
+  return num_set;
+}
+
+size_t cda_rail::solver::mip_based::VSSGenTimetableSolver::
+    apply_warm_start_train_variables(size_t tr, size_t prior_tr) {
+  /**
+   * Maps the speeds of a train and, if the routes are fixed and coincide with
+   * the prior route, its positions onto the model.
+   *
+   * @param tr: index of the train in the current instance
+   * @param prior_tr: index of the same train in the prior solution
+   *
+   * @return: number of variables whose value was set
+   */
+
+  const auto& prior       = warm_start_solution.value();
+  const auto& prior_inst  = prior.get_instance();
+  const auto& train       = instance.get_train_list().get_train(tr);
+  const auto& prior_train = prior_inst.get_train_list().get_train(prior_tr);
+
+  // Values of the prior solution at time t, if known
+  const auto prior_speed = [&prior, prior_tr](int t) -> std::optional<double> {
+    try {
+      return prior.get_train_speed(prior_tr, t);
+    } catch (const exceptions::ConsistencyException&) {
+      return {};
+    }
+  };
+  const auto prior_pos = [&prior, prior_tr](int t) -> std::optional<double> {
+    try {
+      return prior.get_train_pos(prior_tr, t);
+    } catch (const exceptions::ConsistencyException&) {
+      return {};
+    }
+  };
+
+  size_t num_set = 0;
+  for (auto t = train_interval[tr].first; t <= train_interval[tr].second + 1;
+       ++t) {
+    const auto speed = prior_speed(static_cast<int>(t) * dt);
+    if (speed.has_value()) {
+      set_warm_start_value(vars["v"](tr, t), speed.value());
+      num_set++;
+    }
+  }
+
+  if (!fix_routes || !instance.has_route(tr) ||
+      !prior_inst.has_route(prior_tr) ||
+      std::abs(prior_train.length - train.length) > EPS) {
+    return num_set;
+  }
+
+  // Positions are only meaningful if both routes use the same edges
+  const auto& route       = instance.get_route(tr).get_edges();
+  const auto& prior_route = prior_inst.get_route(prior_tr).get_edges();
+  const auto  same_edge   = [this, &prior_inst](size_t e, size_t prior_e) {
+    const auto& edge       = instance.const_n().get_edge(e);
+    const auto& prior_edge = prior_inst.const_n().get_edge(prior_e);
+    return instance.const_n().get_vertex(edge.source).name ==
+               prior_inst.const_n().get_vertex(prior_edge.source).name &&
+           instance.const_n().get_vertex(edge.target).name ==
+               prior_inst.const_n().get_vertex(prior_edge.target).name &&
+           std::abs(edge.length - prior_edge.length) < EPS;
+  };
+  if (route.size() != prior_route.size() ||
+      !std::equal(route.begin(), route.end(), prior_route.begin(), same_edge)) {
+    PLOGD << "Route of train " << train.name
+          << " changed, positions are not used for warm start";
+    return num_set;
+  }
+
+  // Trains without tight headways in a coarser solution may only deviate from
+  // it by the distance travelled within one time step, see
+  // solve_coarse_to_fine
+  const bool   bounded      = warm_start_bounded_trains.count(train.name) > 0;
+  const double tolerance    = train.max_speed * dt;
+  const auto   bound_around = [tolerance](GRBVar& var, double value) {
+    const auto lb = var.get(GRB_DoubleAttr_LB);
+    const auto ub = var.get(GRB_DoubleAttr_UB);
+    var.set(GRB_DoubleAttr_LB, std::clamp(value - tolerance, lb, ub));
+    var.set(GRB_DoubleAttr_UB, std::clamp(value + tolerance, lb, ub));
+  };
+
+  std::vector<std::pair<double, double>> edge_positions;
+  edge_positions.reserve(route.size());
+  for (const auto e : route) {
+    edge_positions.emplace_back(instance.route_edge_pos(tr, e));
+  }
+
+  // The prior solution stores the front position. Hence, lda(t) = pos(t) - len
+  // and mu(t) = pos(t+1) + brakelen(t), see extract_solution.
+  for (auto t = train_interval[tr].first; t <= train_interval[tr].second;
+       ++t) {
+    const auto pos = prior_pos(static_cast<int>(t) * dt);
+    const auto next_pos   = prior_pos(static_cast<int>(t + 1) * dt);
+    const auto next_speed = prior_speed(static_cast<int>(t + 1) * dt);
+    if (!pos.has_value() || !next_pos.has_value() || !next_speed.has_value()) {
+      continue;
+    }
+
+    const double lda = pos.value() - train.length;
+    double       mu  = next_pos.value();
+    if (include_braking_curves) {
+      const double brakelen = next_speed.value() * next_speed.value() /
+                              (2 * train.deceleration);
+      mu += brakelen;
+      set_warm_start_value(vars["brakelen"](tr, t), brakelen);
+      num_set++;
+    }
+    set_warm_start_value(vars["lda"](tr, t), lda);
+    set_warm_start_value(vars["mu"](tr, t), mu);
+    num_set += 2;
+    if (bounded) {
+      bound_around(vars["lda"](tr, t), lda);
+      bound_around(vars["mu"](tr, t), mu);
+    }
+
+    for (size_t i = 0; i < route.size(); ++i) {
+      const auto  e        = route.at(i);
+      const auto& edge_pos = edge_positions.at(i);
+      const bool  x_lda    = lda < edge_pos.second;
+      const bool  x_mu     = mu > edge_pos.first;
+      set_warm_start_value(vars["x_lda"](tr, t, e), x_lda ? 1 : 0);
+      set_warm_start_value(vars["x_mu"](tr, t, e), x_mu ? 1 : 0);
+      set_warm_start_value(vars["x"](tr, t, e), x_lda && x_mu ? 1 : 0);
+      num_set += 3;
+    }
+  }
+
+  return num_set;
+}
+
+size_t cda_rail::solver::mip_based::VSSGenTimetableSolver::
+    apply_warm_start_vss_variables() {
+  /**
+   * Maps the VSS of the prior solution onto the model. Only edges whose
+   * vertices and length coincide with an edge of the prior instance are
+   * considered.
+   *
+   * @return: number of variables whose value was set
+   */
+
+  const auto& prior      = warm_start_solution.value();
+  const auto& prior_netw = prior.get_instance().const_n();
+  const auto& network    = instance.const_n();
+
+  size_t num_set = 0;
+  for (size_t r_e_index = 0; r_e_index < relevant_edges.size(); ++r_e_index) {
+    const auto  e           = relevant_edges.at(r_e_index);
+    const auto& edge        = network.get_edge(e);
+    const auto& source_name = network.get_vertex(edge.source).name;
+    const auto& target_name = network.get_vertex(edge.target).name;
+    if (!prior_netw.has_edge(source_name, target_name) ||
+        std::abs(prior_netw.get_edge(source_name, target_name).length -
+                 edge.length) > EPS) {
+      continue;
+    }
+
+    auto       vss_pos      = prior.get_vss_pos(source_name, target_name);
+    const auto vss_number_e =
+        static_cast<size_t>(network.max_vss_on_edge(e));
+    // The model orders the VSS on an edge decreasingly
+    std::sort(vss_pos.begin(), vss_pos.end(), std::greater<>());
+    const auto num_vss = std::min(vss_pos.size(), vss_number_e);
+
+    if (vss_model.get_model_type() == vss::ModelType::Inferred) {
+      set_warm_start_value(vars["num_vss_segments"](r_e_index),
+                           static_cast<double>(num_vss) + 1);
+      num_set++;
+      continue;
+    }
+    if (vss_model.get_model_type() != vss::ModelType::Continuous) {
+      continue;
+    }
+
+    const auto reverse_e = network.get_reverse_edge_index(e);
+    const bool reverse_breakable =
+        reverse_e.has_value() &&
+        breakable_edge_indices.count(reverse_e.value()) > 0;
+    for (size_t vss = 0; vss < vss_number_e; ++vss) {
+      const double pos = vss < num_vss ? vss_pos.at(vss) : 0;
+      set_warm_start_value(vars["b_used"](r_e_index, vss),
+                           vss < num_vss ? 1 : 0);
+      set_warm_start_value(vars["b_pos"](breakable_edge_indices.at(e), vss),
+                           pos);
+      num_set += 2;
+      if (reverse_breakable) {
+        set_warm_start_value(
+            vars["b_pos"](breakable_edge_indices.at(reverse_e.value()), vss),
+            edge.length - pos);
+        num_set++;
+      }
+    }
+  }
+
+  return num_set;
+}
+
+cda_rail::instances::SolVSSGenerationTimetable
+cda_rail::solver::mip_based::VSSGenTimetableSolver::solve_coarse_to_fine(
+    const ModelDetail& model_detail, const std::vector<int>& coarse_delta_t,
+    const ModelSettings& model_settings, const SolverStrategy& solver_strategy,
+    const SolutionSettings& solution_settings, int time_limit,
+    bool debug_input) {
+  /**
+   * Solves the problem on a sequence of time discretizations. The problem is
+   * first solved using the coarse time steps, which results in much smaller
+   * models. Every solution is used as warm start of the next finer one, where
+   * the trajectories are interpolated to the finer time steps. Finally, the
+   * problem is solved using model_detail.delta_t.
+   * If routes are fixed, the final solve only refines trains with tight
+   * headways in the last coarse solution, see trains_without_tight_headways.
+   * The positions of all other trains are bounded to deviate from the coarse
+   * solution by at most the distance travelled within one final time step.
+   * Hence, a solution is only reported as optimal if no train was bounded. If
+   * the bounded model has no solution, it is solved again without bounds.
+   *
+   * @param model_detail: model details of the final solve
+   * @param coarse_delta_t: strictly decreasing time steps used before the
+   * final solve, all greater than model_detail.delta_t
+   * @param time_limit: overall time limit in seconds. If positive, half of it
+   * is shared equally by the coarse solves, the final solve gets the rest.
+   *
+   * Other parameters are as in solve(). Solutions of the coarse solves are
+   * not exported.
+   *
+   * @return: solution of the final solve
+   */
+
+  for (size_t i = 0; i < coarse_delta_t.size(); ++i) {
+    if (coarse_delta_t.at(i) <= model_detail.delta_t ||
+        (i > 0 && coarse_delta_t.at(i) >= coarse_delta_t.at(i - 1))) {
+      throw exceptions::InvalidInputException(
+          "Coarse time steps must be strictly decreasing and greater than the "
+          "final time step.");
+    }
+  }
+
+  // A warm start set by the user is used for the first solve only. It is
+  // restored when leaving, even if a solve throws.
+  class WarmStartRestorer {
+  public:
+    explicit WarmStartRestorer(VSSGenTimetableSolver* solver)
+        : solver(solver), warm_start_solution(solver->warm_start_solution),
+          use_hints(solver->warm_start_use_hints) {}
+    WarmStartRestorer(const WarmStartRestorer&)            = delete;
+    WarmStartRestorer(WarmStartRestorer&&)                 = delete;
+    WarmStartRestorer& operator=(const WarmStartRestorer&) = delete;
+    WarmStartRestorer& operator=(WarmStartRestorer&&)      = delete;
+    ~WarmStartRestorer() {
+      solver->warm_start_solution  = std::move(warm_start_solution);
+      solver->warm_start_use_hints = use_hints;
+      solver->warm_start_bounded_trains.clear();
+    }
+
+  private:
+    VSSGenTimetableSolver*                              solver;
+    std::optional<instances::SolVSSGenerationTimetable> warm_start_solution;
+    bool                                                use_hints;
+  };
+  const WarmStartRestorer warm_start_restorer(this);
+
+  const auto start                = std::chrono::steady_clock::now();
+  const auto remaining_time_limit = [&start, time_limit]() {
+    if (time_limit <= 0) {
+      return -1;
+    }
+    const auto elapsed = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    return std::max(1, time_limit - elapsed);
+  };
+
+  const int coarse_time_limit =
+      time_limit > 0
+          ? std::max(1, time_limit /
+                            (2 * static_cast<int>(coarse_delta_t.size())))
+          : -1;
+  bool coarse_solution_found = false;
+  for (const auto delta_t : coarse_delta_t) {
+    PLOGI << "Solve with coarse time step " << delta_t;
+    auto coarse_model_detail    = model_detail;
+    coarse_model_detail.delta_t = delta_t;
+    const auto coarse_sol = solve(coarse_model_detail, model_settings,
+                                  solver_strategy, {}, coarse_time_limit,
+                                  debug_input);
+    if (coarse_sol.has_solution()) {
+      set_warm_start(coarse_sol);
+      coarse_solution_found = true;
+    } else {
+      PLOGD << "No solution for time step " << delta_t
+            << ", keep previous warm start";
+    }
+  }
+
+  if (coarse_solution_found && model_detail.fix_routes) {
+    warm_start_bounded_trains =
+        trains_without_tight_headways(warm_start_solution.value());
+    PLOGI << warm_start_bounded_trains.size()
+          << " trains without tight headways are bounded around the coarse "
+             "solution";
+  }
+
+  PLOGI << "Solve with final time step " << model_detail.delta_t;
+  auto sol = solve(model_detail, model_settings, solver_strategy,
+                   solution_settings, remaining_time_limit(), debug_input);
+
+  if (!warm_start_bounded_trains.empty()) {
+    if (sol.has_solution()) {
+      // Optimal only with respect to the bounded trains
+      if (sol.get_status() == SolutionStatus::Optimal) {
+        sol.set_status(SolutionStatus::Feasible);
+      }
+    } else {
+      PLOGI << "No solution with bounded trains, solve again without bounds";
+      warm_start_bounded_trains.clear();
+      sol = solve(model_detail, model_settings, solver_strategy,
+                  solution_settings, remaining_time_limit(), debug_input);
+    }
+  }
+
+  return sol;
+}
+
+std::unordered_set<std::string> cda_rail::solver::mip_based::
+    VSSGenTimetableSolver::trains_without_tight_headways(
+        const instances::SolVSSGenerationTimetable& sol) const {
+  /**
+   * Returns the names of all trains that never come close to another train in
+   * the given solution. At every time step, a train occupies all edges of its
+   * route between its rear and the end of its braking distance after the next
+   * time step, i.e., the interval between lda and mu of the model. Two trains
+   * are close if they occupy edges with a common vertex at the same time
+   * step. Trains without a route are considered close to every other train.
+   *
+   * @param sol: solution to check
+   *
+   * @return: names of all trains without tight headways
+   */
+
+  const auto& sol_instance = sol.get_instance();
+  const auto& network      = sol_instance.const_n();
+  const auto& train_list   = sol_instance.get_train_list();
+  const auto  sol_dt       = sol.get_dt();
+
+  // For every time index, occupied vertices of every train present
+  std::vector<bool> tight(train_list.size(), false);
+  std::unordered_map<
+      size_t, std::vector<std::pair<size_t, std::unordered_set<size_t>>>>
+      occupied_vertices;
+  for (size_t tr = 0; tr < train_list.size(); ++tr) {
+    const auto& train = train_list.get_train(tr);
+    if (!sol_instance.has_route(tr)) {
+      tight.at(tr) = true;
+      continue;
+    }
+    const auto& route   = sol_instance.get_route(tr);
+    const auto [t0, tn] = sol_instance.time_index_interval(tr, sol_dt, true);
+    for (auto t = t0; t < tn; ++t) {
+      const auto time       = static_cast<int>(t) * sol_dt;
+      const auto next_speed = sol.get_train_speed(tr, time + sol_dt);
+      const auto brakelen =
+          next_speed * next_speed / (2 * train.deceleration);
+      const auto lda = sol.get_train_pos(tr, time) - train.length;
+      const auto mu  = sol.get_train_pos(tr, time + sol_dt) + brakelen;
+
+      std::unordered_set<size_t> vertices;
+      for (const auto e : route.get_edges()) {
+        const auto [e_start, e_end] = route.edge_pos(e, network);
+        if (e_start <= mu && e_end >= lda) {
+          vertices.insert(network.get_edge(e).source);
+          vertices.insert(network.get_edge(e).target);
+        }
+      }
+      occupied_vertices[t].emplace_back(tr, std::move(vertices));
+    }
+  }
+
+  for (const auto& occupied_at_t : occupied_vertices) {
+    const auto& trains_at_t = occupied_at_t.second;
+    for (size_t i = 0; i < trains_at_t.size(); ++i) {
+      for (size_t j = i + 1; j < trains_at_t.size(); ++j) {
+        const auto& [tr1, vertices1] = trains_at_t.at(i);
+        const auto& [tr2, vertices2] = trains_at_t.at(j);
+        if (std::any_of(vertices1.begin(), vertices1.end(),
+                        [&vertices2 = vertices2](size_t v) {
+                          return vertices2.count(v) > 0;
+                        })) {
+          tight.at(tr1) = true;
+          tight.at(tr2) = true;
+        }
+      }
+    }
+  }
+
+  std::unordered_set<std::string> trains;
+  for (size_t tr = 0; tr < train_list.size(); ++tr) {
+    if (!tight.at(tr)) {
+      trains.insert(train_list.get_train(tr).name);
+    }
+  }
+  return trains;
+}
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::set_warm_start_value(
+    GRBVar& var, double value) const {
+  /**
+   * Sets the start or hint value of a variable. The value is clamped to the
+   * bounds of the variable, since the prior instance might be slightly
+   * different.
+   */
+
+  value = std::clamp(value, var.get(GRB_DoubleAttr_LB),
+                     var.get(GRB_DoubleAttr_UB));
+  var.set(warm_start_use_hints ? GRB_DoubleAttr_VarHintVal
+                               : GRB_DoubleAttr_Start,
+          value);
+}
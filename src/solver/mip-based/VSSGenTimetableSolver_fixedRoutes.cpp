@@ -13,16 +13,18 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Creates variables connected to the fixed route version of the problem
    */
 
-  vars["lda"]   = MultiArray<GRBVar>(num_tr, num_t);
-  vars["mu"]    = MultiArray<GRBVar>(num_tr, num_t);
-  vars["x_lda"] = MultiArray<GRBVar>(num_tr, num_t, num_edges);
-  vars["x_mu"]  = MultiArray<GRBVar>(num_tr, num_t, num_edges);
+  vars["lda"]   = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
+  vars["mu"]    = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
+  vars["x_lda"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_edges);
+  vars["x_mu"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_edges);
 
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto tr_name = train_list.get_train(tr).name;
-    const auto r_len   = instance.route_length(tr_name);
-    const auto tr_len  = train_list.get_train(tr_name).length;
+    const auto r_len   = instance.route_length(tr);
+    const auto tr_len  = train_list.get_train(tr).length;
     double     mu_ub   = r_len + tr_len;
     if (this->include_braking_curves) {
       mu_ub += get_max_brakelen(tr);
@@ -36,12 +38,11 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       vars["lda"](tr, t_steps) =
           model->addVar(-tr_len, r_len, 0, GRB_CONTINUOUS,
                         "lda_" + tr_name + "_" + std::to_string(t));
-      for (auto const edge_id :
-           instance.edges_used_by_train(tr_name, fix_routes)) {
-        const auto& edge = instance.n().get_edge(edge_id);
+      for (auto const edge_id : instance.edges_used_by_train(tr, fix_routes)) {
+        const auto& edge = instance.const_n().get_edge(edge_id);
         const auto& edge_name =
-            "[" + instance.n().get_vertex(edge.source).name + "," +
-            instance.n().get_vertex(edge.target).name + "]";
+            "[" + instance.const_n().get_vertex(edge.source).name + "," +
+            instance.const_n().get_vertex(edge.target).name + "]";
         vars["x_lda"](tr, t_steps, edge_id) = model->addVar(
             0, 1, 0, GRB_BINARY,
             "x_lda_" + tr_name + "_" + std::to_string(t) + "_" + edge_name);
@@ -76,10 +77,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * fixed routes.
    */
 
-  auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     auto tr_name = train_list.get_train(tr).name;
-    auto tr_len  = instance.get_train_list().get_train(tr_name).length;
+    auto tr_len  = instance.get_train_list().get_train(tr).length;
     for (size_t t = train_interval[tr].first;
          t <= train_interval[tr].second - 1; ++t) {
       // full pos: mu - lda = len + (v(t) + v(t+1))/2 * dt + brakelen (if
@@ -123,11 +124,11 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Create boundary conditions for the fixed routes of the trains
    */
 
-  auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t i = 0; i < num_tr; ++i) {
     auto tr_name = train_list.get_train(i).name;
-    auto r_len   = instance.route_length(tr_name);
-    auto tr_len  = instance.get_train_list().get_train(tr_name).length;
+    auto r_len   = instance.route_length(i);
+    auto tr_len  = instance.get_train_list().get_train(i).length;
     // initial_lda: lda(train_interval[i].first) = - tr_len
     model->addConstr(vars["lda"](i, train_interval[i].first) == -tr_len,
                      "initial_lda_" + tr_name);
@@ -152,10 +153,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < train_list.size(); ++tr) {
     const auto  tr_name  = train_list.get_train(tr).name;
-    const auto  r_len    = instance.route_length(tr_name);
-    const auto& tr_route = instance.get_route(tr_name);
+    const auto  r_len    = instance.route_length(tr);
+    const auto& tr_route = instance.get_route(tr);
     const auto  r_size   = tr_route.size();
-    const auto  tr_len   = instance.get_train_list().get_train(tr_name).length;
+    const auto  tr_len   = instance.get_train_list().get_train(tr).length;
 
     double mu_ub = r_len + tr_len;
     if (this->include_braking_curves) {
@@ -165,7 +166,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     // Iterate over all edges
     for (size_t j = 0; j < r_size; ++j) {
       const auto edge_id  = tr_route.get_edge(j);
-      const auto edge_pos = instance.route_edge_pos(tr_name, edge_id);
+      const auto edge_pos = instance.route_edge_pos(tr, edge_id);
       // Iterate over possible time steps
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
@@ -214,14 +215,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < train_list.size(); ++tr) {
     const auto  tr_name     = train_list.get_train(tr).name;
-    const auto& tr_schedule = instance.get_schedule(tr_name);
+    const auto& tr_schedule = instance.get_schedule(tr);
     for (const auto& tr_stop : tr_schedule.get_stops()) {
       const auto  t0 = tr_stop.arrival() / dt;
       const auto  t1 = std::ceil(static_cast<double>(tr_stop.departure()) / dt);
       const auto& stop_edges = instance.get_station_list()
                                    .get_station(tr_stop.get_station_name())
                                    .tracks;
-      const auto& stop_pos = instance.route_edge_pos(tr_name, stop_edges);
+      const auto& stop_pos = instance.route_edge_pos(tr, stop_edges);
       // Other cases follow by increasing of lambda and mu
       model->addConstr(vars["mu"](tr, t0 - 1) >= stop_pos.first,
                        "mu_station_min_" + tr_name + "_" +
@@ -264,14 +265,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         before_max = 0;
       } else {
         before_max =
-            instance.route_edge_pos(tr_name, before_after_struct.edges_before)
+            instance.route_edge_pos(tr, before_after_struct.edges_before)
                 .second;
       }
       if (before_after_struct.t_after >= train_interval[tr].second) {
-        after_min = instance.route_length(tr_name);
+        after_min = instance.route_length(tr);
       } else {
         after_min =
-            instance.route_edge_pos(tr_name, before_after_struct.edges_after)
+            instance.route_edge_pos(tr, before_after_struct.edges_after)
                 .first;
       }
 
@@ -305,18 +306,17 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    */
 
   for (size_t tr = 0; tr < num_tr; ++tr) {
-    const auto& tr_name = instance.get_train_list().get_train(tr).name;
-    const auto  r_len   = instance.route_length(tr_name);
-    const auto& tr_len  = instance.get_train_list().get_train(tr).length;
-    double      mu_ub   = r_len + tr_len;
+    const auto  r_len  = instance.route_length(tr);
+    const auto& tr_len = instance.get_train_list().get_train(tr).length;
+    double      mu_ub  = r_len + tr_len;
     if (this->include_braking_curves) {
       mu_ub += get_max_brakelen(tr);
     }
     for (const auto e : instance.edges_used_by_train(tr, this->fix_routes)) {
       const auto& e_index      = breakable_edge_indices[e];
-      const auto& e_len        = instance.n().get_edge(e).length;
-      const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-      const auto  edge_pos     = instance.route_edge_pos(tr_name, e);
+      const auto& e_len        = instance.const_n().get_edge(e).length;
+      const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+      const auto  edge_pos     = instance.route_edge_pos(tr, e);
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
@@ -410,16 +410,16 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   // For every breakable edge position exactly b_pos if tight
   for (size_t i = 0; i < breakable_edges.size(); ++i) {
     const auto& e            = breakable_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     for (size_t vss = 0; vss < vss_number_e; ++vss) {
       for (const auto tr : instance.trains_on_edge(e, this->fix_routes)) {
         const auto& tr_name  = instance.get_train_list().get_train(tr).name;
-        const auto  edge_pos = instance.route_edge_pos(tr_name, e);
-        const auto  r_len    = instance.route_length(tr_name);
+        const auto  edge_pos = instance.route_edge_pos(tr, e);
+        const auto  r_len    = instance.route_length(tr);
         const auto& tr_len   = instance.get_train_list().get_train(tr).length;
         double      mu_ub    = r_len + tr_len;
         if (this->include_braking_curves) {
@@ -448,14 +448,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   // Analog for every edge ending
   for (size_t e = 0; e < num_edges; ++e) {
-    const auto& edge      = instance.n().get_edge(e);
-    const auto& edge_name = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto& edge      = instance.const_n().get_edge(e);
+    const auto& edge_name =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     for (const auto tr : instance.trains_on_edge(e, this->fix_routes)) {
       const auto& tr_name  = instance.get_train_list().get_train(tr).name;
-      const auto  edge_pos = instance.route_edge_pos(tr_name, e);
-      const auto  r_len    = instance.route_length(tr_name);
+      const auto  edge_pos = instance.route_edge_pos(tr, e);
+      const auto  r_len    = instance.route_length(tr);
       for (size_t t = train_interval[tr].first + 2;
            t <= train_interval[tr].second; ++t) {
         model->addConstr(vars["mu"](tr, t - 1), GRB_GREATER_EQUAL,
@@ -471,7 +471,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_object    = instance.get_train_list().get_train(tr);
     const auto& tr_name      = tr_object.name;
-    const auto  r_len        = instance.route_length(tr_name);
+    const auto  r_len        = instance.route_length(tr);
     const auto& tr_len       = tr_object.length;
     const auto  max_brakelen = get_max_brakelen(tr);
     for (size_t t = train_interval[tr].first + 2;
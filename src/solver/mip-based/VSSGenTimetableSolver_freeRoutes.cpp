@@ -13,19 +13,23 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * This method creates the variables needed if the routes are not fixed.
    */
 
-  vars["overlap"] = MultiArray<GRBVar>(num_tr, num_t - 1, num_edges);
-  vars["x_v"]     = MultiArray<GRBVar>(num_tr, num_t, num_vertices);
-  vars["len_in"]  = MultiArray<GRBVar>(num_tr, num_t);
-  vars["x_in"]    = MultiArray<GRBVar>(num_tr, num_t);
-  vars["len_out"] = MultiArray<GRBVar>(num_tr, num_t);
-  vars["x_out"]   = MultiArray<GRBVar>(num_tr, num_t);
-  vars["e_lda"]   = MultiArray<GRBVar>(num_tr, num_t, num_edges);
-  vars["e_mu"]    = MultiArray<GRBVar>(num_tr, num_t, num_edges);
+  vars["overlap"] = MultiArray<GRBVar>::with_intervals(
+      train_time_intervals(-1), num_t - 1, num_edges);
+  vars["x_v"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_vertices);
+  vars["len_in"]  = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
+  vars["x_in"]    = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
+  vars["len_out"] = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
+  vars["x_out"]   = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
+  vars["e_lda"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_edges);
+  vars["e_mu"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_edges);
 
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = train_list.get_train(tr).name;
-    const auto& tr_len  = instance.get_train_list().get_train(tr_name).length;
+    const auto& tr_len  = instance.get_train_list().get_train(tr).length;
     double      len_out_ub = tr_len;
     if (this->include_braking_curves) {
       len_out_ub += get_max_brakelen(tr);
@@ -33,26 +37,26 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
          ++t) {
       for (size_t e = 0; e < num_edges; ++e) {
-        const auto& edge = instance.n().get_edge(e);
+        const auto& edge = instance.const_n().get_edge(e);
         const auto& edge_name =
-            "[" + instance.n().get_vertex(edge.source).name + "," +
-            instance.n().get_vertex(edge.target).name + "]";
+            "[" + instance.const_n().get_vertex(edge.source).name + "," +
+            instance.const_n().get_vertex(edge.target).name + "]";
         if (t < train_interval[tr].second) {
           vars["overlap"](tr, t, e) = model->addVar(
-              0, instance.n().get_edge(e).length, 0, GRB_CONTINUOUS,
+              0, instance.const_n().get_edge(e).length, 0, GRB_CONTINUOUS,
               "overlap_" + tr_name + "_" + std::to_string(t * dt) + "_" +
                   edge_name);
         }
-        vars["e_lda"](tr, t, e) =
-            model->addVar(0, instance.n().get_edge(e).length, 0, GRB_CONTINUOUS,
-                          "e_lda_" + tr_name + "_" + std::to_string(t * dt) +
-                              "_" + edge_name);
+        vars["e_lda"](tr, t, e) = model->addVar(
+            0, instance.const_n().get_edge(e).length, 0, GRB_CONTINUOUS,
+            "e_lda_" + tr_name + "_" + std::to_string(t * dt) + "_" +
+                edge_name);
         vars["e_mu"](tr, t, e) = model->addVar(
-            0, instance.n().get_edge(e).length, 0, GRB_CONTINUOUS,
+            0, instance.const_n().get_edge(e).length, 0, GRB_CONTINUOUS,
             "e_mu_" + tr_name + "_" + std::to_string(t * dt) + "_" + edge_name);
       }
       for (size_t v = 0; v < num_vertices; ++v) {
-        const auto& v_name    = instance.n().get_vertex(v).name;
+        const auto& v_name    = instance.const_n().get_vertex(v).name;
         vars["x_v"](tr, t, v) = model->addVar(
             0, 1, 0, GRB_BINARY,
             "x_v_" + tr_name + "_" + std::to_string(t * dt) + "_" + v_name);
@@ -94,10 +98,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Creates constraints connected to positioning of trains.
    */
 
-  auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = train_list.get_train(tr).name;
-    const auto& tr_len  = instance.get_train_list().get_train(tr_name).length;
+    const auto& tr_len  = instance.get_train_list().get_train(tr).length;
     const auto& entry   = instance.get_schedule(tr).get_entry();
     const auto& exit    = instance.get_schedule(tr).get_exit();
     for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
@@ -122,8 +126,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       // x_v >= sum_(e in delta_in_v) x_e
       // x_v >= sum_(e in delta_out_v) x_e
       for (size_t v = 0; v < num_vertices; ++v) {
-        const auto out_edges = instance.n().out_edges(v);
-        const auto in_edges  = instance.n().in_edges(v);
+        const auto out_edges = instance.const_n().out_edges(v);
+        const auto in_edges  = instance.const_n().in_edges(v);
         lhs                  = vars["x_v"](tr, t, v);
         GRBLinExpr rhs_in    = 0;
         GRBLinExpr rhs_out   = 0;
@@ -166,12 +170,12 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       // Switches are obeyed, i.e., illegal movements prohibited
       // And train does not go backwards
       for (size_t e1 = 0; e1 < num_edges; ++e1) {
-        const auto& v         = instance.n().get_edge(e1).target;
-        const auto& out_edges = instance.n().out_edges(v);
-        const auto& e_len     = instance.n().get_edge(e1).length;
+        const auto& v         = instance.const_n().get_edge(e1).target;
+        const auto& out_edges = instance.const_n().out_edges(v);
+        const auto& e_len     = instance.const_n().get_edge(e1).length;
         for (const auto& e2 : out_edges) {
           if (t < train_interval[tr].second &&
-              instance.n().is_valid_successor(e1, e2)) {
+              instance.const_n().is_valid_successor(e1, e2)) {
             // Prohibit train going backwards
             // x_e1(t+1) <= x_e1(t) + (1-x_e2(t))
             model->addConstr(vars["x"](tr, t + 1, e1), GRB_LESS_EQUAL,
@@ -179,7 +183,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
                              "train_pos_no_backwards_" + tr_name + "_" +
                                  std::to_string(t) + "_" + std::to_string(e1) +
                                  "_" + std::to_string(e2));
-          } else if (!instance.n().is_valid_successor(e1, e2)) {
+          } else if (!instance.const_n().is_valid_successor(e1, e2)) {
             // Prohibit illegal movement
             // x_e1 + x_e2 <= 1
             model->addConstr(
@@ -227,10 +231,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * routes
    */
 
-  const auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = train_list.get_train(tr).name;
-    const auto& tr_len  = train_list.get_train(tr_name).length;
+    const auto& tr_len  = train_list.get_train(tr).length;
     const auto& entry   = instance.get_schedule(tr).get_entry();
     const auto& exit    = instance.get_schedule(tr).get_exit();
     for (size_t t = train_interval[tr].first;
@@ -260,10 +264,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
       // Determine overlap value per edge
       for (size_t e = 0; e < num_edges; ++e) {
-        const auto& e_v0      = instance.n().get_edge(e).source;
-        const auto& e_v1      = instance.n().get_edge(e).target;
-        const auto& out_edges = instance.n().out_edges(e_v1);
-        const auto& e_len     = instance.n().get_edge(e).length;
+        const auto& e_v0      = instance.const_n().get_edge(e).source;
+        const auto& e_v1      = instance.const_n().get_edge(e).target;
+        const auto& out_edges = instance.const_n().out_edges(e_v1);
+        const auto& e_len     = instance.const_n().get_edge(e).length;
 
         // overlap >= e_mu(t) - e_lda(t+1) if e is occupied at t+1, i.e.,
         // overlap_e + e_len * (1 - x_e(t+1)) >= e_mu(t) - e_lda(t+1)
@@ -292,7 +296,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
         // Overlap is only at front
         for (const auto& e2 : out_edges) {
-          if (instance.n().is_valid_successor(e, e2)) {
+          if (instance.const_n().is_valid_successor(e, e2)) {
             // overlap_e <= e_len * overlap_e2 + e_len * (1 - x_e2)
             model->addConstr(vars["overlap"](tr, t, e), GRB_LESS_EQUAL,
                              e_len * vars["overlap"](tr, t, e2) +
@@ -331,10 +335,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Boundary conditions in case of no fixed routes
    */
 
-  const auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = train_list.get_train(tr).name;
-    const auto& tr_len  = train_list.get_train(tr_name).length;
+    const auto& tr_len  = train_list.get_train(tr).length;
     const auto& t0      = train_interval[tr].first;
     const auto& tn      = train_interval[tr].second;
     // len_in(t0) = tr_len
@@ -358,17 +362,17 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Connects trains position and occupation variables if routes are not fixed
    */
 
-  const auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = train_list.get_train(tr).name;
     const auto& entry   = instance.get_schedule(tr).get_entry();
     const auto& exit    = instance.get_schedule(tr).get_exit();
     for (size_t e = 0; e < num_edges; ++e) {
-      const auto& e_v0      = instance.n().get_edge(e).source;
-      const auto& e_v1      = instance.n().get_edge(e).target;
-      const auto& in_edges  = instance.n().in_edges(e_v0);
-      const auto& out_edges = instance.n().out_edges(e_v1);
-      const auto& e_len     = instance.n().get_edge(e).length;
+      const auto& e_v0      = instance.const_n().get_edge(e).source;
+      const auto& e_v1      = instance.const_n().get_edge(e).target;
+      const auto& in_edges  = instance.const_n().in_edges(e_v0);
+      const auto& out_edges = instance.const_n().out_edges(e_v1);
+      const auto& e_len     = instance.const_n().get_edge(e).length;
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
         // e_lda <= e_mu
@@ -426,7 +430,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     }
 
     // x_in and x_out
-    const auto& tr_len     = train_list.get_train(tr_name).length;
+    const auto& tr_len     = train_list.get_train(tr).length;
     double      len_out_ub = tr_len;
     if (this->include_braking_curves) {
       len_out_ub += get_max_brakelen(tr);
@@ -464,7 +468,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Impossible positions cut off due to schedule.
    */
 
-  const auto apsp = instance.n().all_edge_pairs_shortest_paths();
+  const auto apsp = instance.const_n().all_edge_pairs_shortest_paths();
 
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < train_list.size(); ++tr) {
@@ -489,17 +493,18 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
       // Iterate over all edges
       for (size_t e = 0; e < num_edges; ++e) {
-        const auto& e_len = instance.n().get_edge(e).length;
+        const auto& e_len = instance.const_n().get_edge(e).length;
 
         double dist_before = NAN;
         double dist_after  = NAN;
 
         // Constraint inferred from before position
         if (before_after_struct.t_before <= train_interval[tr].first) {
-          const auto e_before =
-              instance.n().out_edges(instance.get_schedule(tr).get_entry())[0];
-          const auto& e_len_before = instance.n().get_edge(e_before).length;
-          dist_before              = apsp[e_before][e] + e_len_before - e_len;
+          const auto e_before = instance.const_n().out_edges(
+              instance.get_schedule(tr).get_entry())[0];
+          const auto& e_len_before =
+              instance.const_n().get_edge(e_before).length;
+          dist_before = apsp[e_before][e] + e_len_before - e_len;
         } else {
           dist_before = INF;
           for (const auto& e_tmp : before_after_struct.edges_before) {
@@ -529,14 +534,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
         // Constraint inferred from after position
         if (before_after_struct.t_after >= train_interval[tr].second) {
-          const auto e_after =
-              instance.n().in_edges(instance.get_schedule(tr).get_exit())[0];
+          const auto e_after = instance.const_n().in_edges(
+              instance.get_schedule(tr).get_exit())[0];
           dist_after = apsp[e][e_after];
         } else {
           dist_after = INF;
           for (const auto& e_tmp : before_after_struct.edges_after) {
             const auto tmp_val =
-                apsp[e][e_tmp] - instance.n().get_edge(e_tmp).length;
+                apsp[e][e_tmp] - instance.const_n().get_edge(e_tmp).length;
             if (tmp_val < dist_after) {
               dist_after = tmp_val;
             }
@@ -570,13 +575,13 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * VSS constraints for free routes
    */
 
-  const auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = train_list.get_train(tr).name;
     for (size_t e_index = 0; e_index < breakable_edges.size(); ++e_index) {
       const auto& e            = breakable_edges[e_index];
-      const auto& e_len        = instance.n().get_edge(e).length;
-      const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+      const auto& e_len        = instance.const_n().get_edge(e).length;
+      const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
@@ -678,11 +683,11 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   // For every breakable edge position exactly b_pos if tight
   for (size_t i = 0; i < breakable_edges.size(); ++i) {
     const auto& e            = breakable_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     const auto& e_len = edge.length;
     for (size_t vss = 0; vss < vss_number_e; ++vss) {
       for (size_t tr : instance.trains_on_edge(e, this->fix_routes)) {
@@ -708,10 +713,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   // Analog for every edge ending
   for (size_t e = 0; e < num_edges; ++e) {
-    const auto& edge      = instance.n().get_edge(e);
-    const auto& edge_name = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto& edge      = instance.const_n().get_edge(e);
+    const auto& edge_name =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     const auto& e_len = edge.length;
     for (size_t tr : instance.trains_on_edge(e, this->fix_routes)) {
       const auto& tr_name = instance.get_train_list().get_train(tr).name;
@@ -728,7 +733,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   // Fix lenout problem
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = instance.get_train_list().get_train(tr).name;
-    const auto& tr_len  = instance.get_train_list().get_train(tr_name).length;
+    const auto& tr_len  = instance.get_train_list().get_train(tr).length;
     const auto& max_brakelen =
         include_braking_curves ? get_max_brakelen(tr) : 0;
     // NOLINTBEGIN(readability-identifier-naming)
@@ -120,11 +120,12 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::solve(
 
   auto old_instance =
       initialize_variables(model_detail, model_settings, solver_strategy,
-                           solution_settings, time_limit, debug_input);
+                           solution_settings, debug_input);
 
   create_variables();
   set_objective();
   create_constraints();
+  apply_warm_start();
 
   set_timeout(time_limit);
 
@@ -149,18 +150,22 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * Creates general variables that are independent of the fixed route
    */
 
-  vars["v"] = MultiArray<GRBVar>(num_tr, num_t + 1);
-  vars["x"] = MultiArray<GRBVar>(num_tr, num_t, num_edges);
-  vars["x_sec"] =
-      MultiArray<GRBVar>(num_tr, num_t, unbreakable_sections.size());
+  // Trains only exist during their time interval, hence, only these time
+  // steps are stored
+  vars["v"] =
+      MultiArray<GRBVar>::with_intervals(train_time_intervals(1), num_t + 1);
+  vars["x"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_edges);
+  vars["x_sec"] = MultiArray<GRBVar>::with_intervals(
+      train_interval, num_t, unbreakable_sections.size());
   vars["y_sec_fwd"] = MultiArray<GRBVar>(num_t, fwd_bwd_sections.size());
   vars["y_sec_bwd"] = MultiArray<GRBVar>(num_t, fwd_bwd_sections.size());
 
   if (vss_model.get_only_stop_at_vss()) {
-    vars["stopped"] = MultiArray<GRBVar>(num_tr, num_t);
+    vars["stopped"] = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
   }
 
-  auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t i = 0; i < num_tr; ++i) {
     auto max_speed = instance.get_train_list().get_train(i).max_speed;
     auto tr_name   = train_list.get_train(i).name;
@@ -172,12 +177,11 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     }
     for (size_t t = train_interval[i].first; t <= train_interval[i].second;
          ++t) {
-      for (auto const edge_id :
-           instance.edges_used_by_train(tr_name, fix_routes)) {
-        const auto& edge = instance.n().get_edge(edge_id);
+      for (auto const edge_id : instance.edges_used_by_train(i, fix_routes)) {
+        const auto& edge = instance.const_n().get_edge(edge_id);
         const auto& edge_name =
-            "[" + instance.n().get_vertex(edge.source).name + "," +
-            instance.n().get_vertex(edge.target).name + "]";
+            "[" + instance.const_n().get_vertex(edge.source).name + "," +
+            instance.const_n().get_vertex(edge.target).name + "]";
         vars["x"](i, t, edge_id) = model->addVar(
             0, 1, 0, GRB_BINARY,
             "x_" + tr_name + "_" + std::to_string(t * dt) + "_" + edge_name);
@@ -212,7 +216,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   for (size_t i = 0; i < no_border_vss_vertices.size(); ++i) {
     const auto& v_name =
-        instance.n().get_vertex(no_border_vss_vertices[i]).name;
+        instance.const_n().get_vertex(no_border_vss_vertices[i]).name;
     vars["b"](i) = model->addVar(0, 1, 0, GRB_BINARY, "b_" + v_name);
   }
 }
@@ -225,14 +229,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   int max_vss = 0;
   for (const auto& e : breakable_edges) {
-    max_vss = std::max(max_vss, instance.n().max_vss_on_edge(e));
+    max_vss = std::max(max_vss, instance.const_n().max_vss_on_edge(e));
   }
 
-  vars["b_pos"] = MultiArray<GRBVar>(num_breakable_sections, max_vss);
-  vars["b_front"] =
-      MultiArray<GRBVar>(num_tr, num_t, num_breakable_sections, max_vss);
-  vars["b_rear"] =
-      MultiArray<GRBVar>(num_tr, num_t, num_breakable_sections, max_vss);
+  vars["b_pos"]   = MultiArray<GRBVar>(num_breakable_sections, max_vss);
+  vars["b_front"] = MultiArray<GRBVar>::with_intervals(
+      train_interval, num_t, num_breakable_sections, max_vss);
+  vars["b_rear"]  = MultiArray<GRBVar>::with_intervals(
+      train_interval, num_t, num_breakable_sections, max_vss);
 
   if (this->vss_model.get_model_type() == vss::ModelType::Inferred) {
     vars["num_vss_segments"]  = MultiArray<GRBVar>(relevant_edges.size());
@@ -258,12 +262,12 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   for (size_t i = 0; i < breakable_edges.size(); ++i) {
     const auto& e            = breakable_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
     const auto& edge_len     = edge.length;
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     for (size_t vss = 0; vss < vss_number_e; ++vss) {
       const auto& lb = 0;
       const auto& ub = edge_len;
@@ -290,11 +294,11 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   for (size_t i = 0; i < relevant_edges.size(); ++i) {
     const auto& e            = relevant_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
 
     if (this->vss_model.get_model_type() == vss::ModelType::Inferred) {
       vars["num_vss_segments"](i) = model->addVar(
@@ -360,20 +364,21 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     create_non_discretized_only_stop_at_vss_variables() {
   int max_vss = 0;
   for (const auto& e : breakable_edges) {
-    max_vss = std::max(max_vss, instance.n().max_vss_on_edge(e));
+    max_vss = std::max(max_vss, instance.const_n().max_vss_on_edge(e));
   }
 
-  vars["b_tight"] =
-      MultiArray<GRBVar>(num_tr, num_t, num_breakable_sections, max_vss);
-  vars["e_tight"] = MultiArray<GRBVar>(num_tr, num_t, num_edges);
+  vars["b_tight"] = MultiArray<GRBVar>::with_intervals(
+      train_interval, num_t, num_breakable_sections, max_vss);
+  vars["e_tight"] =
+      MultiArray<GRBVar>::with_intervals(train_interval, num_t, num_edges);
 
   for (size_t i = 0; i < breakable_edges.size(); ++i) {
     const auto& e            = breakable_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     for (size_t vss = 0; vss < vss_number_e; ++vss) {
       for (size_t tr : instance.trains_on_edge(e, this->fix_routes)) {
         const auto& tr_name = instance.get_train_list().get_train(tr).name;
@@ -389,10 +394,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   }
 
   for (size_t e = 0; e < num_edges; ++e) {
-    const auto& edge      = instance.n().get_edge(e);
-    const auto& edge_name = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto& edge      = instance.const_n().get_edge(e);
+    const auto& edge_name =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     for (size_t tr : instance.trains_on_edge(e, this->fix_routes)) {
       const auto& tr_name = instance.get_train_list().get_train(tr).name;
       for (size_t t = train_interval[tr].first + 2;
@@ -422,7 +427,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::set_objective() {
   } else if (vss_model.get_model_type() == vss::ModelType::Continuous) {
     for (size_t i = 0; i < relevant_edges.size(); ++i) {
       const auto& e            = relevant_edges[i];
-      const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+      const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
       for (size_t vss = 0; vss < vss_number_e; ++vss) {
         objective_expr += vars["b_used"](i, vss);
       }
@@ -434,7 +439,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::set_objective() {
   } else if (vss_model.get_model_type() == vss::ModelType::InferredAlt) {
     for (size_t i = 0; i < relevant_edges.size(); ++i) {
       const auto& e            = relevant_edges[i];
-      const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+      const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
       for (size_t vss = 0; vss < vss_number_e; ++vss) {
         for (size_t sep_type = 0;
              sep_type < this->vss_model.get_separation_functions().size();
@@ -461,17 +466,17 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     const auto tr_on_section =
         instance.trains_in_section(no_border_vss_section);
     const auto no_border_vss_section_sorted =
-        instance.n().combine_reverse_edges(no_border_vss_section, true);
+        instance.const_n().combine_reverse_edges(no_border_vss_section, true);
     for (size_t i = 0; i < tr_on_section.size(); ++i) {
       const auto& tr1          = tr_on_section[i];
       const auto& tr1_interval = train_interval[tr1];
       const auto& tr1_name     = instance.get_train_list().get_train(tr1).name;
-      const auto& tr1_route    = instance.get_route(tr1_name);
+      const auto& tr1_route    = instance.get_route(tr1);
       for (size_t j = i + 1; j < tr_on_section.size(); ++j) {
         const auto& tr2          = tr_on_section[j];
         const auto& tr2_interval = train_interval[tr2];
         const auto& tr2_name  = instance.get_train_list().get_train(tr2).name;
-        const auto& tr2_route = instance.get_route(tr2_name);
+        const auto& tr2_route = instance.get_route(tr2);
         std::pair<size_t, size_t> const t_interval = {
             std::max(tr1_interval.first, tr2_interval.first),
             std::min(tr1_interval.second, tr2_interval.second)};
@@ -516,7 +521,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
               for (size_t e_overlap = std::min(e1, e2);
                    e_overlap < std::max(e1, e2); ++e_overlap) {
-                const auto& v_overlap = instance.n().common_vertex(
+                const auto& v_overlap = instance.const_n().common_vertex(
                     no_border_vss_section_sorted[e_overlap],
                     no_border_vss_section_sorted[e_overlap + 1]);
                 if (!v_overlap.has_value()) {
@@ -601,7 +606,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     for (auto const tr : tr_on_sec) {
       const auto& tr_interval = train_interval[tr];
       const auto& tr_name     = instance.get_train_list().get_train(tr).name;
-      const auto& tr_route    = instance.get_route(tr_name);
+      const auto& tr_route    = instance.get_route(tr);
       for (size_t t = tr_interval.first; t <= tr_interval.second; ++t) {
         GRBLinExpr lhs   = 0;
         int        count = 0;
@@ -624,7 +629,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
     for (size_t t = 0; t <= num_t; ++t) {
       const auto tr_to_consider =
-          instance.trains_at_t(static_cast<int>(t) * dt, tr_on_sec);
+          train_presence.trains_at_t(static_cast<int>(t) * dt, tr_on_sec);
       GRBLinExpr lhs = 0;
       for (auto const tr : tr_to_consider) {
         lhs += vars["x_sec"](tr, t, sec_index);
@@ -647,7 +652,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < train_list.size(); ++tr) {
     const auto  tr_name     = train_list.get_train(tr).name;
-    const auto& tr_schedule = instance.get_schedule(tr_name);
+    const auto& tr_schedule = instance.get_schedule(tr);
     const auto& tr_edges = instance.edges_used_by_train(tr, this->fix_routes);
     for (const auto& tr_stop : tr_schedule.get_stops()) {
       const auto t0 = static_cast<size_t>(tr_stop.arrival() / dt);
@@ -657,7 +662,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
                                    .get_station(tr_stop.get_station_name())
                                    .tracks;
       const auto inverse_stop_edges =
-          instance.n().inverse_edges(stop_edges, tr_edges);
+          instance.const_n().inverse_edges(stop_edges, tr_edges);
       for (size_t t = t0 - 1; t <= t1; ++t) {
         if (t >= t0) {
           model->addConstr(vars["v"](tr, t) == 0, "station_speed_" + tr_name +
@@ -721,7 +726,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * This method creates the variables corresponding to breaking distances.
    */
 
-  vars["brakelen"] = MultiArray<GRBVar>(num_tr, num_t);
+  vars["brakelen"] = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto  max_break_len = get_max_brakelen(tr);
     const auto& tr_name       = instance.get_train_list().get_train(tr).name;
@@ -797,9 +802,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     for (size_t i = 0; i < relevant_edges.size(); ++i) {
       const auto& e               = relevant_edges[i];
       const auto& e_index         = breakable_edge_indices[e];
-      const auto  vss_number_e    = instance.n().max_vss_on_edge(e);
-      const auto& e_len           = instance.n().get_edge(e).length;
-      const auto& min_block_len_e = instance.n().get_edge(e).min_block_length;
+      const auto  vss_number_e    = instance.const_n().max_vss_on_edge(e);
+      const auto& e_len           = instance.const_n().get_edge(e).length;
+      const auto& min_block_len_e =
+          instance.const_n().get_edge(e).min_block_length;
       for (size_t vss = 0; vss < vss_number_e; ++vss) {
         model->addConstr(e_len * vars["b_used"](i, vss), GRB_GREATER_EQUAL,
                          vars["b_pos"](e_index, vss),
@@ -827,13 +833,15 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       continue;
     }
     const auto vss_number_e =
-        instance.n().max_vss_on_edge(e_pair.first.value());
-    if (instance.n().max_vss_on_edge(e_pair.second.value()) != vss_number_e) {
+        instance.const_n().max_vss_on_edge(e_pair.first.value());
+    if (instance.const_n().max_vss_on_edge(e_pair.second.value()) !=
+        vss_number_e) {
       throw exceptions::ConsistencyException(
           "VSS number of edges " + std::to_string(e_pair.first.value()) +
           " and " + std::to_string(e_pair.second.value()) + " do not match");
     }
-    const auto& e_len = instance.n().get_edge(e_pair.first.value()).length;
+    const auto& e_len =
+        instance.const_n().get_edge(e_pair.first.value()).length;
     for (size_t vss = 0; vss < vss_number_e; ++vss) {
       model->addConstr(
           vars["b_pos"](breakable_edge_indices[e_pair.first.value()], vss) +
@@ -857,7 +865,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   for (size_t e_index = 0; e_index < breakable_edges.size(); ++e_index) {
     const auto& e = breakable_edges[e_index];
     for (const auto& tr : instance.trains_on_edge(e, this->fix_routes)) {
-      const auto vss_number_e = instance.n().max_vss_on_edge(e);
+      const auto vss_number_e = instance.const_n().max_vss_on_edge(e);
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
@@ -883,7 +891,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   // Correct number of borders
   for (size_t e_index = 0; e_index < breakable_edges.size(); ++e_index) {
     const auto& e            = breakable_edges[e_index];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
     const auto& tr_on_e      = instance.trains_on_edge(e, this->fix_routes);
     for (size_t t = 0; t < num_t; ++t) {
       // sum_(tr,vss) b_front(tr, t, e_index, vss) >= sum_(tr) x(tr, t, e) - 1
@@ -893,7 +901,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       GRBLinExpr rhs               = -1;
       bool       create_constraint = false;
       for (const auto& tr :
-           instance.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
+           train_presence.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
         create_constraint = true;
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
           lhs_front += vars["b_front"](tr, t, e_index, vss);
@@ -929,7 +937,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       GRBLinExpr lhs_rear  = 0;
       for (const auto& e : instance.edges_used_by_train(tr, this->fix_routes)) {
         const auto& e_index      = breakable_edge_indices[e];
-        const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+        const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
           lhs_front += vars["b_front"](tr, t, e_index, vss);
           if (instance.get_train_list().get_train(tr).tim) {
@@ -950,7 +958,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   for (size_t e_index = 0; e_index < breakable_edges.size(); ++e_index) {
     const auto& e            = breakable_edges[e_index];
     const auto  tr_on_e      = instance.trains_on_edge(e, this->fix_routes);
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
     for (size_t t = 0; t < num_t; ++t) {
       for (size_t vss = 0; vss < vss_number_e; ++vss) {
         // sum_tr b_front(tr, t, e_index, vss) = sum_tr b_rear(tr, t, e_index,
@@ -958,7 +966,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         GRBLinExpr lhs = 0;
         GRBLinExpr rhs = 0;
         for (const auto& tr :
-             instance.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
+             train_presence.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
           lhs += vars["b_front"](tr, t, e_index, vss);
           if (instance.get_train_list().get_train(tr).tim) {
             rhs += vars["b_rear"](tr, t, e_index, vss);
@@ -978,14 +986,15 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   for (size_t e_index = 0; e_index < breakable_edges.size(); ++e_index) {
     const auto& e = breakable_edges[e_index];
     for (const auto& tr : instance.trains_on_edge(e, this->fix_routes)) {
-      const auto vss_number_e = instance.n().max_vss_on_edge(e);
+      const auto vss_number_e = instance.const_n().max_vss_on_edge(e);
       // Get index of e in relevant_edges array
       const auto find_index =
           std::find(relevant_edges.begin(), relevant_edges.end(), e);
       auto e_index_relevant = find_index - relevant_edges.begin();
       // If edge not found check reverse edge
       if (find_index == relevant_edges.end()) {
-        const auto reverse_e = instance.n().get_reverse_edge_index(e).value();
+        const auto reverse_e =
+            instance.const_n().get_reverse_edge_index(e).value();
         const auto find_index_reverse =
             std::find(relevant_edges.begin(), relevant_edges.end(), reverse_e);
         if (find_index_reverse == relevant_edges.end()) {
@@ -1073,14 +1082,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   // At most one non-tim train can be on any breakable edge
   for (const auto& e : breakable_edges) {
     const auto  tr_on_e = instance.trains_on_edge(e, this->fix_routes);
-    const auto& edge    = instance.n().get_edge(e);
-    const auto& v0      = instance.n().get_vertex(edge.source);
-    const auto& v1      = instance.n().get_vertex(edge.target);
+    const auto& edge    = instance.const_n().get_edge(e);
+    const auto& v0      = instance.const_n().get_vertex(edge.source);
+    const auto& v1      = instance.const_n().get_vertex(edge.target);
     const auto  e_name  = "[" + v0.name + "," + v1.name + "]";
     for (size_t t = 0; t < num_t; ++t) {
       GRBLinExpr lhs = 0;
       for (const auto& tr :
-           instance.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
+           train_presence.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
         if (!instance.get_train_list().get_train(tr).tim) {
           lhs += vars["x"](tr, t, e);
         }
@@ -1096,13 +1105,13 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     create_non_discretized_fraction_constraints() {
   for (size_t i = 0; i < relevant_edges.size(); ++i) {
     const auto& e            = relevant_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     const auto& breakable_e_index = breakable_edge_indices.at(e);
-    const auto& e_len             = instance.n().get_edge(e).length;
+    const auto& e_len             = instance.const_n().get_edge(e).length;
 
     if (vss_model.get_model_type() == vss::ModelType::Inferred) {
       // sum edge_type(i,*) = 1
@@ -1195,13 +1204,13 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   for (size_t i = 0; i < relevant_edges.size(); ++i) {
     const auto& e            = relevant_edges[i];
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
-    const auto& edge         = instance.n().get_edge(e);
-    const auto& edge_name    = "[" + instance.n().get_vertex(edge.source).name +
-                            "," + instance.n().get_vertex(edge.target).name +
-                            "]";
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
+    const auto& edge         = instance.const_n().get_edge(e);
+    const auto& edge_name    =
+        "[" + instance.const_n().get_vertex(edge.source).name + "," +
+        instance.const_n().get_vertex(edge.target).name + "]";
     const auto& breakable_e_index = breakable_edge_indices.at(e);
-    const auto& e_len             = instance.n().get_edge(e).length;
+    const auto& e_len             = instance.const_n().get_edge(e).length;
 
     // Only choose one edge type and number per edge
     GRBLinExpr lhs_sum_edge_type = 0;
@@ -1287,7 +1296,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_speed = instance.get_train_list().get_train(tr).max_speed;
     for (const auto e : instance.edges_used_by_train(tr, this->fix_routes)) {
-      const auto& max_speed = instance.n().get_edge(e).max_speed;
+      const auto& max_speed = instance.const_n().get_edge(e).max_speed;
       if (max_speed < tr_speed) {
         for (size_t t = train_interval[tr].first;
              t <= train_interval[tr].second; ++t) {
@@ -1323,7 +1332,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
   // Connect y_sec and x
   for (size_t t = 0; t < num_t; ++t) {
-    const auto tr_at_t = instance.trains_at_t(static_cast<int>(t) * dt);
+    const auto& tr_at_t = trains_at_time_step.at(t);
     for (size_t i = 0; i < fwd_bwd_sections.size(); ++i) {
       // y_sec_fwd(t,i) >= x(tr, t, e) for all e in fwd_bwd_sections[i].first
       // and applicable trains y_sec_fwd(t,i) <= sum x(tr, t, e)
@@ -1396,7 +1405,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    */
   for (const auto& vss_section : no_border_vss_sections) {
     const auto vss_section_sorted =
-        instance.n().combine_reverse_edges(vss_section, true);
+        instance.const_n().combine_reverse_edges(vss_section, true);
     bool fwd_found = false;
     bool bwd_found = false;
     for (size_t i = 0;
@@ -1454,11 +1463,11 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   /**
    * General boundary conditions, i.e., speed
    */
-  auto train_list = instance.get_train_list();
+  const auto& train_list = instance.get_train_list();
   for (size_t i = 0; i < num_tr; ++i) {
     auto tr_name       = train_list.get_train(i).name;
-    auto initial_speed = instance.get_schedule(tr_name).get_v_0();
-    auto final_speed   = instance.get_schedule(tr_name).get_v_n();
+    auto initial_speed = instance.get_schedule(i).get_v_0();
+    auto final_speed   = instance.get_schedule(i).get_v_n();
     // initial_speed: v(train_interval[i].first) = initial_speed
     model->addConstr(vars["v"](i, train_interval[i].first) == initial_speed,
                      "initial_speed_" + tr_name);
@@ -1470,7 +1479,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
 
 void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     create_only_stop_at_vss_variables() {
-  vars["stopped"] = MultiArray<GRBVar>(num_tr, num_t);
+  vars["stopped"] = MultiArray<GRBVar>::with_intervals(train_interval, num_t);
 
   for (size_t tr = 0; tr < num_tr; ++tr) {
     const auto& tr_name = instance.get_train_list().get_train(tr).name;
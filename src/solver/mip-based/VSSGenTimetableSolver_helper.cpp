@@ -1,7 +1,9 @@
 #include "CustomExceptions.hpp"
 #include "solver/mip-based/VSSGenTimetableSolver.hpp"
 
+#include <chrono>
 #include <cmath>
+#include <optional>
 #include <plog/Log.h>
 #include <unordered_map>
 
@@ -18,8 +20,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::unbreakable_section_indices(
    */
 
   std::vector<size_t> indices;
-  const auto& tr_name  = instance.get_train_list().get_train(train_index).name;
-  const auto& tr_route = instance.get_route(tr_name).get_edges();
+  const auto& tr_route = instance.get_route(train_index).get_edges();
   for (size_t i = 0; i < unbreakable_sections.size(); ++i) {
     bool edge_found = false;
     // If unbreakable_section[i] (of type vector) and tr_route (of type vector)
@@ -56,9 +57,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::
   // Initialize struct
   TemporaryImpossibilityStruct s;
 
-  const auto& train_list  = instance.get_train_list();
-  const auto  tr_name     = train_list.get_train(tr).name;
-  const auto& tr_schedule = instance.get_schedule(tr_name);
+  const auto& tr_schedule = instance.get_schedule(tr);
 
   s.to_use   = true;
   s.t_before = train_interval[tr].first;
@@ -174,6 +173,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::cleanup() {
   unbreakable_sections.clear();
   no_border_vss_sections.clear();
   train_interval.clear();
+  train_presence = TrainIntervalIndex();
+  trains_at_time_step.clear();
   breakable_edges_pairs.clear();
   no_border_vss_vertices.clear();
   relevant_edges.clear();
@@ -184,6 +185,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::cleanup() {
   use_pwl                   = false;
   use_schedule_cuts         = false;
   export_option             = ExportOption::NoExport;
+  solution_format           = SolutionFormat::JSON;
   iterative_vss             = false;
   optimality_strategy       = OptimalityStrategy::Optimal;
   iterative_update_strategy = UpdateStrategy::Fixed;
@@ -197,10 +199,35 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::cleanup() {
   GeneralMIPSolver::cleanup();
 }
 
+std::vector<std::pair<size_t, size_t>>
+cda_rail::solver::mip_based::VSSGenTimetableSolver::train_time_intervals(
+    int end_offset) const {
+  /**
+   * Time index intervals of the trains, where the last index is moved by
+   * end_offset. Used for variables that exist for one time step more or less
+   * than the train itself, e.g., speeds.
+   *
+   * @param end_offset: offset of the last time index
+   * @return vector of intervals, empty intervals have first > second
+   */
+
+  std::vector<std::pair<size_t, size_t>> intervals;
+  intervals.reserve(train_interval.size());
+  for (const auto& [first, last] : train_interval) {
+    const auto new_last = static_cast<int>(last) + end_offset;
+    if (new_last < static_cast<int>(first)) {
+      intervals.emplace_back(1, 0);
+    } else {
+      intervals.emplace_back(first, static_cast<size_t>(new_last));
+    }
+  }
+  return intervals;
+}
+
 bool cda_rail::solver::mip_based::VSSGenTimetableSolver::update_vss(
     size_t relevant_edge_index, double obj_ub, GRBLinExpr& cut_expr) {
   const auto& e            = relevant_edges.at(relevant_edge_index);
-  const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+  const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
   const auto& current_vss_number_e =
       max_vss_per_edge_in_iteration.at(relevant_edge_index);
 
@@ -235,16 +262,18 @@ bool cda_rail::solver::mip_based::VSSGenTimetableSolver::update_vss(
 void cda_rail::solver::mip_based::VSSGenTimetableSolver::update_max_vss_on_edge(
     size_t relevant_edge_index, size_t new_max_vss, GRBLinExpr& cut_expr) {
   const auto& e            = relevant_edges.at(relevant_edge_index);
-  const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+  const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
   const auto  old_max_vss =
       max_vss_per_edge_in_iteration.at(relevant_edge_index);
   max_vss_per_edge_in_iteration[relevant_edge_index] = new_max_vss;
 
   IF_PLOG(plog::debug) {
-    const auto& u =
-        instance.n().get_vertex(instance.n().get_edge(e).source).name;
-    const auto& v =
-        instance.n().get_vertex(instance.n().get_edge(e).target).name;
+    const auto& u = instance.const_n()
+                        .get_vertex(instance.const_n().get_edge(e).source)
+                        .name;
+    const auto& v = instance.const_n()
+                        .get_vertex(instance.const_n().get_edge(e).target)
+                        .name;
     PLOGD << "Update possible VSS on edge " << u << " -> " << v << " from "
           << old_max_vss << " to " << new_max_vss;
   }
@@ -310,12 +339,12 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
     const cda_rail::solver::mip_based::ModelSettings&    model_settings,
     const cda_rail::solver::mip_based::SolverStrategy&   solver_strategy,
     const cda_rail::solver::mip_based::SolutionSettings& solution_settings,
-    int time_limit, bool debug_input) {
+    bool debug_input) {
   /**
    * This function initializes the variables affecting the model creation and
    * optimization process
    */
-  this->solve_init_vss_gen_timetable(time_limit, debug_input);
+  this->solve_init_vss_gen_timetable(debug_input);
 
   if (!model_settings.model_type.check_consistency()) {
     PLOGE << "Model type  and separation types/functions are not consistent.";
@@ -323,7 +352,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
         "Model type and separation types/functions are not consistent.");
   }
 
-  if (!instance.n().is_consistent_for_transformation()) {
+  if (!instance.const_n().is_consistent_for_transformation()) {
     PLOGE << "Instance is not consistent for transformation.";
     throw exceptions::ConsistencyException();
   }
@@ -344,6 +373,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
   this->iterative_include_cuts    = solver_strategy.include_cuts;
   this->postprocess               = solution_settings.postprocess;
   this->export_option             = solution_settings.export_option;
+  this->solution_format           = solution_settings.solution_format;
 
   if (this->iterative_vss) {
     // Iterative optimization strategy
@@ -386,32 +416,37 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
   }
 
   num_tr       = instance.get_train_list().size();
-  num_edges    = instance.n().number_of_edges();
-  num_vertices = instance.n().number_of_vertices();
+  num_edges    = instance.const_n().number_of_edges();
+  num_vertices = instance.const_n().number_of_vertices();
 
-  unbreakable_sections = instance.n().unbreakable_sections();
+  unbreakable_sections = instance.const_n().unbreakable_sections();
 
   if (this->vss_model.get_model_type() == vss::ModelType::Discrete) {
     // Sections of discretized graph
-    no_border_vss_sections = instance.n().no_border_vss_sections();
+    no_border_vss_sections = instance.const_n().no_border_vss_sections();
     num_breakable_sections = no_border_vss_sections.size();
     no_border_vss_vertices =
-        instance.n().get_vertices_by_type(VertexType::NoBorderVSS);
+        instance.const_n().get_vertices_by_type(VertexType::NoBorderVSS);
   } else {
     // Sections of non-discretized graph
-    breakable_edges = instance.n().breakable_edges();
+    breakable_edges = instance.const_n().breakable_edges();
     for (size_t i = 0; i < breakable_edges.size(); ++i) {
       breakable_edge_indices[breakable_edges[i]] = i;
     }
-    breakable_edges_pairs = instance.n().combine_reverse_edges(breakable_edges);
+    breakable_edges_pairs =
+        instance.const_n().combine_reverse_edges(breakable_edges);
     num_breakable_sections = breakable_edges.size();
-    relevant_edges         = instance.n().relevant_breakable_edges();
+    relevant_edges         = instance.const_n().relevant_breakable_edges();
   }
 
   for (size_t i = 0; i < num_tr; ++i) {
     train_interval.emplace_back(instance.time_index_interval(i, dt, false));
   }
 
+  // Trains present at every time step t * dt, t = 0, ..., num_t
+  train_presence      = instance.get_train_interval_index();
+  trains_at_time_step = train_presence.trains_at_time_steps(dt, num_t + 1);
+
   if (iterative_vss && vss_model.get_model_type() == vss::ModelType::Discrete) {
     PLOGE << "Iterative VSS not supported for discrete VSS model";
     throw exceptions::ConsistencyException(
@@ -421,7 +456,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
   max_vss_per_edge_in_iteration.resize(relevant_edges.size(), 0);
   for (size_t i = 0; i < relevant_edges.size(); ++i) {
     const auto& e            = relevant_edges.at(i);
-    const auto  vss_number_e = instance.n().max_vss_on_edge(e);
+    const auto  vss_number_e = instance.const_n().max_vss_on_edge(e);
     if (iterative_vss) {
       if (iterative_update_strategy == UpdateStrategy::Fixed) {
         max_vss_per_edge_in_iteration[i] = std::min(
@@ -451,27 +486,25 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::set_timeout(
     int time_limit) {
   PLOGI << "DONE creating model";
 
-  if (plog::get()->checkSeverity(plog::debug) || time_limit > 0) {
-    model_created = std::chrono::high_resolution_clock::now();
-    create_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      model_created - start)
-                      .count();
+  model_created = std::chrono::high_resolution_clock::now();
+  create_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    model_created - start)
+                    .count();
 
-    auto time_left = time_limit - create_time / 1000;
-    if (time_left < 0 && time_limit > 0) {
-      time_left = 1;
-    }
-    if (time_limit > 0) {
-      model->set(GRB_DoubleParam_TimeLimit, static_cast<double>(time_left));
-    }
-    PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
-          << " s";
-    if (time_limit > 0) {
-      PLOGD << "Time left: " << time_left << " s";
-    } else {
-      PLOGD << "Time left: "
-            << "No Limit";
-    }
+  auto time_left = time_limit - create_time / 1000;
+  if (time_left < 0 && time_limit > 0) {
+    time_left = 1;
+  }
+  if (time_limit > 0) {
+    model->set(GRB_DoubleParam_TimeLimit, static_cast<double>(time_left));
+  }
+  PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
+        << " s";
+  if (time_limit > 0) {
+    PLOGD << "Time left: " << time_left << " s";
+  } else {
+    PLOGD << "Time left: "
+          << "No Limit";
   }
 
   if ((this->include_braking_curves && !this->use_pwl)) {
@@ -502,6 +535,10 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
   std::vector<GRBConstr> iterative_cuts;
   this->iterative_include_cuts_tmp = this->iterative_include_cuts;
 
+  // Objective bounds of the iterative approach, only their rhs changes
+  std::optional<GRBConstr> obj_lb_constr;
+  std::optional<GRBConstr> obj_ub_constr;
+
   while (reoptimize) {
     reoptimize = false;
 
@@ -512,9 +549,20 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
     }
 
     // Optimize the (possibly restricted) model
+    const auto iteration_start = std::chrono::high_resolution_clock::now();
     this->model->optimize();
     iteration_number += 1;
 
+    if (iterative_vss) {
+      const auto iteration_time =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::high_resolution_clock::now() - iteration_start)
+              .count();
+      PLOGI << "Iteration " << iteration_number << " solved in "
+            << (static_cast<double>(iteration_time) / 1000.0) << " s with "
+            << model->get(GRB_IntAttr_SolCount) << " solution(s)";
+    }
+
     if (model->get(GRB_IntAttr_SolCount) >= 1) {
       // If there is a solution, then extract it and compare it with the current
       // best solution
@@ -572,6 +620,9 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
         break;
       }
 
+      // The incumbent stays feasible if more VSS are allowed
+      set_start_to_incumbent();
+
       GRBLinExpr cut_expr = 0;
       for (int i = 0; i < relevant_edges.size(); ++i) {
         if (update_vss(i, obj_ub, cut_expr)) {
@@ -584,20 +635,21 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
         break;
       }
 
-      model->addConstr(objective_expr, GRB_GREATER_EQUAL, obj_lb,
-                       "obj_lb_" + std::to_string(obj_lb) + "_" +
-                           std::to_string(iteration_number));
-      model->addConstr(objective_expr, GRB_LESS_EQUAL, obj_ub,
-                       "obj_ub_" + std::to_string(obj_ub) + "_" +
-                           std::to_string(iteration_number));
-      PLOGD << "Added constraint: obj >= " << obj_lb;
-      PLOGD << "Added constraint: obj <= " << obj_ub;
+      if (!obj_lb_constr.has_value()) {
+        obj_lb_constr = model->addConstr(objective_expr, GRB_GREATER_EQUAL,
+                                         obj_lb, "obj_lb");
+        obj_ub_constr = model->addConstr(objective_expr, GRB_LESS_EQUAL,
+                                         obj_ub, "obj_ub");
+      } else {
+        obj_lb_constr->set(GRB_DoubleAttr_RHS, obj_lb);
+        obj_ub_constr->set(GRB_DoubleAttr_RHS, obj_ub);
+      }
+      PLOGD << "Objective bounds: " << obj_lb << " <= obj <= " << obj_ub;
 
       if (this->iterative_include_cuts_tmp) {
         iterative_cuts.push_back(
             model->addConstr(cut_expr, GRB_GREATER_EQUAL, 1,
                              "cut_" + std::to_string(iteration_number)));
-        model->reset(1);
         PLOGD << "Added constraint: cut_expr >= 1";
       } else {
         PLOGD << "Remove " << iterative_cuts.size() << " cut constraints";
@@ -635,18 +687,32 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
     }
   }
 
+  // Best proven bound, for the iterative approach the one over all iterations
+  obj_bound = -1;
+  if (iterative_vss) {
+    obj_bound = obj_lb;
+  } else {
+    try {
+      obj_bound = model->get(GRB_DoubleAttr_ObjBound);
+    } catch (const GRBException& e) {
+      PLOGD << "No objective bound available: " << e.getMessage();
+    }
+  }
+
   // Extract solving times
-  IF_PLOG(plog::debug) {
-    model_solved = std::chrono::high_resolution_clock::now();
-    solve_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
-                     model_solved - model_created)
-                     .count();
-    PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
-          << " s";
-    PLOGD << "Model solved in " << (static_cast<double>(solve_time) / 1000.0)
-          << " s";
-    PLOGD << "Total time "
-          << (static_cast<double>(create_time + solve_time) / 1000.0) << " s";
+  model_solved = std::chrono::high_resolution_clock::now();
+  solve_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   model_solved - model_created)
+                   .count();
+  PLOGD << "Model created in " << (static_cast<double>(create_time) / 1000.0)
+        << " s";
+  PLOGD << "Model solved in " << (static_cast<double>(solve_time) / 1000.0)
+        << " s";
+  PLOGD << "Total time "
+        << (static_cast<double>(create_time + solve_time) / 1000.0) << " s";
+
+  if (sol_object.has_value()) {
+    sol_object->set_solution_format(solution_format);
   }
 
   return sol_object;
@@ -1353,6 +1353,525 @@ TEST(GenPOMovingBlockMIPSolver, StandardLazySimplified3) {
   }
 }
 
+TEST(GenPOMovingBlockMIPSolver, ParallelLazySeparation) {
+  const std::vector<std::string> paths{"SimpleStation", "SingleTrack",
+                                       "SimpleNetwork"};
+
+  for (const auto& p : paths) {
+    const std::string instance_path = "./example-networks/" + p + "/";
+    const auto        instance_before_parse =
+        cda_rail::instances::VSSGenerationTimetable(instance_path);
+    const auto instance =
+        cda_rail::instances::GeneralPerformanceOptimizationInstance::
+            cast_from_vss_generation(instance_before_parse);
+
+    for (const auto& simplify : {false, true}) {
+      for (const auto& deterministic : {false, true}) {
+        cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+        const auto sol = solver.solve(
+            {false, 5.55, cda_rail::VelocityRefinementStrategy::None,
+             simplify},
+            {true, false, false,
+             cda_rail::solver::mip_based::LazyConstraintSelectionStrategy::
+                 OnlyViolated,
+             cda_rail::solver::mip_based::LazyTrainSelectionStrategy::
+                 OnlyAdjacent,
+             10, 4, deterministic},
+            {}, 250);
+
+        EXPECT_TRUE(sol.has_solution())
+            << "No solution found for instance " << instance_path;
+        EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal)
+            << "Solution status is not optimal for instance " << instance_path;
+        EXPECT_EQ(sol.get_obj(), 0)
+            << "Objective value is not 0 for instance " << instance_path;
+
+        check_last_train_pos(instance_before_parse, sol, instance_path);
+      }
+    }
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, FractionalCuts) {
+  const std::vector<std::string> paths{"SimpleStation", "SingleTrack",
+                                       "SimpleNetwork"};
+
+  for (const auto& p : paths) {
+    const std::string instance_path = "./example-networks/" + p + "/";
+    const auto        instance_before_parse =
+        cda_rail::instances::VSSGenerationTimetable(instance_path);
+    const auto instance =
+        cda_rail::instances::GeneralPerformanceOptimizationInstance::
+            cast_from_vss_generation(instance_before_parse);
+
+    for (const auto& simplify : {false, true}) {
+      cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+      const auto sol = solver.solve(
+          {false, 5.55, cda_rail::VelocityRefinementStrategy::None, simplify},
+          {true, false, false,
+           cda_rail::solver::mip_based::LazyConstraintSelectionStrategy::
+               OnlyViolated,
+           cda_rail::solver::mip_based::LazyTrainSelectionStrategy::
+               OnlyAdjacent,
+           10, 1, true, false, 1, true, 5},
+          {}, 250);
+
+      EXPECT_TRUE(sol.has_solution())
+          << "No solution found for instance " << instance_path;
+      EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal)
+          << "Solution status is not optimal for instance " << instance_path;
+      EXPECT_EQ(sol.get_obj(), 0)
+          << "Objective value is not 0 for instance " << instance_path;
+
+      check_last_train_pos(instance_before_parse, sol, instance_path);
+    }
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, LazyConstraintPool) {
+  const std::string instance_path = "./example-networks/SimpleNetwork/";
+  const auto        instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+
+  const cda_rail::solver::mip_based::ModelDetail model_detail{
+      false, 5.55, cda_rail::VelocityRefinementStrategy::None};
+  cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy{
+      true,
+      false,
+      false,
+      cda_rail::solver::mip_based::LazyConstraintSelectionStrategy::
+          OnlyViolated,
+      cda_rail::solver::mip_based::LazyTrainSelectionStrategy::OnlyAdjacent,
+      10,
+      1,
+      true,
+      true,
+      1};
+
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+  EXPECT_TRUE(solver.get_lazy_constraint_pool().empty());
+
+  const auto sol1 = solver.solve(model_detail, solver_strategy, {}, 250);
+  EXPECT_EQ(sol1.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol1.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol1, instance_path);
+
+  const auto& pool = solver.get_lazy_constraint_pool();
+  EXPECT_FALSE(pool.get_fingerprint().empty());
+  const auto pool_size = pool.size();
+  for (const auto& [key, entry] : pool.get_entries()) {
+    EXPECT_FALSE(entry.terms.empty());
+    EXPECT_FALSE(entry.in_model);
+    EXPECT_EQ(entry.hits, pool.get_hits(key));
+  }
+
+  // Second solve starts with the constraints found before
+  const auto sol2 = solver.solve(model_detail, solver_strategy, {}, 250);
+  EXPECT_EQ(sol2.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol2.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol2, instance_path);
+  EXPECT_GE(solver.get_lazy_constraint_pool().size(), pool_size);
+
+  // Export and import into a new solver, add constraints as hard constraints
+  std::filesystem::remove_all("tmp_lazy_pool");
+  solver.export_lazy_constraint_pool("tmp_lazy_pool");
+  EXPECT_TRUE(
+      std::filesystem::exists("tmp_lazy_pool/lazy_constraint_pool.json"));
+
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver2(instance);
+  solver2.import_lazy_constraint_pool("tmp_lazy_pool");
+  const auto& pool2 = solver2.get_lazy_constraint_pool();
+  EXPECT_EQ(pool2.size(), solver.get_lazy_constraint_pool().size());
+  EXPECT_EQ(pool2.get_fingerprint(),
+            solver.get_lazy_constraint_pool().get_fingerprint());
+  EXPECT_EQ(pool2.total_hits(), solver.get_lazy_constraint_pool().total_hits());
+  for (const auto& [key, entry] : pool2.get_entries()) {
+    const auto& entry_before = solver.get_lazy_constraint_pool().get_entry(key);
+    EXPECT_EQ(entry.sense, entry_before.sense);
+    EXPECT_EQ(entry.terms.size(), entry_before.terms.size());
+  }
+
+  solver_strategy.lazy_constraint_pool_level = 0;
+  const auto sol3 = solver2.solve(model_detail, solver_strategy, {}, 250);
+  EXPECT_EQ(sol3.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol3.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol3, instance_path);
+
+  // Only constraints of trains with other time windows are dropped
+  auto       instance_perturbed = instance;
+  const auto t_n                = instance.get_schedule(0).get_t_n_range();
+  instance_perturbed.editable_schedule(0).set_t_n_range(
+      {t_n.first, t_n.second + 60});
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver3(
+      instance_perturbed);
+  solver3.import_lazy_constraint_pool("tmp_lazy_pool");
+  const auto sol4 = solver3.solve(model_detail, solver_strategy, {}, 250);
+  EXPECT_EQ(sol4.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol4.get_obj(), 0);
+  const auto  pool_exported =
+      cda_rail::solver::mip_based::LazyConstraintPool::import_pool(
+          "tmp_lazy_pool");
+  const auto& pool3 = solver3.get_lazy_constraint_pool();
+  EXPECT_EQ(pool3.get_fingerprint(), pool_exported.get_fingerprint());
+  const auto& signatures_before = pool_exported.get_train_signatures();
+  const auto& signatures_after  = pool3.get_train_signatures();
+  EXPECT_NE(signatures_after.at(0), signatures_before.at(0));
+  for (const auto& [key, entry] : pool_exported.get_entries()) {
+    if (signatures_after.at(key.at(1)) == signatures_before.at(key.at(1)) &&
+        signatures_after.at(key.at(2)) == signatures_before.at(key.at(2))) {
+      EXPECT_TRUE(pool3.contains(key));
+    }
+  }
+
+  solver2.clear_lazy_constraint_pool();
+  EXPECT_TRUE(solver2.get_lazy_constraint_pool().empty());
+
+  EXPECT_THROW(solver2.import_lazy_constraint_pool("tmp_lazy_pool_missing"),
+               cda_rail::exceptions::ImportException);
+
+  std::filesystem::remove_all("tmp_lazy_pool");
+}
+
+TEST(GenPOMovingBlockMIPSolver, RollingHorizon) {
+  const std::string instance_path = "./example-networks/SimpleNetwork/";
+  const auto        instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+
+  const cda_rail::solver::mip_based::ModelDetail model_detail{
+      false, 5.55, cda_rail::VelocityRefinementStrategy::None};
+
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+
+  const auto sol1 =
+      solver.solve_rolling_horizon(model_detail, {}, {}, {1, 0, 250, false});
+  EXPECT_TRUE(sol1.has_solution());
+  EXPECT_EQ(sol1.get_status(), cda_rail::SolutionStatus::Feasible);
+  EXPECT_GE(sol1.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol1, instance_path);
+
+  const auto sol2 =
+      solver.solve_rolling_horizon(model_detail, {}, {}, {2, 1, 250, false});
+  EXPECT_TRUE(sol2.has_solution());
+  EXPECT_EQ(sol2.get_status(), cda_rail::SolutionStatus::Feasible);
+  EXPECT_GE(sol2.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol2, instance_path);
+
+  const auto sol3 = solver.solve_rolling_horizon(model_detail, {}, {},
+                                                 {2, 1, 250, true}, 250);
+  EXPECT_TRUE(sol3.has_solution());
+  EXPECT_EQ(sol3.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol3.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol3, instance_path);
+
+  EXPECT_THROW(
+      solver.solve_rolling_horizon(model_detail, {}, {}, {0, 0, -1, false}),
+      cda_rail::exceptions::InvalidInputException);
+  EXPECT_THROW(
+      solver.solve_rolling_horizon(model_detail, {}, {}, {2, 2, -1, false}),
+      cda_rail::exceptions::InvalidInputException);
+}
+
+TEST(GenPOMovingBlockMIPSolver, SymmetryBreaking) {
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
+
+  const auto v0 = instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto v1 = instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  const auto v2 = instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+
+  instance.n().add_edge(v0, v1, 500, 20);
+  instance.n().add_edge(v1, v2, 500, 20);
+
+  instance.add_train("Train1", 100, 20, 1, 1, {0, 120}, 20, v0, {0, 600}, 20,
+                     v2);
+  instance.add_train("Train2", 100, 20, 1, 1, {0, 120}, 20, v0, {0, 600}, 20,
+                     v2);
+  instance.add_train("Train3", 100, 20, 1, 1, {0, 120}, 20, v0, {0, 600}, 20,
+                     v2);
+
+  cda_rail::solver::mip_based::ModelDetail model_detail;
+  model_detail.break_train_symmetries = true;
+
+  for (const bool use_lazy : {true, false}) {
+    cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy;
+    solver_strategy.use_lazy_constraints = use_lazy;
+
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+    const auto sol_without = solver.solve({}, solver_strategy, {}, 250);
+    const auto sol_with = solver.solve(model_detail, solver_strategy, {}, 250);
+
+    EXPECT_EQ(sol_without.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol_with.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol_with.get_obj(), sol_without.get_obj());
+
+    const auto t1 = sol_with.get_train_times("Train1").front();
+    const auto t2 = sol_with.get_train_times("Train2").front();
+    const auto t3 = sol_with.get_train_times("Train3").front();
+    EXPECT_LE(t1, t2 + cda_rail::GRB_EPS);
+    EXPECT_LE(t2, t3 + cda_rail::GRB_EPS);
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, TightenedTimingBounds) {
+  const std::vector<std::string> paths{"SimpleStation", "SingleTrack",
+                                       "SingleTrackWithStation"};
+
+  for (const auto& p : paths) {
+    const std::string instance_path = "./example-networks/" + p + "/";
+    const auto        instance_before_parse =
+        cda_rail::instances::VSSGenerationTimetable(instance_path);
+    const auto instance =
+        cda_rail::instances::GeneralPerformanceOptimizationInstance::
+            cast_from_vss_generation(instance_before_parse);
+
+    for (const bool use_lazy : {true, false}) {
+      for (const bool simplify : {false, true}) {
+        cda_rail::solver::mip_based::ModelDetail model_detail;
+        model_detail.simplify_headway_constraints = simplify;
+        model_detail.tighten_timing_bounds        = true;
+        cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy;
+        solver_strategy.use_lazy_constraints = use_lazy;
+
+        cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(
+            instance);
+        const auto sol =
+            solver.solve(model_detail, solver_strategy, {}, 250, true);
+
+        EXPECT_TRUE(sol.has_solution())
+            << "No solution found for instance " << instance_path;
+        EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal)
+            << "Solution status is not optimal for instance " << instance_path;
+        EXPECT_EQ(sol.get_obj(), 0)
+            << "Objective value is not 0 for instance " << instance_path;
+
+        check_last_train_pos(instance_before_parse, sol, instance_path);
+      }
+    }
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, ConstraintRowBuffer) {
+  GRBEnv env(true);
+  env.set(GRB_IntParam_OutputFlag, 0);
+  env.start();
+  GRBModel model(env);
+  const auto x = model.addVar(0, 10, 0, GRB_CONTINUOUS, "x");
+  const auto y = model.addVar(0, 10, 0, GRB_CONTINUOUS, "y");
+
+  cda_rail::solver::mip_based::ConstraintRowBuffer rows;
+  EXPECT_TRUE(rows.empty());
+  EXPECT_THROW(rows.add(x, 'X', y, "invalid"),
+               cda_rail::exceptions::InvalidInputException);
+
+  // x + 2 <= 2 * y + 5 is stored as x - 2 * y <= 3
+  rows.add(x + 2, GRB_LESS_EQUAL, 2 * y + 5, "row_1");
+  EXPECT_EQ(rows.size(), 1);
+  EXPECT_EQ(rows.get_sense(0), GRB_LESS_EQUAL);
+  EXPECT_DOUBLE_EQ(rows.get_rhs(0), 3);
+  EXPECT_DOUBLE_EQ(rows.get_expr(0).getConstant(), 0);
+  EXPECT_EQ(rows.get_name(0), "row_1");
+
+  cda_rail::solver::mip_based::ConstraintRowBuffer other;
+  other.add(x + y, GRB_EQUAL, 4, "row_2");
+  other.add(y, GRB_GREATER_EQUAL, 1, "row_3");
+  rows.append(std::move(other));
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(rows.size(), 3);
+  EXPECT_EQ(rows.get_name(1), "row_2");
+  EXPECT_EQ(rows.get_sense(1), GRB_EQUAL);
+  EXPECT_DOUBLE_EQ(rows.get_rhs(1), 4);
+  EXPECT_EQ(rows.get_name(2), "row_3");
+  EXPECT_EQ(rows.get_sense(2), GRB_GREATER_EQUAL);
+  EXPECT_DOUBLE_EQ(rows.get_rhs(2), 1);
+
+  EXPECT_EQ(rows.add_to_model(model), 3);
+  model.update();
+  EXPECT_EQ(model.get(GRB_IntAttr_NumConstrs), 3);
+  EXPECT_DOUBLE_EQ(model.getConstrByName("row_1").get(GRB_DoubleAttr_RHS), 3);
+  EXPECT_EQ(model.getConstrByName("row_2").get(GRB_CharAttr_Sense), GRB_EQUAL);
+}
+
+TEST(GenPOMovingBlockMIPSolver, ParallelModelCreation) {
+  const std::vector<std::string> paths{"SimpleStation", "SingleTrack",
+                                       "SingleTrackWithStation"};
+
+  for (const auto& p : paths) {
+    const std::string instance_path = "./example-networks/" + p + "/";
+    const auto        instance_before_parse =
+        cda_rail::instances::VSSGenerationTimetable(instance_path);
+    const auto instance =
+        cda_rail::instances::GeneralPerformanceOptimizationInstance::
+            cast_from_vss_generation(instance_before_parse);
+
+    for (const bool simplify : {false, true}) {
+      cda_rail::solver::mip_based::ModelDetail model_detail;
+      model_detail.simplify_headway_constraints = simplify;
+      cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy;
+      solver_strategy.use_lazy_constraints = false;
+
+      cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_seq(
+          instance);
+      const auto sol_seq =
+          solver_seq.solve(model_detail, solver_strategy, {}, 250);
+
+      for (const size_t threads : {0, 4}) {
+        solver_strategy.model_creation_threads = threads;
+        cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(
+            instance);
+        const auto sol = solver.solve(model_detail, solver_strategy, {}, 250);
+
+        EXPECT_TRUE(sol.has_solution())
+            << "No solution found for instance " << instance_path;
+        EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal)
+            << "Solution status is not optimal for instance " << instance_path;
+        EXPECT_EQ(sol.get_obj(), sol_seq.get_obj())
+            << "Objective value differs from sequential model creation for "
+               "instance "
+            << instance_path;
+
+        check_last_train_pos(instance_before_parse, sol, instance_path);
+      }
+    }
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, PersistentModel) {
+  const std::string instance_path =
+      "./example-networks/SingleTrackWithStation/";
+  const auto instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+
+  for (const bool use_lazy : {false, true}) {
+    cda_rail::solver::mip_based::ModelDetail model_detail;
+    cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy;
+    solver_strategy.use_lazy_constraints = use_lazy;
+    solver_strategy.abs_mip_gap          = 0;
+
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+    EXPECT_FALSE(solver.has_persistent_model());
+    EXPECT_THROW(static_cast<void>(solver.resolve()),
+                 cda_rail::exceptions::ModelCreationException);
+    EXPECT_THROW(solver.update_train_weight(0, 2),
+                 cda_rail::exceptions::ModelCreationException);
+
+    solver_strategy.keep_model = true;
+    const auto sol_initial =
+        solver.solve(model_detail, solver_strategy, {}, 250);
+    EXPECT_TRUE(solver.has_persistent_model());
+    EXPECT_EQ(sol_initial.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol_initial.get_obj(), 0);
+
+    // Unchanged model yields the same solution
+    const auto sol_same = solver.resolve(250);
+    EXPECT_EQ(sol_same.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol_same.get_obj(), 0);
+    check_last_train_pos(instance_before_parse, sol_same, instance_path);
+
+    // Earlier exit and higher weight of the first train
+    const size_t tr       = 0;
+    const auto   tr_name  = instance.get_train_list().get_train(tr).name;
+    const auto   t_n      = instance.get_schedule(tr).get_t_n_range();
+    const auto   t_n_new  = std::make_pair(std::max(0, t_n.first - 60),
+                                           t_n.second);
+    auto         expected = instance;
+    expected.editable_schedule(tr).set_t_n_range(t_n_new);
+    expected.set_train_weight(tr, 2);
+
+    EXPECT_THROW(solver.update_exit_time_window(
+                     tr_name, std::make_pair(t_n.first, t_n.second + 1)),
+                 cda_rail::exceptions::InvalidInputException);
+    EXPECT_THROW(solver.update_variable_bounds("not_a_variable", 0, 1),
+                 cda_rail::exceptions::InvalidInputException);
+    solver.update_exit_time_window(tr_name, t_n_new);
+    solver.update_train_weight(tr_name, 2);
+    const auto sol_updated = solver.resolve(250);
+
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_expected(
+        expected);
+    solver_strategy.keep_model = false;
+    const auto sol_expected =
+        solver_expected.solve(model_detail, solver_strategy, {}, 250);
+
+    EXPECT_EQ(sol_updated.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol_expected.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_NEAR(sol_updated.get_obj(), sol_expected.get_obj(), 1e-4);
+    EXPECT_EQ(sol_updated.get_instance().get_schedule(tr).get_t_n_range(),
+              t_n_new);
+    EXPECT_EQ(sol_updated.get_instance().get_train_weights().at(tr), 2);
+
+    solver.release_model();
+    EXPECT_FALSE(solver.has_persistent_model());
+    EXPECT_EQ(solver.get_instance().get_schedule(tr).get_t_n_range(),
+              t_n_new);
+    EXPECT_EQ(solver.get_instance().get_schedule(tr).get_stops().size(),
+              instance.get_schedule(tr).get_stops().size());
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, PersistentModelSymmetryBreaking) {
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
+
+  const auto v0 = instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto v1 = instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  const auto v2 = instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+
+  instance.n().add_edge(v0, v1, 500, 20);
+  instance.n().add_edge(v1, v2, 500, 20);
+
+  instance.add_train("Train1", 100, 20, 1, 1, {0, 120}, 20, v0, {0, 600}, 20,
+                     v2);
+  instance.add_train("Train2", 100, 20, 1, 1, {0, 120}, 20, v0, {0, 600}, 20,
+                     v2);
+  instance.add_train("Train3", 100, 20, 1, 1, {0, 120}, 20, v0, {0, 600}, 20,
+                     v2);
+
+  cda_rail::solver::mip_based::ModelDetail model_detail;
+  model_detail.break_train_symmetries = true;
+
+  for (const bool use_lazy : {false, true}) {
+    cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy;
+    solver_strategy.use_lazy_constraints = use_lazy;
+    solver_strategy.keep_model           = true;
+
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+    const auto sol_initial =
+        solver.solve(model_detail, solver_strategy, {}, 250);
+    EXPECT_EQ(sol_initial.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_TRUE(solver.has_persistent_model());
+
+    // Train1 has to enter after Train2, which contradicts the symmetry
+    // breaking constraints of the kept model unless they are removed
+    solver.update_entry_time_window("Train1", std::make_pair(100, 120));
+    solver.update_variable_bounds("t_front_arrival_Train2_v0", 0, 10);
+    const auto sol_updated = solver.resolve(250);
+
+    auto expected = instance;
+    expected.editable_schedule("Train1").set_t_0_range({100, 120});
+    expected.editable_schedule("Train2").set_t_0_range({0, 10});
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_expected(
+        expected);
+    solver_strategy.keep_model = false;
+    const auto sol_expected =
+        solver_expected.solve(model_detail, solver_strategy, {}, 250);
+
+    EXPECT_EQ(sol_updated.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol_expected.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_NEAR(sol_updated.get_obj(), sol_expected.get_obj(), 1e-4);
+    EXPECT_GE(sol_updated.get_train_times("Train1").front(),
+              100 - cda_rail::GRB_EPS);
+    EXPECT_LE(sol_updated.get_train_times("Train2").front(),
+              10 + cda_rail::GRB_EPS);
+  }
+}
+
 TEST(GenPOMovingBlockMIPSolver, SimpleStationExportOptions) {
   const std::string instance_path = "./example-networks/SimpleStation/";
   const auto        instance_before_parse =
@@ -1604,4 +2123,58 @@ TEST(GenPOMovingBlockMIPSolver, SimpleStationExportOptions) {
   std::filesystem::remove("model.json");
 }
 
+TEST(GenPOMovingBlockMIPSolver, TimetableCheck) {
+  const std::string instance_path =
+      "./example-networks/SingleTrackWithStation/";
+  const auto instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+  EXPECT_TRUE(instance.check_timetable_conflicts(false).empty());
+
+  cda_rail::solver::mip_based::SolverStrategyMovingBlock solver_strategy;
+  solver_strategy.check_timetable_conflicts = true;
+
+  // Without conflicts, the full instance is solved as usual
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+  const auto sol = solver.solve({}, solver_strategy, {}, 250);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol.get_obj(), 0);
+
+  // The first train cannot leave right after entering
+  const size_t tr      = 0;
+  const auto   tr_name = instance.get_train_list().get_train(tr).name;
+  const auto   t_exit  = instance.get_schedule(tr).get_t_0_range().second + 1;
+
+  auto instance_late = instance;
+  instance_late.editable_schedule(tr).set_t_n_range({t_exit, t_exit});
+  const auto conflicts = instance_late.check_timetable_conflicts(false);
+  ASSERT_FALSE(conflicts.empty());
+  EXPECT_EQ(conflicts.front().type,
+            cda_rail::instances::TimetableConflictType::RunningTime);
+  EXPECT_EQ(conflicts.front().trains, std::vector<size_t>({tr}));
+
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_late(
+      instance_late);
+  const auto sol_late = solver_late.solve({}, solver_strategy, {}, 250);
+  EXPECT_EQ(sol_late.get_status(), cda_rail::SolutionStatus::Infeasible);
+  EXPECT_FALSE(sol_late.has_solution());
+
+  // An optional train is not scheduled instead
+  instance_late.set_train_optionality_value(tr, true);
+  solver_strategy.drop_conflicting_optional_trains = true;
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_optional(
+      instance_late);
+  const auto sol_optional =
+      solver_optional.solve({}, solver_strategy, {}, 250);
+  EXPECT_EQ(sol_optional.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_TRUE(sol_optional.has_solution());
+  EXPECT_FALSE(sol_optional.get_train_routed(tr_name));
+  for (size_t tr_other = 1; tr_other < instance.get_train_list().size();
+       tr_other++) {
+    EXPECT_TRUE(sol_optional.get_train_routed(tr_other));
+  }
+}
+
 // NOLINTEND (clang-analyzer-deadcode.DeadStores)
@@ -3,9 +3,14 @@
 #include "EOMHelper.hpp"
 #include "datastructure/GeneralTimetable.hpp"
 #include "datastructure/Route.hpp"
+#include "datastructure/TrainTrajectory.hpp"
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 
 #include "gtest/gtest.h"
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
 #include <tuple>
 #include <utility>
 
@@ -774,6 +779,100 @@ TEST(GeneralPerformanceOptimizationInstances,
   EXPECT_FALSE(sol2_read.get_instance().has_route("tr2"));
 }
 
+TEST(GeneralPerformanceOptimizationInstances,
+     SolGeneralPerformanceOptimizationInstanceBinaryExportImport) {
+  instances::GeneralPerformanceOptimizationInstance instance;
+  instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+  instance.n().add_edge("v0", "v1", 100, 10);
+  instance.n().add_edge("v1", "v2", 200, 20);
+  instance.n().add_successor({"v0", "v1"}, {"v1", "v2"});
+  instance.add_train("tr1", 50, 10, 2, 2, {0, 60}, 0, "v0", {120, 180}, 5,
+                     "v2");
+  instance.add_train("tr2", 50, 10, 2, 2, {120, 180}, 0, "v0", {210, 270}, 0,
+                     "v2");
+
+  instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+      sol_instance(instance);
+  sol_instance.set_obj(0.5);
+  sol_instance.set_status(cda_rail::SolutionStatus::Optimal);
+  sol_instance.set_solution_format(cda_rail::SolutionFormat::Binary);
+
+  sol_instance.add_empty_route("tr1");
+  sol_instance.push_back_edge_to_route("tr1", "v0", "v1");
+  sol_instance.push_back_edge_to_route("tr1", "v1", "v2");
+  sol_instance.set_train_routed("tr1");
+  sol_instance.add_train_pos("tr1", 0, 0);
+  sol_instance.add_train_speed("tr1", 0, 0);
+  sol_instance.add_train_pos("tr1", 30.5, 12.25);
+  sol_instance.add_train_speed("tr1", 30.5, 1.0 / 3);
+  sol_instance.add_train_pos("tr1", 60, 100);
+  sol_instance.add_train_speed("tr1", 60, 5);
+  sol_instance.add_train_pos("tr1", 90, 250);
+  EXPECT_TRUE(sol_instance.check_consistency());
+
+  sol_instance.export_solution("./tmp/test-sol-instance-binary", false);
+  EXPECT_TRUE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/trajectories.bin"));
+  EXPECT_FALSE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/train_pos.json"));
+  const auto sol_read =
+      cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>::
+          import_solution("./tmp/test-sol-instance-binary", instance);
+
+  // Exporting JSON to the same path replaces the binary trajectories
+  auto sol_json = sol_instance;
+  sol_json.set_solution_format(cda_rail::SolutionFormat::JSON);
+  sol_json.export_solution("./tmp/test-sol-instance-binary", false);
+  EXPECT_FALSE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/trajectories.bin"));
+  const auto sol_json_read =
+      cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>::
+          import_solution("./tmp/test-sol-instance-binary", instance);
+  EXPECT_EQ(sol_json_read.get_solution_format(),
+            cda_rail::SolutionFormat::JSON);
+  EXPECT_EQ(sol_json_read.get_train_pos("tr1", 30.5), 12.25);
+  EXPECT_EQ(sol_json_read.get_train_pos("tr1", 90), 250);
+
+  // And vice versa
+  sol_instance.export_solution("./tmp/test-sol-instance-binary", false);
+  EXPECT_FALSE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/train_pos.json"));
+  EXPECT_FALSE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/train_routed.json"));
+  EXPECT_EQ(cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+                instances::GeneralPerformanceOptimizationInstance>::
+                import_solution("./tmp/test-sol-instance-binary", instance)
+                    .get_solution_format(),
+            cda_rail::SolutionFormat::Binary);
+  std::filesystem::remove_all("./tmp");
+
+  EXPECT_TRUE(sol_read.check_consistency());
+  EXPECT_EQ(sol_read.get_solution_format(), cda_rail::SolutionFormat::Binary);
+  EXPECT_EQ(sol_read.get_obj(), 0.5);
+  EXPECT_EQ(sol_read.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_TRUE(sol_read.get_train_routed("tr1"));
+  EXPECT_FALSE(sol_read.get_train_routed("tr2"));
+  EXPECT_TRUE(sol_read.get_instance().has_route("tr1"));
+  EXPECT_EQ(sol_read.get_instance().get_route("tr1").size(), 2);
+
+  const auto& trajectory      = sol_instance.get_train_trajectory("tr1");
+  const auto& trajectory_read = sol_read.get_train_trajectory("tr1");
+  EXPECT_EQ(trajectory_read.get_times(), trajectory.get_times());
+  EXPECT_EQ(trajectory_read.number_of_positions(), 4);
+  EXPECT_EQ(trajectory_read.number_of_speeds(), 3);
+  EXPECT_EQ(sol_read.get_train_pos("tr1", 30.5), 12.25);
+  EXPECT_EQ(sol_read.get_train_speed("tr1", 30.5), 1.0 / 3);
+  EXPECT_EQ(sol_read.get_train_pos("tr1", 90), 250);
+  EXPECT_THROW((void)sol_read.get_train_speed("tr1", 90),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_TRUE(sol_read.get_train_trajectory("tr2").empty());
+}
+
 TEST(GeneralPerformanceOptimizationInstances, DiscretizationOfStops1) {
   // Create instance members
   Network network("./example-networks/SimpleStation/network/");
@@ -1453,4 +1552,491 @@ TEST(GeneralPerformanceOptimizationInstances, LeavingTimes) {
   EXPECT_APPROX_EQ(instance.get_minimal_leaving_time(tr4, 5), 7.25);
 }
 
+TEST(GeneralPerformanceOptimizationInstances, InterchangeableTrains) {
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
+
+  const auto v0 = instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto v1 = instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  const auto v2 = instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+
+  const auto e01 = instance.n().add_edge(v0, v1, 1000, 20);
+  const auto e12 = instance.n().add_edge(v1, v2, 1000, 20);
+  instance.n().add_successor(e01, e12);
+
+  const auto tr1 = instance.add_train("Train1", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2);
+  const auto tr2 = instance.add_train("Train2", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2);
+  // Different length
+  const auto tr3 = instance.add_train("Train3", 120, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2);
+  const auto tr4 = instance.add_train("Train4", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2);
+  // Different weight
+  const auto tr5 = instance.add_train("Train5", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2, 2);
+  // Different exit time window
+  const auto tr6 = instance.add_train("Train6", 120, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 400}, 10, v2);
+  const auto tr7 = instance.add_train("Train7", 120, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2);
+
+  EXPECT_TRUE(instance.are_trains_interchangeable(tr1, tr2));
+  EXPECT_TRUE(instance.are_trains_interchangeable(tr2, tr4));
+  EXPECT_TRUE(instance.are_trains_interchangeable(tr3, tr7));
+  EXPECT_FALSE(instance.are_trains_interchangeable(tr1, tr3));
+  EXPECT_FALSE(instance.are_trains_interchangeable(tr1, tr5));
+  EXPECT_FALSE(instance.are_trains_interchangeable(tr3, tr6));
+
+  const auto classes = instance.get_interchangeable_train_classes();
+  ASSERT_EQ(classes.size(), 2);
+  EXPECT_EQ(classes.at(0), std::vector<size_t>({tr1, tr2, tr4}));
+  EXPECT_EQ(classes.at(1), std::vector<size_t>({tr3, tr7}));
+
+  // Different routes
+  instance.add_empty_route("Train1");
+  instance.push_back_edge_to_route("Train1", e01);
+  instance.push_back_edge_to_route("Train1", e12);
+  EXPECT_FALSE(instance.are_trains_interchangeable(tr1, tr2));
+  instance.add_empty_route("Train2");
+  instance.push_back_edge_to_route("Train2", e01);
+  instance.push_back_edge_to_route("Train2", e12);
+  EXPECT_TRUE(instance.are_trains_interchangeable(tr1, tr2));
+
+  // Different optionality
+  instance.set_train_optional(tr2);
+  EXPECT_FALSE(instance.are_trains_interchangeable(tr1, tr2));
+  EXPECT_EQ(instance.get_interchangeable_train_classes().size(), 1);
+}
+
+TEST(GeneralPerformanceOptimizationInstances, TrainUsageIndex) {
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
+
+  const auto v0 = instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto v1 = instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  const auto v2 = instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+  const auto v3 = instance.n().add_vertex("v3", cda_rail::VertexType::TTD);
+
+  const auto e01 = instance.n().add_edge(v0, v1, 1000, 20);
+  const auto e12 = instance.n().add_edge(v1, v2, 1000, 20);
+  const auto e13 = instance.n().add_edge(v1, v3, 1000, 20);
+  instance.n().add_successor(e01, e12);
+  instance.n().add_successor(e01, e13);
+
+  const auto tr1 = instance.add_train("Train1", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v2);
+  const auto tr2 = instance.add_train("Train2", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v3);
+  const auto tr3 = instance.add_train("Train3", 100, 50, 1, 2, {0, 60}, 20, v0,
+                                      {300, 360}, 10, v3);
+
+  instance.add_empty_route("Train1");
+  instance.push_back_edge_to_route("Train1", e01);
+  instance.push_back_edge_to_route("Train1", e12);
+  instance.add_empty_route("Train2");
+  instance.push_back_edge_to_route("Train2", e01);
+  instance.push_back_edge_to_route("Train2", e13);
+  // Train3 has no route, hence, it might use every edge
+
+  const std::vector<std::vector<size_t>> sections = {{e01}, {e12}, {e13}};
+
+  const auto index = instance.get_train_usage_index(sections, true, false);
+  EXPECT_EQ(index.number_of_trains(), 3);
+  EXPECT_EQ(index.number_of_edges(), 3);
+  EXPECT_EQ(index.number_of_sections(), 3);
+
+  EXPECT_TRUE(index.uses_edge(tr1, e01));
+  EXPECT_TRUE(index.uses_edge(tr1, e12));
+  EXPECT_FALSE(index.uses_edge(tr1, e13));
+  EXPECT_FALSE(index.uses_edge(tr2, e12));
+  EXPECT_TRUE(index.uses_edge(tr3, e12));
+  EXPECT_TRUE(index.uses_section(tr2, 2));
+  EXPECT_FALSE(index.uses_section(tr2, 1));
+
+  EXPECT_EQ(index.trains_on_edge(e01), std::vector<size_t>({tr1, tr2, tr3}));
+  EXPECT_EQ(index.trains_on_edge(e12), std::vector<size_t>({tr1, tr3}));
+  EXPECT_EQ(index.trains_on_edge(e13), std::vector<size_t>({tr2, tr3}));
+  EXPECT_EQ(index.trains_on_edges({e13, e12}),
+            std::vector<size_t>({tr1, tr2, tr3}));
+  EXPECT_EQ(index.sections_used_by_train(tr1), std::vector<size_t>({0, 1}));
+
+  // Results coincide with the corresponding instance queries
+  for (size_t tr = 0; tr < 3; tr++) {
+    EXPECT_EQ(index.edges_used_by_train(tr),
+              instance.edges_used_by_train(tr, true, false));
+    EXPECT_EQ(index.vertices_used_by_train(tr),
+              instance.vertices_used_by_train(tr, true, false));
+    EXPECT_EQ(index.sections_used_by_train(tr),
+              instance.sections_used_by_train(tr, sections, true, false));
+  }
+  for (size_t s = 0; s < sections.size(); s++) {
+    EXPECT_EQ(index.trains_in_section(s),
+              instance.trains_in_section(sections.at(s), true, false));
+  }
+  for (const auto e : {e01, e12, e13}) {
+    EXPECT_EQ(index.trains_on_edge(e),
+              instance.trains_on_edge_mixed_routing(e, true, false));
+  }
+
+  // Without fixed routes every train uses everything
+  const auto index_free = instance.get_train_usage_index(sections, false);
+  EXPECT_EQ(index_free.trains_on_edge(e12),
+            std::vector<size_t>({tr1, tr2, tr3}));
+  EXPECT_EQ(index_free.sections_used_by_train(tr1),
+            std::vector<size_t>({0, 1, 2}));
+
+  EXPECT_THROW((void)index.uses_edge(3, e01),
+               cda_rail::exceptions::TrainNotExistentException);
+  EXPECT_THROW((void)index.trains_on_edge(3),
+               cda_rail::exceptions::EdgeNotExistentException);
+  EXPECT_THROW((void)index.trains_in_section(3),
+               cda_rail::exceptions::InvalidInputException);
+  EXPECT_THROW((void)instance.get_train_usage_index(sections, true, true),
+               cda_rail::exceptions::ConsistencyException);
+}
+
+TEST(GeneralPerformanceOptimizationInstances, TrainTrajectory) {
+  cda_rail::TrainTrajectoryBuilder builder;
+  builder.add(30, 200, 5);
+  builder.add(0, 0, 10);
+  builder.add(10, 100, 10);
+  builder.add(10, 90, 8);
+  builder.add(20, 150, 6);
+
+  const auto trajectory = builder.build();
+  EXPECT_EQ(trajectory.size(), 4);
+  EXPECT_TRUE(trajectory.is_complete());
+  EXPECT_EQ(trajectory.get_times(), std::vector<double>({0, 10, 20, 30}));
+  EXPECT_EQ(trajectory.get_positions(),
+            std::vector<double>({0, 90, 150, 200}));
+  EXPECT_EQ(trajectory.get_speeds(), std::vector<double>({10, 8, 6, 5}));
+
+  EXPECT_EQ(trajectory.find_time(20), std::optional<size_t>(2));
+  EXPECT_FALSE(trajectory.find_time(15).has_value());
+  EXPECT_EQ(trajectory.get_bracket(15),
+            std::make_optional(std::make_pair<size_t, size_t>(1, 2)));
+  EXPECT_EQ(trajectory.get_bracket(10),
+            std::make_optional(std::make_pair<size_t, size_t>(1, 1)));
+  EXPECT_FALSE(trajectory.get_bracket(-1).has_value());
+  EXPECT_FALSE(trajectory.get_bracket(31).has_value());
+  EXPECT_TRUE(trajectory.has_non_decreasing_positions());
+  EXPECT_EQ(trajectory.find_pos(150), std::optional<size_t>(2));
+  EXPECT_EQ(trajectory.find_pos(90), std::optional<size_t>(1));
+  EXPECT_FALSE(trajectory.find_pos(100).has_value());
+  EXPECT_THROW((void)trajectory.get_time(4),
+               cda_rail::exceptions::InvalidInputException);
+
+  cda_rail::TrainTrajectory partial;
+  partial.set_pos(10, 100);
+  partial.set_speed(0, 10);
+  partial.set_pos(0, 0);
+  EXPECT_EQ(partial.get_times(), std::vector<double>({0, 10}));
+  EXPECT_EQ(partial.number_of_positions(), 2);
+  EXPECT_EQ(partial.number_of_speeds(), 1);
+  EXPECT_FALSE(partial.is_complete());
+  EXPECT_FALSE(partial.has_speed(1));
+  EXPECT_THROW((void)partial.get_speed(1),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_EQ(partial.get_times_with_speed(), std::vector<double>({0}));
+
+  // Positions that are not non-decreasing are searched linearly
+  cda_rail::TrainTrajectory unordered;
+  unordered.set_pos(0, 0);
+  unordered.set_pos(10, 100);
+  unordered.set_pos(20, 50);
+  EXPECT_FALSE(unordered.has_non_decreasing_positions());
+  EXPECT_EQ(unordered.find_pos(50), std::optional<size_t>(2));
+  EXPECT_EQ(unordered.find_pos(100), std::optional<size_t>(1));
+
+  instances::GeneralPerformanceOptimizationInstance instance;
+  instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+  instance.n().add_edge("v0", "v1", 100, 10);
+  instance.n().add_edge("v1", "v2", 200, 20);
+  instance.n().add_successor({"v0", "v1"}, {"v1", "v2"});
+  instance.add_train("tr1", 50, 10, 2, 2, {0, 60}, 10, "v0", {120, 180}, 5,
+                     "v2");
+
+  instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+      sol_instance(instance);
+  sol_instance.set_obj(0);
+  sol_instance.set_status(cda_rail::SolutionStatus::Optimal);
+  sol_instance.set_solution_found();
+  sol_instance.add_empty_route("tr1");
+  sol_instance.push_back_edge_to_route("tr1", "v0", "v1");
+  sol_instance.push_back_edge_to_route("tr1", "v1", "v2");
+  sol_instance.set_train_routed("tr1");
+  sol_instance.set_train_trajectory("tr1", trajectory);
+
+  EXPECT_TRUE(sol_instance.check_consistency());
+  EXPECT_EQ(sol_instance.get_train_times("tr1"),
+            std::vector<double>({0, 10, 20, 30}));
+  EXPECT_EQ(sol_instance.get_train_pos("tr1", 20), 150);
+  EXPECT_EQ(sol_instance.get_train_speed("tr1", 30), 5);
+  EXPECT_THROW((void)sol_instance.get_train_pos("tr1", 15),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_EQ(sol_instance.get_time_at_pos("tr1", 150), 20);
+  EXPECT_THROW((void)sol_instance.get_time_at_pos("tr1", 100),
+               cda_rail::exceptions::ConsistencyException);
+
+  const auto [edge, t0, t1] = sol_instance.get_edge_and_time_bounds("tr1", 15);
+  EXPECT_EQ(edge, instance.const_n().get_edge_index("v0", "v1"));
+  EXPECT_EQ(t0, 10);
+  EXPECT_EQ(t1, 20);
+
+  // Positions without speed are inconsistent
+  sol_instance.add_train_pos("tr1", 40, 250);
+  EXPECT_FALSE(sol_instance.check_consistency());
+  sol_instance.add_train_speed("tr1", 40, 5);
+  EXPECT_TRUE(sol_instance.check_consistency());
+  EXPECT_EQ(sol_instance.get_train_trajectory("tr1").size(), 5);
+}
+
+TEST(GeneralPerformanceOptimizationInstances, SharedNetwork) {
+  instances::GeneralPerformanceOptimizationInstance instance;
+  instance.n().add_vertex("v0", VertexType::TTD);
+  instance.n().add_vertex("v1", VertexType::TTD);
+  instance.n().add_edge("v0", "v1", 100, 10, false);
+  instance.add_train("tr1", 50, 10, 1, 1, {0, 60}, 0, "v0", {360, 420}, 0,
+                     "v1");
+
+  // Copies and solutions share the network
+  const auto instance_copy = instance;
+  EXPECT_EQ(instance_copy.get_network_ptr(), instance.get_network_ptr());
+  const instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+      sol_instance(instance);
+  EXPECT_EQ(sol_instance.get_instance().get_network_ptr(),
+            instance.get_network_ptr());
+
+  // Modifying a copy does not change the others
+  auto instance_modified = instance;
+  instance_modified.n().add_vertex("v2", VertexType::TTD);
+  EXPECT_NE(instance_modified.get_network_ptr(), instance.get_network_ptr());
+  EXPECT_EQ(instance_modified.const_n().number_of_vertices(), 3);
+  EXPECT_EQ(instance.const_n().number_of_vertices(), 2);
+  EXPECT_EQ(instance_copy.const_n().number_of_vertices(), 2);
+  EXPECT_EQ(sol_instance.get_instance().const_n().number_of_vertices(), 2);
+
+  // A network that is not shared is modified in place
+  const auto* network_ptr = instance_modified.get_network_ptr().get();
+  instance_modified.n().add_vertex("v3", VertexType::TTD);
+  EXPECT_EQ(instance_modified.get_network_ptr().get(), network_ptr);
+  EXPECT_EQ(instance_modified.const_n().number_of_vertices(), 4);
+}
+
+TEST(GeneralPerformanceOptimizationInstances, AsyncImport) {
+  instances::GeneralPerformanceOptimizationInstance instance;
+  instance.n().add_vertex("v0", VertexType::TTD);
+  instance.n().add_vertex("v1", VertexType::TTD);
+  instance.n().add_vertex("v2", VertexType::TTD);
+  instance.n().add_edge("v0", "v1", 100, 10, false);
+  instance.n().add_edge("v1", "v2", 200, 10, false);
+  instance.n().add_successor({"v0", "v1"}, {"v1", "v2"});
+  instance.add_train("tr1", 50, 10, 1, 1, {0, 60}, 0, "v0", {360, 420}, 0,
+                     "v2", 2, true);
+  instance.add_train("tr2", 50, 10, 1, 1, {60, 120}, 0, "v0", {400, 460}, 0,
+                     "v2");
+  instance.add_station("S");
+  instance.add_track_to_station("S", "v1", "v2");
+  instance.add_stop("tr2", "S", std::pair<int, int>(100, 160),
+                    std::pair<int, int>(160, 220), 30);
+  instance.add_empty_route("tr1");
+  instance.push_back_edge_to_route("tr1", "v0", "v1");
+  instance.push_back_edge_to_route("tr1", "v1", "v2");
+  instance.set_lambda(3);
+
+  instance.export_instance("./tmp/test-async-import/");
+
+  std::map<std::string, double> import_times;
+  const auto                    instance_async = instances::
+      GeneralPerformanceOptimizationInstance::import_instance_async(
+          "./tmp/test-async-import/", &import_times);
+  const instances::GeneralPerformanceOptimizationInstance instance_read(
+      "./tmp/test-async-import/");
+  std::filesystem::remove_all("./tmp");
+
+  EXPECT_TRUE(instance_async.check_consistency());
+  EXPECT_EQ(instance_async.const_n().number_of_vertices(),
+            instance_read.const_n().number_of_vertices());
+  EXPECT_EQ(instance_async.const_n().number_of_edges(),
+            instance_read.const_n().number_of_edges());
+  EXPECT_TRUE(instance_async.const_n().is_valid_successor(
+      instance_async.const_n().get_edge_index("v0", "v1"),
+      instance_async.const_n().get_edge_index("v1", "v2")));
+  EXPECT_EQ(instance_async.get_train_list().size(), 2);
+  EXPECT_EQ(instance_async.get_train_weights(),
+            instance_read.get_train_weights());
+  EXPECT_EQ(instance_async.get_train_optional(),
+            instance_read.get_train_optional());
+  EXPECT_EQ(instance_async.get_lambda(), 3);
+  EXPECT_EQ(instance_async.get_schedule("tr2").get_stops().size(), 1);
+  EXPECT_EQ(instance_async.get_schedule("tr2").get_stops().at(0),
+            instance_read.get_schedule("tr2").get_stops().at(0));
+  EXPECT_EQ(instance_async.get_station_list().get_station("S").tracks,
+            instance_read.get_station_list().get_station("S").tracks);
+  EXPECT_EQ(instance_async.get_route("tr1").size(), 2);
+  EXPECT_FALSE(instance_async.has_route("tr2"));
+
+  for (const auto& key :
+       {"network", "timetable/trains.json", "timetable/schedules.json",
+        "timetable/stations.json", "routes/routes.json", "problem_data.json",
+        "total"}) {
+    EXPECT_TRUE(import_times.count(key) == 1) << key;
+    EXPECT_GE(import_times[key], 0) << key;
+  }
+
+  EXPECT_THROW(
+      instances::GeneralPerformanceOptimizationInstance::import_instance_async(
+          "./does-not-exist/"),
+      exceptions::ImportException);
+}
+
+TEST(GeneralPerformanceOptimizationInstances, IndexAccessors) {
+  instances::GeneralPerformanceOptimizationInstance instance;
+  instance.n().add_vertex("v0", VertexType::TTD);
+  instance.n().add_vertex("v1", VertexType::TTD);
+  instance.n().add_vertex("v2", VertexType::TTD);
+  const auto v0_v1 = instance.n().add_edge("v0", "v1", 100, 10, false);
+  const auto v1_v2 = instance.n().add_edge("v1", "v2", 200, 20, false);
+  instance.n().add_successor(v0_v1, v1_v2);
+  const auto tr1 = instance.add_train("tr1", 50, 10, 2, 2, {0, 60}, 10, "v0",
+                                      {120, 180}, 5, "v2");
+  const auto tr2 = instance.add_train("tr2", 50, 10, 2, 2, {0, 60}, 10, "v0",
+                                      {120, 180}, 5, "v1");
+
+  // Routes are added in a different order than the trains
+  instance.add_empty_route("tr2");
+  EXPECT_FALSE(instance.has_route(tr1));
+  EXPECT_TRUE(instance.has_route(tr2));
+  EXPECT_THROW((void)instance.has_route(2),
+               cda_rail::exceptions::TrainNotExistentException);
+  EXPECT_THROW((void)instance.get_route(tr1),
+               cda_rail::exceptions::ConsistencyException);
+  instance.push_back_edge_to_route(tr2, v0_v1);
+  instance.add_empty_route("tr1");
+  instance.push_back_edge_to_route("tr1", v0_v1);
+  instance.push_back_edge_to_route(tr1, v1_v2);
+
+  EXPECT_EQ(&instance.get_route(tr1), &instance.get_route("tr1"));
+  EXPECT_EQ(&instance.get_route(tr2), &instance.get_route("tr2"));
+  EXPECT_EQ(instance.route_length(tr1), 300);
+  EXPECT_EQ(instance.route_length(tr2), 100);
+  EXPECT_EQ(instance.route_edge_pos(tr1, v1_v2), std::make_pair(100.0, 300.0));
+  EXPECT_EQ(instance.edges_used_by_train(tr1, true),
+            instance.edges_used_by_train("tr1", true));
+  EXPECT_EQ(instance.trains_on_edge(v1_v2, true), std::vector<size_t>({tr1}));
+  EXPECT_TRUE(instance.has_route_for_every_train());
+
+  // The solution reuses the routes of the instance
+  instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+      sol_instance(instance);
+  EXPECT_EQ(sol_instance.get_instance().route_length(tr2), 100);
+  sol_instance.set_train_routed_value(tr2, true);
+  cda_rail::TrainTrajectoryBuilder builder;
+  builder.add(0, 0, 10);
+  builder.add(10, 100, 10);
+  sol_instance.set_train_trajectory(tr2, builder.build());
+
+  EXPECT_FALSE(sol_instance.get_train_routed(tr1));
+  EXPECT_TRUE(sol_instance.get_train_routed(tr2));
+  EXPECT_EQ(&sol_instance.get_train_trajectory(tr2),
+            &sol_instance.get_train_trajectory("tr2"));
+  EXPECT_EQ(sol_instance.get_train_times(tr2), std::vector<double>({0, 10}));
+  EXPECT_EQ(sol_instance.get_train_pos(tr2, 10), 100);
+  EXPECT_EQ(sol_instance.get_train_speed(tr2, 0), 10);
+  EXPECT_EQ(sol_instance.get_time_at_pos(tr2, 100), 10);
+  EXPECT_THROW((void)sol_instance.get_train_routed(2),
+               cda_rail::exceptions::TrainNotExistentException);
+}
+
+TEST(GeneralPerformanceOptimizationInstances, TimetableConflicts) {
+  instances::GeneralPerformanceOptimizationInstance instance;
+  instance.n().add_vertex("l", VertexType::TTD);
+  instance.n().add_vertex("a", VertexType::TTD);
+  instance.n().add_vertex("b", VertexType::TTD);
+  instance.n().add_vertex("r", VertexType::TTD);
+  instance.n().add_edge("l", "a", 500, 50, false);
+  instance.n().add_edge("a", "b", 300, 50, false);
+  instance.n().add_edge("b", "r", 500, 50, false);
+  instance.n().add_edge("r", "b", 500, 50, false);
+  instance.n().add_edge("b", "a", 300, 50, false);
+  instance.n().add_edge("a", "l", 500, 50, false);
+  instance.n().add_successor({"l", "a"}, {"a", "b"});
+  instance.n().add_successor({"a", "b"}, {"b", "r"});
+  instance.n().add_successor({"r", "b"}, {"b", "a"});
+  instance.n().add_successor({"b", "a"}, {"a", "l"});
+  instance.add_station("S");
+  instance.add_track_to_station("S", "a", "b");
+  instance.add_track_to_station("S", "b", "a");
+
+  // s1 and s2 do not fit into S at the same time, s1 and rev block each other
+  const auto s1 = instance.add_train("s1", 200, 50, 1, 1, {0, 0}, 0, "l",
+                                     {0, 1000}, 0, "r", 0.5, true);
+  const auto s2 = instance.add_train("s2", 200, 50, 1, 1, {30, 30}, 0, "l",
+                                     {0, 1000}, 0, "r", 2, true);
+  const auto rev = instance.add_train("rev", 50, 50, 1, 1, {0, 0}, 0, "r",
+                                      {0, 1000}, 0, "l", 1, true);
+  instance.add_stop("s1", "S", std::pair<int, int>(100, 100),
+                    std::pair<int, int>(200, 200), 60);
+  instance.add_stop("s2", "S", std::pair<int, int>(100, 100),
+                    std::pair<int, int>(140, 140), 30);
+  instance.add_stop("rev", "S", std::pair<int, int>(150, 150),
+                    std::pair<int, int>(250, 250), 60);
+  for (const auto* tr_name : {"s1", "s2"}) {
+    instance.add_empty_route(tr_name);
+    instance.push_back_edge_to_route(tr_name, "l", "a");
+    instance.push_back_edge_to_route(tr_name, "a", "b");
+    instance.push_back_edge_to_route(tr_name, "b", "r");
+  }
+  instance.add_empty_route("rev");
+  instance.push_back_edge_to_route("rev", "r", "b");
+  instance.push_back_edge_to_route("rev", "b", "a");
+  instance.push_back_edge_to_route("rev", "a", "l");
+
+  // late cannot travel 1300 m within 20 s, h1 and h2 cannot enter together
+  const auto late = instance.add_train("late", 100, 50, 1, 1, {500, 500}, 0,
+                                       "l", {510, 520}, 0, "r");
+  const auto h1   = instance.add_train("h1", 100, 50, 1, 1, {700, 700}, 0,
+                                       "l", {0, 2000}, 0, "r", 3, true);
+  const auto h2   = instance.add_train("h2", 100, 50, 1, 1, {700, 700}, 0,
+                                       "l", {0, 2000}, 0, "r", 1, true);
+
+  const auto conflicts = instance.check_timetable_conflicts(true);
+  ASSERT_EQ(conflicts.size(), 4);
+  EXPECT_EQ(conflicts.at(0).type,
+            instances::TimetableConflictType::RunningTime);
+  EXPECT_EQ(conflicts.at(0).trains, std::vector<size_t>({late}));
+  EXPECT_NE(conflicts.at(0).explanation.find("late"), std::string::npos);
+  EXPECT_EQ(conflicts.at(1).type,
+            instances::TimetableConflictType::StationCapacity);
+  EXPECT_EQ(conflicts.at(1).trains, std::vector<size_t>({s1, s2}));
+  EXPECT_EQ(conflicts.at(2).type,
+            instances::TimetableConflictType::OppositeTracks);
+  EXPECT_EQ(conflicts.at(2).trains, std::vector<size_t>({s1, rev}));
+  EXPECT_EQ(conflicts.at(3).type,
+            instances::TimetableConflictType::EntryHeadway);
+  EXPECT_EQ(conflicts.at(3).trains, std::vector<size_t>({h1, h2}));
+
+  // Without fixed routes, every train might stop in both directions
+  const auto conflicts_free_routes = instance.check_timetable_conflicts(false);
+  ASSERT_EQ(conflicts_free_routes.size(), 3);
+  EXPECT_EQ(conflicts_free_routes.at(1).type,
+            instances::TimetableConflictType::StationCapacity);
+  EXPECT_EQ(conflicts_free_routes.at(2).type,
+            instances::TimetableConflictType::EntryHeadway);
+
+  // late is not optional
+  EXPECT_FALSE(
+      instance.optional_trains_resolving_conflicts(conflicts).has_value());
+  instance.set_train_optionality_value("late", true);
+  const auto trains_to_drop =
+      instance.optional_trains_resolving_conflicts(conflicts);
+  ASSERT_TRUE(trains_to_drop.has_value());
+  EXPECT_EQ(trains_to_drop.value(), std::vector<size_t>({s1, late, h2}));
+}
+
 // NOLINTEND (clang-analyzer-deadcode.DeadStores)
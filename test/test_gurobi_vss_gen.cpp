@@ -1,4 +1,6 @@
+#include "CustomExceptions.hpp"
 #include "VSSModel.hpp"
+#include "solver/mip-based/GurobiEnvironmentPool.hpp"
 #include "solver/mip-based/VSSGenTimetableSolver.hpp"
 
 #include "gtest/gtest.h"
@@ -1548,3 +1550,138 @@ TEST(Solver, SimpleStationExportOptions) {
   std::filesystem::remove("model.mps");
   std::filesystem::remove("model.sol");
 }
+
+TEST(Solver, GurobiEnvironmentPool) {
+  auto& pool =
+      cda_rail::solver::mip_based::GurobiEnvironmentPool::get_instance();
+  pool.clear();
+  pool.reset_metrics();
+  const auto max_size_before = pool.get_max_size();
+  pool.set_max_size(2);
+
+  auto env1 = pool.acquire();
+  auto env2 = pool.acquire();
+  EXPECT_NE(env1, nullptr);
+  EXPECT_NE(env2, nullptr);
+  EXPECT_EQ(pool.get_metrics().num_acquired, 2);
+  EXPECT_EQ(pool.get_metrics().num_created, 2);
+  EXPECT_EQ(pool.get_metrics().num_reused, 0);
+  EXPECT_EQ(pool.number_of_idle_environments(), 0);
+
+  // Parameters are reset on return
+  env1->set(GRB_IntParam_OutputFlag, 0);
+  pool.release(std::move(env1));
+  EXPECT_EQ(pool.number_of_idle_environments(), 1);
+  env1 = pool.acquire();
+  EXPECT_EQ(env1->get(GRB_IntParam_OutputFlag), 1);
+  EXPECT_EQ(pool.get_metrics().num_acquired, 3);
+  EXPECT_EQ(pool.get_metrics().num_created, 2);
+  EXPECT_EQ(pool.get_metrics().num_reused, 1);
+  EXPECT_GE(pool.get_metrics().total_acquisition_time,
+            pool.get_metrics().max_acquisition_time);
+
+  pool.release(std::move(env1));
+  pool.release(std::move(env2));
+  EXPECT_EQ(pool.number_of_idle_environments(), 2);
+  pool.set_max_size(1);
+  EXPECT_EQ(pool.number_of_idle_environments(), 1);
+  pool.clear();
+  EXPECT_EQ(pool.number_of_idle_environments(), 0);
+
+  // Subsequent solves share one environment
+  pool.reset_metrics();
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/SimpleStation/");
+  for (size_t i = 0; i < 2; i++) {
+    const auto sol = solver.solve({15, true, true, false}, {}, {}, {}, 20);
+    EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_EQ(sol.get_obj(), 1);
+  }
+  EXPECT_EQ(pool.get_metrics().num_acquired, 2);
+  EXPECT_EQ(pool.get_metrics().num_created, 1);
+  EXPECT_EQ(pool.get_metrics().num_reused, 1);
+  EXPECT_EQ(pool.number_of_idle_environments(), 1);
+
+  pool.set_max_size(max_size_before);
+}
+
+TEST(Solver, WarmStartFromPriorSolution) {
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/SimpleStation/");
+  EXPECT_FALSE(solver.has_warm_start());
+
+  const auto prior_sol = solver.solve({15, true}, {}, {}, {}, 60);
+  EXPECT_EQ(prior_sol.get_status(), cda_rail::SolutionStatus::Optimal);
+
+  solver.set_warm_start(prior_sol);
+  EXPECT_TRUE(solver.has_warm_start());
+  const auto sol = solver.solve({15, true}, {}, {}, {}, 60);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol.get_obj(), prior_sol.get_obj());
+
+  // Hints do not change the optimal value either
+  solver.set_warm_start(prior_sol, true);
+  const auto sol_hints = solver.solve({15, true}, {}, {}, {}, 60);
+  EXPECT_EQ(sol_hints.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_hints.get_obj(), prior_sol.get_obj());
+
+  // Free routes only use speeds
+  solver.set_warm_start(prior_sol);
+  const auto sol_free = solver.solve({15, false}, {}, {}, {}, 240);
+  EXPECT_EQ(sol_free.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_free.get_obj(), prior_sol.get_obj());
+
+  // Warm start from an exported solution
+  prior_sol.export_solution("tmp_warm_start", true);
+  solver.set_warm_start(std::filesystem::path("tmp_warm_start"));
+  const auto sol_import = solver.solve({15, true}, {}, {}, {}, 60);
+  EXPECT_EQ(sol_import.get_obj(), prior_sol.get_obj());
+  std::filesystem::remove_all("tmp_warm_start");
+
+  solver.clear_warm_start();
+  EXPECT_FALSE(solver.has_warm_start());
+}
+
+TEST(Solver, CoarseToFineTimeDiscretization) {
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/SimpleStation/");
+
+  const auto sol = solver.solve_coarse_to_fine({15, true}, {60, 30}, {}, {},
+                                               {}, 120);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol.get_obj(), 1);
+  EXPECT_EQ(sol.get_dt(), 15);
+  EXPECT_FALSE(solver.has_warm_start());
+
+  // A warm start set by the user is restored, even if a solve throws
+  solver.set_warm_start(sol);
+  cda_rail::solver::mip_based::SolverStrategy invalid_strategy;
+  invalid_strategy.iterative_approach = true;
+  invalid_strategy.update_value       = 0.5;
+  EXPECT_THROW(
+      solver.solve_coarse_to_fine({15, true}, {60}, {}, invalid_strategy),
+      cda_rail::exceptions::ConsistencyException);
+  EXPECT_TRUE(solver.has_warm_start());
+  solver.clear_warm_start();
+
+  EXPECT_THROW(solver.solve_coarse_to_fine({15, true}, {30, 60}),
+               cda_rail::exceptions::InvalidInputException);
+  EXPECT_THROW(solver.solve_coarse_to_fine({15, true}, {15}),
+               cda_rail::exceptions::InvalidInputException);
+}
+
+TEST(Solver, ThreadsAndObjectiveBound) {
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/SimpleStation/");
+  EXPECT_EQ(solver.get_threads(), 0);
+  EXPECT_THROW(solver.set_threads(-1),
+               cda_rail::exceptions::InvalidInputException);
+  solver.set_threads(1);
+  EXPECT_EQ(solver.get_threads(), 1);
+
+  const auto sol = solver.solve({15, true}, {}, {}, {}, 60);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_NEAR(solver.get_obj_bound(), sol.get_mip_obj(), 1e-4);
+  EXPECT_GE(solver.get_create_time(), 0);
+  EXPECT_GE(solver.get_solve_time(), 0);
+}
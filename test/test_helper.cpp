@@ -1,12 +1,16 @@
+#include "ColumnFile.hpp"
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
+#include "EdgePairsSaxParser.hpp"
 #include "VSSModel.hpp"
 
 #include "gtest/gtest.h"
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <filesystem>
+#include <fstream>
 #include <limits>
 #include <stdexcept>
 #include <string>
@@ -1787,4 +1791,118 @@ TEST(Helper, ConsistencySmallNegativeValues) {
                cda_rail::exceptions::ConsistencyException);
 }
 
+TEST(Helper, ColumnFile) {
+  const std::vector<double> column = {0,
+                                      10,
+                                      20,
+                                      20,
+                                      -1.5,
+                                      1.0 / 3,
+                                      std::numeric_limits<double>::max(),
+                                      std::numeric_limits<double>::quiet_NaN(),
+                                      0};
+
+  std::filesystem::create_directories("./tmp");
+  cda_rail::ColumnFileWriter writer("./tmp/column_file.bin");
+  writer.write_size(3);
+  writer.write_int(-42);
+  writer.write_bool(true);
+  writer.write_string("tr1");
+  writer.write_column(column);
+  writer.write_column({});
+  writer.close();
+
+  // Repeated values only take one byte
+  cda_rail::ColumnFileWriter writer_constant("./tmp/column_file_constant.bin");
+  writer_constant.write_column(std::vector<double>(100, 10));
+  writer_constant.close();
+  EXPECT_LT(std::filesystem::file_size("./tmp/column_file_constant.bin"), 130);
+
+  cda_rail::ColumnFileReader reader("./tmp/column_file.bin");
+  EXPECT_EQ(reader.read_size(), 3);
+  EXPECT_EQ(reader.read_int(), -42);
+  EXPECT_TRUE(reader.read_bool());
+  EXPECT_EQ(reader.read_string(), "tr1");
+  const auto column_read = reader.read_column();
+  EXPECT_EQ(column_read.size(), column.size());
+  for (size_t i = 0; i < column.size(); i++) {
+    if (std::isnan(column[i])) {
+      EXPECT_TRUE(std::isnan(column_read[i]));
+    } else {
+      EXPECT_EQ(column_read[i], column[i]);
+    }
+  }
+  EXPECT_TRUE(reader.read_column().empty());
+  EXPECT_THROW((void)reader.read_size(), cda_rail::exceptions::ImportException);
+
+  std::ofstream invalid_file("./tmp/invalid_column_file.bin");
+  invalid_file << "{}";
+  invalid_file.close();
+  EXPECT_THROW(cda_rail::ColumnFileReader("./tmp/invalid_column_file.bin"),
+               cda_rail::exceptions::ImportException);
+
+  // Corrupted lengths exceeding the file are rejected before allocating
+  cda_rail::ColumnFileWriter writer_corrupted(
+      "./tmp/corrupted_column_file.bin");
+  writer_corrupted.write_size(std::numeric_limits<size_t>::max());
+  writer_corrupted.write_size(std::numeric_limits<size_t>::max());
+  writer_corrupted.close();
+  cda_rail::ColumnFileReader reader_corrupted(
+      "./tmp/corrupted_column_file.bin");
+  EXPECT_THROW((void)reader_corrupted.read_string(),
+               cda_rail::exceptions::ImportException);
+  EXPECT_THROW((void)reader_corrupted.read_column(),
+               cda_rail::exceptions::ImportException);
+  std::filesystem::remove_all("./tmp");
+}
+
+TEST(Helper, EdgePairsSaxParser) {
+  std::filesystem::create_directories("./tmp");
+  std::ofstream file("./tmp/edge_pairs.json");
+  file << R"({"tr1": [["v0", "v1"], ["v1", "v2"]], "tr2": [], "tr3": [["v2",)"
+       << R"( "v1"]]})";
+  file.close();
+
+  std::vector<std::string>                          keys;
+  std::vector<std::vector<std::string>>             pairs;
+  const cda_rail::EdgePairsSaxParser::KeyCallback  on_key =
+      [&keys](const std::string& key) { keys.push_back(key); };
+  const cda_rail::EdgePairsSaxParser::PairCallback on_pair =
+      [&pairs](const std::string& key, const std::string& v_0,
+               const std::string& v_1) { pairs.push_back({key, v_0, v_1}); };
+
+  cda_rail::EdgePairsSaxParser::parse("./tmp/edge_pairs.json", on_key, on_pair);
+  EXPECT_EQ(keys, std::vector<std::string>({"tr1", "tr2", "tr3"}));
+  EXPECT_EQ(pairs, std::vector<std::vector<std::string>>(
+                       {{"tr1", "v0", "v1"}, {"tr1", "v1", "v2"},
+                        {"tr3", "v2", "v1"}}));
+
+  // null is treated as an empty file
+  std::ofstream null_file("./tmp/edge_pairs_null.json");
+  null_file << "null";
+  null_file.close();
+  keys.clear();
+  cda_rail::EdgePairsSaxParser::parse("./tmp/edge_pairs_null.json", on_key,
+                                      on_pair);
+  EXPECT_TRUE(keys.empty());
+
+  std::ofstream invalid_file("./tmp/edge_pairs_invalid.json");
+  invalid_file << R"({"tr1": [["v0", "v1", "v2"]]})";
+  invalid_file.close();
+  EXPECT_THROW(cda_rail::EdgePairsSaxParser::parse(
+                   "./tmp/edge_pairs_invalid.json", on_key, on_pair),
+               cda_rail::exceptions::ImportException);
+
+  std::ofstream broken_file("./tmp/edge_pairs_broken.json");
+  broken_file << R"({"tr1": [["v0", "v1"])";
+  broken_file.close();
+  EXPECT_THROW(cda_rail::EdgePairsSaxParser::parse(
+                   "./tmp/edge_pairs_broken.json", on_key, on_pair),
+               cda_rail::exceptions::ImportException);
+  EXPECT_THROW(cda_rail::EdgePairsSaxParser::parse("./tmp/does_not_exist.json",
+                                                   on_key, on_pair),
+               cda_rail::exceptions::ImportException);
+  std::filesystem::remove_all("./tmp");
+}
+
 // NOLINTEND(clang-diagnostic-unused-result)
@@ -38,3 +38,53 @@ TEST(Functionality, MultiArray) {
   EXPECT_THROW(a1(0, 2, 0), std::out_of_range);
   EXPECT_THROW(a1(0, 0, 3), std::out_of_range);
 }
+
+TEST(Functionality, MultiArrayWithIntervals) {
+  auto a1 = cda_rail::MultiArray<size_t>::with_intervals(
+      {{1, 2}, {0, 3}, {3, 1}}, 4, 2);
+
+  EXPECT_EQ(a1.size(), 12);
+  EXPECT_EQ(a1.dimensions(), 3);
+  EXPECT_EQ(a1.get_shape(), std::vector<size_t>({3, 4, 2}));
+
+  // Set stored elements
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t k = 0; k < 2; ++k) {
+        const bool stored = (i == 0 && j >= 1 && j <= 2) || i == 1;
+        EXPECT_EQ(a1.is_stored(i, j, k), stored);
+        if (stored) {
+          a1(i, j, k) = 100 * i + 10 * j + k + 1;
+        }
+      }
+    }
+  }
+
+  // Check elements, which are default values if not stored
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t k = 0; k < 2; ++k) {
+        if (a1.is_stored(i, j, k)) {
+          EXPECT_EQ(a1(i, j, k), 100 * i + 10 * j + k + 1);
+          EXPECT_EQ(a1.at(i, j, k), 100 * i + 10 * j + k + 1);
+        } else {
+          EXPECT_EQ(a1.at(i, j, k), 0);
+        }
+      }
+    }
+  }
+
+  // Elements that are not stored cannot be set
+  EXPECT_THROW(a1(0, 0, 0), std::out_of_range);
+  EXPECT_THROW(a1(2, 1, 0), std::out_of_range);
+
+  // Shape is checked as before
+  EXPECT_THROW(a1(0, 1), std::invalid_argument);
+  EXPECT_THROW(a1(3, 1, 0), std::out_of_range);
+  EXPECT_THROW(a1(1, 4, 0), std::out_of_range);
+  EXPECT_THROW(a1(1, 1, 2), std::out_of_range);
+
+  // Intervals must be within the second dimension
+  EXPECT_THROW(cda_rail::MultiArray<size_t>::with_intervals({{0, 4}}, 4),
+               std::out_of_range);
+}
@@ -1007,6 +1007,78 @@ TEST(Functionality, HelperFunctions) {
                         tr2) != trains_on_v1_v2_partial.end());
 }
 
+TEST(Functionality, TrainIntervalIndex) {
+  cda_rail::instances::VSSGenerationTimetable instance;
+  instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  instance.n().add_edge("v0", "v1", 100, 100, false);
+
+  const auto tr1 =
+      instance.add_train("tr1", 100, 100, 2, 2, 0, 10, 0, 200, 10, 1);
+  const auto tr2 =
+      instance.add_train("tr2", 100, 100, 2, 2, 60, 10, 0, 120, 10, 1);
+  const auto tr3 =
+      instance.add_train("tr3", 100, 100, 2, 2, 80, 10, 0, 150, 10, 1);
+  const auto tr4 =
+      instance.add_train("tr4", 100, 100, 2, 2, 150, 10, 0, 180, 10, 1);
+
+  const auto index = instance.get_train_interval_index();
+  EXPECT_EQ(index.number_of_trains(), 4);
+  EXPECT_EQ(index.get_interval(tr2), std::make_pair(60, 120));
+  EXPECT_TRUE(index.is_present(tr3, 80));
+  EXPECT_FALSE(index.is_present(tr3, 150));
+
+  // Results coincide with the instance queries
+  for (int t = 0; t <= 210; t++) {
+    EXPECT_EQ(index.trains_at_t(t), instance.trains_at_t(t));
+    EXPECT_EQ(index.trains_at_t(t, {tr4, tr2}),
+              instance.trains_at_t(t, {tr4, tr2}));
+  }
+  EXPECT_EQ(index.trains_at_t(100), std::vector<size_t>({tr1, tr2, tr3}));
+  EXPECT_EQ(index.trains_at_t(150), std::vector<size_t>({tr1, tr4}));
+  EXPECT_TRUE(index.trains_at_t(-1).empty());
+
+  EXPECT_EQ(index.trains_in_time_window(120, 150),
+            std::vector<size_t>({tr1, tr3}));
+  EXPECT_EQ(index.trains_in_time_window(119, 151),
+            std::vector<size_t>({tr1, tr2, tr3, tr4}));
+  EXPECT_EQ(index.trains_in_time_window(200, 300), std::vector<size_t>());
+  EXPECT_THROW((void)index.trains_in_time_window(100, 100),
+               cda_rail::exceptions::InvalidInputException);
+
+  const auto by_step = index.trains_at_time_steps(15, 15);
+  EXPECT_EQ(by_step.size(), 15);
+  for (size_t t = 0; t < by_step.size(); t++) {
+    EXPECT_EQ(by_step.at(t), instance.trains_at_t(static_cast<int>(t) * 15));
+  }
+  EXPECT_THROW((void)index.trains_at_time_steps(0, 15),
+               cda_rail::exceptions::InvalidInputException);
+  EXPECT_THROW((void)index.is_present(4, 0),
+               cda_rail::exceptions::TrainNotExistentException);
+
+  // Compare against checking every interval, including empty ones
+  std::vector<std::pair<int, int>> intervals;
+  for (int i = 0; i < 50; i++) {
+    intervals.emplace_back((i * 37) % 101, (i * 37) % 101 + (i * 13) % 29);
+  }
+  const cda_rail::TrainIntervalIndex large_index(intervals);
+  for (int t = -1; t <= 131; t++) {
+    std::vector<size_t> expected;
+    std::vector<size_t> expected_window;
+    for (size_t tr = 0; tr < intervals.size(); tr++) {
+      const auto& [t_0, t_n] = intervals.at(tr);
+      if (t_0 <= t && t < t_n) {
+        expected.push_back(tr);
+      }
+      if (t_0 < t_n && t_0 < t + 10 && t < t_n) {
+        expected_window.push_back(tr);
+      }
+    }
+    EXPECT_EQ(large_index.trains_at_t(t), expected);
+    EXPECT_EQ(large_index.trains_in_time_window(t, t + 10), expected_window);
+  }
+}
+
 TEST(Example, Stammstrecke) {
   cda_rail::instances::VSSGenerationTimetable instance;
 
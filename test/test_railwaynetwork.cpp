@@ -8,7 +8,10 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <cmath>
 #include <optional>
+#include <unordered_set>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -2803,6 +2806,53 @@ TEST(Functionality, ShortestPaths) {
   EXPECT_EQ(shortest_paths_4_path, std::vector<size_t>({v1_v2}));
 }
 
+TEST(Functionality, ShortestPathDistances) {
+  cda_rail::Network network;
+  const auto v0 = network.add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto v1 = network.add_vertex("v1", cda_rail::VertexType::TTD);
+  const auto v2 = network.add_vertex("v2", cda_rail::VertexType::TTD);
+  const auto v3 = network.add_vertex("v3", cda_rail::VertexType::TTD);
+
+  const auto v0_v1 = network.add_edge(v0, v1, 100, 10, false);
+  const auto v1_v2 = network.add_edge(v1, v2, 200, 20, false);
+  const auto v0_v2 = network.add_edge(v0, v2, 250, 5, false);
+  const auto v2_v3 = network.add_edge(v2, v3, 50, 10, false);
+
+  const std::unordered_set<size_t> all_edges = {v0_v1, v1_v2, v0_v2, v2_v3};
+  const auto length = [](const cda_rail::Edge& edge) { return edge.length; };
+  const auto time   = [](const cda_rail::Edge& edge) {
+    return edge.length / edge.max_speed;
+  };
+
+  const auto distances =
+      network.shortest_path_distances({v0}, all_edges, length);
+  EXPECT_EQ(distances, std::vector<double>({0, 100, 250, 300}));
+
+  const auto times = network.shortest_path_distances({v0}, all_edges, time);
+  EXPECT_EQ(times, std::vector<double>({0, 10, 20, 25}));
+
+  // Backward from v3 without v0_v1, v0 is only reachable via v0_v2
+  const auto backward = network.shortest_path_distances(
+      {v3}, {v1_v2, v0_v2, v2_v3}, length, false);
+  EXPECT_EQ(backward, std::vector<double>({300, 250, 50, 0}));
+
+  // Multiple sources and unreachable vertices
+  const auto multi =
+      network.shortest_path_distances({v1, v3}, {v1_v2}, length);
+  EXPECT_TRUE(std::isinf(multi.at(v0)));
+  EXPECT_EQ(multi.at(v1), 0);
+  EXPECT_EQ(multi.at(v2), 200);
+  EXPECT_EQ(multi.at(v3), 0);
+
+  // Usable edges given by a predicate
+  const auto predicate = network.shortest_path_distances(
+      {v0}, [v0_v2](size_t e) { return e != v0_v2; }, length);
+  EXPECT_EQ(predicate, std::vector<double>({0, 100, 300, 350}));
+
+  EXPECT_THROW((void)network.shortest_path_distances({10}, all_edges, length),
+               cda_rail::exceptions::VertexNotExistentException);
+}
+
 TEST(Functionality, ReadTrains) {
   auto trains = cda_rail::TrainList::import_trains(
       "./example-networks/SimpleStation/timetable/");
@@ -3697,6 +3747,130 @@ TEST(Functionality, RouteMapHelper) {
   EXPECT_EQ(tr1_map.length(network), 60);
 }
 
+TEST(Functionality, RouteEdgeAtPos) {
+  cda_rail::Network network;
+  network.add_vertex("v0", cda_rail::VertexType::TTD);
+  network.add_vertex("v1", cda_rail::VertexType::TTD);
+  network.add_vertex("v2", cda_rail::VertexType::TTD);
+  network.add_vertex("v3", cda_rail::VertexType::TTD);
+
+  const auto v0_v1 = network.add_edge("v0", "v1", 10, 5, false);
+  const auto v1_v2 = network.add_edge("v1", "v2", 20, 5, false);
+  const auto v2_v3 = network.add_edge("v2", "v3", 30, 5, false);
+
+  network.add_successor(v0_v1, v1_v2);
+  network.add_successor(v1_v2, v2_v3);
+
+  cda_rail::Route route;
+  EXPECT_EQ(route.length(network), 0);
+  EXPECT_THROW((void)route.get_edge_at_pos(0, network),
+               cda_rail::exceptions::ConsistencyException);
+
+  route.push_back_edge(v1_v2, network);
+  EXPECT_EQ(route.length(network), 20);
+  EXPECT_EQ(route.get_edge_at_pos(0, network), v1_v2);
+  EXPECT_EQ(route.get_edge_at_pos(20, network), v1_v2);
+
+  // Cached lengths have to be updated whenever the route changes
+  route.push_back_edge(v2_v3, network);
+  route.push_front_edge(v0_v1, network);
+  EXPECT_EQ(route.length(network), 60);
+  EXPECT_EQ(route.get_edge_at_pos(0, network), v0_v1);
+  EXPECT_EQ(route.get_edge_at_pos(9.5, network), v0_v1);
+  EXPECT_EQ(route.get_edge_at_pos(10, network), v1_v2);
+  EXPECT_EQ(route.get_edge_at_pos(30, network), v2_v3);
+  EXPECT_EQ(route.get_edge_at_pos(60, network), v2_v3);
+  EXPECT_THROW((void)route.get_edge_at_pos(61, network),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW((void)route.get_edge_at_pos(-1, network),
+               cda_rail::exceptions::InvalidInputException);
+
+  route.remove_first_edge();
+  EXPECT_EQ(route.length(network), 50);
+  EXPECT_EQ(route.get_edge_at_pos(10, network), v1_v2);
+  route.remove_last_edge();
+  EXPECT_EQ(route.length(network), 20);
+  EXPECT_THROW((void)route.get_edge_at_pos(30, network),
+               cda_rail::exceptions::ConsistencyException);
+
+  // Changing the network requires updating the cached lengths explicitly
+  network.change_edge_length(v1_v2, 40);
+  EXPECT_THROW((void)route.length(network),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW((void)route.get_edge_at_pos(30, network),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW((void)route.edge_pos(v1_v2, network),
+               cda_rail::exceptions::ConsistencyException);
+  route.update_edge_lengths(network);
+  EXPECT_EQ(route.length(network), 40);
+  EXPECT_EQ(route.get_edge_at_pos(30, network), v1_v2);
+  EXPECT_EQ(route.edge_pos(v1_v2, network), std::make_pair(0.0, 40.0));
+
+  cda_rail::RouteMap route_map;
+  route_map.add_empty_route("tr1");
+  route_map.push_back_edge("tr1", v1_v2, network);
+  network.change_edge_length(v1_v2, 25);
+  EXPECT_THROW((void)route_map.length("tr1", network),
+               cda_rail::exceptions::ConsistencyException);
+  route_map.update_edge_lengths(network);
+  EXPECT_EQ(route_map.length("tr1", network), 25);
+
+  // Extending an outdated route recomputes all cached lengths
+  network.change_edge_length(v1_v2, 30);
+  route_map.push_back_edge("tr1", v2_v3, network);
+  EXPECT_EQ(route_map.length("tr1", network), 60);
+}
+
+TEST(Functionality, RouteEdgeIndex) {
+  cda_rail::Network network;
+  network.add_vertex("v0", cda_rail::VertexType::TTD);
+  network.add_vertex("v1", cda_rail::VertexType::TTD);
+  network.add_vertex("v2", cda_rail::VertexType::TTD);
+  network.add_vertex("v3", cda_rail::VertexType::TTD);
+
+  const auto v0_v1 = network.add_edge("v0", "v1", 10, 5, false);
+  const auto v1_v2 = network.add_edge("v1", "v2", 20, 5, true);
+  const auto v2_v3 = network.add_edge("v2", "v3", 30, 5, false);
+
+  network.add_successor(v0_v1, v1_v2);
+  network.add_successor(v1_v2, v2_v3);
+
+  cda_rail::Route route;
+  EXPECT_FALSE(route.contains_edge(v0_v1));
+
+  route.push_back_edge(v1_v2, network);
+  route.push_front_edge(v0_v1, network);
+  route.push_back_edge(v2_v3, network);
+  EXPECT_TRUE(route.contains_edge(v0_v1));
+  EXPECT_TRUE(route.contains_edge(v2_v3));
+  EXPECT_EQ(route.edge_pos(v0_v1, network), std::make_pair(0.0, 10.0));
+  EXPECT_EQ(route.edge_pos(v1_v2, network), std::make_pair(10.0, 30.0));
+  EXPECT_EQ(route.edge_pos(v2_v3, network), std::make_pair(30.0, 60.0));
+
+  route.remove_first_edge();
+  EXPECT_FALSE(route.contains_edge(v0_v1));
+  EXPECT_THROW((void)route.edge_pos(v0_v1, network),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_EQ(route.edge_pos(v1_v2, network), std::make_pair(0.0, 20.0));
+  EXPECT_EQ(route.edge_pos(v2_v3, network), std::make_pair(20.0, 50.0));
+
+  route.remove_last_edge();
+  EXPECT_FALSE(route.contains_edge(v2_v3));
+  EXPECT_TRUE(route.contains_edge(v1_v2));
+  route.push_back_edge(v2_v3, network);
+
+  // Replace v1_v2 by two edges of length 5 and 15
+  network.add_vertex("v12", cda_rail::VertexType::NoBorder);
+  const auto v1_v12 = network.add_edge("v1", "v12", 5, 5, true);
+  const auto v12_v2 = network.add_edge("v12", "v2", 15, 5, true);
+  route.update_after_discretization({{v1_v2, {v1_v12, v12_v2}}}, network);
+  EXPECT_FALSE(route.contains_edge(v1_v2));
+  EXPECT_EQ(route.get_edges(), std::vector<size_t>({v1_v12, v12_v2, v2_v3}));
+  EXPECT_EQ(route.length(network), 50);
+  EXPECT_EQ(route.edge_pos(v12_v2, network), std::make_pair(5.0, 20.0));
+  EXPECT_EQ(route.get_edge_at_pos(7, network), v12_v2);
+}
+
 TEST(Functionality, Iterators) {
   // Create a train list
   auto trains = cda_rail::TrainList();
@@ -3764,4 +3938,68 @@ TEST(Functionality, IsFullyInStation) {
   EXPECT_FALSE(stations.is_fully_in_station("Station1", {0, 2}));
 }
 
+TEST(Functionality, RouteMapIndices) {
+  cda_rail::Network network;
+  network.add_vertex("v0", cda_rail::VertexType::TTD);
+  network.add_vertex("v1", cda_rail::VertexType::TTD);
+  network.add_vertex("v2", cda_rail::VertexType::TTD);
+  const auto v0_v1 = network.add_edge("v0", "v1", 10, 5, false);
+  const auto v1_v2 = network.add_edge("v1", "v2", 20, 5, false);
+  network.add_successor(v0_v1, v1_v2);
+
+  cda_rail::RouteMap routes;
+  routes.add_empty_route("tr1");
+  routes.add_empty_route("tr2");
+  routes.add_empty_route("tr3");
+  EXPECT_EQ(routes.get_route_index("tr1"), 0);
+  EXPECT_EQ(routes.get_route_index("tr2"), 1);
+  EXPECT_EQ(routes.get_route_index("tr3"), 2);
+  EXPECT_THROW((void)routes.get_route_index("tr4"),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW((void)routes.get_route(3),
+               cda_rail::exceptions::ConsistencyException);
+
+  routes.push_back_edge(1, v0_v1, network);
+  routes.push_back_edge("tr2", v1_v2, network);
+  EXPECT_EQ(&routes.get_route(1), &routes.get_route("tr2"));
+  EXPECT_EQ(routes.get_route(1).get_edges(),
+            std::vector<size_t>({v0_v1, v1_v2}));
+  EXPECT_TRUE(routes.get_route(0).empty());
+
+  // Removing a route shifts the indices of all later routes
+  routes.remove_route("tr1");
+  EXPECT_FALSE(routes.has_route("tr1"));
+  EXPECT_EQ(routes.size(), 2);
+  EXPECT_EQ(routes.get_route_index("tr2"), 0);
+  EXPECT_EQ(routes.get_route_index("tr3"), 1);
+  EXPECT_EQ(routes.get_route(0).get_edges(),
+            std::vector<size_t>({v0_v1, v1_v2}));
+  EXPECT_THROW(routes.add_empty_route("tr2"),
+               cda_rail::exceptions::InvalidInputException);
+}
+
+TEST(Functionality, StationListIndices) {
+  cda_rail::StationList stations;
+  EXPECT_EQ(stations.add_station("S1"), 0);
+  EXPECT_EQ(stations.add_station("S2"), 1);
+  stations.add_track_to_station("S2", 3);
+  EXPECT_EQ(stations.get_station_index("S1"), 0);
+  EXPECT_EQ(stations.get_station_index("S2"), 1);
+  EXPECT_TRUE(stations.has_station(1));
+  EXPECT_FALSE(stations.has_station(2));
+  EXPECT_EQ(&stations.get_station(1), &stations.get_station("S2"));
+  EXPECT_EQ(stations.get_station(1).tracks, std::vector<size_t>({3}));
+  EXPECT_EQ(stations.get_station_names(),
+            std::vector<std::string>({"S1", "S2"}));
+  EXPECT_THROW((void)stations.get_station(2),
+               cda_rail::exceptions::StationNotExistentException);
+  EXPECT_THROW((void)stations.get_station_index("S3"),
+               cda_rail::exceptions::StationNotExistentException);
+
+  // Adding an existing station keeps its index but removes its tracks
+  EXPECT_EQ(stations.add_station("S2"), 1);
+  EXPECT_EQ(stations.size(), 2);
+  EXPECT_TRUE(stations.get_station("S2").tracks.empty());
+}
+
 // NOLINTEND(clang-diagnostic-unused-result,clang-analyzer-deadcode.DeadStores)